@@ -24,6 +24,8 @@ struct call_subquery
 {
     cypher_astnode_t _astnode;
     cypher_astnode_t *query;
+    bool in_transactions;
+    const cypher_astnode_t *batch_size;
 };
 
 
@@ -44,24 +46,32 @@ const struct cypher_astnode_vt cypher_call_subquery_astnode_vt =
       .clone = clone };
 
 
-cypher_astnode_t *cypher_ast_call_subquery
+static cypher_astnode_t *_call_subquery
 (
     cypher_astnode_t *query,
+    bool in_transactions,
+    cypher_astnode_t *batch_size,
     struct cypher_input_range range
 )
 {
+    REQUIRE_TYPE_OPTIONAL(batch_size, CYPHER_AST_EXPRESSION, NULL);
+
     struct call_subquery *node = calloc(1, sizeof(struct call_subquery));
     if (node == NULL)
     {
         return NULL;
     }
 
+    cypher_astnode_t *children[2] = { query, batch_size };
+    unsigned int nchildren = (batch_size != NULL) ? 2 : 1;
     if (cypher_astnode_init(&(node->_astnode), CYPHER_AST_CALL_SUBQUERY,
-            &query, 1, range))
+            children, nchildren, range))
     {
         goto cleanup;
     }
     node->query = query;
+    node->in_transactions = in_transactions;
+    node->batch_size = batch_size;
     return &(node->_astnode);
 
     int errsv;
@@ -72,6 +82,25 @@ cleanup:
     return NULL;
 }
 
+cypher_astnode_t *cypher_ast_call_subquery
+(
+    cypher_astnode_t *query,
+    struct cypher_input_range range
+)
+{
+    return _call_subquery(query, false, NULL, range);
+}
+
+cypher_astnode_t *cypher_ast_call_subquery_in_transactions
+(
+    cypher_astnode_t *query,
+    cypher_astnode_t *batch_size,
+    struct cypher_input_range range
+)
+{
+    return _call_subquery(query, true, batch_size, range);
+}
+
 cypher_astnode_t *cypher_ast_call_subquery_get_query
 (
     const cypher_astnode_t *astnode
@@ -83,6 +112,28 @@ cypher_astnode_t *cypher_ast_call_subquery_get_query
     return node->query;
 }
 
+bool cypher_ast_call_subquery_is_in_transactions
+(
+    const cypher_astnode_t *astnode
+)
+{
+    REQUIRE_TYPE(astnode, CYPHER_AST_CALL_SUBQUERY, false);
+    struct call_subquery *node =
+            container_of(astnode, struct call_subquery, _astnode);
+    return node->in_transactions;
+}
+
+const cypher_astnode_t *cypher_ast_call_subquery_get_batch_size
+(
+    const cypher_astnode_t *astnode
+)
+{
+    REQUIRE_TYPE(astnode, CYPHER_AST_CALL_SUBQUERY, NULL);
+    struct call_subquery *node =
+            container_of(astnode, struct call_subquery, _astnode);
+    return node->batch_size;
+}
+
 void cypher_ast_call_subquery_replace_query
 (
     cypher_astnode_t *astnode,
@@ -104,8 +155,13 @@ cypher_astnode_t *clone(const cypher_astnode_t *self,
 {
     REQUIRE_TYPE(self, CYPHER_AST_CALL_SUBQUERY, NULL);
 
-    cypher_astnode_t *clone = cypher_ast_call_subquery(
-            children[0], self->range);
+    struct call_subquery *node =
+            container_of(self, struct call_subquery, _astnode);
+    cypher_astnode_t *batch_size = (node->batch_size != NULL) ?
+            children[1] : NULL;
+
+    cypher_astnode_t *clone = _call_subquery(children[0],
+            node->in_transactions, batch_size, self->range);
     int errsv = errno;
     errno = errsv;
     return clone;
@@ -125,5 +181,19 @@ ssize_t detailstr(const cypher_astnode_t *self, char *str, size_t size)
         return -1;
     }
 
+    if (node->in_transactions)
+    {
+        ssize_t r = (node->batch_size != NULL) ?
+            snprintf(str + n, (n < size)? size-n : 0,
+                    ", IN TRANSACTIONS OF @%u ROWS",
+                    node->batch_size->ordinal) :
+            snprintf(str + n, (n < size)? size-n : 0, ", IN TRANSACTIONS");
+        if (r < 0)
+        {
+            return -1;
+        }
+        n += r;
+    }
+
     return n;
 }
@@ -333,8 +333,9 @@ static cypher_astnode_t *_unwind_clause(yycontext *yy,
 #define call_clause(p, w) _call_clause(yy, p, w)
 static cypher_astnode_t *_call_clause(yycontext *yy,
         cypher_astnode_t *proc_name, cypher_astnode_t *predicate);
-#define call_subquery() _call_subquery(yy)
-static cypher_astnode_t *_call_subquery(yycontext *yy);
+#define call_subquery(t, r) _call_subquery(yy, t, r)
+static cypher_astnode_t *_call_subquery(yycontext *yy, bool in_transactions,
+        cypher_astnode_t *batch_size);
 #define return_clause(d, a, o, s, l) _return_clause(yy, d, a, o, s, l)
 static cypher_astnode_t *_return_clause(yycontext *yy, bool distinct,
         bool include_existing, cypher_astnode_t *order_by,
@@ -2104,7 +2105,8 @@ cypher_astnode_t *_call_clause(yycontext *yy, cypher_astnode_t *proc_name,
 }
 
 
-cypher_astnode_t *_call_subquery(yycontext *yy)
+cypher_astnode_t *_call_subquery(yycontext *yy, bool in_transactions,
+        cypher_astnode_t *batch_size)
 {
     assert(yy->prev_block != NULL &&
             "An AST node can only be created immediately after a `>` in the grammar");
@@ -2112,13 +2114,25 @@ cypher_astnode_t *_call_subquery(yycontext *yy)
     cypher_astnode_t **seq = astnodes_elements(&(yy->prev_block->sequence));
     unsigned int nseq = astnodes_size(&(yy->prev_block->sequence));
 
+    // the batch size is the last child of the block, it belongs to the
+    // CALL {} node rather than to the subquery
+    unsigned int nchildren = astnodes_size(&(yy->prev_block->children));
+    if (batch_size != NULL)
+    {
+        assert(nchildren > 0 &&
+                astnodes_elements(&(yy->prev_block->children))[nchildren - 1]
+                == batch_size);
+        nchildren--;
+    }
+
     cypher_astnode_t *query = cypher_ast_query(
         NULL, 0, seq, nseq, astnodes_elements(&(yy->prev_block->children)),
-        astnodes_size(&(yy->prev_block->children)), yy->prev_block->range);
+        nchildren, yy->prev_block->range);
 
-    cypher_astnode_t *node = cypher_ast_call_subquery(
-        query,
-        cypher_astnode_range(query));
+    cypher_astnode_t *node = in_transactions ?
+        cypher_ast_call_subquery_in_transactions(query, batch_size,
+            yy->prev_block->range) :
+        cypher_ast_call_subquery(query, cypher_astnode_range(query));
     if (node == NULL)
     {
         abort_parse(yy);
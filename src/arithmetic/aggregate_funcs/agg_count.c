@@ -25,6 +25,16 @@ AggregateResult AGG_COUNT(SIValue *argv, int argc, void *private_data) {
 	return AGGREGATE_OK;
 }
 
+void AGG_COUNT_N(SIValue *argv, int argc, uint64_t n, void *private_data) {
+	AggregateCtx *ctx = private_data;
+
+	SIValue v = argv[0];
+	if(SI_TYPE(v) == T_NULL) return;
+
+	// Increment the result by n.
+	ctx->result.longval += n;
+}
+
 AggregateCtx *Count_PrivateData(void)
 {
 	AggregateCtx *ctx = rm_malloc(sizeof(AggregateCtx));
@@ -45,6 +55,7 @@ void Register_COUNT(void) {
 	ret_type = T_INT64;
 	func_desc = AR_AggFuncDescNew("count", AGG_COUNT, 1, 1, types, ret_type,
 			NULL, NULL, Count_PrivateData);
+	AR_AggFuncSetStepN(func_desc, AGG_COUNT_N);
 	AR_RegFunc(func_desc);
 }
 
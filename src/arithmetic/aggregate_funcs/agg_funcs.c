@@ -40,6 +40,18 @@ AR_FuncDesc *AR_AggFuncDescNew
 	return desc;
 }
 
+// set the bulk aggregation routine of an aggregation function
+void AR_AggFuncSetStepN
+(
+	AR_FuncDesc *func_desc,  // aggregation function descriptor
+	AR_Func_StepN step_n     // bulk aggregation routine
+) {
+	ASSERT(func_desc != NULL);
+	ASSERT(func_desc->aggregate);
+
+	func_desc->callbacks.step_n = step_n;
+}
+
 // TODO: might be deprecated?
 // routine for cloning a generic aggregate function context
 void *Aggregate_Clone(void *orig) {
@@ -59,6 +71,27 @@ void Aggregate_SetResult
 	ctx->result = result;
 }
 
+// aggregates 'argv' 'n' times
+void Aggregate_StepN
+(
+	AR_FuncDesc *func_desc,  // aggregation function descriptor
+	AggregateCtx *ctx,       // aggregation context
+	SIValue *argv,           // arguments
+	int argc,                // number of arguments
+	uint64_t n               // number of times to aggregate 'argv'
+) {
+	ASSERT(ctx != NULL);
+	ASSERT(func_desc != NULL);
+	ASSERT(func_desc->aggregate);
+
+	if(func_desc->callbacks.step_n) {
+		func_desc->callbacks.step_n(argv, argc, n, ctx);
+		return;
+	}
+
+	for(uint64_t i = 0; i < n; i++) func_desc->func(argv, argc, ctx);
+}
+
 void Aggregate_Finalize
 (
 	AR_FuncDesc *func_desc,
@@ -27,6 +27,14 @@ AR_FuncDesc *AR_AggFuncDescNew
 	AR_Func_PrivateData private_data    // generate private data
 );
 
+// set the bulk aggregation routine of an aggregation function
+// functions without one are stepped 'n' times
+void AR_AggFuncSetStepN
+(
+	AR_FuncDesc *func_desc,  // aggregation function descriptor
+	AR_Func_StepN step_n     // bulk aggregation routine
+);
+
 // register all aggregation funcitons
 void Register_AggFuncs(void);
 
@@ -43,6 +51,17 @@ void Aggregate_SetResult
 	SIValue result
 );
 
+// aggregates 'argv' 'n' times
+// equivalent to invoking the aggregation function 'n' times with 'argv'
+void Aggregate_StepN
+(
+	AR_FuncDesc *func_desc,  // aggregation function descriptor
+	AggregateCtx *ctx,       // aggregation context
+	SIValue *argv,           // arguments
+	int argc,                // number of arguments
+	uint64_t n               // number of times to aggregate 'argv'
+);
+
 void Aggregate_Finalize
 (
 	AR_FuncDesc *func_desc,
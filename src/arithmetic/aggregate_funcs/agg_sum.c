@@ -25,6 +25,16 @@ AggregateResult AGG_SUM(SIValue *argv, int argc, void *private_data) {
 	return AGGREGATE_OK;
 }
 
+void AGG_SUM_N(SIValue *argv, int argc, uint64_t n, void *private_data) {
+	AggregateCtx *ctx = private_data;
+
+	SIValue v = argv[0];
+	if(SI_TYPE(v) == T_NULL) return;
+
+	// Update the total by n times the value.
+	ctx->result.doubleval += SI_GET_NUMERIC(v) * n;
+}
+
 AggregateCtx *SUM_PrivateData(void)
 {
 	AggregateCtx *ctx = rm_malloc(sizeof(AggregateCtx));
@@ -45,6 +55,7 @@ void Register_SUM(void) {
 	ret_type = T_NULL | T_DOUBLE;
 	func_desc = AR_AggFuncDescNew("sum", AGG_SUM, 1, 1, types, ret_type, NULL,
 			NULL, SUM_PrivateData);
+	AR_AggFuncSetStepN(func_desc, AGG_SUM_N);
 	AR_RegFunc(func_desc);
 }
 
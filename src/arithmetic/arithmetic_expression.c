@@ -126,6 +126,12 @@ static AR_ExpNode *_AR_EXP_CloneOperand
 	case AR_EXP_BORROW_RECORD:
 		clone->operand.type = AR_EXP_BORROW_RECORD;
 		break;
+	case AR_EXP_CACHED:
+		clone->operand.type = AR_EXP_CACHED;
+		clone->operand.cached.alias = exp->operand.cached.alias;
+		clone->operand.cached.alias_idx = exp->operand.cached.alias_idx;
+		clone->operand.cached.exp = AR_EXP_Clone(exp->operand.cached.exp);
+		break;
 	default:
 		ASSERT(false);
 		break;
@@ -271,6 +277,26 @@ AR_ExpNode *AR_EXP_NewRecordNode() {
 	return _AR_EXP_InitializeOperand(AR_EXP_BORROW_RECORD);
 }
 
+void AR_EXP_Cache
+(
+	AR_ExpNode *exp,
+	const char *alias
+) {
+	ASSERT(exp != NULL);
+	ASSERT(alias != NULL);
+
+	// move expression into a new node
+	AR_ExpNode *inner = rm_malloc(sizeof(AR_ExpNode));
+	*inner = *exp;
+
+	// repurpose as cached operand, keep resolved name
+	exp->type                     = AR_EXP_OPERAND;
+	exp->operand.type             = AR_EXP_CACHED;
+	exp->operand.cached.alias     = alias;
+	exp->operand.cached.alias_idx = IDENTIFIER_NOT_FOUND;
+	exp->operand.cached.exp       = inner;
+}
+
 void AR_SetPrivateData
 (
 	AR_ExpNode *node, void *pdata
@@ -577,6 +603,46 @@ static AR_EXP_Result _AR_EXP_EvaluateParam
 	return EVAL_FOUND_PARAM;
 }
 
+static AR_EXP_Result _AR_EXP_EvaluateCached
+(
+	AR_ExpNode *node,
+	const Record r,
+	SIValue *result
+) {
+	if(r == NULL) {
+		return _AR_EXP_Evaluate(node->operand.cached.exp, r, result);
+	}
+
+	if(node->operand.cached.alias_idx == IDENTIFIER_NOT_FOUND) {
+		int idx = Record_GetEntryIdx(r, node->operand.cached.alias);
+
+		// record has no entry for the cached value, evaluate as is
+		if(idx == INVALID_INDEX) {
+			return _AR_EXP_Evaluate(node->operand.cached.exp, r, result);
+		}
+		node->operand.cached.alias_idx = idx;
+	}
+
+	int idx = node->operand.cached.alias_idx;
+
+	// value already computed for this record, share with the caller
+	if(Record_ContainsEntry(r, idx)) {
+		*result = SI_ShareValue(Record_Get(r, idx));
+		return EVAL_OK;
+	}
+
+	SIValue v;
+	AR_EXP_Result res = _AR_EXP_Evaluate(node->operand.cached.exp, r, &v);
+	if(res == EVAL_ERR) return res;
+
+	// store a copy of the value within the record
+	if(SI_TYPE(v) & (T_NODE | T_EDGE)) Record_Add(r, idx, v);
+	else Record_AddScalar(r, idx, SI_CloneValue(v));
+
+	*result = v;
+	return res;
+}
+
 static inline AR_EXP_Result _AR_EXP_EvaluateBorrowRecord(AR_ExpNode *node, const Record r,
 														 SIValue *result) {
 	// Wrap the current Record in an SI pointer.
@@ -611,6 +677,8 @@ static AR_EXP_Result _AR_EXP_Evaluate
 			return _AR_EXP_EvaluateParam(root, result);
 		case AR_EXP_BORROW_RECORD:
 			return _AR_EXP_EvaluateBorrowRecord(root, r, result);
+		case AR_EXP_CACHED:
+			return _AR_EXP_EvaluateCached(root, r, result);
 		default:
 			ASSERT(false && "Invalid expression type");
 		}
@@ -736,6 +804,8 @@ void AR_EXP_CollectEntities(AR_ExpNode *root, rax *aliases) {
 		if(root->operand.type == AR_EXP_VARIADIC) {
 			const char *entity = root->operand.variadic.entity_alias;
 			raxInsert(aliases, (unsigned char *)entity, strlen(entity), NULL, NULL);
+		} else if(root->operand.type == AR_EXP_CACHED) {
+			AR_EXP_CollectEntities(root->operand.cached.exp, aliases);
 		}
 	}
 }
@@ -755,6 +825,8 @@ void AR_EXP_CollectAttributes(AR_ExpNode *root, rax *attributes) {
 		for(int i = 0; i < root->op.child_count; i ++) {
 			AR_EXP_CollectAttributes(root->op.children[i], attributes);
 		}
+	} else if(root->operand.type == AR_EXP_CACHED) {
+		AR_EXP_CollectAttributes(root->operand.cached.exp, attributes);
 	}
 }
 
@@ -766,6 +838,8 @@ bool AR_EXP_ContainsAggregation(AR_ExpNode *root) {
 			AR_ExpNode *child = root->op.children[i];
 			if(AR_EXP_ContainsAggregation(child)) return true;
 		}
+	} else if(root->operand.type == AR_EXP_CACHED) {
+		return AR_EXP_ContainsAggregation(root->operand.cached.exp);
 	}
 
 	return false;
@@ -778,6 +852,8 @@ bool AR_EXP_ContainsFunc(const AR_ExpNode *root, const char *func) {
 		for(int i = 0; i < root->op.child_count; i++) {
 			if(AR_EXP_ContainsFunc(root->op.children[i], func)) return true;
 		}
+	} else if(root->operand.type == AR_EXP_CACHED) {
+		return AR_EXP_ContainsFunc(root->operand.cached.exp, func);
 	}
 	return false;
 }
@@ -790,6 +866,8 @@ bool AR_EXP_ContainsVariadic(const AR_ExpNode *root) {
 		}
 	} else if(AR_EXP_IsVariadic(root)) {
 		return true;
+	} else if(root->operand.type == AR_EXP_CACHED) {
+		return AR_EXP_ContainsVariadic(root->operand.cached.exp);
 	}
 	return false;
 }
@@ -894,6 +972,8 @@ void _AR_EXP_ToString(const AR_ExpNode *root, char **str, size_t *str_size,
 		// Concat Operand node.
 		if(root->operand.type == AR_EXP_CONSTANT) {
 			SIValue_ToString(root->operand.constant, str, str_size, bytes_written);
+		} else if(root->operand.type == AR_EXP_CACHED) {
+			_AR_EXP_ToString(root->operand.cached.exp, str, str_size, bytes_written);
 		} else {
 			*bytes_written += sprintf((*str + *bytes_written), "%s", root->operand.variadic.entity_alias);
 		}
@@ -966,6 +1046,8 @@ inline void AR_EXP_Free
 		_AR_EXP_FreeOpInternals(root);
 	} else if(AR_EXP_IsConstant(root)) {
 		SIValue_Free(root->operand.constant);
+	} else if(root->operand.type == AR_EXP_CACHED) {
+		AR_EXP_Free(root->operand.cached.exp);
 	}
 
 	rm_free(root);
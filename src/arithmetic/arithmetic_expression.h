@@ -27,7 +27,8 @@ typedef enum {
 	AR_EXP_CONSTANT,       // a constant, e.g. 3
 	AR_EXP_VARIADIC,       // a variable, e.g. n
 	AR_EXP_PARAM,          // a parameter, e.g. $p
-	AR_EXP_BORROW_RECORD   // a directive to store the current record
+	AR_EXP_BORROW_RECORD,  // a directive to store the current record
+	AR_EXP_CACHED          // a subexpression whose value is cached in the record
 } AR_OperandNodeType;
 
 // success of an evaluation
@@ -54,6 +55,11 @@ typedef struct {
 			const char *entity_alias;
 			int entity_alias_idx;
 		} variadic;
+		struct {
+			const char *alias;        // record entry holding the value
+			int alias_idx;            // record index of alias
+			struct AR_ExpNode *exp;   // cached expression
+		} cached;
 	};
 	AR_OperandNodeType type;
 } AR_OperandNode;
@@ -90,6 +96,11 @@ AR_ExpNode *AR_EXP_NewParameterOperandNode(const char *param_name);
 // creates a new Arithmetic expression that will resolve to the current Record
 AR_ExpNode *AR_EXP_NewRecordNode(void);
 
+// in-place wraps 'exp' such that its value is computed once per record
+// and stored under 'alias', subsequent evaluations against the same record
+// share the stored value
+void AR_EXP_Cache(AR_ExpNode *exp, const char *alias);
+
 // set node private data
 void AR_SetPrivateData(AR_ExpNode *node, void *pdata);
 
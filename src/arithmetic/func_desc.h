@@ -34,12 +34,16 @@ typedef void *(*AR_Func_Clone)(void *orig);
 // AR_Func_PrivateData - function pointer to a routine which produce function's private data
 typedef AggregateCtx *(*AR_Func_PrivateData)(void);
 
+// AR_Func_StepN - function pointer to a routine aggregating the same arguments 'n' times
+typedef void (*AR_Func_StepN)(SIValue *argv, int argc, uint64_t n, void *ctx);
+
 // aggregation function callbacks
 typedef struct {
 	AR_Func_Free free;                  // [optional] function pointer to cleanup routine
 	AR_Func_Clone clone;                // [optional] function pointer to clone routine
 	AR_Func_Finalize finalize;          // [optional] function pointer to finalizing aggregate value routine
 	AR_Func_PrivateData private_data;   // function pointer to private data generator
+	AR_Func_StepN step_n;               // [optional] function pointer to bulk aggregation routine
 } AR_FuncCBs;
 
 typedef struct {
@@ -9,9 +9,9 @@
 #include "../../util/arr.h"
 #include "../../errors/errors.h"
 #include "../../datatypes/map.h"
+#include "point_funcs.h"
 #include <math.h>
 
-#define EARTH_RADIUS 6378140.0
 #define DegreeToRadians(d) ((d) * M_PI / 180.0)
 
 SIValue AR_TOPOINT(SIValue *argv, int argc, void *private_data) {
@@ -8,5 +8,11 @@
 
 #include "../../value.h"
 
+// earth radius in meters
+#define EARTH_RADIUS 6378140.0
+
+// computes the distance in meters between two points
+SIValue AR_DISTANCE(SIValue *argv, int argc, void *private_data);
+
 void Register_PointFuncs();
 
@@ -138,6 +138,12 @@ static void _AST_MapMatchClauseReferences(AST *ast, const cypher_astnode_t *matc
 	// Where clause.
 	const cypher_astnode_t *predicate = cypher_ast_match_get_predicate(match_clause);
 	if(predicate) _AST_MapExpression(ast, predicate);
+
+	// Planner hints, hinted nodes must not be folded into a traversal.
+	uint hint_count = cypher_ast_match_nhints(match_clause);
+	for(uint i = 0; i < hint_count; i++) {
+		_AST_MapExpression(ast, cypher_ast_match_get_hint(match_clause, i));
+	}
 }
 
 // Add referenced aliases from CREATE clause.
@@ -324,6 +330,19 @@ static void _AST_MapUnwindClauseReferences
 	_AST_MapExpression(ast, expr);
 }
 
+// maps entities referenced by a LOAD CSV clause URI expression
+static void _AST_MapLoadCSVClauseReferences
+(
+	AST *ast,
+	const cypher_astnode_t *load_csv_clause
+) {
+	ASSERT(ast != NULL);
+	ASSERT(load_csv_clause != NULL);
+
+	const cypher_astnode_t *url = cypher_ast_load_csv_get_url(load_csv_clause);
+	_AST_MapExpression(ast, url);
+}
+
 // maps entities in a FOREACH clause
 // MATCH (n) FOREACH(v in [1,2,3,4] | CREATE (:L{x:v})-[:R]->(n))
 static void _AST_MapForeachClauseReferences
@@ -485,6 +504,9 @@ static void _ASTClause_BuildReferenceMap(AST *ast, const cypher_astnode_t *claus
 	} else if(type == CYPHER_AST_UNWIND) {
 		// add referenced aliases for UNWIND clause
 		_AST_MapUnwindClauseReferences(ast, clause);
+	} else if(type == CYPHER_AST_LOAD_CSV) {
+		// add referenced aliases for LOAD CSV clause
+		_AST_MapLoadCSVClauseReferences(ast, clause);
 	} else if(type == CYPHER_AST_FOREACH) {
 		// add referenced aliases for a FOREACH clause
 		_AST_MapForeachClauseReferences(ast, clause);
@@ -20,7 +20,9 @@ AST *AST_MockMatchClause(AST *master_ast, cypher_astnode_t *node, bool node_is_p
 	struct cypher_input_range range = {0};
 	const cypher_astnode_t *predicate = NULL;
 	uint child_count = (node_is_path) ? 1 : cypher_astnode_nchildren(node);
+	uint hint_count = (node_is_path) ? 0 : cypher_ast_match_nhints(node);
 	cypher_astnode_t *children[child_count];
+	cypher_astnode_t *hints[hint_count + 1];
 
 	if(node_is_path) {
 		/* MERGE clauses and path filters are comprised of a single path.
@@ -38,11 +40,16 @@ AST *AST_MockMatchClause(AST *master_ast, cypher_astnode_t *node, bool node_is_p
 		for(uint i = 0; i < child_count; i ++) {
 			children[i] = (cypher_astnode_t *)cypher_astnode_get_child(node, i);
 		}
+
+		// Retain planner hints.
+		for(uint i = 0; i < hint_count; i ++) {
+			hints[i] = (cypher_astnode_t *)cypher_ast_match_get_hint(node, i);
+		}
 	}
 
 	// Build a new match clause that holds this pattern.
-	cypher_astnode_t *match_clause = cypher_ast_match(false, pattern, NULL, 0, predicate,
-													  children, child_count, range);
+	cypher_astnode_t *match_clause = cypher_ast_match(false, pattern, hints, hint_count,
+													  predicate, children, child_count, range);
 
 	// Build a query node holding this clause.
 	ast->root = cypher_ast_query(NULL, 0, &match_clause, 1, &match_clause, 1, range);
@@ -431,6 +431,14 @@ void collect_aliases_in_scope
 				cypher_ast_identifier_get_name(unwind_alias);
 			raxTryInsert(identifiers, (unsigned char *)identifier,
 				strlen(identifier), (void *)unwind_alias, NULL);
+		} else if(type == CYPHER_AST_LOAD_CSV) {
+			// the LOAD CSV clause introduces one alias
+			const cypher_astnode_t *csv_alias =
+				cypher_ast_load_csv_get_identifier(clause);
+			const char *identifier =
+				cypher_ast_identifier_get_name(csv_alias);
+			raxTryInsert(identifiers, (unsigned char *)identifier,
+				strlen(identifier), (void *)csv_alias, NULL);
 		} else if(type == CYPHER_AST_CALL) {
 			_collect_call_projections(clause, identifiers);
 		} else if(type == CYPHER_AST_CALL_SUBQUERY) {
@@ -1267,6 +1267,64 @@ static bool _ValidateCallInitialWith
 	return true;
 }
 
+// returns true if the clause is an updating clause, false otherwise
+static bool _is_updating_clause
+(
+	const cypher_astnode_t *clause  // clause
+) {
+	cypher_astnode_type_t type = cypher_astnode_type(clause);
+
+	return type == CYPHER_AST_CREATE             ||
+	       type == CYPHER_AST_MERGE              ||
+	       type == CYPHER_AST_DELETE             ||
+	       type == CYPHER_AST_SET                ||
+	       type == CYPHER_AST_REMOVE             ||
+	       type == CYPHER_AST_FOREACH;
+}
+
+// validates the `IN TRANSACTIONS` modifier of a CALL {} clause
+static bool _ValidateCallInTransactions
+(
+	const cypher_astnode_t *n  // CALL {} clause
+) {
+	const cypher_astnode_t *body = cypher_ast_call_subquery_get_query(n);
+	uint nclauses = cypher_ast_query_nclauses(body);
+
+	// batches of a nested subquery can't be committed on their own
+	bool updating = false;
+	for(uint i = 0; i < nclauses; i++) {
+		const cypher_astnode_t *clause = cypher_ast_query_get_clause(body, i);
+		if(cypher_astnode_type(clause) == CYPHER_AST_CALL_SUBQUERY &&
+		   cypher_ast_call_subquery_is_in_transactions(clause)) {
+			ErrorCtx_SetError(EMSG_CALLSUBQUERY_IN_TRANSACTIONS_NESTED);
+			return false;
+		}
+		updating |= _is_updating_clause(clause);
+	}
+
+	if(!cypher_ast_call_subquery_is_in_transactions(n)) {
+		return true;
+	}
+
+	if(!updating) {
+		ErrorCtx_SetError(EMSG_CALLSUBQUERY_IN_TRANSACTIONS_READ_ONLY);
+		return false;
+	}
+
+	// batch size is evaluated once, prior to execution
+	const cypher_astnode_t *batch_size =
+		cypher_ast_call_subquery_get_batch_size(n);
+	if(batch_size != NULL) {
+		cypher_astnode_type_t t = cypher_astnode_type(batch_size);
+		if(t != CYPHER_AST_INTEGER && t != CYPHER_AST_PARAMETER) {
+			ErrorCtx_SetError(EMSG_CALLSUBQUERY_IN_TRANSACTIONS_BATCH_EXP);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // validate a CALL {} (subquery) clause
 static VISITOR_STRATEGY _Validate_call_subquery
 (
@@ -1278,6 +1336,10 @@ static VISITOR_STRATEGY _Validate_call_subquery
 
 	vctx->clause = cypher_astnode_type(n);
 
+	if(!_ValidateCallInTransactions(n)) {
+		return VISITOR_BREAK;
+	}
+
 	// create a query astnode with the body of the subquery as its body
 	cypher_astnode_t *body = cypher_ast_call_subquery_get_query(n);
 	uint nclauses = cypher_ast_query_nclauses(body);
@@ -1393,21 +1455,6 @@ static VISITOR_STRATEGY _Validate_call_subquery
 	return VISITOR_CONTINUE;
 }
 
-// returns true if the clause is an updating clause, false otherwise
-static bool _is_updating_clause
-(
-	const cypher_astnode_t *clause  // clause
-) {
-	cypher_astnode_type_t type = cypher_astnode_type(clause);
-
-	return type == CYPHER_AST_CREATE             ||
-	       type == CYPHER_AST_MERGE              ||
-	       type == CYPHER_AST_DELETE             ||
-	       type == CYPHER_AST_SET                ||
-	       type == CYPHER_AST_REMOVE             ||
-	       type == CYPHER_AST_FOREACH;
-}
-
 // validate a WITH clause
 static VISITOR_STRATEGY _Validate_WITH_Clause
 (
@@ -1762,6 +1809,60 @@ static VISITOR_STRATEGY _Validate_UNWIND_Clause
 	return VISITOR_CONTINUE;
 }
 
+// validate a LOAD CSV clause
+// LOAD CSV WITH HEADERS FROM 'file:///data.csv' AS row RETURN row
+static VISITOR_STRATEGY _Validate_LOAD_CSV_Clause
+(
+	const cypher_astnode_t *n,  // ast-node
+	bool start,                 // first traversal
+	ast_visitor *visitor        // visitor
+) {
+	validations_ctx *vctx = AST_Visitor_GetContext(visitor);
+
+	if(!start) {
+		return VISITOR_CONTINUE;
+	}
+
+	// set current clause
+	vctx->clause = cypher_astnode_type(n);
+
+	//--------------------------------------------------------------------------
+	// validate URI expression
+	//--------------------------------------------------------------------------
+
+	const cypher_astnode_t *url = cypher_ast_load_csv_get_url(n);
+
+	AST_Visitor_visit(url, visitor);
+	if(ErrorCtx_EncounteredError()) {
+		return VISITOR_BREAK;
+	}
+
+	//--------------------------------------------------------------------------
+	// validate field terminator
+	//--------------------------------------------------------------------------
+
+	const cypher_astnode_t *terminator =
+		cypher_ast_load_csv_get_field_terminator(n);
+	if(terminator != NULL &&
+	   strlen(cypher_ast_string_get_value(terminator)) != 1) {
+		ErrorCtx_SetError(EMSG_LOAD_CSV_FIELD_TERMINATOR);
+		return VISITOR_BREAK;
+	}
+
+	// introduce LOAD CSV alias to scope
+	// fail if alias is already defined
+	// e.g. MATCH (n) LOAD CSV FROM 'file:///data.csv' AS n RETURN n
+	const cypher_astnode_t *alias = cypher_ast_load_csv_get_identifier(n);
+	const char *identifier = cypher_ast_identifier_get_name(alias);
+
+	if(_IdentifierAdd(vctx, identifier, NULL) == 0) {
+		ErrorCtx_SetError(EMSG_VAIABLE_ALREADY_DECLARED, identifier);
+		return VISITOR_BREAK;
+	}
+
+	return VISITOR_CONTINUE;
+}
+
 // validate a FOREACH clause
 // MATCH (n) FOREACH(x in [1,2,3] | CREATE (n)-[:R]->({v:x}))
 static VISITOR_STRATEGY _Validate_FOREACH_Clause
@@ -1905,6 +2006,91 @@ static VISITOR_STRATEGY _Validate_RETURN_Clause
 }
 
 // validate a MATCH clause
+// returns true if 'root' contains a node pattern aliased 'alias'
+// which is labeled 'label'
+static bool _PatternNodeHasLabel
+(
+	const cypher_astnode_t *root,  // ast-node to search
+	const char *alias,             // node alias
+	const char *label              // label
+) {
+	if(cypher_astnode_type(root) == CYPHER_AST_NODE_PATTERN) {
+		const cypher_astnode_t *id =
+			cypher_ast_node_pattern_get_identifier(root);
+		if(id == NULL || strcmp(cypher_ast_identifier_get_name(id), alias)) {
+			return false;
+		}
+
+		uint nlabels = cypher_ast_node_pattern_nlabels(root);
+		for(uint i = 0; i < nlabels; i++) {
+			const cypher_astnode_t *l = cypher_ast_node_pattern_get_label(root, i);
+			if(strcmp(cypher_ast_label_get_name(l), label) == 0) return true;
+		}
+		return false;
+	}
+
+	uint nchildren = cypher_astnode_nchildren(root);
+	for(uint i = 0; i < nchildren; i++) {
+		if(_PatternNodeHasLabel(cypher_astnode_get_child(root, i), alias,
+					label)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// validate a MATCH clause planner hint
+// hinted variables must be introduced by the clause itself
+// USING INDEX and USING SCAN hints must refer to a label the node
+// is associated with within the clause pattern
+static AST_Validation _ValidateMatchHint
+(
+	validations_ctx *vctx,          // validations context
+	const cypher_astnode_t *match,  // MATCH clause
+	const cypher_astnode_t *hint    // hint
+) {
+	const cypher_astnode_t *label = NULL;
+	const cypher_astnode_t *id    = NULL;
+	uint nidentifiers = 1;
+
+	cypher_astnode_type_t t = cypher_astnode_type(hint);
+	if(t == CYPHER_AST_USING_INDEX) {
+		id    = cypher_ast_using_index_get_identifier(hint);
+		label = cypher_ast_using_index_get_label(hint);
+	} else if(t == CYPHER_AST_USING_SCAN) {
+		id    = cypher_ast_using_scan_get_identifier(hint);
+		label = cypher_ast_using_scan_get_label(hint);
+	} else {
+		ASSERT(t == CYPHER_AST_USING_JOIN);
+		nidentifiers = cypher_ast_using_join_nidentifiers(hint);
+	}
+
+	for(uint i = 0; i < nidentifiers; i++) {
+		if(t == CYPHER_AST_USING_JOIN) {
+			id = cypher_ast_using_join_get_identifier(hint, i);
+		}
+		const char *alias = cypher_ast_identifier_get_name(id);
+
+		// hints apply to the way the clause resolves its own variables
+		if(_IdentifiersFind(vctx, alias) != raxNotFound) {
+			ErrorCtx_SetError(EMSG_HINT_BOUND_VARIABLE, alias);
+			return AST_INVALID;
+		}
+
+		if(label == NULL) continue;
+
+		const char *l = cypher_ast_label_get_name(label);
+		if(!_PatternNodeHasLabel(cypher_ast_match_get_pattern(match), alias,
+					l)) {
+			ErrorCtx_SetError(EMSG_HINT_LABEL, alias, l);
+			return AST_INVALID;
+		}
+	}
+
+	return AST_VALID;
+}
+
 static VISITOR_STRATEGY _Validate_MATCH_Clause
 (
 	const cypher_astnode_t *n,  // ast-node
@@ -1918,6 +2104,16 @@ static VISITOR_STRATEGY _Validate_MATCH_Clause
 	}
 
 	vctx->clause = cypher_astnode_type(n);
+
+	// validate hints before the clause's pattern introduces its variables
+	uint nhints = cypher_ast_match_nhints(n);
+	for(uint i = 0; i < nhints; i++) {
+		if(_ValidateMatchHint(vctx, n, cypher_ast_match_get_hint(n, i)) ==
+				AST_INVALID) {
+			return VISITOR_BREAK;
+		}
+	}
+
 	return VISITOR_RECURSE;
 }
 
@@ -2077,7 +2273,7 @@ static AST_Validation _ValidateQuerySequence
 	return AST_VALID;
 }
 
-/* In any given query scope, reading clauses (MATCH, UNWIND, and InQueryCall)
+/* In any given query scope, reading clauses (MATCH, UNWIND, LOAD CSV and InQueryCall)
  * cannot follow updating clauses (CREATE, MERGE, DELETE, SET, REMOVE, FOREACH).
  * https://s3.amazonaws.com/artifacts.opencypher.org/railroad/SinglePartQuery.html
  * Additionally, a MATCH clause cannot follow an OPTIONAL MATCH clause. */
@@ -2094,6 +2290,7 @@ static AST_Validation _ValidateClauseOrder
 		cypher_astnode_type_t type = cypher_astnode_type(clause);
 		if(encountered_updating_clause && (type == CYPHER_AST_MATCH          ||
 										   type == CYPHER_AST_UNWIND         ||
+										   type == CYPHER_AST_LOAD_CSV       ||
 										   type == CYPHER_AST_CALL           ||
 										   type == CYPHER_AST_CALL_SUBQUERY)) {
 			ErrorCtx_SetError(EMSG_MISSING_WITH, cypher_astnode_typestr(type));
@@ -2212,6 +2409,7 @@ bool AST_ValidationsMappingInit(void) {
 	validations_mapping[CYPHER_AST_SINGLE]                     = _Validate_list_comprehension;
 	validations_mapping[CYPHER_AST_RETURN]                     = _Validate_RETURN_Clause;
 	validations_mapping[CYPHER_AST_UNWIND]                     = _Validate_UNWIND_Clause;
+	validations_mapping[CYPHER_AST_LOAD_CSV]                   = _Validate_LOAD_CSV_Clause;
 	validations_mapping[CYPHER_AST_CREATE]                     = _Validate_CREATE_Clause;
 	validations_mapping[CYPHER_AST_DELETE]                     = _Validate_DELETE_Clause;
 	validations_mapping[CYPHER_AST_REDUCE]                     = _Validate_reduce;
@@ -2239,14 +2437,10 @@ bool AST_ValidationsMappingInit(void) {
 	validations_mapping[CYPHER_AST_FILTER]                      = _visit_break;
 	validations_mapping[CYPHER_AST_EXTRACT]                     = _visit_break;
 	validations_mapping[CYPHER_AST_COMMAND]                     = _visit_break;
-	validations_mapping[CYPHER_AST_LOAD_CSV]                    = _visit_break;
 	validations_mapping[CYPHER_AST_MATCH_HINT]                  = _visit_break;
-	validations_mapping[CYPHER_AST_USING_JOIN]                  = _visit_break;
-	validations_mapping[CYPHER_AST_USING_SCAN]                  = _visit_break;
 	validations_mapping[CYPHER_AST_INDEX_NAME]                  = _visit_break;
 	validations_mapping[CYPHER_AST_REL_ID_LOOKUP]               = _visit_break;
 	validations_mapping[CYPHER_AST_ALL_RELS_SCAN]               = _visit_break;
-	validations_mapping[CYPHER_AST_USING_INDEX]                 = _visit_break;
 	validations_mapping[CYPHER_AST_START_POINT]                 = _visit_break;
 	validations_mapping[CYPHER_AST_REMOVE_ITEM]                 = _visit_break;
 	validations_mapping[CYPHER_AST_QUERY_OPTION]                = _visit_break;
@@ -238,6 +238,8 @@ static int _BulkInsert_ProcessNodeFile
 				continue;
 			GraphEntity_AddProperty(ge, prop_indices[i], value);
 		}
+
+		GraphContext_TrackExpiry(gc, ge, GETYPE_NODE);
 	}
 
     Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
@@ -303,6 +305,8 @@ static int _BulkInsert_ProcessEdgeFile
 
 			GraphEntity_AddProperty(ge, prop_indices[i], value);
 		}
+
+		GraphContext_TrackExpiry(gc, ge, GETYPE_EDGE);
 	}
 
     array_free(type_ids);
@@ -376,6 +380,7 @@ int BulkInsert
 	// allocate space for new nodes and edges
 	// set graph sync policy to resize only
 	Graph_AcquireWriteLock(g);
+	Graph_TouchAll(g);  // labels and relations aren't tracked individually
 	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
 	Graph_AllocateNodes(g, node_count);
 	Graph_AllocateEdges(g, edge_count);
@@ -8,6 +8,36 @@
 #include "RG.h"
 #include "configuration/config.h"
 
+// reply with a (name, value) pair
+// returns false if the configuration field could not be retrieved
+static bool _Config_reply_field
+(
+	RedisModuleCtx *ctx,
+	Config_Option_Field field,
+	const char *config_name
+) {
+	// string configurations
+	if(field == Config_IMPORT_FOLDER ||
+	   field == Config_ATTRIBUTE_SPILL_FOLDER ||
+	   field == Config_ENTITY_EXPIRY_ATTRIBUTE) {
+		const char *value = NULL;
+		if(!Config_Option_get(field, &value)) return false;
+
+		RedisModule_ReplyWithArray(ctx, 2);
+		RedisModule_ReplyWithCString(ctx, config_name);
+		RedisModule_ReplyWithCString(ctx, value);
+		return true;
+	}
+
+	long long value = 0;
+	if(!Config_Option_get(field, &value)) return false;
+
+	RedisModule_ReplyWithArray(ctx, 2);
+	RedisModule_ReplyWithCString(ctx, config_name);
+	RedisModule_ReplyWithLongLong(ctx, value);
+	return true;
+}
+
 void _Config_get_all
 (
 	RedisModuleCtx *ctx
@@ -16,17 +46,12 @@ void _Config_get_all
 	RedisModule_ReplyWithArray(ctx, config_count);
 
 	for(Config_Option_Field field = 0; field < Config_END_MARKER; field++) {
-		long long value = 0;
 		const char *config_name = Config_Field_name(field);
-		bool res = Config_Option_get(field, &value);
 
-		if(!res || config_name == NULL) {
+		if(config_name == NULL ||
+		   !_Config_reply_field(ctx, field, config_name)) {
 			RedisModule_ReplyWithError(ctx, "Configuration field was not found");
 			return;
-		} else {
-			RedisModule_ReplyWithArray(ctx, 2);
-			RedisModule_ReplyWithCString(ctx, config_name);
-			RedisModule_ReplyWithLongLong(ctx, value);
 		}
 	}
 }
@@ -53,13 +78,7 @@ void _Config_get
 		return;
 	}
 
-	long long value = 0;
-
-	if(Config_Option_get(config_field, &value)) {
-		RedisModule_ReplyWithArray(ctx, 2);
-		RedisModule_ReplyWithCString(ctx, config_name);
-		RedisModule_ReplyWithLongLong(ctx, value);
-	} else {
+	if(!_Config_reply_field(ctx, config_field, config_name)) {
 		RedisModule_ReplyWithError(ctx, "Configuration field was not found");
 	}
 }
@@ -25,6 +25,7 @@ CommandCtx *CommandCtx_New
 	ExecutorThread thread,         // which thread executes this command
 	bool replicated_command,       // whether this instance was spawned by a replication command
 	bool compact,                  // whether this query was issued with the compact flag
+	bool arrow,                    // whether this query was issued with the arrow flag
 	long long timeout,             // the query timeout, if specified
 	bool timeout_rw,               // apply timeout on both read and write queries
 	uint64_t received_ts,          // command received at this  UNIX timestamp
@@ -38,6 +39,7 @@ CommandCtx *CommandCtx_New
 	context->bolt_client        = bolt_client;
 	context->query              = NULL;
 	context->thread             = thread;
+	context->arrow              = arrow;
 	context->compact            = compact;
 	context->timeout            = timeout;
 	context->ref_count          = ATOMIC_VAR_INIT(1);
@@ -31,6 +31,7 @@ typedef struct {
 	RedisModuleBlockedClient *bc;  // blocked client
 	bool replicated_command;       // whether this instance was spawned by a replication command
 	bool compact;                  // whether this query was issued with the compact flag
+	bool arrow;                    // whether this query was issued with the arrow flag
 	ExecutorThread thread;         // which thread executes this command
 	long long timeout;             // the query timeout, if specified
 	bool timeout_rw;               // apply timeout on both read and write queries
@@ -50,6 +51,7 @@ CommandCtx *CommandCtx_New
 	ExecutorThread thread,         // which thread executes this command
 	bool replicated_command,       // whether this instance was spawned by a replication command
 	bool compact,                  // whether this query was issued with the compact flag
+	bool arrow,                    // whether this query was issued with the arrow flag
 	long long timeout,             // the query timeout, if specified
 	bool timeout_rw,               // apply timeout on both read and write queries
 	uint64_t received_ts,          // command received at this  UNIX timestamp
@@ -7,6 +7,7 @@
 #include "RG.h"
 #include "../redismodule.h"
 #include "../module_event_handlers.h"
+#include "../graph/entities/attribute_spill.h"
 
 #include <string.h>
 
@@ -29,6 +30,21 @@ static void Debug_AUX(RedisModuleString **argv, int argc) {
 
 int Graph_Debug(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	ASSERT(ctx != NULL);
+
+	// number of attribute-sets spilled to disk
+	if(argc > 1 &&
+	   strcmp(RedisModule_StringPtrLen(argv[1], NULL), "SPILLED") == 0) {
+		RedisModule_ReplyWithLongLong(ctx, AttributeSpill_SpilledCount());
+		return REDISMODULE_OK;
+	}
+
+	// size of the attribute spill file
+	if(argc > 1 &&
+	   strcmp(RedisModule_StringPtrLen(argv[1], NULL), "SPILL_SIZE") == 0) {
+		RedisModule_ReplyWithLongLong(ctx, AttributeSpill_FileSize());
+		return REDISMODULE_OK;
+	}
+
 	RedisModule_ReplicateVerbatim(ctx);
 
 	if(strcmp(RedisModule_StringPtrLen(argv[1], NULL), "AUX") == 0) {
@@ -24,18 +24,21 @@ static int _read_flags
 	RedisModuleString **argv,   // commands arguments
   	int argc,                   // number of arguments
   	bool *compact,              // compact result-set format
+  	bool *arrow,                // arrow result-set format
 	long long *timeout,         // query level timeout
   	bool *timeout_rw,           // apply timeout on both read and write queries
   	uint *graph_version,        // graph version [UNUSED]
   	char **errmsg,              // reported error message
 	bolt_client_t **bolt_client // BOLT client
 ) {
+	ASSERT(arrow   != NULL);
 	ASSERT(compact != NULL);
 	ASSERT(timeout != NULL);
 
 	long long max_timeout;
 
 	// set defaults
+	*arrow         = false;
 	*compact       = false;  // verbose
 	*bolt_client   = NULL;
 	*graph_version = GRAPH_VERSION_MISSING;
@@ -64,6 +67,9 @@ static int _read_flags
 		if(!strcasecmp(arg, "--compact")) {
 			// compact result-set
 			*compact = true;
+		} else if(!strcasecmp(arg, "--arrow")) {
+			// arrow IPC stream result-set
+			*arrow = true;
 		} else if(!strcasecmp(arg, "--bolt")) {
 			*bolt_client = (bolt_client_t *)argv[++i];
 		} else if(!strcasecmp(arg, "timeout")) {
@@ -184,6 +190,7 @@ int CommandDispatch
 	char *errmsg;
 	uint version;
 	bolt_client_t *bolt_client;
+	bool arrow;
 	bool compact;
 	bool timeout_rw;
 	long long timeout;
@@ -201,8 +208,8 @@ int CommandDispatch
 	if(_validate_command_arity(cmd, argc) == false) return RedisModule_WrongArity(ctx);
 
 	// parse additional arguments
-	int res = _read_flags(argv, argc, &compact, &timeout, &timeout_rw, &version,
-			&errmsg, &bolt_client);
+	int res = _read_flags(argv, argc, &compact, &arrow, &timeout, &timeout_rw,
+			&version, &errmsg, &bolt_client);
 	if(res == REDISMODULE_ERR) {
 		// emit error and exit if argument parsing failed
 		RedisModule_ReplyWithError(ctx, errmsg);
@@ -247,7 +254,7 @@ int CommandDispatch
 	if(exec_thread == EXEC_THREAD_MAIN) {
 		// run query on Redis main thread
 		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, arrow, timeout, timeout_rw,
 								 received_ts, timer, bolt_client);
 		handler(context);
 	} else {
@@ -255,7 +262,7 @@ int CommandDispatch
 		RedisModuleBlockedClient *bc = bolt_client != NULL ? NULL : RedisGraph_BlockClient(ctx);
 		RedisModuleCtx*redis_ctx = bolt_client != NULL ? bolt_client->ctx : NULL;
 		context = CommandCtx_New(redis_ctx, bc, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, arrow, timeout, timeout_rw,
 								 received_ts, timer, bolt_client);
 
 		if(ThreadPools_AddWorkReader(handler, context, false) ==
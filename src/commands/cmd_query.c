@@ -21,6 +21,7 @@
 #include "../util/thpool/pools.h"
 #include "../configuration/config.h"
 #include "../execution_plan/execution_plan.h"
+#include "../execution_plan/execution_plan_build/execution_plan_util.h"
 
 // GraphQueryCtx stores the allocations required to execute a query.
 typedef struct {
@@ -30,6 +31,7 @@ typedef struct {
 	ExecutionCtx *exec_ctx;   // execution context
 	CommandCtx *command_ctx;  // command context
 	CronTaskHandle timeout;   // timeout cron task
+	ExecutionCtx *standby;    // optimistic write, copy re-executed on conflict
 } GraphQueryCtx;
 
 static GraphQueryCtx *GraphQueryCtx_New
@@ -50,10 +52,24 @@ static GraphQueryCtx *GraphQueryCtx_New
 	ctx->query_ctx->flags = flags;
 	ctx->command_ctx      =  command_ctx;
 	ctx->timeout          =  timeout;
+	ctx->standby          =  NULL;
 
 	return ctx;
 }
 
+// max number of write queries sharing a single lock acquisition
+#define GROUP_COMMIT_MAX_QUERIES 64
+
+// a group isn't extended once its locks were held for this many milliseconds
+// such that readers and other clients aren't starved by a long group
+#define GROUP_COMMIT_MAX_HOLD_MS 1
+
+// clients of a commit group, unblocked once the group releases its locks
+static __thread CommandCtx **_group_commit_clients = NULL;
+
+static void _ExecuteQuery(void *args);
+static void _DelegateWriter(GraphQueryCtx *gq_ctx);
+
 static void inline GraphQueryCtx_Free
 (
 	GraphQueryCtx *ctx
@@ -124,6 +140,46 @@ static bool abort_and_check_timeout
 	return has_timed_out;
 }
 
+//------------------------------------------------------------------------------
+// Group commit
+//------------------------------------------------------------------------------
+
+// returns true if the next queued write task is a query against 'gc'
+// which can join the current commit group
+static bool _GroupCommitContinues
+(
+	const GraphQueryCtx *gq_ctx  // query concluding
+) {
+	// commit groups are formed by the writer thread only
+	if(gq_ctx->command_ctx->thread != EXEC_THREAD_WRITER) return false;
+
+	if(_group_commit_clients != NULL &&
+	   array_len(_group_commit_clients) + 1 >= GROUP_COMMIT_MAX_QUERIES) {
+		return false;
+	}
+
+	if(QueryCtx_CommitLockHeldTime() >= GROUP_COMMIT_MAX_HOLD_MS) return false;
+
+	GraphQueryCtx *next = ThreadPools_PeekWriterTask(_ExecuteQuery);
+	return (next != NULL                           &&
+			next->graph_ctx == gq_ctx->graph_ctx    &&
+			next->exec_ctx->exec_type == EXECUTION_TYPE_QUERY);
+}
+
+// unblocks the clients of the commit group
+// must be called once the group released its locks
+static void _GroupCommitUnblockClients(void) {
+	if(_group_commit_clients == NULL) return;
+
+	uint n = array_len(_group_commit_clients);
+	for(uint i = 0; i < n; i++) {
+		CommandCtx *command_ctx = _group_commit_clients[i];
+		CommandCtx_UnblockClient(command_ctx);
+		CommandCtx_Free(command_ctx);
+	}
+	array_clear(_group_commit_clients);
+}
+
 //------------------------------------------------------------------------------
 // Query timeout
 //------------------------------------------------------------------------------
@@ -141,6 +197,143 @@ CronTaskHandle Query_SetTimeOut(uint timeout, ExecutionPlan *plan) {
 	return Cron_AddTask(timeout, QueryTimedOut, NULL, plan);
 }
 
+//------------------------------------------------------------------------------
+// Optimistic write
+//------------------------------------------------------------------------------
+
+// returns true if the write query can execute its read phase on a reader
+// thread, the query may only update and delete entities, modifications
+// which are computed while reading and applied once the write lock is held
+static bool _OptimisticWrite
+(
+	const ExecutionCtx *exec_ctx  // execution context
+) {
+	if(exec_ctx->exec_type != EXECUTION_TYPE_QUERY) return false;
+
+	// operations modifying the graph while reading e.g. reserving node IDs
+	// or performing arbitrary writes
+	const OPType types[] = {OPType_CREATE, OPType_MERGE, OPType_MERGE_CREATE,
+		OPType_FOREACH, OPType_PROC_CALL, OPType_CALLSUBQUERY};
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingTypes(exec_ctx->plan->root,
+			types, sizeof(types) / sizeof(types[0]));
+	bool optimistic = array_len(ops) == 0;
+	array_free(ops);
+
+	return optimistic;
+}
+
+// appends 'id' to 'ids' unless already present
+static void _AddReadID
+(
+	int **ids,  // label or relation IDs
+	int id      // ID to add
+) {
+	uint n = array_len(*ids);
+	for(uint i = 0; i < n; i++) {
+		if((*ids)[i] == id) return;
+	}
+	array_append(*ids, id);
+}
+
+// collects the labels and relations of the entities 'op' and its children
+// read, every entity a plan reads is matched by its segment's query graph
+// returns false if a read entity may be of any label or relation e.g.
+// an unlabeled node or nodes along a variable length traversal
+static bool _CollectReadSet
+(
+	const OpBase *op,       // operation
+	LabelID **labels,       // [output] labels read
+	RelationID **relations  // [output] relations read
+) {
+	const QueryGraph *qg = op->plan->query_graph;
+	if(qg != NULL) {
+		uint n = QueryGraph_NodeCount(qg);
+		for(uint i = 0; i < n; i++) {
+			const QGNode *node = qg->nodes[i];
+			uint label_count = QGNode_LabelCount(node);
+			if(label_count == 0) return false;
+
+			for(uint j = 0; j < label_count; j++) {
+				// label didn't exist when the plan was built
+				int l = QGNode_GetLabelID(node, j);
+				if(l < 0) return false;
+				_AddReadID(labels, l);
+			}
+		}
+
+		n = QueryGraph_EdgeCount(qg);
+		for(uint i = 0; i < n; i++) {
+			const QGEdge *e = qg->edges[i];
+			int rel_count = QGEdge_RelationCount(e);
+			if(!QGEdge_SingleHop(e) || rel_count == 0) return false;
+
+			for(int j = 0; j < rel_count; j++) {
+				// relation didn't exist when the plan was built
+				int r = QGEdge_RelationID(e, j);
+				if(r < 0) return false;
+				_AddReadID(relations, r);
+			}
+		}
+	}
+
+	for(uint i = 0; i < op->childCount; i++) {
+		if(!_CollectReadSet(op->children[i], labels, relations)) return false;
+	}
+
+	return true;
+}
+
+// starts the read phase of an optimistic write
+// a write committed meanwhile only conflicts with the query if it modified
+// the labels or relations the plan reads
+static void _OptimisticWriteBegin
+(
+	const ExecutionPlan *plan  // execution plan
+) {
+	LabelID    *labels    = array_new(LabelID, 0);
+	RelationID *relations = array_new(RelationID, 0);
+
+	// any write conflicts
+	if(!_CollectReadSet(plan->root, &labels, &relations)) {
+		array_free(labels);
+		array_free(relations);
+		labels    = NULL;
+		relations = NULL;
+	}
+
+	QueryCtx_BeginOptimisticWrite(labels, relations);
+}
+
+// discards an optimistic write which conflicted with another write
+// and re-executes the query on the writer thread
+static void _OptimisticWriteRestart
+(
+	GraphQueryCtx *gq_ctx,  // query context
+	ResultSet *result_set   // discarded result set
+) {
+	ASSERT(gq_ctx->standby != NULL);
+
+	QueryCtx_AbortOptimisticWrite();
+
+	ResultSet_Free(result_set);
+	QueryCtx_SetResultSet(NULL);
+	gq_ctx->query_ctx->status = QueryExecutionStatus_SUCCESS;
+
+	// swap in the unused execution context
+	ExecutionCtx_Free(gq_ctx->exec_ctx);
+	gq_ctx->exec_ctx = gq_ctx->standby;
+	gq_ctx->standby  = NULL;
+	QueryCtx_SetAST(gq_ctx->exec_ctx->ast);
+
+	// previous timeout task was aborted, re-arm it for the new plan
+	if(gq_ctx->timeout != 0) {
+		gq_ctx->timeout = Query_SetTimeOut(gq_ctx->command_ctx->timeout,
+				gq_ctx->exec_ctx->plan);
+	}
+
+	_DelegateWriter(gq_ctx);
+}
+
 inline static bool _readonly_cmd_mode(CommandCtx *ctx) {
 	return strcasecmp(CommandCtx_GetCommandName(ctx), "graph.RO_QUERY") == 0;
 }
@@ -162,6 +355,7 @@ static void _ExecuteQuery(void *args) {
 	ExecutionType  exec_type    = exec_ctx->exec_type;
 	const bool     profile      = (query_ctx->flags & QueryExecutionTypeFlag_PROFILE);
 	const bool     readonly     = !(query_ctx->flags & QueryExecutionTypeFlag_WRITE);
+	const bool     optimistic   = gq_ctx->standby != NULL;
 
 	// if we have migrated to a writer thread,
 	// update thread-local storage and track the CommandCtx
@@ -174,6 +368,7 @@ static void _ExecuteQuery(void *args) {
 
 	// instantiate the query ResultSet
 	bool bolt    = command_ctx->bolt_client != NULL;
+	bool arrow   = command_ctx->arrow;
 	bool compact = command_ctx->compact;
 	// replicated command don't need to return result
 	ResultSetFormatterType resultset_format =
@@ -181,9 +376,11 @@ static void _ExecuteQuery(void *args) {
 		? FORMATTER_NOP
 		: (bolt)
 			? FORMATTER_BOLT
-			: (compact)
-				? FORMATTER_COMPACT
-				: FORMATTER_VERBOSE;
+			: (arrow)
+				? FORMATTER_ARROW
+				: (compact)
+					? FORMATTER_COMPACT
+					: FORMATTER_VERBOSE;
 	ResultSet *result_set = NewResultSet(rm_ctx, command_ctx->bolt_client, resultset_format);
 	if(exec_ctx->cached) {
 		ResultSet_CachedExecution(result_set); // indicate a cached execution
@@ -195,14 +392,24 @@ static void _ExecuteQuery(void *args) {
 	if(readonly) {
 		Graph_AcquireReadLock(gc->g);
 	} else {
+		// the writer thread reads the graph without locking it
+		// keep optimistic writes from committing meanwhile
+		if(command_ctx->thread == EXEC_THREAD_WRITER) QueryCtx_LockWriters();
+
 		// if this is a writer query `we need to re-open the graph key with write flag
 		// this notifies Redis that the key is "dirty" any watcher on that key will
 		// be notified
-		CommandCtx_ThreadSafeContextLock(command_ctx);
+		// the GIL might already be held on behalf of a commit group
+		bool group_locked = QueryCtx_CommitGroupLocked();
+		if(!group_locked) CommandCtx_ThreadSafeContextLock(command_ctx);
 		{
 			GraphContext_MarkWriter(rm_ctx, gc);
 		}
-		CommandCtx_ThreadSafeContextUnlock(command_ctx);
+		if(!group_locked) CommandCtx_ThreadSafeContextUnlock(command_ctx);
+
+		// optimistic write, read under the read lock
+		// acquired after releasing the GIL, see QueryCtx_LockForCommit
+		if(optimistic) _OptimisticWriteBegin(plan);
 	}
 
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
@@ -239,6 +446,12 @@ static void _ExecuteQuery(void *args) {
 		ASSERT("Unhandled query type" && false);
 	}
 
+	// the optimistic write read stale data, re-run it on the writer thread
+	if(optimistic && QueryCtx_WriteConflict()) {
+		_OptimisticWriteRestart(gq_ctx, result_set);
+		return;
+	}
+
 	// in case of an error, rollback any modifications
 	if(ErrorCtx_EncounteredError()) {
 		QueryCtx_Rollback();
@@ -250,9 +463,14 @@ static void _ExecuteQuery(void *args) {
 	} else {
 		// replicate if graph was modified
 		if(ResultSetStat_IndicateModification(&result_set->stats)) {
+			// a query which committed in batches must replicate its
+			// remaining changes via effects, earlier batches were already
+			// replicated
+			bool batched = QueryCtx_CommittedBatch();
+
 			// determine rather or not to replicate via effects
 			if(EffectsBuffer_Length(QueryCtx_GetEffectsBuffer()) > 0 &&
-			   _should_replicate_effects()) {
+			   (batched || _should_replicate_effects())) {
 				// compute effects buffer
 				size_t effects_len = 0;
 				u_char *effects = EffectsBuffer_Buffer(
@@ -263,14 +481,25 @@ static void _ExecuteQuery(void *args) {
 				RedisModule_Replicate(rm_ctx, "GRAPH.EFFECT", "cb!",
 						GraphContext_GetName(gc), effects, effects_len);
 				rm_free(effects);
-			} else {
+			} else if(!batched) {
 				// replicate original query
 				QueryCtx_Replicate(query_ctx);
 			}
 		}	
 	}
 
-	QueryCtx_UnlockCommit();
+	// group commit: when another write against this graph is queued, keep the
+	// locks for it, the group's replication is propagated as a single batch
+	// once the last query in the group releases the GIL
+	// each query keeps its own undo-log, errors are isolated per query
+	bool group_commit = !readonly && _GroupCommitContinues(gq_ctx) &&
+		QueryCtx_DeferUnlock();
+	if(!group_commit) {
+		QueryCtx_UnlockCommit();
+		QueryCtx_UnlockCommitGroup();
+		QueryCtx_UnlockWriters();
+	}
+	if(optimistic) QueryCtx_EndOptimisticWrite();
 
 	if(!profile || ErrorCtx_EncounteredError()) {
 		// if we encountered an error, ResultSet_Reply will emit the error
@@ -294,8 +523,18 @@ static void _ExecuteQuery(void *args) {
 	ExecutionCtx_Free(exec_ctx);
 	GraphContext_DecreaseRefCount(gc);
 	Globals_UntrackCommandCtx(command_ctx);
-	CommandCtx_UnblockClient(command_ctx);
-	CommandCtx_Free(command_ctx);
+	if(group_commit) {
+		// reply is delivered once the group's changes are committed
+		if(_group_commit_clients == NULL) {
+			_group_commit_clients = array_new(CommandCtx *,
+					GROUP_COMMIT_MAX_QUERIES);
+		}
+		array_append(_group_commit_clients, command_ctx);
+	} else {
+		_GroupCommitUnblockClients();
+		CommandCtx_UnblockClient(command_ctx);
+		CommandCtx_Free(command_ctx);
+	}
 	QueryCtx_Free(); // reset the QueryCtx and free its allocations
 	ErrorCtx_Clear();
 	ResultSet_Free(result_set);
@@ -394,7 +633,17 @@ void _query
 	// if 'thread' is redis main thread, continue running
 	// if readonly is true we're executing on a worker thread from
 	// the read-only threadpool
-	if(readonly || command_ctx->thread == EXEC_THREAD_MAIN) {
+	// write queries which only update or delete entities execute their
+	// read phase on this reader thread, a copy of the execution context
+	// is kept in case the query has to be re-executed by the writer thread
+	bool optimistic = !readonly && !profile &&
+		command_ctx->thread == EXEC_THREAD_READER && _OptimisticWrite(exec_ctx);
+	if(optimistic) {
+		gq_ctx->standby = ExecutionCtx_Clone(exec_ctx);
+		QueryCtx_SetAST(exec_ctx->ast);
+	}
+
+	if(readonly || optimistic || command_ctx->thread == EXEC_THREAD_MAIN) {
 		_ExecuteQuery(gq_ctx);
 	} else {
 		_DelegateWriter(gq_ctx);
@@ -10,6 +10,7 @@
 #include <string.h>
 #include <limits.h>
 #include <errno.h>
+#include "util/rmalloc.h"
 #include "util/redis_version.h"
 #include "../deps/GraphBLAS/Include/GraphBLAS.h"
 
@@ -64,6 +65,27 @@
 // effects replication threshold
 #define EFFECTS_THRESHOLD "EFFECTS_THRESHOLD"
 
+// folder from which LOAD CSV is allowed to read files
+#define IMPORT_FOLDER "IMPORT_FOLDER"
+
+// folder cold attribute-sets are spilled to
+#define ATTRIBUTE_SPILL_FOLDER "ATTRIBUTE_SPILL_FOLDER"
+
+// interval(ms) between attribute eviction sweeps
+#define ATTRIBUTE_SPILL_INTERVAL "ATTRIBUTE_SPILL_INTERVAL"
+
+// attribute holding an entity's expiration time
+#define ENTITY_EXPIRY_ATTRIBUTE "ENTITY_EXPIRY_ATTRIBUTE"
+
+// number of rows in each record batch of an arrow result-set
+#define ARROW_BATCH_SIZE "ARROW_BATCH_SIZE"
+
+// node range indices keep a column per indexed attribute
+#define INDEX_COLUMNS "INDEX_COLUMNS"
+
+// edge range indices keep a per node adjacency ordered by indexed attribute
+#define ORDERED_ADJACENCY "ORDERED_ADJACENCY"
+
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -74,6 +96,13 @@
 #define VKEY_MAX_ENTITY_COUNT_DEFAULT      100000
 #define CMD_INFO_DEFAULT                   true
 #define CMD_INFO_QUERIES_MAX_COUNT_DEFAULT 1000
+#define IMPORT_FOLDER_DEFAULT              "/var/lib/FalkorDB/import/"
+#define ATTRIBUTE_SPILL_FOLDER_DEFAULT     ""
+#define ATTRIBUTE_SPILL_INTERVAL_DEFAULT   60000
+#define ENTITY_EXPIRY_ATTRIBUTE_DEFAULT    ""
+#define ARROW_BATCH_SIZE_DEFAULT           65536
+#define INDEX_COLUMNS_DEFAULT              false
+#define ORDERED_ADJACENCY_DEFAULT          false
 
 // configuration object
 typedef struct {
@@ -94,6 +123,13 @@ typedef struct {
 	bool cmd_info_on;                  // If true, the GRAPH.INFO is enabled.
 	uint64_t effects_threshold;        // replicate via effects when runtime exceeds threshold
 	uint32_t max_info_queries_count;   // Maximum number of query info elements.
+	char *import_folder;               // folder from which LOAD CSV reads files
+	char *spill_folder;                // folder cold attribute-sets are spilled to
+	uint64_t spill_interval;           // interval(ms) between attribute eviction sweeps
+	char *expiry_attribute;            // attribute holding an entity's expiration time
+	uint64_t arrow_batch_size;         // number of rows in each arrow record batch
+	bool index_columns;                // node range indices keep attribute columns
+	bool ordered_adjacency;            // edge range indices keep an ordered adjacency
 } RG_Config;
 
 RG_Config config; // global module configuration
@@ -436,6 +472,110 @@ static uint64_t Config_effects_threshold_get (void) {
 	return config.effects_threshold;
 }
 
+//------------------------------------------------------------------------------
+// import folder
+//------------------------------------------------------------------------------
+
+static void Config_import_folder_set
+(
+	const char *import_folder
+) {
+	if(config.import_folder != NULL) rm_free(config.import_folder);
+	config.import_folder = rm_strdup(import_folder);
+}
+
+static const char *Config_import_folder_get(void) {
+	return config.import_folder;
+}
+
+//------------------------------------------------------------------------------
+// attribute spilling
+//------------------------------------------------------------------------------
+
+static void Config_spill_folder_set
+(
+	const char *spill_folder
+) {
+	if(config.spill_folder != NULL) rm_free(config.spill_folder);
+	config.spill_folder = rm_strdup(spill_folder);
+}
+
+static const char *Config_spill_folder_get(void) {
+	return config.spill_folder;
+}
+
+static void Config_spill_interval_set
+(
+	uint64_t interval
+) {
+	config.spill_interval = interval;
+}
+
+static uint64_t Config_spill_interval_get(void) {
+	return config.spill_interval;
+}
+
+//------------------------------------------------------------------------------
+// entity expiry
+//------------------------------------------------------------------------------
+
+static void Config_expiry_attribute_set
+(
+	const char *attribute
+) {
+	if(config.expiry_attribute != NULL) rm_free(config.expiry_attribute);
+	config.expiry_attribute = rm_strdup(attribute);
+}
+
+static const char *Config_expiry_attribute_get(void) {
+	return config.expiry_attribute;
+}
+
+//------------------------------------------------------------------------------
+// arrow batch size
+//------------------------------------------------------------------------------
+
+static void Config_arrow_batch_size_set
+(
+	uint64_t batch_size
+) {
+	config.arrow_batch_size = batch_size;
+}
+
+static uint64_t Config_arrow_batch_size_get(void) {
+	return config.arrow_batch_size;
+}
+
+//------------------------------------------------------------------------------
+// index columns
+//------------------------------------------------------------------------------
+
+static void Config_index_columns_set
+(
+	bool index_columns
+) {
+	config.index_columns = index_columns;
+}
+
+static bool Config_index_columns_get(void) {
+	return config.index_columns;
+}
+
+//------------------------------------------------------------------------------
+// ordered adjacency
+//------------------------------------------------------------------------------
+
+static void Config_ordered_adjacency_set
+(
+	bool ordered_adjacency
+) {
+	config.ordered_adjacency = ordered_adjacency;
+}
+
+static bool Config_ordered_adjacency_get(void) {
+	return config.ordered_adjacency;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -477,6 +617,20 @@ bool Config_Contains_field
 		f = Config_CMD_INFO_MAX_QUERY_COUNT;
 	} else if (!(strcasecmp(field_str, EFFECTS_THRESHOLD))) {
 		f = Config_EFFECTS_THRESHOLD;
+	} else if (!(strcasecmp(field_str, IMPORT_FOLDER))) {
+		f = Config_IMPORT_FOLDER;
+	} else if (!(strcasecmp(field_str, ATTRIBUTE_SPILL_FOLDER))) {
+		f = Config_ATTRIBUTE_SPILL_FOLDER;
+	} else if (!(strcasecmp(field_str, ATTRIBUTE_SPILL_INTERVAL))) {
+		f = Config_ATTRIBUTE_SPILL_INTERVAL;
+	} else if (!(strcasecmp(field_str, ENTITY_EXPIRY_ATTRIBUTE))) {
+		f = Config_ENTITY_EXPIRY_ATTRIBUTE;
+	} else if (!(strcasecmp(field_str, ARROW_BATCH_SIZE))) {
+		f = Config_ARROW_BATCH_SIZE;
+	} else if (!(strcasecmp(field_str, INDEX_COLUMNS))) {
+		f = Config_INDEX_COLUMNS;
+	} else if (!(strcasecmp(field_str, ORDERED_ADJACENCY))) {
+		f = Config_ORDERED_ADJACENCY;
 	} else {
 		return false;
 	}
@@ -555,6 +709,34 @@ const char *Config_Field_name
 			name = EFFECTS_THRESHOLD;
 			break;
 
+		case Config_IMPORT_FOLDER:
+			name = IMPORT_FOLDER;
+			break;
+
+		case Config_ATTRIBUTE_SPILL_FOLDER:
+			name = ATTRIBUTE_SPILL_FOLDER;
+			break;
+
+		case Config_ATTRIBUTE_SPILL_INTERVAL:
+			name = ATTRIBUTE_SPILL_INTERVAL;
+			break;
+
+		case Config_ENTITY_EXPIRY_ATTRIBUTE:
+			name = ENTITY_EXPIRY_ATTRIBUTE;
+			break;
+
+		case Config_ARROW_BATCH_SIZE:
+			name = ARROW_BATCH_SIZE;
+			break;
+
+		case Config_INDEX_COLUMNS:
+			name = INDEX_COLUMNS;
+			break;
+
+		case Config_ORDERED_ADJACENCY:
+			name = ORDERED_ADJACENCY;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -622,6 +804,25 @@ static void _Config_SetToDefaults(void) {
 
 	// replicate effects if avg change time μs > effects_threshold μs
 	config.effects_threshold = 300 ;
+
+	// LOAD CSV import folder
+	Config_import_folder_set(IMPORT_FOLDER_DEFAULT);
+
+	// attribute spilling is disabled by default
+	Config_spill_folder_set(ATTRIBUTE_SPILL_FOLDER_DEFAULT);
+	Config_spill_interval_set(ATTRIBUTE_SPILL_INTERVAL_DEFAULT);
+
+	// entity expiry is disabled by default
+	Config_expiry_attribute_set(ENTITY_EXPIRY_ATTRIBUTE_DEFAULT);
+
+	// arrow result-set record batch size
+	Config_arrow_batch_size_set(ARROW_BATCH_SIZE_DEFAULT);
+
+	// index columns are opt-in
+	Config_index_columns_set(INDEX_COLUMNS_DEFAULT);
+
+	// ordered adjacency is opt-in
+	Config_ordered_adjacency_set(ORDERED_ADJACENCY_DEFAULT);
 }
 
 int Config_Init
@@ -930,6 +1131,104 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// import folder
+		//----------------------------------------------------------------------
+
+		case Config_IMPORT_FOLDER: {
+			va_start(ap, field);
+			const char **import_folder = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(import_folder != NULL);
+			(*import_folder) = Config_import_folder_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// attribute spill folder
+		//----------------------------------------------------------------------
+
+		case Config_ATTRIBUTE_SPILL_FOLDER: {
+			va_start(ap, field);
+			const char **spill_folder = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(spill_folder != NULL);
+			(*spill_folder) = Config_spill_folder_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// attribute spill interval
+		//----------------------------------------------------------------------
+
+		case Config_ATTRIBUTE_SPILL_INTERVAL: {
+			va_start(ap, field);
+			uint64_t *spill_interval = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(spill_interval != NULL);
+			(*spill_interval) = Config_spill_interval_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// entity expiry attribute
+		//----------------------------------------------------------------------
+
+		case Config_ENTITY_EXPIRY_ATTRIBUTE: {
+			va_start(ap, field);
+			const char **expiry_attribute = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(expiry_attribute != NULL);
+			(*expiry_attribute) = Config_expiry_attribute_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// arrow batch size
+		//----------------------------------------------------------------------
+
+		case Config_ARROW_BATCH_SIZE: {
+			va_start(ap, field);
+			uint64_t *arrow_batch_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(arrow_batch_size != NULL);
+			(*arrow_batch_size) = Config_arrow_batch_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// index columns
+		//----------------------------------------------------------------------
+
+		case Config_INDEX_COLUMNS: {
+			va_start(ap, field);
+			bool *index_columns = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(index_columns != NULL);
+			(*index_columns) = Config_index_columns_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// ordered adjacency
+		//----------------------------------------------------------------------
+
+		case Config_ORDERED_ADJACENCY: {
+			va_start(ap, field);
+			bool *ordered_adjacency = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(ordered_adjacency != NULL);
+			(*ordered_adjacency) = Config_ordered_adjacency_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -1169,6 +1468,87 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// import folder
+		//----------------------------------------------------------------------
+
+		case Config_IMPORT_FOLDER: {
+			if(strlen(val) == 0) {
+				if(err) *err = "IMPORT_FOLDER must not be empty";
+				return false;
+			}
+			Config_import_folder_set(val);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// attribute spill folder
+		//----------------------------------------------------------------------
+
+		case Config_ATTRIBUTE_SPILL_FOLDER: {
+			Config_spill_folder_set(val);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// attribute spill interval
+		//----------------------------------------------------------------------
+
+		case Config_ATTRIBUTE_SPILL_INTERVAL: {
+			long long interval;
+			if(!_Config_ParsePositiveInteger(val, &interval)) {
+				if(err) *err = "ATTRIBUTE_SPILL_INTERVAL must be a positive integer";
+				return false;
+			}
+			Config_spill_interval_set(interval);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// entity expiry attribute
+		//----------------------------------------------------------------------
+
+		case Config_ENTITY_EXPIRY_ATTRIBUTE: {
+			Config_expiry_attribute_set(val);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// arrow batch size
+		//----------------------------------------------------------------------
+
+		case Config_ARROW_BATCH_SIZE: {
+			long long batch_size;
+			if(!_Config_ParsePositiveInteger(val, &batch_size)) {
+				if(err) *err = "ARROW_BATCH_SIZE must be a positive integer";
+				return false;
+			}
+			Config_arrow_batch_size_set(batch_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// index columns
+		//----------------------------------------------------------------------
+
+		case Config_INDEX_COLUMNS: {
+			bool index_columns;
+			if(!_Config_ParseYesNo(val, &index_columns)) return false;
+			Config_index_columns_set(index_columns);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// ordered adjacency
+		//----------------------------------------------------------------------
+
+		case Config_ORDERED_ADJACENCY: {
+			bool ordered_adjacency;
+			if(!_Config_ParseYesNo(val, &ordered_adjacency)) return false;
+			Config_ordered_adjacency_set(ordered_adjacency);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
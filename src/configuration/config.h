@@ -33,7 +33,14 @@ typedef enum {
 	Config_CMD_INFO                  = 13,  // toggle on/off the GRAPH.INFO
 	Config_CMD_INFO_MAX_QUERY_COUNT  = 14,  // the max number of info queries count
 	Config_EFFECTS_THRESHOLD         = 15,  // replicate queries via effects
-	Config_END_MARKER                = 16
+	Config_IMPORT_FOLDER             = 16,  // folder from which LOAD CSV reads files
+	Config_ATTRIBUTE_SPILL_FOLDER    = 17,  // folder cold attribute-sets are spilled to
+	Config_ATTRIBUTE_SPILL_INTERVAL  = 18,  // interval(ms) between attribute eviction sweeps
+	Config_ENTITY_EXPIRY_ATTRIBUTE   = 19,  // attribute holding an entity's expiration time
+	Config_ARROW_BATCH_SIZE          = 20,  // number of rows in each arrow record batch
+	Config_INDEX_COLUMNS             = 21,  // node range indices keep attribute columns
+	Config_ORDERED_ADJACENCY         = 22,  // edge range indices keep an ordered adjacency
+	Config_END_MARKER                = 23
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -53,7 +60,9 @@ static const Config_Option_Field RUNTIME_CONFIGS[] = {
 	Config_DELTA_MAX_PENDING_CHANGES,
 	Config_CMD_INFO,
 	Config_CMD_INFO_MAX_QUERY_COUNT,
-	Config_EFFECTS_THRESHOLD
+	Config_EFFECTS_THRESHOLD,
+	Config_ATTRIBUTE_SPILL_INTERVAL,
+	Config_ARROW_BATCH_SIZE
 };
 static const size_t RUNTIME_CONFIG_COUNT = sizeof(RUNTIME_CONFIGS) / sizeof(RUNTIME_CONFIGS[0]);
 
@@ -33,6 +33,12 @@ void Cron_AddRecurringTasks(void);
 // add stream finished queries task
 void CronTask_AddStreamFinishedQueries();
 
+// add attribute eviction task
+void CronTask_AddSpillAttributes();
+
+// add entity expiry task
+void CronTask_AddExpireEntities();
+
 // create a new CRON task
 CronTaskHandle Cron_AddTask
 (
@@ -8,7 +8,10 @@
 #include "cron.h"
 #include "util/rmalloc.h"
 #include "configuration/config.h"
+#include "tasks/expire_entities.h"
+#include "tasks/spill_attributes.h"
 #include "tasks/stream_finished_queries.h"
+#include "graph/entities/attribute_spill.h"
 
 typedef struct RecurringTaskCtx {
 	uint32_t when;
@@ -80,8 +83,36 @@ void CronTask_AddStreamFinishedQueries() {
 	}
 }
 
+void CronTask_AddSpillAttributes() {
+	//--------------------------------------------------------------------------
+	// add attribute eviction task
+	//--------------------------------------------------------------------------
+
+	// make sure attribute spilling is enabled
+	if(!AttributeSpill_Enabled()) return;
+
+	uint64_t interval;
+	Config_Option_get(Config_ATTRIBUTE_SPILL_INTERVAL, &interval);
+	Cron_AddTask(interval, CronTask_spillAttributes, NULL, NULL);
+}
+
+void CronTask_AddExpireEntities() {
+	//--------------------------------------------------------------------------
+	// add entity expiry task
+	//--------------------------------------------------------------------------
+
+	// make sure an expiry attribute is configured
+	const char *expiry_attr;
+	Config_Option_get(Config_ENTITY_EXPIRY_ATTRIBUTE, &expiry_attr);
+	if(strlen(expiry_attr) == 0) return;
+
+	Cron_AddTask(0, CronTask_expireEntities, NULL, NULL);
+}
+
 // add recurring tasks
 void Cron_AddRecurringTasks(void) {
 	CronTask_AddStreamFinishedQueries();
+	CronTask_AddSpillAttributes();
+	CronTask_AddExpireEntities();
 }
 
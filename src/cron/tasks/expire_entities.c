@@ -0,0 +1,251 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "query_ctx.h"
+#include "cron/cron.h"
+#include "util/arr.h"
+#include "redismodule.h"
+#include "lock_graph.h"
+#include "expire_entities.h"
+#include "graph/graph_hub.h"
+#include "util/simple_timer.h"
+#include "graph/graphcontext.h"
+#include "datatypes/temporal_value.h"
+#include "serializers/graphcontext_type.h"
+
+// GraphContext type as it is registered at Redis
+extern RedisModuleType *GraphContextRedisModuleType;
+
+// number of due entries popped between deadline checks
+#define EXPIRE_BATCH 256
+
+// max duration(ms) of a single expiry step
+#define EXPIRE_DEADLINE 3
+
+// delay(ms) between expiry steps while entities are due
+#define EXPIRE_STEP_DELAY 10
+
+// delay(ms) between expiry rounds
+#define EXPIRE_INTERVAL 100
+
+// graph being expired
+// a round visits each graph in the keyspace over one or more steps
+// each step holds the graph's locks for a short while
+static uint32_t _graph_idx = 0;
+
+static int _entity_cmp
+(
+	const GraphEntity *a,
+	const GraphEntity *b
+) {
+	EntityID a_id = ENTITY_GET_ID(a);
+	EntityID b_id = ENTITY_GET_ID(b);
+	return (a_id > b_id) - (a_id < b_id);
+}
+
+// collects entity if its expiration time passed
+// an expired node is collected along with its edges
+static void _CollectExpired
+(
+	GraphContext *gc,   // graph context
+	GraphEntityType t,  // entity type
+	EntityID id,        // entity ID
+	int64_t now,        // current time
+	Node **nodes,       // [output] expired nodes
+	Edge **edges        // [output] expired edges
+) {
+	int64_t expires;
+	Graph *g = gc->g;
+
+	if(t == GETYPE_NODE) {
+		Node n;
+		// entity was deleted or its expiration time was updated
+		if(!Graph_GetNode(g, id, &n)) return;
+		if(!GraphContext_GetEntityExpiry(gc, (GraphEntity *)&n, &expires) ||
+		   expires > now) {
+			return;
+		}
+
+		array_append(*nodes, n);
+		Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_BOTH, GRAPH_NO_RELATION,
+				edges);
+	} else {
+		Edge e;
+		if(!Graph_GetEdge(g, id, &e)) return;
+		if(!GraphContext_GetEntityExpiry(gc, (GraphEntity *)&e, &expires) ||
+		   expires > now) {
+			return;
+		}
+
+		// Graph_GetEdge resolves the edge's relation and endpoints
+		array_append(*edges, e);
+	}
+}
+
+// removes duplicates from sorted entities array
+static uint _Distinct
+(
+	GraphEntity *entities,  // entities array
+	uint n,                 // number of entities
+	size_t size             // entity size
+) {
+	if(n == 0) return 0;
+
+	qsort(entities, n, size, (int(*)(const void*, const void*))_entity_cmp);
+
+	uint distinct = 1;
+	for(uint i = 1; i < n; i++) {
+		GraphEntity *prev = (GraphEntity *)((char *)entities + (distinct - 1) * size);
+		GraphEntity *curr = (GraphEntity *)((char *)entities + i * size);
+		if(ENTITY_GET_ID(prev) == ENTITY_GET_ID(curr)) continue;
+
+		memmove((char *)entities + distinct * size, curr, size);
+		distinct++;
+	}
+
+	return distinct;
+}
+
+// deletes expired entities of graph until deadline is reached
+// returns true if no due entities remain
+static bool _ExpireGraph
+(
+	RedisModuleCtx *rm_ctx,   // redis module context
+	GraphContext *gc,         // graph to expire
+	simple_timer_t stopwatch  // step stopwatch
+) {
+	bool done   = false;
+	int64_t now = TemporalValue_NewTimestamp();
+	Node *nodes = array_new(Node, 0);
+	Edge *edges = array_new(Edge, 0);
+
+	while(!done && TIMER_GET_ELAPSED_MILLISECONDS(stopwatch) < EXPIRE_DEADLINE) {
+		for(uint i = 0; i < EXPIRE_BATCH && !done; i++) {
+			EntityID id;
+			GraphEntityType t;
+			done = !EntityExpiry_Pop(gc->expiry, now, &t, &id);
+			if(!done) _CollectExpired(gc, t, id, now, &nodes, &edges);
+		}
+	}
+
+	uint node_count = _Distinct((GraphEntity *)nodes, array_len(nodes),
+			sizeof(Node));
+	uint edge_count = _Distinct((GraphEntity *)edges, array_len(edges),
+			sizeof(Edge));
+
+	if(node_count + edge_count > 0) {
+		// delete via the graph hub, as DELETE does
+		// NOTE: delete edges before nodes
+		// required as a deleted node must be detached
+		QueryCtx_SetGraphCtx(gc);
+
+		// interleaving optimistic writes reading the expired entities
+		// must not commit, deletions mark their labels and relations
+		Graph_CountWrite(gc->g);
+
+		if(edge_count > 0) DeleteEdges(gc, edges, edge_count, true);
+		if(node_count > 0) DeleteNodes(gc, nodes, node_count, true);
+
+		// replicate deletions
+		size_t effects_len = 0;
+		EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+		u_char *effects = EffectsBuffer_Buffer(eb, &effects_len);
+		RedisModule_Replicate(rm_ctx, "GRAPH.EFFECT", "cb!", gc->graph_name,
+				effects, effects_len);
+		rm_free(effects);
+
+		// deletions are committed, discard undo log
+		QueryCtx_Free();
+	}
+
+	array_free(nodes);
+	array_free(edges);
+
+	return done;
+}
+
+// expires graph's entities
+// returns true if no due entities remain
+static bool _ExpireStep
+(
+	RedisModuleCtx *rm_ctx,   // redis module context
+	GraphContext *gc,         // graph to expire
+	simple_timer_t stopwatch  // step stopwatch
+) {
+	// replicas receive deletions from their primary
+	int flags = RedisModule_GetContextFlags(rm_ctx);
+	if(flags & (REDISMODULE_CTX_FLAGS_SLAVE | REDISMODULE_CTX_FLAGS_LOADING)) {
+		return true;
+	}
+
+	// make sure the graph's key still holds the graph
+	RedisModuleString *graph_id = RedisModule_CreateString(rm_ctx,
+			gc->graph_name, strlen(gc->graph_name));
+	RedisModuleKey *key = RedisModule_OpenKey(rm_ctx, graph_id,
+			REDISMODULE_WRITE);
+	RedisModule_FreeString(rm_ctx, graph_id);
+
+	bool done = true;
+	if(RedisModule_ModuleTypeGetType(key) == GraphContextRedisModuleType &&
+	   RedisModule_ModuleTypeGetValue(key) == gc) {
+		done = _ExpireGraph(rm_ctx, gc, stopwatch);
+	}
+
+	RedisModule_CloseKey(key);
+	return done;
+}
+
+void CronTask_expireEntities
+(
+	void *pdata  // unused
+) {
+	simple_timer_t stopwatch;
+	simple_tic(stopwatch);
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+	GraphIterator_Seek(&it, _graph_idx);
+
+	// skip graphs without due entities
+	GraphContext *gc;
+	int64_t now = TemporalValue_NewTimestamp();
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		if(gc->expiry != NULL && EntityExpiry_Due(gc->expiry, now)) break;
+
+		GraphContext_DecreaseRefCount(gc);
+		_graph_idx++;
+	}
+
+	// round completed, schedule next round
+	if(gc == NULL) {
+		_graph_idx = 0;
+		Cron_AddTask(EXPIRE_INTERVAL, CronTask_expireEntities, NULL, NULL);
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// lock graph
+	//--------------------------------------------------------------------------
+
+	// give up on contention, retry on next step
+	bool done = false;
+	RedisModuleCtx *rm_ctx = RedisModule_GetThreadSafeContext(NULL);
+
+	if(CronTask_LockGraph(rm_ctx, gc->g)) {
+		done = _ExpireStep(rm_ctx, gc, stopwatch);
+		CronTask_UnlockGraph(rm_ctx, gc->g);
+	}
+
+	RedisModule_FreeThreadSafeContext(rm_ctx);
+	GraphContext_DecreaseRefCount(gc);
+
+	// advance to next graph
+	if(done) _graph_idx++;
+
+	Cron_AddTask(EXPIRE_STEP_DELAY, CronTask_expireEntities, NULL, NULL);
+}
+
@@ -0,0 +1,17 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+// cron task
+// deletes entities of each graph in the keyspace whose expiration time passed
+// deletions are replicated as effects
+void CronTask_expireEntities
+(
+	void *pdata  // unused
+);
+
@@ -0,0 +1,46 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "query_ctx.h"
+#include "lock_graph.h"
+
+bool CronTask_LockGraph
+(
+	RedisModuleCtx *rm_ctx,
+	Graph *g
+) {
+	ASSERT(g      != NULL);
+	ASSERT(rm_ctx != NULL);
+
+	if(!QueryCtx_TryLockWriters()) return false;
+
+	if(RedisModule_ThreadSafeContextTryLock(rm_ctx) != REDISMODULE_OK) {
+		QueryCtx_UnlockWriters();
+		return false;
+	}
+
+	// don't block on the graph while holding the GIL
+	if(!Graph_TryAcquireWriteLock(g)) {
+		RedisModule_ThreadSafeContextUnlock(rm_ctx);
+		QueryCtx_UnlockWriters();
+		return false;
+	}
+
+	return true;
+}
+
+void CronTask_UnlockGraph
+(
+	RedisModuleCtx *rm_ctx,
+	Graph *g
+) {
+	ASSERT(g      != NULL);
+	ASSERT(rm_ctx != NULL);
+
+	Graph_ReleaseLock(g);
+	RedisModule_ThreadSafeContextUnlock(rm_ctx);
+	QueryCtx_UnlockWriters();
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "redismodule.h"
+#include "graph/graph.h"
+
+// locks graph for a cron task step
+// same locking order as a committing query: writers, GIL, graph
+// the writer thread reads the graph holding the writers lock only
+// the main thread reads the graph holding the GIL only
+// never blocks, gives up on contention such that the step is retried later
+// the graph lock isn't counted as a write, see Graph_TryAcquireWriteLock
+// returns true if all locks were acquired
+bool CronTask_LockGraph
+(
+	RedisModuleCtx *rm_ctx,  // thread safe context
+	Graph *g                 // graph to lock
+);
+
+// releases the locks acquired by CronTask_LockGraph
+void CronTask_UnlockGraph
+(
+	RedisModuleCtx *rm_ctx,  // thread safe context
+	Graph *g                 // graph to unlock
+);
@@ -0,0 +1,166 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "cron/cron.h"
+#include "lock_graph.h"
+#include "redismodule.h"
+#include "spill_attributes.h"
+#include "util/simple_timer.h"
+#include "graph/graphcontext.h"
+#include "configuration/config.h"
+#include "graph/entities/attribute_spill.h"
+
+// number of entities visited between deadline checks
+#define SWEEP_BATCH 1024
+
+// max duration(ms) of a single sweep step
+#define SWEEP_DEADLINE 3
+
+// delay(ms) between sweep steps
+#define SWEEP_STEP_DELAY 10
+
+// sweep progress
+// a sweep visits every node and edge of each graph in the keyspace
+// over multiple steps, each step holds the graph's locks for a short while
+static struct {
+	uint32_t graph_idx;     // graph being swept
+	uint64_t node_cursor;   // next node to visit
+	uint64_t edge_cursor;   // next edge to visit
+	uint64_t version;       // graph write version as of the previous step
+	uint64_t drops;         // spilled sets dropped as of the first step
+	uint64_t resident;      // number of sets left in memory by the sweep
+	bool conclusive;        // graph wasn't modified during the sweep
+} _sweep = {0};
+
+// advances sweep to the next graph
+static void _nextGraph(void) {
+	_sweep.graph_idx++;
+	_sweep.node_cursor = 0;
+	_sweep.edge_cursor = 0;
+}
+
+// returns true if graph's attribute-sets are all spilled
+// i.e. a previous sweep left no set in memory, since then the graph wasn't
+// modified and no spilled set was loaded back into memory
+static bool _fullySpilled
+(
+	const GraphContext *gc  // graph to check
+) {
+	return gc->spilled_version == Graph_WriteVersion(gc->g) &&
+		gc->spilled_drops == AttributeSpill_DropCount();
+}
+
+// sweeps graph until deadline is reached
+// returns true if the graph was fully swept
+static bool _sweepGraph
+(
+	Graph *g,                 // graph to sweep
+	simple_timer_t stopwatch, // step stopwatch
+	uint64_t *spilled         // [output] number of spilled sets
+) {
+	bool done = false;
+
+	while(!done && TIMER_GET_ELAPSED_MILLISECONDS(stopwatch) < SWEEP_DEADLINE) {
+		done = Graph_SpillAttributes(g, GETYPE_NODE, &_sweep.node_cursor,
+				SWEEP_BATCH, spilled, &_sweep.resident);
+	}
+
+	if(!done) return false;
+	done = false;
+
+	while(!done && TIMER_GET_ELAPSED_MILLISECONDS(stopwatch) < SWEEP_DEADLINE) {
+		done = Graph_SpillAttributes(g, GETYPE_EDGE, &_sweep.edge_cursor,
+				SWEEP_BATCH, spilled, &_sweep.resident);
+	}
+
+	return done;
+}
+
+void CronTask_spillAttributes
+(
+	void *pdata  // unused
+) {
+	simple_timer_t stopwatch;
+	simple_tic(stopwatch);
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+	GraphIterator_Seek(&it, _sweep.graph_idx);
+
+	// skip graphs with nothing to spill, without locking them
+	GraphContext *gc;
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		bool sweeping = (_sweep.node_cursor > 0 || _sweep.edge_cursor > 0);
+		if(sweeping || !_fullySpilled(gc)) break;
+
+		GraphContext_DecreaseRefCount(gc);
+		_nextGraph();
+	}
+
+	// sweep completed, schedule next sweep
+	if(gc == NULL) {
+		_sweep.graph_idx   = 0;
+		_sweep.node_cursor = 0;
+		_sweep.edge_cursor = 0;
+
+		uint64_t interval;
+		Config_Option_get(Config_ATTRIBUTE_SPILL_INTERVAL, &interval);
+		Cron_AddTask(interval, CronTask_spillAttributes, NULL, NULL);
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// lock graph
+	//--------------------------------------------------------------------------
+
+	// spilling frees attribute-sets, the graph must not be accessed meanwhile
+	// give up on contention, retry on next step
+	Graph *g = gc->g;
+	bool swept = false;
+	RedisModuleCtx *rm_ctx = RedisModule_GetThreadSafeContext(NULL);
+
+	if(CronTask_LockGraph(rm_ctx, g)) {
+		// first step of the graph's sweep
+		if(_sweep.node_cursor == 0 && _sweep.edge_cursor == 0) {
+			_sweep.drops      = AttributeSpill_DropCount();
+			_sweep.version    = Graph_WriteVersion(g);
+			_sweep.resident   = 0;
+			_sweep.conclusive = true;
+		}
+
+		// graph was modified between steps
+		// entities created meanwhile might have been skipped
+		if(Graph_WriteVersion(g) != _sweep.version) _sweep.conclusive = false;
+
+		uint64_t spilled = 0;
+		swept = _sweepGraph(g, stopwatch, &spilled);
+
+		// interleaving optimistic writes might hold spilled attributes
+		if(spilled > 0) {
+			Graph_CountWrite(g);
+			Graph_TouchAll(g);
+		}
+		_sweep.version = Graph_WriteVersion(g);
+
+		// nothing is left to spill, skip graph until it's accessed
+		if(swept && _sweep.conclusive && _sweep.resident == 0 &&
+		   _sweep.drops == AttributeSpill_DropCount()) {
+			gc->spilled_version = _sweep.version;
+			gc->spilled_drops   = _sweep.drops;
+		}
+
+		CronTask_UnlockGraph(rm_ctx, g);
+	}
+
+	RedisModule_FreeThreadSafeContext(rm_ctx);
+	GraphContext_DecreaseRefCount(gc);
+
+	// advance to next graph
+	if(swept) _nextGraph();
+
+	Cron_AddTask(SWEEP_STEP_DELAY, CronTask_spillAttributes, NULL, NULL);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+// cron task
+// sweeps the attribute-sets of each graph in the keyspace
+// spilling sets which weren't accessed since the previous sweep to disk
+void CronTask_spillAttributes
+(
+	void *pdata  // unused
+);
@@ -0,0 +1,660 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "csv_reader.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
+#include "../util/thpool/pools.h"
+
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define CSV_BLOCK_SIZE        (4 * 1024 * 1024)  // number of bytes read per batch
+#define CSV_MIN_CHUNK_SIZE    (64 * 1024)        // smallest chunk worth a thread
+#define CSV_MAX_PARSE_THREADS 8                  // max number of parser threads
+
+// task states
+#define CSV_TASK_PENDING 0  // task is queued
+#define CSV_TASK_RUNNING 1  // task was picked up
+#define CSV_TASK_DONE    2  // task completed
+
+// a routine dispatched to the readers thread pool
+// whoever waits on a task runs it itself if no worker picked it up yet
+// such that waiting never depends on a free worker
+typedef struct {
+	void *(*func)(void *);  // routine
+	void *arg;              // routine argument
+	atomic_int state;       // task state
+	atomic_uint refs;       // held by the dispatcher and the thread pool
+	pthread_mutex_t lock;   // guards completion
+	pthread_cond_t done;    // signaled once the task completes
+} CSVTask;
+
+// a record aligned section of a block, parsed by a single thread
+typedef struct {
+	char *begin;             // chunk start
+	char *end;               // chunk end, exclusive
+	char delimiter;          // field delimiter
+	const SIValue *headers;  // column names, NULL if CSV has no headers
+	SIValue *rows;           // [output] parsed rows
+	const char *err;         // [output] parse error
+} CSVChunk;
+
+// rows parsed out of a single block
+typedef struct {
+	SIValue *rows;    // parsed rows
+	uint32_t idx;     // index of the next row to hand out
+	const char *err;  // error encountered while loading the batch
+} CSVBatch;
+
+struct Opaque_CSVReader {
+	int fd;              // CSV file descriptor
+	char *buf;           // block buffer
+	size_t cap;          // block buffer capacity
+	size_t len;          // number of bytes held by buffer
+	bool eof;            // file was read to its end
+	char delimiter;      // field delimiter
+	bool with_headers;   // first row holds column names
+	SIValue *headers;    // column names
+	uint nthreads;       // max number of parser threads
+	CSVBatch batch;      // batch consumed by the caller
+	CSVBatch next;       // batch loaded in the background
+	CSVTask *loader;     // background batch loader, NULL if not loading
+	char *err;           // encountered error
+};
+
+//------------------------------------------------------------------------------
+// tasks
+//------------------------------------------------------------------------------
+
+// drop a reference to task, last reference frees the task
+static void _TaskRelease
+(
+	CSVTask *task  // task to release
+) {
+	if(atomic_fetch_sub(&task->refs, 1) > 1) return;
+
+	pthread_cond_destroy(&task->done);
+	pthread_mutex_destroy(&task->lock);
+	rm_free(task);
+}
+
+// run task unless it was already picked up
+// returns true if task was run
+static bool _TaskTryRun
+(
+	CSVTask *task  // task to run
+) {
+	int expected = CSV_TASK_PENDING;
+	if(!atomic_compare_exchange_strong(&task->state, &expected,
+				CSV_TASK_RUNNING)) {
+		return false;
+	}
+
+	task->func(task->arg);
+
+	pthread_mutex_lock(&task->lock);
+	atomic_store(&task->state, CSV_TASK_DONE);
+	pthread_cond_broadcast(&task->done);
+	pthread_mutex_unlock(&task->lock);
+
+	return true;
+}
+
+// thread pool entry point
+static void _TaskHandler
+(
+	void *arg  // task
+) {
+	CSVTask *task = (CSVTask *)arg;
+	_TaskTryRun(task);
+	_TaskRelease(task);
+}
+
+// dispatch 'func' to the readers thread pool
+static CSVTask *_TaskDispatch
+(
+	void *(*func)(void *),  // routine
+	void *arg               // routine argument
+) {
+	CSVTask *task = rm_malloc(sizeof(CSVTask));
+
+	task->func = func;
+	task->arg  = arg;
+	atomic_init(&task->state, CSV_TASK_PENDING);
+	atomic_init(&task->refs, 2);
+	pthread_mutex_init(&task->lock, NULL);
+	pthread_cond_init(&task->done, NULL);
+
+	// failed to enqueue, task will be run by the waiter
+	if(ThreadPools_AddWorkReader(_TaskHandler, task, true) != 0) {
+		atomic_store(&task->refs, 1);
+	}
+
+	return task;
+}
+
+// wait for task to complete and release it
+// a task no worker picked up is run on the calling thread
+static void _TaskWait
+(
+	CSVTask *task  // task to wait on
+) {
+	if(!_TaskTryRun(task)) {
+		pthread_mutex_lock(&task->lock);
+		while(atomic_load(&task->state) != CSV_TASK_DONE) {
+			pthread_cond_wait(&task->done, &task->lock);
+		}
+		pthread_mutex_unlock(&task->lock);
+	}
+
+	_TaskRelease(task);
+}
+
+//------------------------------------------------------------------------------
+// parsing
+//------------------------------------------------------------------------------
+
+// parse a single field starting at 'p'
+// the field is unescaped and NULL terminated in place
+// returns a pointer to the beginning of the next field
+static char *_ParseField
+(
+	char *p,           // field start
+	char *end,         // chunk end
+	char delimiter,    // field delimiter
+	SIValue *v,        // [output] field value
+	bool *eor,         // [output] true if field terminates the record
+	const char **err   // [output] parse error
+) {
+	*eor = true;
+
+	//--------------------------------------------------------------------------
+	// quoted field
+	//--------------------------------------------------------------------------
+
+	if(p < end && *p == '"') {
+		char *w = p;      // write position
+		char *r = p + 1;  // read position
+		while(true) {
+			if(r == end) {
+				*err = "unterminated quoted field";
+				return end;
+			}
+			if(*r == '"') {
+				// escaped quote
+				if(r + 1 < end && r[1] == '"') {
+					*w++ = '"';
+					r += 2;
+					continue;
+				}
+				r++;
+				break;
+			}
+			*w++ = *r++;
+		}
+
+		// skip carriage return
+		if(r < end && *r == '\r' && r + 1 < end && r[1] == '\n') r++;
+
+		if(r < end && *r != delimiter && *r != '\n') {
+			*err = "unexpected character after quoted field";
+			return end;
+		}
+
+		*v = SI_ConstStringVal(p);
+		*eor = (r == end || *r == '\n');
+		*w = '\0';
+		return (r == end) ? end : r + 1;
+	}
+
+	//--------------------------------------------------------------------------
+	// unquoted field
+	//--------------------------------------------------------------------------
+
+	char *r = p;
+	while(r < end && *r != delimiter && *r != '\n') {
+		if(*r == '"') {
+			*err = "unexpected quote in unquoted field";
+			return end;
+		}
+		r++;
+	}
+
+	*eor = (r == end || *r == '\n');
+
+	// trim carriage return
+	char *field_end = r;
+	if(*eor && field_end > p && field_end[-1] == '\r') field_end--;
+
+	*v = (field_end == p) ? SI_NullVal() : SI_ConstStringVal(p);
+	*field_end = '\0';
+	return (r == end) ? end : r + 1;
+}
+
+// parse a single record starting at '*p'
+// advances '*p' to the beginning of the next record
+// returns false if the record is empty or a parse error was encountered
+static bool _ParseRecord
+(
+	char **p,                // record start
+	char *end,               // chunk end
+	char delimiter,          // field delimiter
+	const SIValue *headers,  // column names, NULL if CSV has no headers
+	SIValue *row,            // [output] parsed row
+	const char **err         // [output] parse error
+) {
+	char *r = *p;
+
+	// skip empty lines
+	if(*r == '\n' || (*r == '\r' && r + 1 < end && r[1] == '\n')) {
+		*p = (*r == '\n') ? r + 1 : r + 2;
+		return false;
+	}
+
+	bool eor = false;
+
+	if(headers == NULL) {
+		*row = SIArray_New(8);
+		while(!eor) {
+			SIValue v;
+			r = _ParseField(r, end, delimiter, &v, &eor, err);
+			if(*err != NULL) break;
+			SIArray_Append(row, v);
+		}
+	} else {
+		uint col = 0;
+		uint ncols = array_len((SIValue *)headers);
+		*row = Map_New(ncols);
+		while(!eor) {
+			SIValue v;
+			r = _ParseField(r, end, delimiter, &v, &eor, err);
+			if(*err != NULL) break;
+			// columns without a header are discarded
+			if(col < ncols) Map_Add(row, headers[col], v);
+			col++;
+		}
+		// missing columns are set to NULL
+		for(; col < ncols; col++) Map_Add(row, headers[col], SI_NullVal());
+	}
+
+	*p = r;
+
+	if(*err != NULL) {
+		SIValue_Free(*row);
+		return false;
+	}
+
+	return true;
+}
+
+// parse chunk, invoked concurrently by parser threads
+static void *_ParseChunk
+(
+	void *arg  // chunk to parse
+) {
+	CSVChunk *chunk = (CSVChunk *)arg;
+
+	char *p = chunk->begin;
+	while(p < chunk->end && chunk->err == NULL) {
+		SIValue row;
+		if(_ParseRecord(&p, chunk->end, chunk->delimiter, chunk->headers, &row,
+					&chunk->err)) {
+			array_append(chunk->rows, row);
+		}
+	}
+
+	return NULL;
+}
+
+// locate record boundaries within 'buf'
+// 'splits' is populated with the first boundary at or past each of the
+// 'n' evenly spaced offsets, returns the offset right after the last complete
+// record, or 'len' if this is the last block in the file
+static size_t _FindBoundaries
+(
+	const char *buf,  // buffer to scan
+	size_t len,       // buffer length
+	bool eof,         // buffer holds the end of the file
+	size_t *splits,   // [output] chunk boundaries
+	uint n            // number of chunks
+) {
+	uint k = 1;
+	size_t last = 0;
+	bool quoted = false;
+	size_t step = len / n;
+
+	// a quote always toggles the quoting state, escaped quotes ("")
+	// toggle it twice, as such new lines within quoted fields are skipped
+	for(size_t i = 0; i < len; i++) {
+		char c = buf[i];
+		if(c == '"') {
+			quoted = !quoted;
+		} else if(c == '\n' && !quoted) {
+			last = i + 1;
+			while(k < n && last >= step * k) splits[k++] = last;
+		}
+	}
+
+	if(eof) last = len;
+
+	splits[0] = 0;
+	for(; k <= n; k++) splits[k] = last;
+	splits[n] = last;
+
+	return last;
+}
+
+//------------------------------------------------------------------------------
+// batch loading
+//------------------------------------------------------------------------------
+
+// fill block buffer
+// returns false on read failure
+static bool _FillBuffer
+(
+	CSVReader reader  // CSV reader
+) {
+	while(!reader->eof && reader->len < reader->cap) {
+		ssize_t n = read(reader->fd, reader->buf + reader->len,
+				reader->cap - reader->len);
+		if(n < 0) {
+			if(errno == EINTR) continue;
+			return false;
+		}
+		if(n == 0) reader->eof = true;
+		reader->len += n;
+	}
+
+	return true;
+}
+
+// load the next batch of rows
+// reads the next block from the file and parses it in parallel
+static void *_LoadBatch
+(
+	void *arg  // CSV reader
+) {
+	CSVReader reader = (CSVReader)arg;
+	CSVBatch *batch = &reader->next;
+
+	batch->rows = array_new(SIValue, 0);
+
+	uint nchunks;
+	size_t last;
+	size_t offset = 0;
+	size_t splits[CSV_MAX_PARSE_THREADS + 1];
+
+	while(true) {
+		if(!_FillBuffer(reader)) {
+			batch->err = "failed reading CSV file";
+			return NULL;
+		}
+
+		//----------------------------------------------------------------------
+		// parse headers
+		//----------------------------------------------------------------------
+
+		if(reader->with_headers && reader->headers == NULL && reader->len > 0) {
+			SIValue row = SI_NullVal();
+			char *p = reader->buf;
+			char *end = reader->buf + reader->len;
+			size_t boundary = _FindBoundaries(reader->buf, reader->len,
+					reader->eof, splits, 1);
+
+			// header must be fully contained within the buffer
+			if(boundary > 0) {
+				end = reader->buf + boundary;
+				while(p < end && !_ParseRecord(&p, end, reader->delimiter,
+							NULL, &row, &batch->err)) {
+					if(batch->err != NULL) return NULL;
+				}
+
+				reader->headers = array_new(SIValue, 0);
+				if(SI_TYPE(row) == T_ARRAY) {
+					uint ncols = SIArray_Length(row);
+					for(uint i = 0; i < ncols; i++) {
+						SIValue col = SIArray_Get(row, i);
+						array_append(reader->headers, SI_TYPE(col) == T_STRING ?
+								SI_DuplicateStringVal(col.stringval) :
+								SI_ConstStringVal(""));
+					}
+					SIValue_Free(row);
+				}
+
+				offset = p - reader->buf;
+			}
+		}
+
+		//----------------------------------------------------------------------
+		// split block to chunks
+		//----------------------------------------------------------------------
+
+		size_t len = reader->len - offset;
+		nchunks = MAX(1, MIN(reader->nthreads, len / CSV_MIN_CHUNK_SIZE));
+		last = _FindBoundaries(reader->buf + offset, len, reader->eof, splits,
+				nchunks);
+
+		// buffer holds at least one complete record
+		if(last > 0 || reader->eof) break;
+
+		// record is larger than the buffer, grow buffer and read some more
+		reader->cap *= 2;
+		reader->buf = rm_realloc(reader->buf, reader->cap + 1);
+	}
+
+	//--------------------------------------------------------------------------
+	// parse chunks in parallel
+	//--------------------------------------------------------------------------
+
+	CSVChunk chunks[CSV_MAX_PARSE_THREADS];
+	CSVTask *tasks[CSV_MAX_PARSE_THREADS] = {0};
+
+	char *base = reader->buf + offset;
+	for(uint i = 0; i < nchunks; i++) {
+		chunks[i] = (CSVChunk) {
+			.begin     = base + splits[i],
+			.end       = base + splits[i + 1],
+			.delimiter = reader->delimiter,
+			.headers   = reader->headers,
+			.rows      = array_new(SIValue, 0),
+			.err       = NULL
+		};
+	}
+
+	// chunk 0 is parsed by the loader
+	// chunks no reader picked up by then are parsed by the loader as well
+	for(uint i = 1; i < nchunks; i++) {
+		if(chunks[i].begin == chunks[i].end) continue;
+		tasks[i] = _TaskDispatch(_ParseChunk, chunks + i);
+	}
+
+	_ParseChunk(chunks);
+
+	for(uint i = 1; i < nchunks; i++) {
+		if(tasks[i] != NULL) _TaskWait(tasks[i]);
+	}
+
+	//--------------------------------------------------------------------------
+	// concatenate chunks in file order
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < nchunks; i++) {
+		if(batch->err == NULL) batch->err = chunks[i].err;
+		uint n = array_len(chunks[i].rows);
+		if(batch->err == NULL) {
+			array_ensure_append(batch->rows, chunks[i].rows, n, SIValue);
+		} else {
+			for(uint j = 0; j < n; j++) SIValue_Free(chunks[i].rows[j]);
+		}
+		array_free(chunks[i].rows);
+	}
+
+	// move incomplete record to the beginning of the buffer
+	size_t consumed = offset + last;
+	memmove(reader->buf, reader->buf + consumed, reader->len - consumed);
+	reader->len -= consumed;
+
+	return NULL;
+}
+
+// start loading the next batch in the background
+static void _StartLoad
+(
+	CSVReader reader  // CSV reader
+) {
+	ASSERT(reader->loader == NULL);
+
+	reader->next   = (CSVBatch) {0};
+	reader->loader = _TaskDispatch(_LoadBatch, reader);
+}
+
+// wait for the background loader to finish
+static void _WaitLoad
+(
+	CSVReader reader  // CSV reader
+) {
+	ASSERT(reader->loader != NULL);
+
+	_TaskWait(reader->loader);
+	reader->loader = NULL;
+}
+
+// free batch rows which were not handed out
+static void _FreeBatch
+(
+	CSVBatch *batch  // batch to free
+) {
+	if(batch->rows == NULL) return;
+
+	uint n = array_len(batch->rows);
+	for(uint i = batch->idx; i < n; i++) SIValue_Free(batch->rows[i]);
+	array_free(batch->rows);
+	batch->rows = NULL;
+}
+
+// switch to the next batch
+// returns false if there are no more batches
+static bool _NextBatch
+(
+	CSVReader reader  // CSV reader
+) {
+	if(reader->loader == NULL) return false;
+
+	_WaitLoad(reader);
+	_FreeBatch(&reader->batch);
+
+	reader->batch = reader->next;
+	reader->next  = (CSVBatch) {0};
+
+	if(reader->batch.err != NULL) {
+		reader->err = rm_strdup(reader->batch.err);
+		return false;
+	}
+
+	// prefetch the following batch while the caller consumes this one
+	if(!reader->eof || reader->len > 0) _StartLoad(reader);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// API
+//------------------------------------------------------------------------------
+
+CSVReader CSVReader_New
+(
+	const char *path,   // path to CSV file
+	bool with_headers,  // first row holds column names
+	char delimiter,     // field delimiter
+	char **err          // [output] error message, caller should free
+) {
+	ASSERT(path != NULL);
+	ASSERT(err  != NULL);
+
+	int fd = open(path, O_RDONLY);
+	if(fd == -1) {
+		int rc __attribute__((unused));
+		rc = asprintf(err, "failed to open file '%s': %s", path,
+				strerror(errno));
+		return NULL;
+	}
+
+	// hint sequential access
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	CSVReader reader = rm_calloc(1, sizeof(struct Opaque_CSVReader));
+
+	// chunks are parsed by the readers thread pool
+	uint nreaders = ThreadPools_ReadersCount();
+
+	reader->fd           = fd;
+	reader->cap          = CSV_BLOCK_SIZE;
+	reader->buf          = rm_malloc(reader->cap + 1);  // room for terminator
+	reader->delimiter    = delimiter;
+	reader->with_headers = with_headers;
+	reader->nthreads     = MAX(1, MIN(CSV_MAX_PARSE_THREADS, nreaders));
+
+	_StartLoad(reader);
+
+	return reader;
+}
+
+bool CSVReader_GetRow
+(
+	CSVReader reader,  // CSV reader
+	SIValue *row       // [output] row, caller takes ownership
+) {
+	ASSERT(row    != NULL);
+	ASSERT(reader != NULL);
+
+	while(reader->batch.rows == NULL ||
+		  reader->batch.idx == array_len(reader->batch.rows)) {
+		if(reader->err != NULL)  return false;
+		if(!_NextBatch(reader)) return false;
+	}
+
+	*row = reader->batch.rows[reader->batch.idx++];
+	return true;
+}
+
+const char *CSVReader_Error
+(
+	const CSVReader reader  // CSV reader
+) {
+	ASSERT(reader != NULL);
+	return reader->err;
+}
+
+void CSVReader_Free
+(
+	CSVReader reader  // CSV reader to free
+) {
+	ASSERT(reader != NULL);
+
+	if(reader->loader != NULL) _WaitLoad(reader);
+
+	_FreeBatch(&reader->batch);
+	_FreeBatch(&reader->next);
+
+	if(reader->headers != NULL) {
+		array_free_cb(reader->headers, SIValue_Free);
+	}
+
+	if(reader->err != NULL) rm_free(reader->err);
+
+	close(reader->fd);
+	rm_free(reader->buf);
+	rm_free(reader);
+}
+
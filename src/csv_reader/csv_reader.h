@@ -0,0 +1,50 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+
+#include <stdbool.h>
+
+// streaming CSV reader
+// the file is consumed in fixed size blocks, each block is split on record
+// boundaries into chunks which are parsed concurrently by the readers
+// thread pool while the caller consumes the rows of the previous block
+typedef struct Opaque_CSVReader *CSVReader;
+
+// create a new CSV reader
+// returns NULL and sets 'err' if the file can't be opened
+CSVReader CSVReader_New
+(
+	const char *path,   // path to CSV file
+	bool with_headers,  // first row holds column names
+	char delimiter,     // field delimiter
+	char **err          // [output] error message, caller should free
+);
+
+// produce the next row
+// rows are arrays of strings, or maps from column name to string when the
+// reader was created with headers, empty unquoted fields are reported as NULL
+// returns false once the file is depleted or a parse error was encountered
+bool CSVReader_GetRow
+(
+	CSVReader reader,  // CSV reader
+	SIValue *row       // [output] row, caller takes ownership
+);
+
+// returns the error encountered by the reader, NULL if there is none
+const char *CSVReader_Error
+(
+	const CSVReader reader  // CSV reader
+);
+
+// free CSV reader
+void CSVReader_Free
+(
+	CSVReader reader  // CSV reader to free
+);
+
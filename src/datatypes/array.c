@@ -189,6 +189,24 @@ XXH64_hash_t SIArray_HashCode(SIValue siarray) {
 	return hashCode;
 }
 
+// writes a binary representation of an array to stream
+void SIArray_ToBinary
+(
+	FILE *stream,       // stream to write to
+	const SIValue *arr  // array to write
+) {
+	// format:
+	// number of elements
+	// elements
+
+	uint32_t n = SIArray_Length(*arr);
+	fwrite_assert(&n, sizeof(uint32_t), stream);
+
+	for(uint32_t i = 0; i < n; i++) {
+		SIValue_ToBinary(stream, arr->array + i);
+	}
+}
+
 // creates an array from its binary representation
 // this is the reverse of SIArray_ToBinary
 // x = SIArray_FromBinary(SIArray_ToBinary(y));
@@ -97,6 +97,13 @@ void SIArray_ToString(SIValue list, char **buf, size_t *bufferLen, size_t *bytes
  */
 XXH64_hash_t SIArray_HashCode(SIValue siarray);
 
+// writes a binary representation of an array to stream
+void SIArray_ToBinary
+(
+	FILE *stream,       // stream to write to
+	const SIValue *arr  // array to write
+);
+
 // creates an array from its binary representation
 // this is the reverse of SIArray_ToBinary
 // x = SIArray_FromBinary(SIArray_ToBinary(y));
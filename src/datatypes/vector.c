@@ -58,6 +58,27 @@ SIValue SIVector_Clone
 	};
 }
 
+// writes a binary representation of a vector to stream
+void SIVector_ToBinary
+(
+	FILE *stream,     // stream to write to
+	const SIValue *v  // vector to write
+) {
+	// format:
+	// number of elements
+	// elements
+
+	ASSERT(stream != NULL);
+	ASSERT(SI_TYPE(*v) & T_VECTOR);
+
+	uint32_t dim = SIVector_Dim(*v);
+	fwrite_assert(&dim, sizeof(uint32_t), stream);
+
+	if(dim > 0) {
+		fwrite_assert(SIVector_Elements(*v), dim * sizeof(float), stream);
+	}
+}
+
 // creates a vector from its binary representation
 SIValue SIVector_FromBinary
 (
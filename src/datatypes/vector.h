@@ -19,6 +19,13 @@ SIValue SIVector_Clone
 	SIValue vector // vector to clone
 );
 
+// writes a binary representation of a vector to stream
+void SIVector_ToBinary
+(
+	FILE *stream,     // stream to write to
+	const SIValue *v  // vector to write
+);
+
 // creates a vector from its binary representation
 SIValue SIVector_FromBinary
 (
@@ -666,7 +666,7 @@ void EffectsBuffer_AddEntityRemoveAttributeEffect
 ) {
 	// attribute was deleted
 	int n = (attr_id == ATTRIBUTE_ID_ALL)
-		? AttributeSet_Count(*entity->attributes)
+		? AttributeSet_Count(GraphEntity_GetAttributes(entity))
 		: 1;
 
 	ResultSetStatistics *stats = QueryCtx_GetResultSetStatistics();
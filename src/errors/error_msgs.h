@@ -9,6 +9,7 @@
 #define EMSG_EMPTY_KEY "Encountered an empty key when opened key %s"
 #define EMSG_NON_GRAPH_KEY "Encountered a non-graph value type when opened key %s"
 #define EMSG_DIFFERENT_VALUE "Encountered different graph value when opened key %s"
+#define EMSG_WRITE_CONFLICT "Graph %s was modified while the query was reading it"
 #define EMSG_ACCESS_VAR "Attempted to access variable before it has been defined"
 #define EMSG_INVALID_NUMERIC "Invalid numeric value '%s'"
 #define EMSG_INTEGER_OVERFLOW "Integer overflow '%s'"
@@ -62,6 +63,10 @@
 #define EMSG_VAIABLE_ALREADY_DECLARED "Variable `%s` already declared"
 #define EMSG_PROCEDURE_INVALID_OUTPUT "Procedure `%s` does not yield output `%s`"
 #define EMSG_CALLSUBQUERY_INVALID_REFERENCES "WITH imports in CALL {} must consist of only simple references to outside variables"
+#define EMSG_CALLSUBQUERY_BATCH_SIZE "CALL {} IN TRANSACTIONS batch size must be a positive integer"
+#define EMSG_CALLSUBQUERY_IN_TRANSACTIONS_NESTED "CALL {} IN TRANSACTIONS can not be nested in a subquery"
+#define EMSG_CALLSUBQUERY_IN_TRANSACTIONS_READ_ONLY "CALL {} IN TRANSACTIONS must contain an updating clause"
+#define EMSG_CALLSUBQUERY_IN_TRANSACTIONS_BATCH_EXP "CALL {} IN TRANSACTIONS batch size must be an integer literal or a parameter"
 #define EMSG_VAIABLE_ALREADY_DECLARED_IN_OUTER_SCOPE "Variable `%s` already declared in outer scope"
 #define EMSG_DELETE_INVALID_ARGUMENTS "DELETE can only be called on nodes, paths and relationships"
 #define EMSG_SET_LHS_NON_ALIAS "RedisGraph does not currently support non-alias references on the left-hand side of SET expressions"
@@ -122,4 +127,15 @@
 #define EMSG_INDEX_FIELD_ALREADY_EXISTS "Attribute '%s' is already indexed"
 #define EMSG_VECTOR_INDEX_INVALID_CONFIG "Invalid vector index configuration"
 #define EMSG_INDEX_CANT_RECONFIG "Can not override index configuration"
+#define EMSG_HYBRID_MISSING_INDEX "Hybrid query requires a full-text index on :%s and a vector index on :%s(%s)"
 
+#define EMSG_LOAD_CSV_URI "LOAD CSV only supports file:// URIs, got '%s'"
+#define EMSG_LOAD_CSV_FILE_ACCESS "LOAD CSV: unable to access file '%s'"
+#define EMSG_LOAD_CSV_OUTSIDE_IMPORT_FOLDER "LOAD CSV: file '%s' is outside of the import folder"
+#define EMSG_LOAD_CSV_FIELD_TERMINATOR "LOAD CSV field terminator must be a single character"
+#define EMSG_LOAD_CSV_ERROR "LOAD CSV: %s"
+
+#define EMSG_HINT_BOUND_VARIABLE "Cannot apply planner hint on '%s', variable is already bound"
+#define EMSG_HINT_LABEL "Cannot apply planner hint on '%s', node is not labeled :%s within the MATCH pattern"
+#define EMSG_HINT_JOIN "Cannot apply join hint on '%s', it does not split the pattern into two parts"
+#define EMSG_HINT_MULTIPLE_START "Cannot apply both hints on '%s' and '%s' within a connected pattern, consider USING JOIN"
@@ -16,6 +16,7 @@
 #include "execution_plan_modify.h"
 #include "../ops/op_argument_list.h"
 #include "../ops/op_call_subquery.h"
+#include "../../arithmetic/arithmetic_expression_construct.h"
 
 // adds an empty projection as the child of parent, such that the records passed
 // to parent are "filtered" to contain no bound vars
@@ -285,7 +286,18 @@ void buildCallSubqueryPlan
 	// introduce a Call-Subquery op
 	//--------------------------------------------------------------------------
 
-	OpBase *call_op = NewCallSubqueryOp(plan, is_eager, is_returning);
+	// CALL {} IN TRANSACTIONS defaults to batches of 1000 records
+	AR_ExpNode *batch_size = NULL;
+	if(cypher_ast_call_subquery_is_in_transactions(clause)) {
+		const cypher_astnode_t *batch_size_exp =
+			cypher_ast_call_subquery_get_batch_size(clause);
+		batch_size = (batch_size_exp != NULL) ?
+			AR_EXP_FromASTNode(batch_size_exp) :
+			AR_EXP_NewConstOperandNode(SI_LongVal(CALLSUBQUERY_BATCH_SIZE));
+	}
+
+	OpBase *call_op = NewCallSubqueryOp(plan, is_eager, is_returning,
+			batch_size);
 	ExecutionPlan_UpdateRoot(plan, call_op);
 
 	// add the embedded plan as a child of the Call-Subquery op
@@ -15,19 +15,348 @@
 #include "../optimizations/optimizations.h"
 #include "../../ast/ast_build_filter_tree.h"
 
-static void _ExecutionPlan_ProcessQueryGraph
+// USING INDEX / USING SCAN hint
+typedef struct {
+	ScanHint type;      // hint type
+	const char *alias;  // hinted node
+	const char *label;  // hinted label
+	const char *attr;   // hinted attribute, USING INDEX only
+} NodeScanHint;
+
+// collect planner hints specified by a MATCH clause
+static void _CollectHints
+(
+	const cypher_astnode_t *clause,  // MATCH clause
+	NodeScanHint **scan_hints,       // [output] USING INDEX / SCAN hints
+	const char ***join_hints         // [output] USING JOIN nodes
+) {
+	*scan_hints = array_new(NodeScanHint, 0);
+	*join_hints = array_new(const char *, 0);
+
+	uint nhints = cypher_ast_match_nhints(clause);
+	for(uint i = 0; i < nhints; i++) {
+		const cypher_astnode_t *hint = cypher_ast_match_get_hint(clause, i);
+		cypher_astnode_type_t t = cypher_astnode_type(hint);
+
+		if(t == CYPHER_AST_USING_INDEX) {
+			NodeScanHint h = {
+				.type  = SCAN_HINT_INDEX,
+				.alias = cypher_ast_identifier_get_name(
+						cypher_ast_using_index_get_identifier(hint)),
+				.label = cypher_ast_label_get_name(
+						cypher_ast_using_index_get_label(hint)),
+				.attr  = cypher_ast_prop_name_get_value(
+						cypher_ast_using_index_get_prop_name(hint))
+			};
+			array_append(*scan_hints, h);
+		} else if(t == CYPHER_AST_USING_SCAN) {
+			NodeScanHint h = {
+				.type  = SCAN_HINT_SCAN,
+				.alias = cypher_ast_identifier_get_name(
+						cypher_ast_using_scan_get_identifier(hint)),
+				.label = cypher_ast_label_get_name(
+						cypher_ast_using_scan_get_label(hint)),
+				.attr  = NULL
+			};
+			array_append(*scan_hints, h);
+		} else {
+			ASSERT(t == CYPHER_AST_USING_JOIN);
+			uint n = cypher_ast_using_join_nidentifiers(hint);
+			for(uint j = 0; j < n; j++) {
+				const char *alias = cypher_ast_identifier_get_name(
+						cypher_ast_using_join_get_identifier(hint, j));
+				array_append(*join_hints, alias);
+			}
+		}
+	}
+}
+
+// split connected component 'cc' on node 'alias'
+// both parts retain the split node and the edges connecting it to the part
+// returns false if removing the node doesn't disconnect 'cc'
+static bool _SplitOnNode
+(
+	const QueryGraph *cc,  // connected component to split
+	const char *alias,     // node to split on
+	QueryGraph **lhs,      // [output] first part
+	QueryGraph **rhs       // [output] remaining parts
+) {
+	bool split = false;
+	QueryGraph *rest = QueryGraph_Clone(cc);
+	QGNode *n = QueryGraph_GetNodeByAlias(rest, alias);
+	QGNode_Free(QueryGraph_RemoveNode(rest, n));
+
+	if(QueryGraph_NodeCount(rest) > 0) {
+		QueryGraph **parts = QueryGraph_ConnectedComponents(rest);
+		uint part_count = array_len(parts);
+
+		if(part_count > 1) {
+			split = true;
+			*lhs = QueryGraph_Clone(cc);
+			*rhs = QueryGraph_Clone(cc);
+
+			// first part goes to the left, the rest to the right
+			uint node_count = QueryGraph_NodeCount(cc);
+			for(uint i = 0; i < node_count; i++) {
+				const char *a = cc->nodes[i]->alias;
+				if(strcmp(a, alias) == 0) continue;
+
+				bool left = QueryGraph_GetNodeByAlias(parts[0], a) != NULL;
+				QueryGraph *g = left ? *rhs : *lhs;
+				n = QueryGraph_RemoveNode(g, QueryGraph_GetNodeByAlias(g, a));
+				QGNode_Free(n);
+			}
+		}
+
+		for(uint i = 0; i < part_count; i++) QueryGraph_Free(parts[i]);
+		array_free(parts);
+	}
+
+	QueryGraph_Free(rest);
+	return split;
+}
+
+// returns the expression ID(alias)
+static AR_ExpNode *_NodeIDExp
+(
+	const char *alias
+) {
+	AR_ExpNode *exp = AR_EXP_NewOpNode("id", true, 1);
+	exp->op.children[0] = AR_EXP_NewVariableOperandNode(alias);
+	return exp;
+}
+
+static OpBase *_ExecutionPlan_BuildComponent
 (
 	ExecutionPlan *plan,
 	QueryGraph *qg,
-	AST *ast
+	QueryGraph *cc,
+	FT_FilterNode *ft,
+	rax *bound_vars,
+	NodeScanHint *scan_hints,
+	const char **join_hints
+);
+
+// resolve connected component 'cc' by joining the two parts
+// obtained by splitting 'cc' on the hinted node
+// USING JOIN ON n
+static OpBase *_ExecutionPlan_BuildJoin
+(
+	ExecutionPlan *plan,
+	QueryGraph *qg,
+	QueryGraph *cc,
+	FT_FilterNode *ft,
+	rax *bound_vars,
+	NodeScanHint *scan_hints,
+	const char **join_hints,
+	uint join_idx               // position of the applied hint in join_hints
+) {
+	QueryGraph *lhs = NULL;
+	QueryGraph *rhs = NULL;
+	const char *alias = join_hints[join_idx];
+
+	if(!_SplitOnNode(cc, alias, &lhs, &rhs)) {
+		ErrorCtx_SetError(EMSG_HINT_JOIN, alias);
+		return NULL;
+	}
+
+	// the hash join caches its left-hand stream, prefer the smaller part
+	if(QueryGraph_NodeCount(lhs) > QueryGraph_NodeCount(rhs)) {
+		QueryGraph *tmp = lhs;
+		lhs = rhs;
+		rhs = tmp;
+	}
+
+	// remaining join hints apply to the parts
+	const char **remaining;
+	array_clone(remaining, join_hints);
+	array_del(remaining, join_idx);
+
+	// both parts are planned as if the other part was never resolved
+	rax *vars = raxClone(bound_vars);
+
+	OpBase *join  = NewValueHashJoin(plan, _NodeIDExp(alias), _NodeIDExp(alias));
+	OpBase *left  = _ExecutionPlan_BuildComponent(plan, qg, lhs, ft, vars,
+			scan_hints, remaining);
+	OpBase *right = _ExecutionPlan_BuildComponent(plan, qg, rhs, ft, vars,
+			scan_hints, remaining);
+
+	if(left  != NULL) ExecutionPlan_AddOp(join, left);
+	if(right != NULL) ExecutionPlan_AddOp(join, right);
+
+	raxFree(vars);
+	array_free(remaining);
+	QueryGraph_Free(lhs);
+	QueryGraph_Free(rhs);
+
+	return join;
+}
+
+// build the chain of operations resolving connected component 'cc'
+// returns NULL if the component requires no operations
+static OpBase *_ExecutionPlan_BuildComponent
+(
+	ExecutionPlan *plan,       // plan
+	QueryGraph *qg,            // query graph
+	QueryGraph *cc,            // connected component to resolve
+	FT_FilterNode *ft,         // filter tree
+	rax *bound_vars,           // bound variables
+	NodeScanHint *scan_hints,  // USING INDEX / USING SCAN hints
+	const char **join_hints    // USING JOIN hints
 ) {
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint edge_count = array_len(cc->edges);
+	OpBase *root = NULL; // the root of the traversal chain will be added to the ExecutionPlan
+	OpBase *tail = NULL;
+
+	if(edge_count == 0) {
+		// if there are no edges in the component, we only need a node scan
+		// if no labels are introduced, and the var is bound, don't build
+		// a traversal
+		QGNode *n = cc->nodes[0];
+		if(raxFind(bound_vars, (unsigned char *)n->alias, strlen(n->alias))
+				!= raxNotFound && QGNode_LabelCount(n) == 0) {
+			return NULL;
+		}
+	}
+
+	// split component on a join hint
+	uint join_count = array_len(join_hints);
+	for(uint i = 0; i < join_count; i++) {
+		if(QueryGraph_GetNodeByAlias(cc, join_hints[i]) != NULL) {
+			return _ExecutionPlan_BuildJoin(plan, qg, cc, ft, bound_vars,
+					scan_hints, join_hints, i);
+		}
+	}
+
+	// a hinted node is the component's entry point
+	NodeScanHint *start = NULL;
+	uint scan_hint_count = array_len(scan_hints);
+	for(uint i = 0; i < scan_hint_count; i++) {
+		if(QueryGraph_GetNodeByAlias(cc, scan_hints[i].alias) == NULL) continue;
+		if(start != NULL) {
+			ErrorCtx_SetError(EMSG_HINT_MULTIPLE_START, start->alias,
+					scan_hints[i].alias);
+			return NULL;
+		}
+		start = scan_hints + i;
+	}
 
+	AlgebraicExpression **exps = AlgebraicExpression_FromQueryGraph(cc);
+	uint expCount = array_len(exps);
+
+	// Reorder exps, to the most performant arrangement of evaluation.
+	orderExpressions(qg, exps, &expCount, ft, bound_vars,
+			(start != NULL) ? start->alias : NULL);
+
+	// Create the SCAN operation that will be the tail of the traversal chain.
+	QGNode *src = QueryGraph_GetNodeByAlias(qg,
+		AlgebraicExpression_Src(exps[0]));
+
+	uint label_count = QGNode_LabelCount(src);
+	if(label_count > 0) {
+		AlgebraicExpression *ae_src =
+			AlgebraicExpression_RemoveSource(&exps[0]);
+		ASSERT(AlgebraicExpression_DiagonalOperand(ae_src, 0));
+
+		const char *label = AlgebraicExpression_Label(ae_src);
+		const char *alias = AlgebraicExpression_Src(ae_src);
+		ASSERT(label != NULL);
+		ASSERT(alias != NULL);
+
+		int label_id = GRAPH_UNKNOWN_LABEL;
+		Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+		if(s != NULL) label_id = Schema_GetID(s);
+
+		// resolve source node by performing label scan
+		NodeScanCtx *ctx = NodeScanCtx_New((char *)alias, (char *)label,
+			label_id, src);
+
+		// the hinted label is picked once the plan is optimized
+		if(start != NULL && strcmp(start->alias, alias) == 0) {
+			ctx->hint       = start->type;
+			ctx->hint_label = start->label;
+			ctx->hint_attr  = start->attr;
+		}
+
+		root = tail = NewNodeByLabelScanOp(plan, ctx);
+
+		// first operand has been converted into a label scan op
+		AlgebraicExpression_Free(ae_src);
+	} else {
+		root = tail = NewAllNodeScanOp(plan, src->alias);
+		// free expression source
+		// in-case there are additional patterns to traverse
+		if(array_len(cc->edges) == 0) {
+			AlgebraicExpression_Free(
+					AlgebraicExpression_RemoveSource(&exps[0]));
+		}
+	}
+
+	// for each expression, build the appropriate traversal operation
+	for(int j = 0; j < expCount; j++) {
+		AlgebraicExpression *exp = exps[j];
+		// Empty expression, already freed.
+		if(AlgebraicExpression_OperandCount(exp) == 0) continue;
+
+		QGEdge *edge = NULL;
+		if(AlgebraicExpression_Edge(exp)) {
+			edge =
+				QueryGraph_GetEdgeByAlias(qg, AlgebraicExpression_Edge(exp));
+		}
+
+		if(edge && (QGEdge_VariableLength(edge) || !QGEdge_SingleHop(edge))) {
+			if(QGEdge_IsShortestPath(edge)) {
+				// edge is part of a shortest-path
+				// MATCH allShortestPaths((a)-[*..]->(b))
+				// validate both edge ends are bounded
+				const char *src_alias  = QGNode_Alias(QGEdge_Src(edge));
+				const char *dest_alias = QGNode_Alias(QGEdge_Dest(edge));
+				bool src_bounded =
+					raxFind(bound_vars, (unsigned char *)src_alias,
+							strlen(src_alias)) != raxNotFound;
+				bool dest_bounded =
+					raxFind(bound_vars, (unsigned char *)dest_alias,
+							strlen(dest_alias)) != raxNotFound;
+
+				// TODO: would be great if we can perform this validation
+				// at AST validation time
+				if(!src_bounded || !dest_bounded) {
+					ErrorCtx_SetError(EMSG_ALLSHORTESTPATH_SRC_DST_RESLOVED);
+				}
+			}
+			root = NewCondVarLenTraverseOp(plan, gc->g, exp);
+		} else {
+			root = NewCondTraverseOp(plan, gc->g, exp);
+		}
+		// Insert the new traversal op at the root of the chain.
+		ExecutionPlan_AddOp(root, tail);
+		tail = root;
+	}
+
+	// Free the expressions array, as its parts have been converted into operations
+	array_free(exps);
+
+	return root;
+}
+
+static void _ExecutionPlan_ProcessQueryGraph
+(
+	ExecutionPlan *plan,
+	QueryGraph *qg,
+	AST *ast,
+	const cypher_astnode_t *clause
+) {
 	// build the full FilterTree for this AST
 	// so that we can order traversals properly
 	FT_FilterNode *ft = AST_BuildFilterTree(ast);
 	QueryGraph **connectedComponents = QueryGraph_ConnectedComponents(qg);
 
+	// collect planner hints
+	NodeScanHint *scan_hints;
+	const char **join_hints;
+	_CollectHints(clause, &scan_hints, &join_hints);
+
 	// if we have already constructed any ops
 	// the plan's record map contains all variables bound at this time
 	uint connectedComponentsCount = array_len(connectedComponents);
@@ -45,106 +374,9 @@ static void _ExecutionPlan_ProcessQueryGraph
 	// keep track after all traversal operations along a pattern
 	for(uint i = 0; i < connectedComponentsCount; i++) {
 		QueryGraph *cc = connectedComponents[i];
-		uint edge_count = array_len(cc->edges);
-		OpBase *root = NULL; // the root of the traversal chain will be added to the ExecutionPlan
-		OpBase *tail = NULL;
-
-		if(edge_count == 0) {
-			// if there are no edges in the component, we only need a node scan
-			// if no labels are introduced, and the var is bound, don't build
-			// a traversal
-			QGNode *n = cc->nodes[0];
-			if(raxFind(bound_vars, (unsigned char *)n->alias, strlen(n->alias))
-					!= raxNotFound && QGNode_LabelCount(n) == 0) {
-				continue;
-			}
-		}
-
-		AlgebraicExpression **exps = AlgebraicExpression_FromQueryGraph(cc);
-		uint expCount = array_len(exps);
-
-		// Reorder exps, to the most performant arrangement of evaluation.
-		orderExpressions(qg, exps, &expCount, ft, bound_vars);
-
-		// Create the SCAN operation that will be the tail of the traversal chain.
-		QGNode *src = QueryGraph_GetNodeByAlias(qg,
-			AlgebraicExpression_Src(exps[0]));
-
-		uint label_count = QGNode_LabelCount(src);
-		if(label_count > 0) {
-			AlgebraicExpression *ae_src =
-				AlgebraicExpression_RemoveSource(&exps[0]);
-			ASSERT(AlgebraicExpression_DiagonalOperand(ae_src, 0));
-
-			const char *label = AlgebraicExpression_Label(ae_src);
-			const char *alias = AlgebraicExpression_Src(ae_src);
-			ASSERT(label != NULL);
-			ASSERT(alias != NULL);
-
-			int label_id = GRAPH_UNKNOWN_LABEL;
-			Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
-			if(s != NULL) label_id = Schema_GetID(s);
-
-			// resolve source node by performing label scan
-			NodeScanCtx *ctx = NodeScanCtx_New((char *)alias, (char *)label,
-				label_id, src);
-			root = tail = NewNodeByLabelScanOp(plan, ctx);
-
-			// first operand has been converted into a label scan op
-			AlgebraicExpression_Free(ae_src);
-		} else {
-			root = tail = NewAllNodeScanOp(plan, src->alias);
-			// free expression source
-			// in-case there are additional patterns to traverse
-			if(array_len(cc->edges) == 0) {
-				AlgebraicExpression_Free(
-						AlgebraicExpression_RemoveSource(&exps[0]));
-			}
-		}
-
-		// for each expression, build the appropriate traversal operation
-		for(int j = 0; j < expCount; j++) {
-			AlgebraicExpression *exp = exps[j];
-			// Empty expression, already freed.
-			if(AlgebraicExpression_OperandCount(exp) == 0) continue;
-
-			QGEdge *edge = NULL;
-			if(AlgebraicExpression_Edge(exp)) {
-				edge =
-					QueryGraph_GetEdgeByAlias(qg, AlgebraicExpression_Edge(exp));
-			}
-
-			if(edge && (QGEdge_VariableLength(edge) || !QGEdge_SingleHop(edge))) {
-				if(QGEdge_IsShortestPath(edge)) {
-					// edge is part of a shortest-path
-					// MATCH allShortestPaths((a)-[*..]->(b))
-					// validate both edge ends are bounded
-					const char *src_alias  = QGNode_Alias(QGEdge_Src(edge));
-					const char *dest_alias = QGNode_Alias(QGEdge_Dest(edge));
-					bool src_bounded =
-						raxFind(bound_vars, (unsigned char *)src_alias,
-								strlen(src_alias)) != raxNotFound;
-					bool dest_bounded =
-						raxFind(bound_vars, (unsigned char *)dest_alias,
-								strlen(dest_alias)) != raxNotFound;
-
-					// TODO: would be great if we can perform this validation
-					// at AST validation time
-					if(!src_bounded || !dest_bounded) {
-						ErrorCtx_SetError(EMSG_ALLSHORTESTPATH_SRC_DST_RESLOVED);
-					}
-				}
-				root = NewCondVarLenTraverseOp(plan, gc->g, exp);
-			} else {
-				root = NewCondTraverseOp(plan, gc->g, exp);
-			}
-			// Insert the new traversal op at the root of the chain.
-			ExecutionPlan_AddOp(root, tail);
-			tail = root;
-		}
-
-		// Free the expressions array, as its parts have been converted into operations
-		array_free(exps);
+		OpBase *root = _ExecutionPlan_BuildComponent(plan, qg, cc, ft,
+				bound_vars, scan_hints, join_hints);
+		if(root == NULL) continue;
 
 		if(cartesianProduct) {
 			// We have multiple disjoint traversal chains.
@@ -160,6 +392,8 @@ static void _ExecutionPlan_ProcessQueryGraph
 		QueryGraph_Free(connectedComponents[i]);
 	}
 	array_free(connectedComponents);
+	array_free(scan_hints);
+	array_free(join_hints);
 	FilterTree_Free(ft);
 }
 
@@ -211,7 +445,7 @@ void buildMatchOpTree(ExecutionPlan *plan, AST *ast, const cypher_astnode_t *cla
 	QueryGraph *sub_qg =
 		QueryGraph_ExtractPatterns(plan->query_graph, &pattern, 1);
 
-	_ExecutionPlan_ProcessQueryGraph(plan, sub_qg, ast);
+	_ExecutionPlan_ProcessQueryGraph(plan, sub_qg, ast, clause);
 	if(ErrorCtx_EncounteredError()) goto cleanup;
 
 	// Build the FilterTree to model any WHERE predicates on these clauses and place ops appropriately.
@@ -20,13 +20,16 @@ typedef enum {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
 	OPType_NODE_BY_INDEX_SCAN,
+	OPType_NODE_BY_DISTANCE_SCAN,
 	OPType_EDGE_BY_INDEX_SCAN,
 	OPType_NODE_BY_ID_SEEK,
+	OPType_EDGE_BY_ID_SEEK,
 	OPType_NODE_BY_LABEL_AND_ID_SCAN,
 	OPType_EXPAND_INTO,
 	OPType_CONDITIONAL_TRAVERSE,
 	OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
 	OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO,
+	OPType_ORDERED_TRAVERSE,
 	OPType_RESULTS,
 	OPType_PROJECT,
 	OPType_AGGREGATE,
@@ -55,6 +58,9 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_LOAD_CSV,
+	OPType_LEAPFROG_JOIN,
+	OPType_COLUMN_AGGREGATE,
 } OPType;
 
 typedef enum {
@@ -79,13 +85,15 @@ static const OPType TRAVERSE_OPS[] = {
 	OPType_CONDITIONAL_VAR_LEN_TRAVERSE
 };
 
-#define SCAN_OP_COUNT 5
+#define SCAN_OP_COUNT 7
 static const OPType SCAN_OPS[] = {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
 	OPType_NODE_BY_INDEX_SCAN,
+	OPType_NODE_BY_DISTANCE_SCAN,
 	OPType_EDGE_BY_INDEX_SCAN,
 	OPType_NODE_BY_ID_SEEK,
+	OPType_EDGE_BY_ID_SEEK,
 	OPType_NODE_BY_LABEL_AND_ID_SCAN
 };
 
@@ -8,6 +8,7 @@
 #include "op_sort.h"
 #include "op_aggregate.h"
 #include "../../util/arr.h"
+#include "../../arithmetic/aggregate_funcs/agg_funcs.h"
 #include "../../query_ctx.h"
 #include "../../util/rmalloc.h"
 
@@ -179,10 +180,23 @@ static void _aggregateRecord
 	Group *g = _GetGroup(op, r);
 	ASSERT(g != NULL);
 
-	// aggregate group exps
-	for(uint i = 0; i < op->aggregate_count; i++) {
-		AR_ExpNode *exp = g->agg[i];
-		AR_EXP_Aggregate(exp, r);
+	if(op->factor_idx != -1) {
+		// factorized input, record represents multiple rows
+		// advance each count by the record's multiplicity
+		// the multiplicity takes the place of the counted destination
+		// which is never NULL
+		SIValue n = Record_Get(r, op->factor_idx);
+		ASSERT(SI_TYPE(n) == T_INT64 && n.longval >= 0);
+		for(uint i = 0; i < op->aggregate_count; i++) {
+			AR_ExpNode *exp = g->agg[i];
+			Aggregate_StepN(exp->op.f, exp->op.private_data, &n, 1, n.longval);
+		}
+	} else {
+		// aggregate group exps
+		for(uint i = 0; i < op->aggregate_count; i++) {
+			AR_ExpNode *exp = g->agg[i];
+			AR_EXP_Aggregate(exp, r);
+		}
 	}
 
 	OpBase_DeleteRecord(r);
@@ -231,6 +245,7 @@ OpBase *NewAggregateOp
 
 	op->groups               = HashTableCreate(&_dt);
 	op->group_iter           = NULL;
+	op->factor_idx           = -1;
 
 	OpBase_Init((OpBase *)op, OPType_AGGREGATE, "Aggregate", NULL,
 			AggregateConsume, AggregateReset, NULL, AggregateClone,
@@ -365,7 +380,23 @@ static OpBase *AggregateClone
 		array_append(exps, AR_EXP_Clone(op->aggregate_exps[i]));
 	}
 
-	return NewAggregateOp(plan, exps);
+	OpBase *clone = NewAggregateOp(plan, exps);
+	if(op->factor_idx != -1) {
+		Aggregate_SetFactorized((OpAggregate *)clone, op->factor_idx);
+	}
+
+	return clone;
+}
+
+void Aggregate_SetFactorized
+(
+	OpAggregate *op,
+	int factor_idx
+) {
+	ASSERT(op != NULL);
+	ASSERT(factor_idx >= 0);
+
+	op->factor_idx = factor_idx;
 }
 
 // bind the Aggregate operation to the execution plan
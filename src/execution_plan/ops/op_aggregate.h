@@ -21,6 +21,7 @@ typedef struct {
 	dictIterator *group_iter;     // iterator for walking all groups
 	uint key_count;               // number of key expressions
 	uint aggregate_count;         // number of aggregating expressions
+	int factor_idx;               // record index of input multiplicity, -1 if none
 } OpAggregate;
 
 OpBase *NewAggregateOp
@@ -29,6 +30,15 @@ OpBase *NewAggregateOp
 	AR_ExpNode **exps
 );
 
+// consume factorized input
+// each input record stands for as many rows as the integer held at
+// 'factor_idx', all aggregate expressions must be non-distinct counts
+void Aggregate_SetFactorized
+(
+	OpAggregate *op,  // aggregate op
+	int factor_idx    // record index holding multiplicity
+);
+
 // bind the Aggregate operation to the execution plan
 void AggregateBindToPlan
 (
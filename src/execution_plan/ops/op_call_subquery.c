@@ -6,6 +6,8 @@
 
 #include "op_join.h"
 #include "op_call_subquery.h"
+#include "../../query_ctx.h"
+#include "../../errors/errors.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
 // forward declarations
@@ -14,6 +16,7 @@ static OpResult CallSubqueryInit(OpBase *opBase);
 static OpResult CallSubqueryReset(OpBase *opBase);
 static Record CallSubqueryConsume(OpBase *opBase);
 static Record CallSubqueryConsumeEager(OpBase *opBase);
+static Record CallSubqueryConsumeBatched(OpBase *opBase);
 static OpBase *CallSubqueryClone(const ExecutionPlan *plan,
 	const OpBase *opBase);
 
@@ -65,12 +68,33 @@ static void _plant_records_Arguments
 	}
 }
 
+// evaluates the number of records to process per transaction
+static void _eval_batch_size
+(
+	OpCallSubquery *op,     // CallSubquery operation
+	AR_ExpNode *batch_size  // batch size expression
+) {
+	// keep a copy of the original expression, evaluating a parameterized
+	// batch size "OF $n ROWS" replaces the parameter with a constant
+	op->batch_size_exp = AR_EXP_Clone(batch_size);
+
+	SIValue n = AR_EXP_Evaluate(batch_size, NULL);
+	if(SI_TYPE(n) != T_INT64 || SI_GET_NUMERIC(n) <= 0) {
+		ErrorCtx_SetError(EMSG_CALLSUBQUERY_BATCH_SIZE);
+	} else {
+		op->batch_size = SI_GET_NUMERIC(n);
+	}
+
+	AR_EXP_Free(batch_size);
+}
+
 // creates a new CallSubquery operation
 OpBase *NewCallSubqueryOp
 (
 	const ExecutionPlan *plan,  // execution plan
 	bool is_eager,              // is the subquery eager or not
-	bool is_returning           // is the subquery returning or not
+	bool is_returning,          // is the subquery returning or not
+	AR_ExpNode *batch_size      // batch size, NULL if not IN TRANSACTIONS
 ) {
 	OpCallSubquery *op = rm_calloc(1, sizeof(OpCallSubquery));
 
@@ -83,6 +107,13 @@ OpBase *NewCallSubqueryOp
 		CallSubqueryConsumeEager :
 		CallSubqueryConsume;
 
+	// batches are fed to the body via ArgumentLists
+	if(batch_size != NULL) {
+		ASSERT(is_eager);
+		_eval_batch_size(op, batch_size);
+		consumeFunc = CallSubqueryConsumeBatched;
+	}
+
 	OpBase_Init((OpBase *)op, OPType_CALLSUBQUERY, "CallSubquery",
 		CallSubqueryInit, consumeFunc, CallSubqueryReset, NULL,
 		CallSubqueryClone, CallSubqueryFree, false, plan);
@@ -229,6 +260,108 @@ static Record CallSubqueryConsumeEager
 	return _handoff_eager(op);
 }
 
+// feeds the next batch of input records to the body, depletes the body and
+// commits the batch's modifications
+// the records to hand off are placed in op->records
+static void _run_batch
+(
+	OpCallSubquery *op  // CallSubquery operation
+) {
+	ASSERT(op->records == NULL || array_len(op->records) == 0);
+
+	if(op->records != NULL) {
+		array_free(op->records);
+	}
+
+	// take the next batch of input records
+	uint n = array_len(op->input) - op->input_idx;
+	if(n > op->batch_size) {
+		n = op->batch_size;
+	}
+	op->records = array_new(Record, n);
+	for(uint i = 0; i < n; i++) {
+		array_append(op->records, op->input[op->input_idx]);
+		op->input[op->input_idx++] = NULL;
+	}
+
+	_plant_records_ArgumentLists(op);
+
+	Record r;
+	int n_branches = (int)array_len(op->feeders.argumentLists);
+	if(op->is_returning) {
+		// give the last branch the original records
+		ArgumentList_AddRecordList(
+			op->feeders.argumentLists[n_branches - 1], op->records);
+
+		// collect the records produced by the batch
+		op->records = array_new(Record, n);
+		while((r = OpBase_Consume(op->body))) {
+			array_append(op->records, r);
+		}
+	} else {
+		// give the last branch a clone of the original record(s)
+		Record *records_clone;
+		array_clone_with_cb(records_clone, op->records,
+			OpBase_DeepCloneRecord);
+		ArgumentList_AddRecordList(
+			op->feeders.argumentLists[n_branches - 1], records_clone);
+
+		// deplete body and discard records
+		while((r = OpBase_Consume(op->body))) {
+			OpBase_DeleteRecord(r);
+		}
+	}
+
+	// prepare the body for the next batch
+	OpBase_PropagateReset(op->body);
+
+	// commit the batch, releasing the locks acquired by its modifications
+	QueryCtx_CommitBatch();
+}
+
+// consumes all records from the lhs, then runs the body over batches of
+// `batch_size` records, committing after each batch
+// records are handed off once their batch has been committed
+static Record CallSubqueryConsumeBatched
+(
+	OpBase *opBase  // operation
+) {
+	OpCallSubquery *op = (OpCallSubquery *)opBase;
+
+	if(op->first) {
+		op->first = false;
+
+		// lhs is consumed up front, an open lhs (e.g. an index scan) must not
+		// be held while the body modifies the graph, nor across commits
+		// which release the write lock
+		// input records remain in memory until their batch is fed
+		ASSERT(op->input == NULL);
+		op->input = array_new(Record, 1);
+		Record r;
+		if(op->lhs) {
+			while((r = OpBase_Consume(op->lhs))) {
+				array_append(op->input, r);
+			}
+			// propagate reset to lhs, to release RediSearch index locks (if any)
+			OpBase_PropagateReset(op->lhs);
+		} else {
+			r = OpBase_CreateRecord((OpBase *)op);
+			array_append(op->input, r);
+		}
+	}
+
+	// run batches until one yields records or input is depleted
+	// NOTICE: The order of records reverses within a batch
+	while(op->records == NULL || array_len(op->records) == 0) {
+		if(op->input_idx == array_len(op->input)) {
+			return NULL;
+		}
+		_run_batch(op);
+	}
+
+	return array_pop(op->records);
+}
+
 // tries to consumes a record from the body, merge it with the current input
 // record and return it. If body is depleted for this record, tries to consume
 // a record from the lhs, and repeat the process (if the lhs record is not NULL)
@@ -349,6 +482,16 @@ static void _free_records
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+
+	if(op->input != NULL) {
+		uint n_records = array_len(op->input);
+		for(uint i = op->input_idx; i < n_records; i++) {
+			OpBase_DeleteRecord(op->input[i]);
+		}
+		array_free(op->input);
+		op->input = NULL;
+		op->input_idx = 0;
+	}
 }
 
 // resets a CallSubquery operation
@@ -373,7 +516,12 @@ static OpBase *CallSubqueryClone
 	ASSERT(opBase->type == OPType_CALLSUBQUERY);
 	OpCallSubquery *op = (OpCallSubquery *) opBase;
 
-	return NewCallSubqueryOp(plan, op->is_eager, op->is_returning);
+	AR_ExpNode *batch_size = (op->batch_size_exp != NULL) ?
+		AR_EXP_Clone(op->batch_size_exp) :
+		NULL;
+
+	return NewCallSubqueryOp(plan, op->is_eager, op->is_returning,
+			batch_size);
 }
 
 // frees a CallSubquery operation
@@ -385,6 +533,11 @@ static void CallSubqueryFree
 
 	_free_records(_op);
 
+	if(_op->batch_size_exp != NULL) {
+		AR_EXP_Free(_op->batch_size_exp);
+		_op->batch_size_exp = NULL;
+	}
+
 	if(_op->feeders.type != FEEDER_NONE) {
 		if(_op->feeders.type == FEEDER_ARGUMENT) {
 			ASSERT(_op->feeders.arguments != NULL);
@@ -8,6 +8,7 @@
 
 #include "op_argument.h"
 #include "op_argument_list.h"
+#include "../../arithmetic/arithmetic_expression.h"
 
 // The Call {} operation is used to embed a subquery in the
 // execution-plan. It generally passes records from its first child (lhs), to
@@ -18,6 +19,16 @@
 // is created and passed to the body.
 // The Call {} operation is eager\non-eager according to whether its body
 // is\isn't eager (non-eager -> Arguments, eager -> ArgumentLists).
+// `CALL {} IN TRANSACTIONS` feeds the body with batches of `batch_size` input
+// records, committing the modifications of each batch before moving on
+// to the next one.
+// NOTICE: the lhs is depleted before the first batch runs, its records are
+// held in memory for the duration of the operation. an open lhs can't be
+// pulled from across commits, the graph may change once the write lock is
+// released, and the lhs must not observe entities created by earlier batches.
+
+// default number of records per transaction of CALL {} IN TRANSACTIONS
+#define CALLSUBQUERY_BATCH_SIZE 1000
 
 typedef enum {
 	FEEDER_NONE,          // non-initialized
@@ -44,6 +55,10 @@ typedef struct {
 	Record r;           // current record consumed from lhs
 	Record *records;    // records aggregated by the operation
 	Feeder feeders;     // feeders to the body (Args/ArgLists)
+	uint64_t batch_size;         // records per transaction, 0 if not batched
+	AR_ExpNode *batch_size_exp;  // batch size expression
+	Record *input;               // records consumed from lhs (batched)
+	uint input_idx;              // next input record to feed (batched)
 } OpCallSubquery;
 
 // creates a new CallSubquery operation
@@ -51,5 +66,6 @@ OpBase *NewCallSubqueryOp
 (
 	const ExecutionPlan *plan,  // execution plan
 	bool is_eager,              // if an updating clause lies in the body, eagerly consume the records
-	bool is_returning           // is the subquery returning or unit
+	bool is_returning,          // is the subquery returning or unit
+	AR_ExpNode *batch_size      // batch size, NULL if not IN TRANSACTIONS
 );
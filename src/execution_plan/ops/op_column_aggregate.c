@@ -0,0 +1,331 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_column_aggregate.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../arithmetic/aggregate_funcs/agg_funcs.h"
+#include "../../index/index.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+
+// forward declarations
+static Record ColumnAggregateConsume(OpBase *opBase);
+static OpResult ColumnAggregateReset(OpBase *opBase);
+static OpBase *ColumnAggregateClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void ColumnAggregateFree(OpBase *opBase);
+
+// aggregation functions which can be computed from a column
+static const char *_supported_funcs[] = {"count", "sum", "avg", "min", "max"};
+
+Attribute_ID ColumnAggregate_AggregatedAttribute
+(
+	const AR_ExpNode *exp,
+	const char *alias
+) {
+	ASSERT(exp   != NULL);
+	ASSERT(alias != NULL);
+
+	if(exp->type != AR_EXP_OP || !exp->op.f->aggregate) {
+		return ATTRIBUTE_ID_NONE;
+	}
+
+	if(exp->op.child_count != 1 ||
+	   AR_EXP_PerformsDistinct((AR_ExpNode *)exp)) {
+		return ATTRIBUTE_ID_NONE;
+	}
+
+	bool supported = false;
+	const char *func = AR_EXP_GetFuncName(exp);
+	for(uint i = 0; i < sizeof(_supported_funcs) / sizeof(char *); i++) {
+		supported |= strcasecmp(func, _supported_funcs[i]) == 0;
+	}
+	if(!supported) return ATTRIBUTE_ID_NONE;
+
+	// aggregated value must be an attribute of 'alias', e.g. n.v
+	char *attr;
+	AR_ExpNode *arg = exp->op.children[0];
+	if(!AR_EXP_IsAttribute(arg, &attr)) return ATTRIBUTE_ID_NONE;
+
+	AR_ExpNode *entity = arg->op.children[0];
+	if(!AR_EXP_IsVariadic(entity) ||
+	   strcmp(entity->operand.variadic.entity_alias, alias) != 0) {
+		return ATTRIBUTE_ID_NONE;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	return GraphContext_GetAttributeID(gc, attr);
+}
+
+static void ColumnAggregateToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpColumnAggregate *op = (const OpColumnAggregate *)ctx;
+	*buf = sdscatprintf(*buf, "%s | (%s:%s)", op->op.name, op->alias,
+			op->label);
+}
+
+OpBase *NewColumnAggregateOp
+(
+	const ExecutionPlan *plan,
+	const char *alias,
+	const char *label,
+	AR_ExpNode **exps
+) {
+	ASSERT(exps  != NULL);
+	ASSERT(alias != NULL);
+	ASSERT(label != NULL);
+
+	OpColumnAggregate *op = rm_calloc(1, sizeof(OpColumnAggregate));
+
+	op->exps      = exps;
+	op->aggs      = NULL;
+	op->alias     = alias;
+	op->label     = label;
+	op->depleted  = false;
+	op->exp_count = array_len(exps);
+	op->attrs     = rm_malloc(sizeof(Attribute_ID) * op->exp_count);
+
+	OpBase_Init((OpBase *)op, OPType_COLUMN_AGGREGATE, "Column Aggregate",
+			NULL, ColumnAggregateConsume, ColumnAggregateReset,
+			ColumnAggregateToString, ColumnAggregateClone, ColumnAggregateFree,
+			false, plan);
+
+	// node slot is used when aggregating entries not held by a column
+	op->node_idx = OpBase_Modifies((OpBase *)op, alias);
+
+	op->record_offsets = rm_malloc(sizeof(uint) * op->exp_count);
+	for(uint i = 0; i < op->exp_count; i++) {
+		op->attrs[i] = ColumnAggregate_AggregatedAttribute(exps[i], alias);
+		ASSERT(op->attrs[i] != ATTRIBUTE_ID_NONE);
+
+		op->record_offsets[i] = OpBase_Modifies((OpBase *)op,
+				exps[i]->resolved_name);
+	}
+
+	return (OpBase *)op;
+}
+
+// aggregates node 'id' the usual way, by evaluating 'agg' on it
+static void _AggregateNode
+(
+	OpColumnAggregate *op,  // column aggregate op
+	AR_ExpNode *agg,        // aggregate expression
+	Graph *g,               // graph
+	NodeID id,              // node to aggregate
+	Record r                // record to bind node to
+) {
+	Node n;
+	Graph_GetNode(g, id, &n);
+	Record_AddNode(r, op->node_idx, n);
+	AR_EXP_Aggregate(agg, r);
+}
+
+// aggregates a column
+// the label matrix drives the aggregation, each labeled node's entry is
+// looked up in the column, integer and floating point entries are fed
+// directly to the aggregation
+// entries are visited in node ID order, the order of a label scan
+// such that floating point sums match a scan's result
+static void _AggregateColumn
+(
+	OpColumnAggregate *op,   // column aggregate op
+	AR_ExpNode *agg,         // aggregate expression
+	const IndexColumn *col,  // aggregated column
+	Graph *g,                // graph
+	LabelID label_id,        // aggregated label
+	Record r                 // record to bind nodes to
+) {
+	AggregateCtx *ctx   = agg->op.private_data;
+	const char   *func  = AR_EXP_GetFuncName(agg);
+	bool         count  = strcasecmp(func, "count") == 0;
+	AR_Func      step   = agg->op.f->func;
+	uint64_t     n      = 0;  // number of entries holding a value
+
+	NodeID id;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, Graph_GetLabelMatrix(g, label_id));
+
+	while(RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		ColumnValue cv;
+		ColumnEntryType t = IndexColumn_Get(col, id, &cv);
+		if(t == COL_NONE) continue;
+
+		// count every entry holding a value
+		if(count) {
+			n++;
+			continue;
+		}
+
+		// booleans and other types are aggregated from the node
+		if(t != COL_INT && t != COL_DOUBLE) {
+			_AggregateNode(op, agg, g, id, r);
+			continue;
+		}
+
+		// sum, avg, min and max, invoke aggregation function per value
+		SIValue v = (t == COL_INT) ? SI_LongVal(cv.i) : SI_DoubleVal(cv.d);
+		step(&v, 1, ctx);
+	}
+
+	// counted entries are never NULL, count them all at once
+	if(count) {
+		SIValue v = SI_BoolVal(true);
+		Aggregate_StepN(agg->op.f, ctx, &v, 1, n);
+	}
+
+	RG_MatrixTupleIter_detach(&it);
+}
+
+// aggregates every expression by scanning the label
+static void _AggregateScan
+(
+	OpColumnAggregate *op,  // column aggregate op
+	Graph *g,               // graph
+	LabelID label_id,       // aggregated label
+	Record r                // record to bind nodes to
+) {
+	NodeID id;
+	RG_MatrixTupleIter it = {0};
+	RG_MatrixTupleIter_attach(&it, Graph_GetLabelMatrix(g, label_id));
+
+	while(RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		Node n;
+		Graph_GetNode(g, id, &n);
+		Record_AddNode(r, op->node_idx, n);
+		for(uint i = 0; i < op->exp_count; i++) {
+			AR_EXP_Aggregate(op->aggs[i], r);
+		}
+	}
+
+	RG_MatrixTupleIter_detach(&it);
+}
+
+static void _FreeAggregations
+(
+	OpColumnAggregate *op
+) {
+	if(op->aggs == NULL) return;
+
+	for(uint i = 0; i < op->exp_count; i++) {
+		AR_EXP_Free(op->aggs[i]);
+	}
+	array_free(op->aggs);
+	op->aggs = NULL;
+}
+
+static Record ColumnAggregateConsume
+(
+	OpBase *opBase
+) {
+	OpColumnAggregate *op = (OpColumnAggregate *)opBase;
+
+	// aggregation without grouping keys emits a single record
+	if(op->depleted) return NULL;
+	op->depleted = true;
+
+	// fresh aggregation state
+	_FreeAggregations(op);
+	op->aggs = array_new(AR_ExpNode *, op->exp_count);
+	for(uint i = 0; i < op->exp_count; i++) {
+		array_append(op->aggs, AR_EXP_Clone(op->exps[i]));
+	}
+
+	Record r = OpBase_CreateRecord(opBase);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, op->label, SCHEMA_NODE);
+
+	// label doesn't exists, aggregate nothing
+	if(s != NULL) {
+		// make sure all columns are available
+		const IndexColumn *cols[op->exp_count];
+		Index idx = ACTIVE_IDX(s);
+		bool available = (idx != NULL && Index_Enabled(idx));
+		for(uint i = 0; i < op->exp_count && available; i++) {
+			cols[i] = Index_GetColumn(idx, op->attrs[i]);
+			available = (cols[i] != NULL);
+		}
+
+		if(available) {
+			for(uint i = 0; i < op->exp_count; i++) {
+				_AggregateColumn(op, op->aggs[i], cols[i], gc->g,
+						Schema_GetID(s), r);
+			}
+		} else {
+			// index dropped since the plan was built, or columns are
+			// disabled, scan label
+			_AggregateScan(op, gc->g, Schema_GetID(s), r);
+		}
+	}
+
+	// the aggregated node isn't visible above this op
+	Record_Remove(r, op->node_idx);
+
+	for(uint i = 0; i < op->exp_count; i++) {
+		SIValue v = AR_EXP_FinalizeAggregations(op->aggs[i], r);
+		Record_AddScalar(r, op->record_offsets[i], v);
+	}
+
+	return r;
+}
+
+static OpResult ColumnAggregateReset
+(
+	OpBase *opBase
+) {
+	OpColumnAggregate *op = (OpColumnAggregate *)opBase;
+
+	_FreeAggregations(op);
+	op->depleted = false;
+
+	return OP_OK;
+}
+
+static OpBase *ColumnAggregateClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_COLUMN_AGGREGATE);
+	const OpColumnAggregate *op = (const OpColumnAggregate *)opBase;
+
+	AR_ExpNode **exps = array_new(AR_ExpNode *, op->exp_count);
+	for(uint i = 0; i < op->exp_count; i++) {
+		array_append(exps, AR_EXP_Clone(op->exps[i]));
+	}
+
+	return NewColumnAggregateOp(plan, op->alias, op->label, exps);
+}
+
+static void ColumnAggregateFree
+(
+	OpBase *opBase
+) {
+	OpColumnAggregate *op = (OpColumnAggregate *)opBase;
+
+	_FreeAggregations(op);
+
+	if(op->exps != NULL) {
+		for(uint i = 0; i < op->exp_count; i++) {
+			AR_EXP_Free(op->exps[i]);
+		}
+		array_free(op->exps);
+		op->exps = NULL;
+	}
+
+	if(op->attrs != NULL) {
+		rm_free(op->attrs);
+		op->attrs = NULL;
+	}
+
+	if(op->record_offsets != NULL) {
+		rm_free(op->record_offsets);
+		op->record_offsets = NULL;
+	}
+}
+
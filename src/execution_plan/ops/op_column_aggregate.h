@@ -0,0 +1,53 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../arithmetic/arithmetic_expression.h"
+
+// aggregates attributes of a label's nodes without fetching the nodes
+//
+// MATCH (n:L) RETURN sum(n.v), max(n.w)
+//
+// the label matrix is iterated and each aggregated attribute is read from
+// the column the range index over the attribute maintains, integer and
+// floating point entries are fed to the aggregation directly, nodes holding
+// values of other types are fetched and aggregated as usual
+// if a column isn't available at execution time the label is scanned
+// and its nodes are fetched instead
+typedef struct {
+	OpBase op;
+	const char *alias;       // aggregated node alias
+	const char *label;       // aggregated node label
+	int node_idx;            // record index of the aggregated node
+	AR_ExpNode **exps;       // aggregate expressions, e.g. sum(n.v)
+	AR_ExpNode **aggs;       // aggregate expressions of current execution
+	Attribute_ID *attrs;     // aggregated attribute of each expression
+	uint *record_offsets;    // record index of each expression
+	uint exp_count;          // number of aggregate expressions
+	bool depleted;           // aggregation result was emitted
+} OpColumnAggregate;
+
+// returns the ID of the attribute of 'alias' 'exp' aggregates
+// ATTRIBUTE_ID_NONE if 'exp' isn't a non-distinct count, sum, avg, min or max
+// over a single attribute of 'alias'
+Attribute_ID ColumnAggregate_AggregatedAttribute
+(
+	const AR_ExpNode *exp,  // aggregate expression
+	const char *alias       // aggregated node alias
+);
+
+// creates a new column aggregate operation
+// the operation takes ownership of 'exps'
+OpBase *NewColumnAggregateOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	const char *alias,          // aggregated node alias
+	const char *label,          // aggregated node label
+	AR_ExpNode **exps           // supported aggregate expressions, array
+);
+
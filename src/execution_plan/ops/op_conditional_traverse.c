@@ -21,7 +21,10 @@ static OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase
 static void CondTraverseFree(OpBase *opBase);
 
 static void CondTraverseToString(const OpBase *ctx, sds *buf) {
-	TraversalToString(ctx, buf, ((const OpCondTraverse *)ctx)->ae);
+	const OpCondTraverse *op = (const OpCondTraverse *)ctx;
+	TraversalToString(ctx, buf, op->ae);
+	if(op->factorized) *buf = sdscatprintf(*buf, " (factorized)");
+	if(op->dest_filter != NULL) *buf = sdscatprintf(*buf, " (index mask)");
 }
 
 static void _populate_filter_matrix(OpCondTraverse *op) {
@@ -40,6 +43,35 @@ static void _populate_filter_matrix(OpCondTraverse *op) {
 	}
 }
 
+// populate destination mask D
+// D[i, i] = true for each node i returned by the destination index query
+static void _populate_destination_mask(OpCondTraverse *op) {
+	GrB_Matrix DM = RG_MATRIX_M(op->D);
+
+	// clear destination mask
+	GrB_Matrix_clear(DM);
+
+	// filters which can't be converted are still applied by the filter ops
+	// following this traversal
+	FT_FilterNode *unresolved = NULL;
+	RSIndex *rsIdx = Index_RSIndex(op->dest_idx);
+	RSQNode *rs_query_node = Index_BuildQueryTree(&unresolved, op->dest_idx,
+			op->dest_filter);
+	ASSERT(rs_query_node != NULL);
+
+	const EntityID *id = NULL;
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+			rsIdx);
+	while((id = RediSearch_ResultsIteratorNext(iter, rsIdx, NULL)) != NULL) {
+		GrB_Matrix_setElement_BOOL(DM, true, *id, *id);
+	}
+
+	RediSearch_ResultsIteratorFree(iter);
+	if(unresolved != NULL) FilterTree_Free(unresolved);
+
+	op->stale_mask = false;
+}
+
 // evaluate algebraic expression:
 // prepends filter matrix as the left most operand
 // perform multiplications
@@ -57,6 +89,13 @@ void _traverse(OpCondTraverse *op) {
 		// prepend filter matrix to algebraic expression as the leftmost operand
 		AlgebraicExpression_MultiplyToTheLeft(&op->ae, op->F);
 
+		// append destination mask as the rightmost operand
+		if(op->dest_filter != NULL) {
+			RG_Matrix_new(&op->D, GrB_BOOL, required_dim, required_dim);
+			AlgebraicExpression_MultiplyToTheRight(&op->ae, op->D);
+			op->stale_mask = true;
+		}
+
 		// optimize the expression tree
 		AlgebraicExpression_Optimize(&op->ae);
 	}
@@ -64,6 +103,9 @@ void _traverse(OpCondTraverse *op) {
 	// populate filter matrix
 	_populate_filter_matrix(op);
 
+	// compute destination mask once per execution
+	if(op->stale_mask) _populate_destination_mask(op);
+
 	// evaluate expression
 	AlgebraicExpression_Eval(op->ae, op->M);
 
@@ -108,6 +150,29 @@ OpBase *NewCondTraverseOp
 	return (OpBase *)op;
 }
 
+void CondTraverseOp_Factorize(OpCondTraverse *op) {
+	ASSERT(op != NULL);
+	ASSERT(op->edge_ctx == NULL);
+
+	op->factorized = true;
+}
+
+void CondTraverseOp_SetDestinationMask
+(
+	OpCondTraverse *op,
+	Index idx,
+	FT_FilterNode *filter
+) {
+	ASSERT(op              != NULL);
+	ASSERT(idx             != NULL);
+	ASSERT(filter          != NULL);
+	ASSERT(op->F           == NULL);
+	ASSERT(op->dest_filter == NULL);
+
+	op->dest_idx    = idx;
+	op->dest_filter = filter;
+}
+
 static OpResult CondTraverseInit(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
 
@@ -119,16 +184,84 @@ static OpResult CondTraverseInit(OpBase *opBase) {
 	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
 
 	op->records = rm_calloc(op->record_cap, sizeof(Record));
+	if(op->factorized) {
+		op->neighbor_count = rm_calloc(op->record_cap, sizeof(uint64_t));
+	}
 
 	return OP_OK;
 }
 
+// free held records and ask child operation for a new batch
+// returns number of records fetched
+static uint64_t _fetchRecords(OpCondTraverse *op) {
+	OpBase *child = op->op.children[0];
+
+	for(uint i = 0; i < op->record_count; i++) {
+		OpBase_DeleteRecord(op->records[i]);
+	}
+
+	// Ask child operations for data.
+	for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
+		Record childRecord = OpBase_Consume(child);
+		// If the Record is NULL, the child has been depleted.
+		if(childRecord == NULL) {
+			break;
+		}
+		if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
+			/* The child Record may not contain the source node in scenarios like
+			 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+			OpBase_DeleteRecord(childRecord);
+			op->record_count--;
+			continue;
+		}
+
+		// Store received record.
+		Record_PersistScalars(childRecord);
+		op->records[op->record_count] = childRecord;
+	}
+
+	return op->record_count;
+}
+
+// factorized consume
+// emits each held record once, with the number of destinations reachable
+// from its source node in place of the destination node
+// records without any destination are skipped
+static Record _FactorizedConsume(OpCondTraverse *op) {
+	while(true) {
+		while(op->current < op->record_count) {
+			uint64_t i = op->current++;
+			uint64_t n = op->neighbor_count[i];
+			if(n == 0) continue;
+
+			Record r = OpBase_DeepCloneRecord(op->records[i]);
+			Record_AddScalar(r, op->destNodeIdx, SI_LongVal(n));
+			return r;
+		}
+
+		// No data.
+		if(_fetchRecords(op) == 0) return NULL;
+
+		_traverse(op);
+
+		// count entries in each row of the result matrix
+		// rows aren't necessarily visited in order
+		NodeID src_id = INVALID_ENTITY_ID;
+		memset(op->neighbor_count, 0, sizeof(uint64_t) * op->record_count);
+		while(RG_MatrixTupleIter_next_UINT64(&op->iter, &src_id, NULL, NULL)
+				== GrB_SUCCESS) {
+			op->neighbor_count[src_id]++;
+		}
+		op->current = 0;
+	}
+}
+
 /* Each call to CondTraverseConsume emits a Record containing the
  * traversal's endpoints and, if required, an edge.
  * Returns NULL once all traversals have been performed. */
 static Record CondTraverseConsume(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
-	OpBase *child = op->op.children[0];
+	if(op->factorized) return _FactorizedConsume(op);
 
 	/* If we're required to update an edge and have one queued, we can return early.
 	 * Otherwise, try to get a new pair of source and destination nodes. */
@@ -150,32 +283,9 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		/* Run out of tuples, try to get new data.
 		 * Free old records. */
 		op->r = NULL;
-		for(uint i = 0; i < op->record_count; i++) {
-			OpBase_DeleteRecord(op->records[i]);
-		}
-
-		// Ask child operations for data.
-		for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
-			Record childRecord = OpBase_Consume(child);
-			// If the Record is NULL, the child has been depleted.
-			if(childRecord == NULL) {
-				break;
-			}
-			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
-				/* The child Record may not contain the source node in scenarios like
-				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
-				OpBase_DeleteRecord(childRecord);
-				op->record_count--;
-				continue;
-			}
-
-			// Store received record.
-			Record_PersistScalars(childRecord);
-			op->records[op->record_count] = childRecord;
-		}
 
 		// No data.
-		if(op->record_count == 0) return NULL;
+		if(_fetchRecords(op) == 0) return NULL;
 
 		_traverse(op);
 	}
@@ -206,6 +316,7 @@ static OpResult CondTraverseReset(OpBase *ctx) {
 	op->r = NULL;
 	for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
 	op->record_count = 0;
+	op->current = 0;
 
 	if(op->edge_ctx) EdgeTraverseCtx_Reset(op->edge_ctx);
 
@@ -213,13 +324,24 @@ static OpResult CondTraverseReset(OpBase *ctx) {
 	ASSERT(info == GrB_SUCCESS);
 
 	if(op->F != NULL) RG_Matrix_clear(op->F);
+
+	// destination index might have changed since the mask was computed
+	if(op->D != NULL) op->stale_mask = true;
+
 	return OP_OK;
 }
 
 static inline OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_CONDITIONAL_TRAVERSE);
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
-	return NewCondTraverseOp(plan, QueryCtx_GetGraph(), AlgebraicExpression_Clone(op->ae));
+	OpBase *clone = NewCondTraverseOp(plan, QueryCtx_GetGraph(),
+			AlgebraicExpression_Clone(op->ae));
+	if(op->factorized) CondTraverseOp_Factorize((OpCondTraverse *)clone);
+	if(op->dest_filter != NULL) {
+		CondTraverseOp_SetDestinationMask((OpCondTraverse *)clone, op->dest_idx,
+				FilterTree_Clone(op->dest_filter));
+	}
+	return clone;
 }
 
 /* Frees CondTraverse */
@@ -239,6 +361,16 @@ static void CondTraverseFree(OpBase *ctx) {
 		op->M = NULL;
 	}
 
+	if(op->D != NULL) {
+		RG_Matrix_free(&op->D);
+		op->D = NULL;
+	}
+
+	if(op->dest_filter != NULL) {
+		FilterTree_Free(op->dest_filter);
+		op->dest_filter = NULL;
+	}
+
 	if(op->ae) {
 		AlgebraicExpression_Free(op->ae);
 		op->ae = NULL;
@@ -256,5 +388,10 @@ static void CondTraverseFree(OpBase *ctx) {
 		rm_free(op->records);
 		op->records = NULL;
 	}
+
+	if(op->neighbor_count) {
+		rm_free(op->neighbor_count);
+		op->neighbor_count = NULL;
+	}
 }
 
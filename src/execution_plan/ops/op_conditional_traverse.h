@@ -10,6 +10,7 @@
 #include "../execution_plan.h"
 #include "shared/traverse_functions.h"
 #include "../../graph/rg_matrix/rg_matrix_iter.h"
+#include "../../index/index.h"
 #include "../../arithmetic/algebraic_expression.h"
 #include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
 
@@ -28,8 +29,34 @@ typedef struct {
 	uint64_t record_cap;        // Max number of records to process.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
+	bool factorized;            // Emit neighbor counts instead of neighbors.
+	uint64_t *neighbor_count;   // Number of neighbors per held record.
+	uint64_t current;           // Next held record to emit when factorized.
+	Index dest_idx;             // Index resolving destination filter.
+	FT_FilterNode *dest_filter; // Indexed filter on destination node.
+	RG_Matrix D;                // Diagonal mask of passing destinations.
+	bool stale_mask;            // Destination mask should be recomputed.
 } OpCondTraverse;
 
 /* Creates a new Traverse operation */
 OpBase *NewCondTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpression *ae);
 
+// switch traversal to factorized mode
+// instead of emitting a record per (source, destination) pair, a single
+// record is emitted per source node, the destination slot holds the number
+// of reachable destinations rather than a node
+// only valid when the consumer is a count aggregation over the destination
+void CondTraverseOp_Factorize(OpCondTraverse *op);
+
+// restrict traversal destinations to nodes passing 'filter'
+// the filter is resolved by 'idx' into a diagonal mask multiplied into the
+// traversal expression, such that failing destinations are never produced
+// the filter must only refer to the destination node
+// the operation takes ownership of 'filter'
+void CondTraverseOp_SetDestinationMask
+(
+	OpCondTraverse *op,     // traversal
+	Index idx,              // index over destination label
+	FT_FilterNode *filter   // filter on destination node
+);
+
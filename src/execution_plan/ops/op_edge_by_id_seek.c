@@ -0,0 +1,197 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_edge_by_id_seek.h"
+#include "RG.h"
+#include "../../query_ctx.h"
+
+// forward declarations
+static OpResult EdgeByIdSeekInit(OpBase *opBase);
+static Record EdgeByIdSeekConsume(OpBase *opBase);
+static OpResult EdgeByIdSeekReset(OpBase *opBase);
+static OpBase *EdgeByIdSeekClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void EdgeByIdSeekFree(OpBase *opBase);
+
+static void EdgeByIdSeekToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	EdgeByIdSeek *op = (EdgeByIdSeek *)ctx;
+
+	// Edge By Id Seek | [e:R]
+	*buf = sdscatprintf(*buf, "%s | ", ctx->name);
+	QGEdge_ToString(op->edge, buf);
+}
+
+OpBase *NewEdgeByIdSeekOp
+(
+	const ExecutionPlan *plan,
+	QGEdge *e,
+	UnsignedRange *id_range
+) {
+	ASSERT(e        != NULL);
+	ASSERT(plan     != NULL);
+	ASSERT(id_range != NULL);
+
+	EdgeByIdSeek *op = rm_malloc(sizeof(EdgeByIdSeek));
+	op->g         = QueryCtx_GetGraph();
+	op->edge      = e;
+	op->relations = NULL;
+	op->minId     = id_range->include_min ? id_range->min : id_range->min + 1;
+	op->maxId     = id_range->include_max ? id_range->max : id_range->max - 1;
+
+	// exclusive bounds which can't be adjusted, the range is empty
+	if((!id_range->include_min && id_range->min == UINT64_MAX) ||
+	   (!id_range->include_max && id_range->max == 0)) {
+		op->minId = 1;
+		op->maxId = 0;
+	}
+
+	// range is clamped to the largest possible edge ID on init
+	// such that clones are independent of the current graph size
+	op->endId     = 0;
+	op->currentId = op->minId;
+
+	OpBase_Init((OpBase *)op, OPType_EDGE_BY_ID_SEEK, "Edge By Id Seek",
+			EdgeByIdSeekInit, EdgeByIdSeekConsume, EdgeByIdSeekReset,
+			EdgeByIdSeekToString, EdgeByIdSeekClone, EdgeByIdSeekFree, false,
+			plan);
+
+	op->edgeRecIdx = OpBase_Modifies((OpBase *)op, QGEdge_Alias(e));
+	op->srcRecIdx  = OpBase_Modifies((OpBase *)op, QGNode_Alias(QGEdge_Src(e)));
+	op->destRecIdx = OpBase_Modifies((OpBase *)op, QGNode_Alias(QGEdge_Dest(e)));
+
+	return (OpBase *)op;
+}
+
+static OpResult EdgeByIdSeekInit
+(
+	OpBase *opBase
+) {
+	EdgeByIdSeek *op = (EdgeByIdSeek *)opBase;
+
+	// the largest possible edge ID is the number of edges
+	// deleted and real in the DataBlock
+	uint64_t edge_count = Graph_EdgeCount(op->g) + Graph_DeletedEdgeCount(op->g);
+	op->endId     = (op->maxId < edge_count) ? op->maxId + 1 : edge_count;
+	op->currentId = op->minId;
+
+	// resolve accepted relation types
+	uint reltype_count = QGEdge_RelationCount(op->edge);
+	if(reltype_count > 0 && op->relations == NULL) {
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		op->relations = array_new(RelationID, reltype_count);
+
+		for(uint i = 0; i < reltype_count; i++) {
+			int rel_id = op->edge->reltypeIDs[i];
+			if(rel_id != GRAPH_UNKNOWN_RELATION) {
+				array_append(op->relations, rel_id);
+			} else {
+				const char *rel_type = op->edge->reltypes[i];
+				Schema *s = GraphContext_GetSchema(gc, rel_type, SCHEMA_EDGE);
+				if(s) array_append(op->relations, s->id);
+			}
+		}
+	}
+
+	return OP_OK;
+}
+
+// returns true if edge's relation type is accepted
+static inline bool _AcceptedRelation
+(
+	const EdgeByIdSeek *op,
+	RelationID r
+) {
+	if(op->relations == NULL) return true;
+
+	uint n = array_len(op->relations);
+	for(uint i = 0; i < n; i++) {
+		if(op->relations[i] == r) return true;
+	}
+
+	return false;
+}
+
+static Record EdgeByIdSeekConsume
+(
+	OpBase *opBase
+) {
+	EdgeByIdSeek *op = (EdgeByIdSeek *)opBase;
+
+	Edge e = GE_NEW_LABELED_EDGE(NULL, GRAPH_NO_RELATION);
+
+	// as long as we're within range bounds and we've yet to get an edge
+	bool found = false;
+	while(!found && op->currentId < op->endId) {
+		found = Graph_GetEdge(op->g, op->currentId, &e) &&
+			_AcceptedRelation(op, Edge_GetRelationID(&e));
+		op->currentId++;
+	}
+
+	if(!found) return NULL;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	e.relationship = GraphContext_GetEdgeRelationType(gc, &e);
+
+	Node src  = GE_NEW_NODE();
+	Node dest = GE_NEW_NODE();
+
+	int res;
+	UNUSED(res);
+	res = Graph_GetNode(op->g, Edge_GetSrcNodeID(&e), &src);
+	ASSERT(res != 0);
+	res = Graph_GetNode(op->g, Edge_GetDestNodeID(&e), &dest);
+	ASSERT(res != 0);
+
+	// populate the record with the edge and its endpoints
+	Record r = OpBase_CreateRecord(opBase);
+	Record_AddNode(r, op->srcRecIdx, src);
+	Record_AddNode(r, op->destRecIdx, dest);
+	Record_AddEdge(r, op->edgeRecIdx, e);
+
+	return r;
+}
+
+static OpResult EdgeByIdSeekReset
+(
+	OpBase *opBase
+) {
+	EdgeByIdSeek *op = (EdgeByIdSeek *)opBase;
+	op->currentId = op->minId;
+	return OP_OK;
+}
+
+static OpBase *EdgeByIdSeekClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_EDGE_BY_ID_SEEK);
+	EdgeByIdSeek *op = (EdgeByIdSeek *)opBase;
+
+	// inclusive range, reproducing the original's bounds
+	UnsignedRange range;
+	range.min         = op->minId;
+	range.max         = op->maxId;
+	range.include_min = true;
+	range.include_max = true;
+
+	QGEdge *e = QueryGraph_GetEdgeByAlias(plan->query_graph,
+			QGEdge_Alias(op->edge));
+	return NewEdgeByIdSeekOp(plan, e, &range);
+}
+
+static void EdgeByIdSeekFree
+(
+	OpBase *opBase
+) {
+	EdgeByIdSeek *op = (EdgeByIdSeek *)opBase;
+	if(op->relations != NULL) {
+		array_free(op->relations);
+		op->relations = NULL;
+	}
+}
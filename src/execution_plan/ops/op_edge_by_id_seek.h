@@ -0,0 +1,35 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../util/range/unsigned_range.h"
+
+// edge by ID seek locates edges by their ID
+// resolving both the edge and its endpoints
+typedef struct {
+	OpBase op;
+	Graph *g;                // graph
+	QGEdge *edge;            // edge sought
+	RelationID *relations;   // accepted relation types, NULL if any
+	int edgeRecIdx;          // record index of edge
+	int srcRecIdx;           // record index of source node
+	int destRecIdx;          // record index of destination node
+	EdgeID currentId;        // current ID fetched
+	EdgeID minId;            // min ID to fetch
+	EdgeID maxId;            // max ID to fetch
+	EdgeID endId;            // fetch IDs below, maxId clamped on init
+} EdgeByIdSeek;
+
+// creates a new EdgeByIdSeek operation
+OpBase *NewEdgeByIdSeekOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	QGEdge *e,                  // edge sought
+	UnsignedRange *id_range     // edge IDs range
+);
@@ -13,6 +13,7 @@
 static OpResult EdgeIndexScanInit(OpBase *opBase);
 static Record EdgeIndexScanConsume(OpBase *opBase);
 static Record EdgeIndexScanConsumeFromChild(OpBase *opBase);
+static Record EdgeIndexScanConsumeBatchFromChild(OpBase *opBase);
 static OpResult EdgeIndexScanReset(OpBase *opBase);
 static void EdgeIndexScanFree(OpBase *opBase);
 
@@ -53,6 +54,7 @@ OpBase *NewEdgeIndexScanOp
 	op->idx                  =  idx;
 	op->edge                 =  e;
 	op->iter                 =  NULL;
+	op->batch                =  NULL;
 	op->filter               =  filter;
 	op->child_record         =  NULL;
 	op->current_src_node_id  =  NULL;
@@ -79,6 +81,46 @@ OpBase *NewEdgeIndexScanOp
 	return (OpBase *)op;
 }
 
+// creates a batch resolving multiple input records with a single query
+// returns NULL if the index query isn't batchable
+static IndexLookupBatch *_BatchLookups
+(
+	OpEdgeIndexScan *op
+) {
+	const char *alias = QGEdge_Alias(op->edge);
+
+	// looking up both endpoints
+	if(op->srcAware && op->destAware) return NULL;
+
+	// determine if filter refers only to the scanned edge
+	rax *entities = FilterTree_CollectModified(op->filter);
+	bool shared = raxSize(entities) == 1;
+	raxFree(entities);
+
+	if(op->srcAware || op->destAware) {
+		if(!shared) return NULL;
+
+		// look up edges by their resolved endpoint's ID
+		const char *node_alias = op->srcAware ?
+			QGNode_Alias(QGEdge_Src(op->edge)) :
+			QGNode_Alias(QGEdge_Dest(op->edge));
+
+		AR_ExpNode *key = AR_EXP_NewOpNode("id", false, 1);
+		key->op.children[0] = AR_EXP_NewVariableOperandNode(node_alias);
+
+		AR_ExpNode *attr = AR_EXP_NewAttributeAccessNode(
+				AR_EXP_NewVariableOperandNode(alias),
+				op->srcAware ? "_src_id" : "_dest_id");
+
+		return IndexLookupBatch_New(key, attr, FilterTree_Clone(op->filter), 3);
+	}
+
+	// filter doesn't depend on input records, a single query is used
+	if(shared) return NULL;
+
+	return IndexLookupBatch_FromFilter(op->filter, alias, 3);
+}
+
 static OpResult EdgeIndexScanInit
 (
 	OpBase *opBase
@@ -105,6 +147,9 @@ static OpResult EdgeIndexScanInit
 	}
 
 	if(opBase->childCount > 0) {
+		// per record queries looking up a value by equality are batched
+		if(op->batch == NULL) op->batch = _BatchLookups(op);
+
 		const char *alias =  QGEdge_Alias(op->edge);
 		if(op->srcAware) {
 			op->current_src_node_id  = AR_EXP_NewConstOperandNode(SI_NullVal());
@@ -140,7 +185,11 @@ static OpResult EdgeIndexScanInit
 			raxFree(entities);
 		}
 
-		OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromChild);
+		if(op->batch != NULL) {
+			OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeBatchFromChild);
+		} else {
+			OpBase_UpdateConsume(opBase, EdgeIndexScanConsumeFromChild);
+		}
 	}
 
 	return OP_OK;
@@ -205,6 +254,168 @@ static void UpdateCurrentAwareIds(const OpEdgeIndexScan *op) {
 	}
 }
 
+// builds an index query for the current child record
+static void _RebuildIndexQuery
+(
+	OpEdgeIndexScan *op
+) {
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+
+	// free previous iterator
+	if(op->iter != NULL) {
+		RediSearch_ResultsIteratorFree(op->iter);
+		op->iter = NULL;
+	}
+
+	// free previous unresolved filters
+	if(op->unresolved_filters != NULL) {
+		FilterTree_Free(op->unresolved_filters);
+		op->unresolved_filters = NULL;
+	}
+
+	UpdateCurrentAwareIds(op);
+
+	// rebuild index query, probably relies on runtime values
+	// resolve runtime variables within filter
+	FT_FilterNode *filter = FilterTree_Clone(op->filter);
+	FilterTree_ResolveVariables(filter, op->child_record);
+
+	// make sure there's only one unresolve entity in filter
+	#ifdef RG_DEBUG
+	{
+		rax *entities = FilterTree_CollectModified(filter);
+		ASSERT(raxSize(entities) == 1);
+		raxFree(entities);
+	}
+	#endif
+
+	// convert filter into a RediSearch query
+	RSQNode *rs_query_node = Index_BuildQueryTree(&op->unresolved_filters,
+			op->idx, filter);
+	FilterTree_Free(filter);
+
+	// create iterator
+	ASSERT(rs_query_node != NULL);
+	op->iter = RediSearch_GetResultsIterator(rs_query_node, rsIdx);
+}
+
+// resolves all records of the current batch with a single index query
+static void _ResolveBatch
+(
+	OpEdgeIndexScan *op
+) {
+	IndexLookupBatch *batch = op->batch;
+
+	// edges are routed either by an endpoint or by an attribute
+	bool by_src  = strcmp(batch->attr_name, "_src_id") == 0;
+	bool by_dest = strcmp(batch->attr_name, "_dest_id") == 0;
+
+	Attribute_ID attr_id = ATTRIBUTE_ID_NONE;
+	if(!by_src && !by_dest) {
+		// no edge holds the looked up attribute
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		attr_id = GraphContext_GetAttributeID(gc, batch->attr_name);
+		if(attr_id == ATTRIBUTE_ID_NONE) return;
+	}
+
+	RSQNode *rs_query_node = IndexLookupBatch_BuildQuery(batch, op->idx);
+	if(rs_query_node == NULL) return;
+
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+			rsIdx);
+
+	// route each matching edge to the records looking up its value
+	const EdgeIndexKey *edgeKey = NULL;
+	while((edgeKey = RediSearch_ResultsIteratorNext(iter, rsIdx, NULL))
+			!= NULL) {
+		EntityID match[3] = {edgeKey->src_id, edgeKey->dest_id,
+			edgeKey->edge_id};
+
+		if(by_src) {
+			IndexLookupBatch_Route(batch, SI_LongVal(edgeKey->src_id), match);
+		} else if(by_dest) {
+			IndexLookupBatch_Route(batch, SI_LongVal(edgeKey->dest_id), match);
+		} else {
+			Edge e = GE_NEW_LABELED_EDGE(op->edge->reltypes[0],
+					op->edge->reltypeIDs[0]);
+			int res = Graph_GetEdge(op->g, edgeKey->edge_id, &e);
+			UNUSED(res);
+			ASSERT(res != 0);
+
+			SIValue *v = GraphEntity_GetProperty((GraphEntity *)&e, attr_id);
+			if(v != ATTRIBUTE_NOTFOUND) IndexLookupBatch_Route(batch, *v, match);
+		}
+	}
+
+	// release index read lock as soon as possible
+	RediSearch_ResultsIteratorFree(iter);
+}
+
+static Record EdgeIndexScanConsumeBatchFromChild
+(
+	OpBase *opBase
+) {
+	OpEdgeIndexScan *op = (OpEdgeIndexScan *)opBase;
+	IndexLookupBatch *batch = op->batch;
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+	const EdgeIndexKey *edgeKey = NULL;
+	const EntityID *match = NULL;
+
+	while(true) {
+		//----------------------------------------------------------------------
+		// emit current record's matches
+		//----------------------------------------------------------------------
+
+		if(op->child_record != NULL) {
+			if(op->iter != NULL) {
+				// record resolved by its own lookup
+				while((edgeKey = RediSearch_ResultsIteratorNext(op->iter, rsIdx,
+								NULL)) != NULL) {
+					_UpdateRecord(op, op->child_record, edgeKey);
+					if(_PassUnresolvedFilters(op, op->child_record)) {
+						return OpBase_CloneRecord(op->child_record);
+					}
+				}
+			} else {
+				while((match = IndexLookupBatch_NextMatch(batch)) != NULL) {
+					EdgeIndexKey key = {.src_id = match[0],
+						.dest_id = match[1], .edge_id = match[2]};
+					_UpdateRecord(op, op->child_record, &key);
+					if(batch->unresolved == NULL ||
+					   FilterTree_applyFilters(batch->unresolved,
+						   op->child_record) == FILTER_PASS) {
+						return OpBase_CloneRecord(op->child_record);
+					}
+				}
+			}
+
+			OpBase_DeleteRecord(op->child_record);
+			op->child_record = NULL;
+		}
+
+		if(op->iter != NULL) {
+			RediSearch_ResultsIteratorFree(op->iter);
+			op->iter = NULL;
+		}
+
+		//----------------------------------------------------------------------
+		// advance to the next record, pull a new batch if needed
+		//----------------------------------------------------------------------
+
+		bool separate;
+		op->child_record = IndexLookupBatch_NextRecord(batch, &separate);
+		if(op->child_record == NULL) {
+			if(!IndexLookupBatch_Fill(batch, op->op.children[0])) return NULL;
+			_ResolveBatch(op);
+			continue;
+		}
+
+		// value can't be batched, e.g. an array
+		if(separate) _RebuildIndexQuery(op);
+	}
+}
+
 static Record EdgeIndexScanConsumeFromChild
 (
 	OpBase *opBase
@@ -253,42 +464,7 @@ pull_index:
 	//--------------------------------------------------------------------------
 
 	if(op->rebuild_index_query) {
-		// free previous iterator
-		if(op->iter != NULL) {
-			RediSearch_ResultsIteratorFree(op->iter);
-			op->iter = NULL;
-		}
-
-		// free previous unresolved filters
-		if(op->unresolved_filters != NULL) {
-			FilterTree_Free(op->unresolved_filters);
-			op->unresolved_filters = NULL;
-		}
-
-		UpdateCurrentAwareIds(op);
-
-		// rebuild index query, probably relies on runtime values
-		// resolve runtime variables within filter
-		FT_FilterNode *filter = FilterTree_Clone(op->filter);
-		FilterTree_ResolveVariables(filter, op->child_record);
-
-		// make sure there's only one unresolve entity in filter
-		#ifdef RG_DEBUG
-		{
-			rax *entities = FilterTree_CollectModified(filter);
-			ASSERT(raxSize(entities) == 1);
-			raxFree(entities);
-		}
-		#endif
-
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = Index_BuildQueryTree(&op->unresolved_filters,
-				op->idx, filter);
-		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, rsIdx);
+		_RebuildIndexQuery(op);
 	} else {
 		// build index query only once (first call)
 		// reset it if already initialized
@@ -347,6 +523,8 @@ static Record EdgeIndexScanConsume
 static OpResult EdgeIndexScanReset(OpBase *opBase) {
 	OpEdgeIndexScan *op = (OpEdgeIndexScan *)opBase;
 
+	if(op->batch != NULL) IndexLookupBatch_Reset(op->batch);
+
 	if(op->iter) {
 		RediSearch_ResultsIteratorFree(op->iter);
 		op->iter = NULL;
@@ -376,6 +554,11 @@ static void EdgeIndexScanFree(OpBase *opBase) {
 		op->child_record = NULL;
 	}
 
+	if(op->batch != NULL) {
+		IndexLookupBatch_Free(op->batch);
+		op->batch = NULL;
+	}
+
 	if(op->filter) {
 		FilterTree_Free(op->filter);
 		op->filter = NULL;
@@ -10,6 +10,7 @@
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../index/index.h"
+#include "shared/index_lookup_batch.h"
 
 typedef struct {
 	OpBase op;
@@ -28,6 +29,7 @@ typedef struct {
 	AR_ExpNode *current_dest_node_id;   // current destination node id
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // input record in case op ins't a tap
+	IndexLookupBatch *batch;            // batched lookups, NULL if not batched
 } OpEdgeIndexScan;
 
 // creates a new OpEdgeIndexScan operation
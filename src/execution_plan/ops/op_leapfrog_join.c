@@ -0,0 +1,459 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_leapfrog_join.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+
+#include <stdlib.h>
+
+// forward declarations
+static OpResult LeapfrogJoinInit(OpBase *opBase);
+static Record LeapfrogJoinConsume(OpBase *opBase);
+static OpResult LeapfrogJoinReset(OpBase *opBase);
+static OpBase *LeapfrogJoinClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void LeapfrogJoinFree(OpBase *opBase);
+
+// collects the operands of 'ae' binding 'alias'
+// returns false if the expression isn't supported
+static bool _CollectOperands
+(
+	const AlgebraicExpression *ae,      // expression to inspect
+	const char *alias,                  // joined node alias
+	const AlgebraicExpression **rel,    // [output] relationship operand
+	const char ***labels                // [output, optional] alias labels
+) {
+	if(ae->type == AL_OPERATION) {
+		// multiple relationship types and variable length traversals
+		// can't be described by a single adjacency list
+		if(ae->operation.op != AL_EXP_MUL &&
+		   ae->operation.op != AL_EXP_TRANSPOSE) {
+			return false;
+		}
+
+		uint n = AlgebraicExpression_ChildCount(ae);
+		for(uint i = 0; i < n; i++) {
+			if(!_CollectOperands(ae->operation.children[i], alias, rel,
+						labels)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	if(ae->operand.diagonal) {
+		// only the joined node labels are supported
+		// labels of bound nodes were already applied
+		if(ae->operand.label == NULL ||
+		   strcmp(ae->operand.src, alias) != 0) {
+			return false;
+		}
+		if(labels != NULL) array_append(*labels, ae->operand.label);
+		return true;
+	}
+
+	// a single relationship which isn't referenced, connecting the joined
+	// node to a different node
+	if(*rel != NULL || ae->operand.edge != NULL) return false;
+
+	bool src  = strcmp(ae->operand.src,  alias) == 0;
+	bool dest = strcmp(ae->operand.dest, alias) == 0;
+	if(src == dest) return false;
+
+	*rel = ae;
+	return true;
+}
+
+bool LeapfrogJoin_SupportedExpression
+(
+	const AlgebraicExpression *ae,
+	const char *alias
+) {
+	ASSERT(ae    != NULL);
+	ASSERT(alias != NULL);
+
+	const AlgebraicExpression *rel = NULL;
+	return _CollectOperands(ae, alias, &rel, NULL) && rel != NULL;
+}
+
+static void LeapfrogJoinToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpLeapfrogJoin *op = (const OpLeapfrogJoin *)ctx;
+
+	*buf = sdscatprintf(*buf, "%s | ", op->op.name);
+	for(uint i = 0; i < op->relation_count; i++) {
+		const LeapfrogRelation *rel = op->relations + i;
+		if(i > 0) *buf = sdscat(*buf, ", ");
+
+		// print relationships in their original direction
+		const char *src  = rel->transposed ? op->alias : rel->alias;
+		const char *dest = rel->transposed ? rel->alias : op->alias;
+		if(rel->relation != NULL) {
+			*buf = sdscatprintf(*buf, "(%s)-[:%s]->(%s)", src, rel->relation,
+					dest);
+		} else {
+			*buf = sdscatprintf(*buf, "(%s)->(%s)", src, dest);
+		}
+	}
+}
+
+OpBase *NewLeapfrogJoinOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	const char *alias,
+	AlgebraicExpression **exps
+) {
+	ASSERT(g     != NULL);
+	ASSERT(exps  != NULL);
+	ASSERT(alias != NULL);
+
+	OpLeapfrogJoin *op = rm_calloc(1, sizeof(OpLeapfrogJoin));
+
+	op->r              = NULL;
+	op->exps           = exps;
+	op->graph          = g;
+	op->alias          = alias;
+	op->labels         = array_new(const char *, 0);
+	op->relation_count = array_len(exps);
+	op->relations      = rm_calloc(op->relation_count, sizeof(LeapfrogRelation));
+
+	OpBase_Init((OpBase *)op, OPType_LEAPFROG_JOIN, "Leapfrog Join",
+			LeapfrogJoinInit, LeapfrogJoinConsume, LeapfrogJoinReset,
+			LeapfrogJoinToString, LeapfrogJoinClone, LeapfrogJoinFree, false,
+			plan);
+
+	for(uint i = 0; i < op->relation_count; i++) {
+		const AlgebraicExpression *operand = NULL;
+		bool supported = _CollectOperands(exps[i], alias, &operand,
+				&op->labels);
+		UNUSED(supported);
+		ASSERT(supported && operand != NULL);
+
+		// R[src, dest] connects src to dest
+		// when the joined node is the relationship source its candidates are
+		// the bound node's row in the transposed matrix
+		LeapfrogRelation *rel = op->relations + i;
+		rel->transposed = strcmp(operand->operand.src, alias) == 0;
+		rel->alias      = rel->transposed ? operand->operand.dest :
+			operand->operand.src;
+		rel->relation   = operand->operand.label;
+		rel->cached     = INVALID_ENTITY_ID;
+		rel->neighbors  = array_new(NodeID, 0);
+
+		bool aware = OpBase_Aware((OpBase *)op, rel->alias, &rel->node_idx);
+		UNUSED(aware);
+		ASSERT(aware == true);
+	}
+
+	op->node_idx = OpBase_Modifies((OpBase *)op, alias);
+
+	return (OpBase *)op;
+}
+
+static OpResult LeapfrogJoinInit
+(
+	OpBase *opBase
+) {
+	OpLeapfrogJoin *op = (OpLeapfrogJoin *)opBase;
+	GraphContext   *gc = QueryCtx_GetGraphCtx();
+
+	// resolve relationship matrices
+	for(uint i = 0; i < op->relation_count; i++) {
+		LeapfrogRelation *rel = op->relations + i;
+		RelationID r = GRAPH_NO_RELATION;
+
+		if(rel->relation != NULL) {
+			Schema *s = GraphContext_GetSchema(gc, rel->relation, SCHEMA_EDGE);
+			if(s == NULL) {
+				// relationship doesn't exist, nothing to join
+				op->empty = true;
+				return OP_OK;
+			}
+			r = Schema_GetID(s);
+		}
+
+		rel->M = Graph_GetRelationMatrix(op->graph, r, rel->transposed);
+		RG_MatrixTupleIter_attach(&rel->it, rel->M);
+	}
+
+	// resolve labels
+	uint label_count = array_len(op->labels);
+	op->label_ids = rm_malloc(sizeof(LabelID) * label_count);
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchema(gc, op->labels[i], SCHEMA_NODE);
+		if(s == NULL) {
+			// label doesn't exist, nothing to join
+			op->empty = true;
+			return OP_OK;
+		}
+		op->label_ids[i] = Schema_GetID(s);
+	}
+
+	return OP_OK;
+}
+
+static int _CompareNodeID
+(
+	const void *a,
+	const void *b
+) {
+	NodeID x = *(const NodeID *)a;
+	NodeID y = *(const NodeID *)b;
+	return (x > y) - (x < y);
+}
+
+// load the neighbors of the bound node into rel->neighbors
+// the previous load is reused as records sharing a bound node
+// usually arrive consecutively
+static void _LoadNeighbors
+(
+	LeapfrogRelation *rel,  // relationship
+	NodeID id               // bound node ID
+) {
+	rel->pos = 0;
+	if(rel->cached == id) return;
+
+	rel->cached = id;
+	array_clear(rel->neighbors);
+
+	NodeID   col;
+	bool     sorted = true;
+	RG_MatrixTupleIter_iterate_row(&rel->it, id);
+	while(RG_MatrixTupleIter_next_BOOL(&rel->it, NULL, &col, NULL) ==
+			GrB_SUCCESS) {
+		uint n = array_len(rel->neighbors);
+		if(n > 0 && rel->neighbors[n - 1] > col) sorted = false;
+		array_append(rel->neighbors, col);
+	}
+
+	// pending additions are scanned after the main matrix
+	if(!sorted) {
+		qsort(rel->neighbors, array_len(rel->neighbors), sizeof(NodeID),
+				_CompareNodeID);
+	}
+}
+
+// advance cursor to the first neighbor >= id
+// gallops before binary searching, cursors usually move forward by little
+static void _Seek
+(
+	LeapfrogRelation *rel,  // relationship
+	NodeID id               // lower bound
+) {
+	uint64_t  n    = array_len(rel->neighbors);
+	uint64_t  lo   = rel->pos;
+	uint64_t  step = 1;
+
+	if(lo >= n || rel->neighbors[lo] >= id) return;
+
+	// gallop, neighbors[lo] < id
+	uint64_t hi = lo + step;
+	while(hi < n && rel->neighbors[hi] < id) {
+		lo    =  hi;
+		step  <<= 1;
+		hi    =  lo + step;
+	}
+	if(hi > n) hi = n;
+
+	// binary search (lo, hi]
+	while(lo + 1 < hi) {
+		uint64_t mid = lo + (hi - lo) / 2;
+		if(rel->neighbors[mid] < id) lo = mid;
+		else hi = mid;
+	}
+
+	rel->pos = hi;
+}
+
+// produce the next node common to all adjacency lists
+// returns false once the lists are depleted
+static bool _Leapfrog
+(
+	OpLeapfrogJoin *op,  // operation
+	NodeID *id           // [output] joined node ID
+) {
+	while(true) {
+		// the largest cursor value is the lower bound for all cursors
+		NodeID max = 0;
+		for(uint i = 0; i < op->relation_count; i++) {
+			LeapfrogRelation *rel = op->relations + i;
+			if(rel->pos >= array_len(rel->neighbors)) return false;
+			NodeID v = rel->neighbors[rel->pos];
+			if(v > max) max = v;
+		}
+
+		bool match = true;
+		for(uint i = 0; i < op->relation_count; i++) {
+			LeapfrogRelation *rel = op->relations + i;
+			_Seek(rel, max);
+			if(rel->pos >= array_len(rel->neighbors)) return false;
+			if(rel->neighbors[rel->pos] != max) match = false;
+		}
+
+		if(match) {
+			for(uint i = 0; i < op->relation_count; i++) {
+				op->relations[i].pos++;
+			}
+			*id = max;
+			return true;
+		}
+	}
+}
+
+// returns true if the joined node carries all required labels
+static bool _Labeled
+(
+	OpLeapfrogJoin *op,
+	NodeID id
+) {
+	uint label_count = array_len(op->labels);
+	for(uint i = 0; i < label_count; i++) {
+		if(!Graph_IsNodeLabeled(op->graph, id, op->label_ids[i])) return false;
+	}
+	return true;
+}
+
+// prepares the adjacency lists of the child record's bound nodes
+// returns false if a bound node is missing
+static bool _Prepare
+(
+	OpLeapfrogJoin *op,
+	Record r
+) {
+	for(uint i = 0; i < op->relation_count; i++) {
+		LeapfrogRelation *rel = op->relations + i;
+		// the child record may not contain a bound node in scenarios like
+		// a failed OPTIONAL MATCH
+		Node *n = Record_GetNode(r, rel->node_idx);
+		if(n == NULL) return false;
+		_LoadNeighbors(rel, ENTITY_GET_ID(n));
+	}
+	return true;
+}
+
+static Record LeapfrogJoinConsume
+(
+	OpBase *opBase
+) {
+	OpLeapfrogJoin *op = (OpLeapfrogJoin *)opBase;
+	OpBase *child = op->op.children[0];
+
+	if(op->empty) return NULL;
+
+	NodeID id;
+	while(true) {
+		if(op->r != NULL) {
+			while(_Leapfrog(op, &id)) {
+				if(!_Labeled(op, id)) continue;
+
+				// populate the joined node and add it to the record
+				Node n = GE_NEW_NODE();
+				Graph_GetNode(op->graph, id, &n);
+				Record_AddNode(op->r, op->node_idx, n);
+
+				return OpBase_DeepCloneRecord(op->r);
+			}
+
+			// current record depleted
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+		}
+
+		op->r = OpBase_Consume(child);
+		if(op->r == NULL) return NULL;
+
+		if(!_Prepare(op, op->r)) {
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+			continue;
+		}
+
+		Record_PersistScalars(op->r);
+	}
+}
+
+static OpResult LeapfrogJoinReset
+(
+	OpBase *ctx
+) {
+	OpLeapfrogJoin *op = (OpLeapfrogJoin *)ctx;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	// graph might change between executions, drop cached adjacency lists
+	for(uint i = 0; i < op->relation_count; i++) {
+		op->relations[i].cached = INVALID_ENTITY_ID;
+		array_clear(op->relations[i].neighbors);
+	}
+
+	return OP_OK;
+}
+
+static OpBase *LeapfrogJoinClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_LEAPFROG_JOIN);
+	const OpLeapfrogJoin *op = (const OpLeapfrogJoin *)opBase;
+
+	AlgebraicExpression **exps = array_new(AlgebraicExpression *,
+			op->relation_count);
+	for(uint i = 0; i < op->relation_count; i++) {
+		array_append(exps, AlgebraicExpression_Clone(op->exps[i]));
+	}
+
+	return NewLeapfrogJoinOp(plan, QueryCtx_GetGraph(), op->alias, exps);
+}
+
+static void LeapfrogJoinFree
+(
+	OpBase *ctx
+) {
+	OpLeapfrogJoin *op = (OpLeapfrogJoin *)ctx;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	if(op->relations != NULL) {
+		for(uint i = 0; i < op->relation_count; i++) {
+			LeapfrogRelation *rel = op->relations + i;
+			RG_MatrixTupleIter_detach(&rel->it);
+			array_free(rel->neighbors);
+		}
+		rm_free(op->relations);
+		op->relations = NULL;
+	}
+
+	if(op->exps != NULL) {
+		for(uint i = 0; i < op->relation_count; i++) {
+			AlgebraicExpression_Free(op->exps[i]);
+		}
+		array_free(op->exps);
+		op->exps = NULL;
+	}
+
+	if(op->labels != NULL) {
+		array_free(op->labels);
+		op->labels = NULL;
+	}
+
+	if(op->label_ids != NULL) {
+		rm_free(op->label_ids);
+		op->label_ids = NULL;
+	}
+}
+
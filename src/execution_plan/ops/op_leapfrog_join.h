@@ -0,0 +1,67 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+#include "../../arithmetic/algebraic_expression.h"
+
+// relationship connecting the joined node to an already bound node
+typedef struct {
+	const char *alias;       // bound node alias
+	const char *relation;    // relationship type, NULL for any type
+	bool transposed;         // joined node is the relationship source
+	int node_idx;            // bound node record index
+	RG_Matrix M;             // matrix whose bound node row is scanned
+	RG_MatrixTupleIter it;   // iterator over M
+	NodeID cached;           // node whose neighbors are held
+	NodeID *neighbors;       // sorted neighbors of the cached node
+	uint64_t pos;            // leapfrog cursor into neighbors
+} LeapfrogRelation;
+
+// worst-case optimal join
+// binds a node which closes a cycle with multiple already bound nodes
+// e.g. (a)-[:R]->(b)-[:R]->(c)-[:R]->(a) once 'a' and 'b' are bound,
+// candidates for 'c' are the intersection of b's outgoing neighbors and
+// a's incoming neighbors, computed by leapfrogging over the sorted
+// adjacency lists instead of materializing every 2-path
+typedef struct {
+	OpBase op;
+	Graph *graph;
+	const char *alias;             // joined node alias
+	int node_idx;                  // joined node record index
+	AlgebraicExpression **exps;    // joined traversal expressions
+	LeapfrogRelation *relations;   // relationship per expression
+	uint relation_count;           // number of relationships
+	const char **labels;           // joined node labels
+	LabelID *label_ids;            // joined node label IDs
+	bool empty;                    // a relationship or label doesn't exist
+	Record r;                      // current child record
+} OpLeapfrogJoin;
+
+// returns true if traversal expression 'ae' can take part in a leapfrog
+// join binding 'alias', the expression must consist of a single
+// relationship connecting 'alias' to another node and optionally labels
+// of 'alias'
+bool LeapfrogJoin_SupportedExpression
+(
+	const AlgebraicExpression *ae,  // traversal expression
+	const char *alias               // joined node alias
+);
+
+// creates a new leapfrog join operation binding 'alias'
+// the operation takes ownership of 'exps'
+OpBase *NewLeapfrogJoinOp
+(
+	const ExecutionPlan *plan,   // execution plan
+	Graph *g,                    // graph
+	const char *alias,           // joined node alias
+	AlgebraicExpression **exps   // supported traversal expressions, array
+);
+
@@ -0,0 +1,242 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_load_csv.h"
+#include "../../query_ctx.h"
+#include "../../errors/errors.h"
+#include "../../configuration/config.h"
+
+#include <limits.h>
+
+#define FILE_URI_PREFIX "file://"
+
+// forward declarations
+static void LoadCSVFree(OpBase *opBase);
+static Record LoadCSVConsume(OpBase *opBase);
+static OpResult LoadCSVReset(OpBase *opBase);
+static OpBase *LoadCSVClone(const ExecutionPlan *plan, const OpBase *opBase);
+
+OpBase *NewLoadCSVOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	AR_ExpNode *exp,            // CSV URI expression
+	const char *alias,          // CSV row alias
+	bool with_headers,          // first row holds column names
+	char delimiter              // field delimiter
+) {
+	ASSERT(exp   != NULL);
+	ASSERT(alias != NULL);
+
+	OpLoadCSV *op = rm_calloc(1, sizeof(OpLoadCSV));
+
+	op->exp          = exp;
+	op->alias        = alias;
+	op->with_headers = with_headers;
+	op->delimiter    = delimiter;
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_LOAD_CSV, "Load CSV", NULL,
+			LoadCSVConsume, LoadCSVReset, NULL, LoadCSVClone, LoadCSVFree,
+			false, plan);
+
+	op->recIdx = OpBase_Modifies((OpBase *)op, alias);
+	return (OpBase *)op;
+}
+
+// resolve a file:// URI against the import folder
+// returns NULL and sets an error if the URI is invalid or if it refers to a
+// file outside of the import folder, otherwise returns a resolved path
+// caller should free
+static char *_ResolveURI
+(
+	const char *uri  // URI to resolve
+) {
+	size_t prefix_len = strlen(FILE_URI_PREFIX);
+	if(strncasecmp(uri, FILE_URI_PREFIX, prefix_len) != 0) {
+		ErrorCtx_SetError(EMSG_LOAD_CSV_URI, uri);
+		return NULL;
+	}
+
+	const char *import_folder;
+	Config_Option_get(Config_IMPORT_FOLDER, &import_folder);
+
+	char *folder = realpath(import_folder, NULL);
+	if(folder == NULL) {
+		ErrorCtx_SetError(EMSG_LOAD_CSV_FILE_ACCESS, uri);
+		return NULL;
+	}
+
+	// file path is relative to the import folder
+	char joined[PATH_MAX];
+	int n = snprintf(joined, PATH_MAX, "%s/%s", folder, uri + prefix_len);
+	char *path = (n > 0 && n < PATH_MAX) ? realpath(joined, NULL) : NULL;
+	if(path == NULL) {
+		free(folder);
+		ErrorCtx_SetError(EMSG_LOAD_CSV_FILE_ACCESS, uri);
+		return NULL;
+	}
+
+	// make sure resolved path is contained within the import folder
+	size_t folder_len = strlen(folder);
+	bool contained = strncmp(path, folder, folder_len) == 0 &&
+		(path[folder_len] == '/' || folder[folder_len - 1] == '/');
+	free(folder);
+
+	if(!contained) {
+		free(path);
+		ErrorCtx_SetError(EMSG_LOAD_CSV_OUTSIDE_IMPORT_FOLDER, uri);
+		return NULL;
+	}
+
+	return path;
+}
+
+// evaluate URI expression and open a CSV reader over the current record
+// returns false if the reader could not be opened
+static bool _OpenReader
+(
+	OpLoadCSV *op
+) {
+	ASSERT(op->reader == NULL);
+
+	SIValue uri = AR_EXP_Evaluate(op->exp, op->child_record);
+	if(SI_TYPE(uri) != T_STRING) {
+		ErrorCtx_SetError(EMSG_TYPE_MISMATCH, "String",
+				SIType_ToString(SI_TYPE(uri)));
+		SIValue_Free(uri);
+		return false;
+	}
+
+	char *path = _ResolveURI(uri.stringval);
+	SIValue_Free(uri);
+	if(path == NULL) return false;
+
+	char *err = NULL;
+	op->reader = CSVReader_New(path, op->with_headers, op->delimiter, &err);
+	free(path);
+
+	if(op->reader == NULL) {
+		ErrorCtx_SetError(EMSG_LOAD_CSV_ERROR, err);
+		free(err);
+		return false;
+	}
+
+	return true;
+}
+
+// pull the next record to expand
+// returns false when there are no more records
+static bool _NextChildRecord
+(
+	OpLoadCSV *op
+) {
+	// no child operation, URI is evaluated once
+	if(op->op.childCount == 0) {
+		if(op->depleted) return false;
+		op->depleted = true;
+		op->child_record = OpBase_CreateRecord((OpBase *)op);
+		return true;
+	}
+
+	Record r = OpBase_Consume(op->op.children[0]);
+	if(r == NULL) return false;
+
+	if(op->child_record != NULL) OpBase_DeleteRecord(op->child_record);
+	op->child_record = r;
+
+	return true;
+}
+
+static Record LoadCSVConsume
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	while(true) {
+		if(op->reader != NULL) {
+			SIValue row;
+			if(CSVReader_GetRow(op->reader, &row)) {
+				Record r = OpBase_CloneRecord(op->child_record);
+				Record_AddScalar(r, op->recIdx, row);
+				return r;
+			}
+
+			// reader is either depleted or failed
+			const char *err = CSVReader_Error(op->reader);
+			if(err != NULL) {
+				ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_ERROR, err);
+				return NULL;
+			}
+
+			CSVReader_Free(op->reader);
+			op->reader = NULL;
+		}
+
+		if(!_NextChildRecord(op)) return NULL;
+
+		if(!_OpenReader(op)) {
+			ErrorCtx_RaiseRuntimeException(NULL);
+			return NULL;
+		}
+	}
+}
+
+static OpResult LoadCSVReset
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	if(op->reader != NULL) {
+		CSVReader_Free(op->reader);
+		op->reader = NULL;
+	}
+
+	if(op->child_record != NULL) {
+		OpBase_DeleteRecord(op->child_record);
+		op->child_record = NULL;
+	}
+
+	op->depleted = false;
+
+	return OP_OK;
+}
+
+static OpBase *LoadCSVClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_LOAD_CSV);
+
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+	return NewLoadCSVOp(plan, AR_EXP_Clone(op->exp), op->alias,
+			op->with_headers, op->delimiter);
+}
+
+static void LoadCSVFree
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	if(op->reader != NULL) {
+		CSVReader_Free(op->reader);
+		op->reader = NULL;
+	}
+
+	if(op->child_record != NULL) {
+		OpBase_DeleteRecord(op->child_record);
+		op->child_record = NULL;
+	}
+
+	if(op->exp != NULL) {
+		AR_EXP_Free(op->exp);
+		op->exp = NULL;
+	}
+}
+
@@ -0,0 +1,37 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../csv_reader/csv_reader.h"
+#include "../../arithmetic/arithmetic_expression.h"
+
+// OP Load CSV
+// streams rows out of a CSV file located within the import folder
+typedef struct {
+	OpBase op;
+	AR_ExpNode *exp;      // expression evaluated to the CSV URI
+	const char *alias;    // CSV row alias
+	int recIdx;           // record index populated with the CSV row
+	bool with_headers;    // first row holds column names
+	char delimiter;       // field delimiter
+	bool depleted;        // no child, URI was already evaluated
+	CSVReader reader;     // CSV reader
+	Record child_record;  // record to clone and add a row to
+} OpLoadCSV;
+
+// creates a new Load CSV operation
+OpBase *NewLoadCSVOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	AR_ExpNode *exp,            // CSV URI expression
+	const char *alias,          // CSV row alias
+	bool with_headers,          // first row holds column names
+	char delimiter              // field delimiter
+);
+
@@ -0,0 +1,270 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_node_by_distance_scan.h"
+#include "RG.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "shared/print_functions.h"
+#include "../../arithmetic/point_funcs/point_funcs.h"
+#include <math.h>
+
+// the index search radius is slightly larger than the distance nodes
+// are collected up to, covering geo index precision errors
+#define RADIUS_MARGIN 0.9
+
+// a radius covering the entire globe
+#define GLOBE_RADIUS (2 * M_PI * EARTH_RADIUS)
+
+// forward declarations
+static OpResult NodeByDistanceScanInit(OpBase *opBase);
+static Record NodeByDistanceScanConsume(OpBase *opBase);
+static OpResult NodeByDistanceScanReset(OpBase *opBase);
+static void NodeByDistanceScanFree(OpBase *opBase);
+
+static void NodeByDistanceScanToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	NodeByDistanceScan *op = (NodeByDistanceScan *)ctx;
+	ScanToString(ctx, buf, op->n->alias, op->n->label);
+}
+
+OpBase *NewNodeByDistanceScanOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	NodeScanCtx *n,
+	Index idx,
+	const char *attr,
+	SIValue origin,
+	uint64_t k
+) {
+	ASSERT(g    != NULL);
+	ASSERT(n    != NULL);
+	ASSERT(k    > 0);
+	ASSERT(idx  != NULL);
+	ASSERT(attr != NULL);
+	ASSERT(plan != NULL);
+	ASSERT(SI_TYPE(origin) == T_POINT);
+
+	NodeByDistanceScan *op = rm_calloc(1, sizeof(NodeByDistanceScan));
+	op->g       = g;
+	op->n       = n;
+	op->k       = k;
+	op->idx     = idx;
+	op->attr    = rm_strdup(attr);
+	op->origin  = origin;
+	op->attr_id = ATTRIBUTE_ID_NONE;
+
+	OpBase_Init((OpBase *)op, OPType_NODE_BY_DISTANCE_SCAN,
+			"Node By Distance Scan", NodeByDistanceScanInit,
+			NodeByDistanceScanConsume, NodeByDistanceScanReset,
+			NodeByDistanceScanToString, NULL, NodeByDistanceScanFree, false,
+			plan);
+
+	op->nodeRecIdx = OpBase_Modifies((OpBase *)op, n->alias);
+	return (OpBase *)op;
+}
+
+static OpResult NodeByDistanceScanInit
+(
+	OpBase *opBase
+) {
+	NodeByDistanceScan *op = (NodeByDistanceScan *)opBase;
+
+	ASSERT(op->n->label_id != GRAPH_UNKNOWN_LABEL);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	op->attr_id = GraphContext_GetAttributeID(gc, op->attr);
+
+	// start with the radius expected to hold k nodes
+	// assuming nodes are spread evenly across the globe
+	// the radius is doubled until k nodes are collected
+	uint64_t node_count = Graph_LabeledNodeCount(op->g, op->n->label_id);
+	double ratio = (node_count == 0) ? 1 : (double)op->k / node_count;
+	op->radius = MAX(1, 2 * EARTH_RADIUS * sqrt(MIN(1, ratio)));
+	op->inner  = -1;
+
+	return OP_OK;
+}
+
+// compare nodes by increasing distance
+static int _distance_cmp
+(
+	const void *a,
+	const void *b
+) {
+	double da = ((const NodeDistance *)a)->distance;
+	double db = ((const NodeDistance *)b)->distance;
+	return (da > db) - (da < db);
+}
+
+// distance of node from origin, -1 if node doesn't hold a point
+static double _NodeDistance
+(
+	NodeByDistanceScan *op,
+	Node *n
+) {
+	SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, op->attr_id);
+	if(v == ATTRIBUTE_NOTFOUND || SI_TYPE(*v) != T_POINT) return -1;
+
+	SIValue argv[2] = {*v, op->origin};
+	return AR_DISTANCE(argv, 2, NULL).doubleval;
+}
+
+// collects nodes within the next ring around origin
+// ordered by increasing distance
+static void _CollectRing
+(
+	NodeByDistanceScan *op
+) {
+	// search the entire globe once the radius covers it
+	op->globe_searched = op->radius >= GLOBE_RADIUS;
+	double radius = op->globe_searched ? GLOBE_RADIUS : op->radius;
+	double outer  = op->globe_searched ? INFINITY : radius * RADIUS_MARGIN;
+
+	if(op->ring == NULL) {
+		op->ring = array_new(NodeDistance, op->k);
+	}
+	array_clear(op->ring);
+	op->ring_idx = 0;
+
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+	RSQNode *root  = Index_BuildGeoQueryTree(op->idx, op->attr, op->origin,
+			radius);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(root, rsIdx);
+	ASSERT(iter != NULL);
+
+	// collect nodes between the previous ring and the current one
+	const EntityID *id;
+	while((id = RediSearch_ResultsIteratorNext(iter, rsIdx, NULL)) != NULL) {
+		Node n = GE_NEW_NODE();
+		bool res = Graph_GetNode(op->g, *id, &n);
+		ASSERT(res == true);
+
+		double d = _NodeDistance(op, &n);
+		if(d <= op->inner || d > outer) continue;
+
+		NodeDistance nd = {.id = *id, .distance = d};
+		array_append(op->ring, nd);
+	}
+
+	// release index read lock as soon as possible
+	RediSearch_ResultsIteratorFree(iter);
+
+	qsort(op->ring, array_len(op->ring), sizeof(NodeDistance), _distance_cmp);
+
+	op->inner   = outer;
+	op->radius *= 2;
+}
+
+// yields node as a new record
+static Record _YieldNode
+(
+	NodeByDistanceScan *op,
+	NodeID id
+) {
+	Record r = OpBase_CreateRecord((OpBase *)op);
+
+	Node n = GE_NEW_NODE();
+	bool res = Graph_GetNode(op->g, id, &n);
+	ASSERT(res == true);
+	Record_AddNode(r, op->nodeRecIdx, n);
+
+	op->emitted++;
+	return r;
+}
+
+static Record NodeByDistanceScanConsume
+(
+	OpBase *opBase
+) {
+	NodeByDistanceScan *op = (NodeByDistanceScan *)opBase;
+
+	while(op->emitted < op->k) {
+		// yield nodes of current ring
+		if(op->ring != NULL && op->ring_idx < array_len(op->ring)) {
+			return _YieldNode(op, op->ring[op->ring_idx++].id);
+		}
+
+		// expand search radius
+		if(!op->globe_searched) {
+			_CollectRing(op);
+			continue;
+		}
+
+		// all indexed points were yielded
+		// nodes lacking a point have a NULL distance and are ordered last
+		if(!op->scanning) {
+			RG_Matrix L = Graph_GetLabelMatrix(op->g, op->n->label_id);
+			GrB_Info info = RG_MatrixTupleIter_attach(&op->iter, L);
+			ASSERT(info == GrB_SUCCESS);
+			op->scanning = true;
+		}
+
+		GrB_Index id;
+		if(RG_MatrixTupleIter_next_BOOL(&op->iter, &id, NULL, NULL) ==
+				GxB_EXHAUSTED) {
+			return NULL;
+		}
+
+		Node n = GE_NEW_NODE();
+		bool res = Graph_GetNode(op->g, id, &n);
+		ASSERT(res == true);
+
+		if(_NodeDistance(op, &n) < 0) return _YieldNode(op, id);
+	}
+
+	return NULL;
+}
+
+static OpResult NodeByDistanceScanReset
+(
+	OpBase *opBase
+) {
+	NodeByDistanceScan *op = (NodeByDistanceScan *)opBase;
+
+	if(op->ring != NULL) array_clear(op->ring);
+	op->ring_idx       = 0;
+	op->emitted        = 0;
+	op->scanning       = false;
+	op->globe_searched = false;
+
+	GrB_Info info = RG_MatrixTupleIter_detach(&op->iter);
+	ASSERT(info == GrB_SUCCESS);
+
+	// restart search from the initial radius
+	NodeByDistanceScanInit(opBase);
+
+	return OP_OK;
+}
+
+static void NodeByDistanceScanFree
+(
+	OpBase *opBase
+) {
+	NodeByDistanceScan *op = (NodeByDistanceScan *)opBase;
+
+	GrB_Info info = RG_MatrixTupleIter_detach(&op->iter);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(op->ring != NULL) {
+		array_free(op->ring);
+		op->ring = NULL;
+	}
+
+	if(op->attr != NULL) {
+		rm_free(op->attr);
+		op->attr = NULL;
+	}
+
+	if(op->n != NULL) {
+		NodeScanCtx_Free(op->n);
+		op->n = NULL;
+	}
+}
+
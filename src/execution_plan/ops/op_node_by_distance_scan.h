@@ -0,0 +1,54 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../index/index.h"
+#include "shared/scan_functions.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+
+// node distance from origin
+typedef struct {
+	NodeID id;        // node ID
+	double distance;  // distance in meters
+} NodeDistance;
+
+// node by distance scan, yields the k nodes nearest to an origin point
+// in increasing distance order, searching a geo index within expanding radii
+typedef struct {
+	OpBase op;
+	Graph *g;                 // graph
+	NodeScanCtx *n;           // label data of node being scanned
+	Index idx;                // index holding the point attribute
+	char *attr;               // point attribute
+	Attribute_ID attr_id;     // point attribute ID
+	SIValue origin;           // point distances are measured from
+	uint64_t k;               // number of nodes to yield
+	uint64_t emitted;         // number of nodes yielded
+	double radius;            // next search radius in meters
+	double inner;             // nodes up to this distance were collected
+	bool globe_searched;      // entire globe was searched
+	NodeDistance *ring;       // nodes of current ring, by increasing distance
+	uint ring_idx;            // next node to yield from ring
+	bool scanning;            // scanning label for nodes lacking a point
+	RG_MatrixTupleIter iter;  // iterator over label matrix
+	int nodeRecIdx;           // node position within record
+} NodeByDistanceScan;
+
+// creates a new NodeByDistanceScan operation
+OpBase *NewNodeByDistanceScanOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	Graph *g,                   // graph
+	NodeScanCtx *n,             // label data of node being scanned
+	Index idx,                  // index holding the point attribute
+	const char *attr,           // point attribute
+	SIValue origin,             // point distances are measured from
+	uint64_t k                  // number of nodes to yield
+);
+
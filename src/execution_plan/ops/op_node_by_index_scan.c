@@ -13,6 +13,7 @@
 static OpResult IndexScanInit(OpBase *opBase);
 static Record IndexScanConsume(OpBase *opBase);
 static Record IndexScanConsumeFromChild(OpBase *opBase);
+static Record IndexScanConsumeBatchFromChild(OpBase *opBase);
 static OpResult IndexScanReset(OpBase *opBase);
 static void IndexScanFree(OpBase *opBase);
 
@@ -40,6 +41,7 @@ OpBase *NewIndexScanOp
 	op->n                    =  n;
 	op->idx                  =  idx;
 	op->iter                 =  NULL;
+	op->batch                =  NULL;
 	op->filter               =  filter;
 	op->child_record         =  NULL;
 	op->unresolved_filters   =  NULL;
@@ -65,7 +67,16 @@ static OpResult IndexScanInit(OpBase *opBase) {
 		op->rebuild_index_query = raxSize(entities) > 1; // this is us
 		raxFree(entities);
 
-		OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		// per record queries looking up a value by equality are batched
+		if(op->rebuild_index_query && op->batch == NULL) {
+			op->batch = IndexLookupBatch_FromFilter(op->filter, op->n->alias, 1);
+		}
+
+		if(op->batch != NULL) {
+			OpBase_UpdateConsume(opBase, IndexScanConsumeBatchFromChild);
+		} else {
+			OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
+		}
 	}
 
 	// resolve label ID now if it is still unknown
@@ -93,6 +104,145 @@ static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 	return FilterTree_applyFilters(unresolved_filters, r) == FILTER_PASS;
 }
 
+// builds an index query for the current child record
+static void _RebuildIndexQuery
+(
+	IndexScan *op
+) {
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+
+	// free previous iterator
+	if(op->iter != NULL) {
+		RediSearch_ResultsIteratorFree(op->iter);
+		op->iter = NULL;
+	}
+
+	// free previous unresolved filters
+	if(op->unresolved_filters != NULL) {
+		FilterTree_Free(op->unresolved_filters);
+		op->unresolved_filters = NULL;
+	}
+
+	// rebuild index query, probably relies on runtime values
+	// resolve runtime variables within filter
+	FT_FilterNode *filter = FilterTree_Clone(op->filter);
+	FilterTree_ResolveVariables(filter, op->child_record);
+
+	// make sure there's only one unresolve entity in filter
+	#ifdef RG_DEBUG
+	{
+		rax *entities = FilterTree_CollectModified(filter);
+		ASSERT(raxSize(entities) == 1);
+		raxFree(entities);
+	}
+	#endif
+
+	// convert filter into a RediSearch query
+	RSQNode *rs_query_node = Index_BuildQueryTree(&op->unresolved_filters,
+			op->idx, filter);
+	FilterTree_Free(filter);
+
+	// create iterator
+	ASSERT(rs_query_node != NULL);
+	op->iter = RediSearch_GetResultsIterator(rs_query_node, rsIdx);
+}
+
+// resolves all records of the current batch with a single index query
+static void _ResolveBatch
+(
+	IndexScan *op
+) {
+	IndexLookupBatch *batch = op->batch;
+
+	// no node holds the looked up attribute
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, batch->attr_name);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	RSQNode *rs_query_node = IndexLookupBatch_BuildQuery(batch, op->idx);
+	if(rs_query_node == NULL) return;
+
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node,
+			rsIdx);
+
+	// route each matching node to the records looking up its value
+	const EntityID *nodeId = NULL;
+	while((nodeId = RediSearch_ResultsIteratorNext(iter, rsIdx, NULL))
+			!= NULL) {
+		Node n = GE_NEW_NODE();
+		int res = Graph_GetNode(op->g, *nodeId, &n);
+		ASSERT(res != 0);
+
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)&n, attr_id);
+		if(v != ATTRIBUTE_NOTFOUND) IndexLookupBatch_Route(batch, *v, nodeId);
+	}
+
+	// release index read lock as soon as possible
+	RediSearch_ResultsIteratorFree(iter);
+}
+
+static Record IndexScanConsumeBatchFromChild
+(
+	OpBase *opBase
+) {
+	IndexScan *op = (IndexScan *)opBase;
+	IndexLookupBatch *batch = op->batch;
+	RSIndex *rsIdx = Index_RSIndex(op->idx);
+	const EntityID *nodeId = NULL;
+
+	while(true) {
+		//----------------------------------------------------------------------
+		// emit current record's matches
+		//----------------------------------------------------------------------
+
+		if(op->child_record != NULL) {
+			if(op->iter != NULL) {
+				// record resolved by its own lookup
+				while((nodeId = RediSearch_ResultsIteratorNext(op->iter, rsIdx,
+								NULL)) != NULL) {
+					_UpdateRecord(op, op->child_record, *nodeId);
+					if(_PassUnresolvedFilters(op, op->child_record)) {
+						return OpBase_CloneRecord(op->child_record);
+					}
+				}
+			} else {
+				while((nodeId = IndexLookupBatch_NextMatch(batch)) != NULL) {
+					_UpdateRecord(op, op->child_record, *nodeId);
+					if(batch->unresolved == NULL ||
+					   FilterTree_applyFilters(batch->unresolved,
+						   op->child_record) == FILTER_PASS) {
+						return OpBase_CloneRecord(op->child_record);
+					}
+				}
+			}
+
+			OpBase_DeleteRecord(op->child_record);
+			op->child_record = NULL;
+		}
+
+		if(op->iter != NULL) {
+			RediSearch_ResultsIteratorFree(op->iter);
+			op->iter = NULL;
+		}
+
+		//----------------------------------------------------------------------
+		// advance to the next record, pull a new batch if needed
+		//----------------------------------------------------------------------
+
+		bool separate;
+		op->child_record = IndexLookupBatch_NextRecord(batch, &separate);
+		if(op->child_record == NULL) {
+			if(!IndexLookupBatch_Fill(batch, op->op.children[0])) return NULL;
+			_ResolveBatch(op);
+			continue;
+		}
+
+		// value can't be batched, e.g. an array
+		if(separate) _RebuildIndexQuery(op);
+	}
+}
+
 static Record IndexScanConsumeFromChild(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 	RSIndex *rsIdx = Index_RSIndex(op->idx);
@@ -138,40 +288,7 @@ pull_index:
 	//--------------------------------------------------------------------------
 
 	if(op->rebuild_index_query) {
-		// free previous iterator
-		if(op->iter != NULL) {
-			RediSearch_ResultsIteratorFree(op->iter);
-			op->iter = NULL;
-		}
-
-		// free previous unresolved filters
-		if(op->unresolved_filters != NULL) {
-			FilterTree_Free(op->unresolved_filters);
-			op->unresolved_filters = NULL;
-		}
-
-		// rebuild index query, probably relies on runtime values
-		// resolve runtime variables within filter
-		FT_FilterNode *filter = FilterTree_Clone(op->filter);
-		FilterTree_ResolveVariables(filter, op->child_record);
-
-		// make sure there's only one unresolve entity in filter
-		#ifdef RG_DEBUG
-		{
-			rax *entities = FilterTree_CollectModified(filter);
-			ASSERT(raxSize(entities) == 1);
-			raxFree(entities);
-		}
-		#endif
-
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = Index_BuildQueryTree(&op->unresolved_filters,
-				op->idx, filter);
-		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, rsIdx);
+		_RebuildIndexQuery(op);
 	} else {
 		// build index query only once (first call)
 		// reset it if already initialized
@@ -225,6 +342,8 @@ static Record IndexScanConsume(OpBase *opBase) {
 static OpResult IndexScanReset(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
+	if(op->batch != NULL) IndexLookupBatch_Reset(op->batch);
+
 	if(op->iter) {
 		RediSearch_ResultsIteratorFree(op->iter);
 		op->iter = NULL;
@@ -254,6 +373,11 @@ static void IndexScanFree(OpBase *opBase) {
 		op->child_record = NULL;
 	}
 
+	if(op->batch != NULL) {
+		IndexLookupBatch_Free(op->batch);
+		op->batch = NULL;
+	}
+
 	if(op->filter != NULL) {
 		FilterTree_Free(op->filter);
 		op->filter = NULL;
@@ -11,6 +11,7 @@
 #include "../../graph/graph.h"
 #include "../../index/index.h"
 #include "shared/scan_functions.h"
+#include "shared/index_lookup_batch.h"
 
 typedef struct {
 	OpBase op;
@@ -23,6 +24,7 @@ typedef struct {
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
+	IndexLookupBatch *batch;            // batched lookups, NULL if not batched
 } IndexScan;
 
 // creates a new IndexScan operation
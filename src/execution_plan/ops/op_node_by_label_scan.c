@@ -26,6 +26,11 @@ static inline void NodeByLabelScanToString
 ) {
 	NodeByLabelScan *op = (NodeByLabelScan *)ctx;
 	ScanToString(ctx, buf, op->n->alias, op->n->label);
+
+	// report planner hint which couldn't be honored
+	if(op->n->hint_unmet != NULL) {
+		*buf = sdscatprintf(*buf, " | %s", op->n->hint_unmet);
+	}
 }
 
 // update the label-id of a cached operation, as it may have not 
@@ -0,0 +1,295 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "op_ordered_traverse.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "shared/print_functions.h"
+
+// forward declarations
+static OpResult OrderedTraverseInit(OpBase *opBase);
+static Record OrderedTraverseConsume(OpBase *opBase);
+static OpResult OrderedTraverseReset(OpBase *opBase);
+static OpBase *OrderedTraverseClone(const ExecutionPlan *plan,
+		const OpBase *opBase);
+static void OrderedTraverseFree(OpBase *opBase);
+
+static void OrderedTraverseToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpOrderedTraverse *op = (const OpOrderedTraverse *)ctx;
+	TraversalToString(ctx, buf, op->ae);
+}
+
+OpBase *NewOrderedTraverseOp
+(
+	const ExecutionPlan *plan,
+	Graph *g,
+	AlgebraicExpression *ae,
+	Index idx,
+	Attribute_ID attr_id,
+	RelationID relation,
+	GRAPH_EDGE_DIR dir,
+	bool desc,
+	uint64_t k
+) {
+	ASSERT(g    != NULL);
+	ASSERT(k    > 0);
+	ASSERT(ae   != NULL);
+	ASSERT(idx  != NULL);
+	ASSERT(plan != NULL);
+	ASSERT(dir  != GRAPH_EDGE_DIR_BOTH);
+
+	OpOrderedTraverse *op = rm_calloc(1, sizeof(OpOrderedTraverse));
+	op->g        = g;
+	op->k        = k;
+	op->ae       = ae;
+	op->dir      = dir;
+	op->idx      = idx;
+	op->desc     = desc;
+	op->edges    = array_new(Edge, 0);
+	op->attr_id  = attr_id;
+	op->relation = relation;
+
+	OpBase_Init((OpBase *)op, OPType_ORDERED_TRAVERSE, "Ordered Traverse",
+			OrderedTraverseInit, OrderedTraverseConsume, OrderedTraverseReset,
+			OrderedTraverseToString, OrderedTraverseClone, OrderedTraverseFree,
+			false, plan);
+
+	bool aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Src(ae),
+			&op->srcNodeIdx);
+	UNUSED(aware);
+	ASSERT(aware == true);
+
+	const char *dest = AlgebraicExpression_Dest(ae);
+	op->destNodeIdx  = OpBase_Modifies((OpBase *)op, dest);
+	op->edgeRecIdx   = OpBase_Modifies((OpBase *)op,
+			AlgebraicExpression_Edge(ae));
+
+	// destination labels are verified per emitted edge
+	QGNode *n = QueryGraph_GetNodeByAlias(plan->query_graph, dest);
+	ASSERT(n != NULL);
+	array_clone(op->dest_labels, n->labelsID);
+
+	return (OpBase *)op;
+}
+
+static OpResult OrderedTraverseInit
+(
+	OpBase *opBase
+) {
+	OpOrderedTraverse *op = (OpOrderedTraverse *)opBase;
+
+	op->adj = Index_GetAdjacency(op->idx, op->attr_id);
+	ASSERT(op->adj != NULL);
+
+	return OP_OK;
+}
+
+// returns true if node 'id' holds all destination labels
+static bool _DestinationLabeled
+(
+	OpOrderedTraverse *op,
+	NodeID id
+) {
+	uint n = array_len(op->dest_labels);
+	for(uint i = 0; i < n; i++) {
+		if(!Graph_IsNodeLabeled(op->g, id, op->dest_labels[i])) return false;
+	}
+
+	return true;
+}
+
+// emits a clone of the current source record
+// extended with the traversed edge and destination node
+static Record _Emit
+(
+	OpOrderedTraverse *op,
+	Edge *e,
+	NodeID dest_id
+) {
+	Record r = OpBase_DeepCloneRecord(op->r);
+
+	Node dest = GE_NEW_NODE();
+	bool res = Graph_GetNode(op->g, dest_id, &dest);
+	ASSERT(res == true);
+
+	Record_AddNode(r, op->destNodeIdx, dest);
+	Record_AddEdge(r, op->edgeRecIdx, *e);
+
+	op->emitted++;
+	return r;
+}
+
+// emits the next edge of the current source in attribute order
+static Record _NextOrdered
+(
+	OpOrderedTraverse *op
+) {
+	EdgeID edge_id;
+	NodeID node_id;
+	while(op->emitted < op->k &&
+		  AdjacencyIterator_Next(&op->iter, &edge_id, &node_id)) {
+		if(!_DestinationLabeled(op, node_id)) continue;
+
+		Edge e;
+		bool res = Graph_GetEdge(op->g, edge_id, &e);
+		ASSERT(res == true);
+
+		NodeID src_id = ENTITY_GET_ID(Record_GetNode(op->r, op->srcNodeIdx));
+		bool outgoing = op->dir == GRAPH_EDGE_DIR_OUTGOING;
+		Edge_SetRelationID(&e, op->relation);
+		Edge_SetSrcNodeID(&e,  outgoing ? src_id : node_id);
+		Edge_SetDestNodeID(&e, outgoing ? node_id : src_id);
+
+		return _Emit(op, &e, node_id);
+	}
+
+	return NULL;
+}
+
+// emits the next edge of the current source in no particular order
+static Record _NextUnordered
+(
+	OpOrderedTraverse *op
+) {
+	uint64_t n = array_len(op->edges);
+	while(op->pos < n) {
+		Edge *e = op->edges + op->pos;
+		op->pos++;
+
+		NodeID dest_id = (op->dir == GRAPH_EDGE_DIR_OUTGOING)
+			? Edge_GetDestNodeID(e)
+			: Edge_GetSrcNodeID(e);
+		if(!_DestinationLabeled(op, dest_id)) continue;
+
+		return _Emit(op, e, dest_id);
+	}
+
+	return NULL;
+}
+
+// prepares the expansion of the current source record
+static void _Expand
+(
+	OpOrderedTraverse *op,
+	Node *src
+) {
+	op->pos     = 0;
+	op->emitted = 0;
+
+	const AdjacencyList *list =
+		IndexAdjacency_GetList(op->adj, ENTITY_GET_ID(src), op->dir);
+
+	// edges lacking a numeric value can't be ordered
+	// expand all of the source edges, these are ordered by the sort above
+	op->ordered = (list == NULL || list->others == 0);
+	if(op->ordered) {
+		AdjacencyIterator_Attach(&op->iter, list, op->desc);
+	} else {
+		AdjacencyIterator_Detach(&op->iter);
+		array_clear(op->edges);
+		Graph_GetNodeEdges(op->g, src, op->dir, op->relation, &op->edges);
+	}
+}
+
+static Record OrderedTraverseConsume
+(
+	OpBase *opBase
+) {
+	OpOrderedTraverse *op = (OpOrderedTraverse *)opBase;
+	OpBase *child = op->op.children[0];
+
+	while(true) {
+		if(op->r != NULL) {
+			Record r = op->ordered ? _NextOrdered(op) : _NextUnordered(op);
+			if(r != NULL) return r;
+
+			// current source is depleted
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+		}
+
+		op->r = OpBase_Consume(child);
+		if(op->r == NULL) return NULL;
+
+		// the child record may not contain the source node
+		// e.g. a failed OPTIONAL MATCH
+		Node *src = Record_GetNode(op->r, op->srcNodeIdx);
+		if(src == NULL) {
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+			continue;
+		}
+
+		Record_PersistScalars(op->r);
+		_Expand(op, src);
+	}
+}
+
+static OpResult OrderedTraverseReset
+(
+	OpBase *opBase
+) {
+	OpOrderedTraverse *op = (OpOrderedTraverse *)opBase;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	array_clear(op->edges);
+	AdjacencyIterator_Detach(&op->iter);
+	op->pos     = 0;
+	op->emitted = 0;
+
+	return OP_OK;
+}
+
+static OpBase *OrderedTraverseClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_ORDERED_TRAVERSE);
+	const OpOrderedTraverse *op = (const OpOrderedTraverse *)opBase;
+
+	return NewOrderedTraverseOp(plan, QueryCtx_GetGraph(),
+			AlgebraicExpression_Clone(op->ae), op->idx, op->attr_id,
+			op->relation, op->dir, op->desc, op->k);
+}
+
+static void OrderedTraverseFree
+(
+	OpBase *opBase
+) {
+	OpOrderedTraverse *op = (OpOrderedTraverse *)opBase;
+
+	if(op->r != NULL) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	AdjacencyIterator_Detach(&op->iter);
+
+	if(op->edges != NULL) {
+		array_free(op->edges);
+		op->edges = NULL;
+	}
+
+	if(op->dest_labels != NULL) {
+		array_free(op->dest_labels);
+		op->dest_labels = NULL;
+	}
+
+	if(op->ae != NULL) {
+		AlgebraicExpression_Free(op->ae);
+		op->ae = NULL;
+	}
+}
+
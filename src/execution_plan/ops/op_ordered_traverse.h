@@ -0,0 +1,54 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../index/index.h"
+#include "../../graph/entities/edge.h"
+#include "../../arithmetic/algebraic_expression.h"
+
+// ordered traverse, expands each source node over a single relationship
+// visiting its edges in the order of an indexed edge attribute
+// at most k edges are emitted per source node
+typedef struct {
+	OpBase op;
+	Graph *g;                    // graph
+	AlgebraicExpression *ae;     // traversal expression
+	Index idx;                   // edge index ordering the adjacency
+	Attribute_ID attr_id;        // attribute edges are ordered by
+	const IndexAdjacency *adj;   // adjacency ordered by attribute
+	RelationID relation;         // traversed relationship type
+	GRAPH_EDGE_DIR dir;          // traversed direction, incoming or outgoing
+	bool desc;                   // visit edges in descending order
+	uint64_t k;                  // max number of edges emitted per source
+	int *dest_labels;            // labels required on destination node
+	int srcNodeIdx;              // source node position within record
+	int destNodeIdx;             // destination node position within record
+	int edgeRecIdx;              // edge position within record
+	Record r;                    // current source record
+	AdjacencyIterator iter;      // ordered edges of current source
+	bool ordered;                // current source is expanded in order
+	Edge *edges;                 // all edges of current source, when unordered
+	uint64_t pos;                // next unordered edge to visit
+	uint64_t emitted;            // number of edges emitted for current source
+} OpOrderedTraverse;
+
+// creates a new OrderedTraverse operation
+OpBase *NewOrderedTraverseOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	Graph *g,                   // graph
+	AlgebraicExpression *ae,    // traversal expression, owned by the operation
+	Index idx,                  // edge index ordering the adjacency
+	Attribute_ID attr_id,       // attribute edges are ordered by
+	RelationID relation,        // traversed relationship type
+	GRAPH_EDGE_DIR dir,         // traversed direction, incoming or outgoing
+	bool desc,                  // visit edges in descending order
+	uint64_t k                  // max number of edges emitted per source
+);
+
@@ -5,12 +5,18 @@
  */
 
 #include "RG.h"
+#include "op_sort.h"
+#include "op_skip.h"
+#include "op_limit.h"
+#include "op_project.h"
 #include "op_procedure_call.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 #include "../../query_ctx.h"
+#include "../../ast/ast_build_op_contexts.h"
 
 /* Forward declarations. */
+static OpResult ProcCallInit(OpBase *opBase);
 static Record ProcCallConsume(OpBase *opBase);
 static OpResult ProcCallReset(OpBase *opBase);
 static OpBase *ProcCallClone(const ExecutionPlan *plan, const OpBase *opBase);
@@ -66,6 +72,7 @@ OpBase *NewProcCallOp
 	op->yield_map  = NULL;
 	op->first_call = true;
 	op->yield_exps = yield_exps;
+	op->top_k      = 0;
 
 	// procedure must exist
 	op->procedure = Proc_Get(proc_name);
@@ -77,7 +84,7 @@ OpBase *NewProcCallOp
 
 	// set callbacks
 	OpBase_Init((OpBase *)op, OPType_PROC_CALL, "ProcedureCall",
-				NULL, ProcCallConsume, ProcCallReset, NULL, ProcCallClone,
+				ProcCallInit, ProcCallConsume, ProcCallReset, NULL, ProcCallClone,
 				ProcCallFree, !Procedure_IsReadOnly(op->procedure), plan);
 
 	// set modifiers
@@ -94,6 +101,69 @@ OpBase *NewProcCallOp
 	return (OpBase *)op;
 }
 
+// determine if only the highest scored rows are consumed, e.g.
+// CALL db.idx.fulltext.queryNodes('L', 'q') YIELD node, score
+// RETURN node ORDER BY score DESC LIMIT 10
+// returns the number of rows consumed, 0 if all rows are consumed
+static uint64_t _TopK
+(
+	const OpProcCall *op
+) {
+	// locate yielded score
+	const char *score = NULL;
+	uint yield_count = array_len(op->output);
+	for(uint i = 0; i < yield_count; i++) {
+		if(strcmp(op->output[i], "score") == 0) {
+			score = op->yield_exps[i]->resolved_name;
+			break;
+		}
+	}
+	if(score == NULL) return 0;
+
+	// rows are projected and sorted, nothing is filtered in between
+	const OpBase *parent = op->op.parent;
+	if(parent == NULL || parent->type != OPType_PROJECT) return 0;
+	const OpProject *project = (const OpProject *)parent;
+
+	parent = parent->parent;
+	if(parent == NULL || parent->type != OPType_SORT) return 0;
+	const OpSort *sort = (const OpSort *)parent;
+
+	// sorted by descending score only
+	if(array_len(sort->exps) != 1 || sort->directions[0] != DIR_DESC) return 0;
+
+	// sort key is the score as yielded
+	const char *key = sort->exps[0]->resolved_name;
+	bool projected = false;
+	for(uint i = 0; i < project->exp_count && !projected; i++) {
+		AR_ExpNode *exp = project->exps[i];
+		projected = strcmp(exp->resolved_name, key) == 0 &&
+			AR_EXP_IsVariadic(exp) &&
+			strcmp(exp->operand.variadic.entity_alias, score) == 0;
+	}
+	if(!projected) return 0;
+
+	// sorted rows are limited, skipped rows are consumed as well
+	uint64_t skip = 0;
+	for(parent = parent->parent; parent != NULL; parent = parent->parent) {
+		if(parent->type == OPType_SKIP) {
+			skip += ((const OpSkip *)parent)->skip;
+		} else if(parent->type == OPType_LIMIT) {
+			return ((const OpLimit *)parent)->limit + skip;
+		} else {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static OpResult ProcCallInit(OpBase *opBase) {
+	OpProcCall *op = (OpProcCall *)opBase;
+	op->top_k = _TopK(op);
+	return OP_OK;
+}
+
 static Record ProcCallConsume(OpBase *opBase) {
 	OpProcCall *op = (OpProcCall *)opBase;
 
@@ -122,6 +192,7 @@ static Record ProcCallConsume(OpBase *opBase) {
 		// TODO: replace with Proc_Reset
 		Proc_Free(op->procedure);
 		op->procedure = Proc_Get(op->proc_name);
+		Proc_SetTopK(op->procedure, op->top_k);
 
 		// at the moment the only two procedures that can modify the graph are:
 		// proc_fulltext_create_index
@@ -32,6 +32,7 @@ typedef struct {
 	ProcedureCtx *procedure;    // Procedure to call.
 	OutputMap *yield_map;       // Maps between yield to procedure output and record idx.
     bool first_call;            // Indicate first call.
+	uint64_t top_k;             // Highest scored rows consumed, 0 for all rows.
 } OpProcCall;
 
 OpBase *NewProcCallOp(
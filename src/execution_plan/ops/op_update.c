@@ -6,6 +6,11 @@
 
 #include "op_update.h"
 #include "RG.h"
+#include "op_filter.h"
+#include "op_unwind.h"
+#include "op_project.h"
+#include "op_aggregate.h"
+#include "op_conditional_traverse.h"
 #include "../../query_ctx.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
@@ -13,12 +18,31 @@
 #include "../../util/rax_extensions.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
+// number of records committed at once by a streaming update
+#define UPDATE_BATCH_SIZE 16384
+
+// functions reading an entity's attributes as a whole
+static const char *_entity_readers[] = {"properties", "keys", "tojson",
+	"subscript"};
+
 // forward declarations
+static OpResult UpdateInit(OpBase *opBase);
 static Record UpdateConsume(OpBase *opBase);
 static OpResult UpdateReset(OpBase *opBase);
 static OpBase *UpdateClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void UpdateFree(OpBase *opBase);
 
+static void UpdateToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpUpdate *op = (const OpUpdate *)ctx;
+
+	*buf = sdscatprintf(*buf, "%s", op->op.name);
+	if(op->stream) *buf = sdscatprintf(*buf, " | Batches: %u", op->batches);
+}
+
 static Record _handoff(OpUpdate *op) {
 	/* TODO: popping a record out of op->records
 	 * will reverse the order in which records
@@ -59,8 +83,8 @@ OpBase *NewUpdateOp(const ExecutionPlan *plan, rax *update_exps) {
 	op->updates_committed = false;
 
 	// set our op operations
-	OpBase_Init((OpBase *)op, OPType_UPDATE, "Update", NULL, UpdateConsume,
-				UpdateReset, NULL, UpdateClone, UpdateFree, true, plan);
+	OpBase_Init((OpBase *)op, OPType_UPDATE, "Update", UpdateInit, UpdateConsume,
+				UpdateReset, UpdateToString, UpdateClone, UpdateFree, true, plan);
 
 	// iterate over all update expressions
 	// set the record index for every entity modified by this operation
@@ -74,6 +98,209 @@ OpBase *NewUpdateOp(const ExecutionPlan *plan, rax *update_exps) {
 	return (OpBase *)op;
 }
 
+//------------------------------------------------------------------------------
+// conflict analysis
+//------------------------------------------------------------------------------
+
+// returns true if expression reads any of the 'updated' attributes
+static bool _ExpReads
+(
+	AR_ExpNode *exp,  // expression
+	rax *updated      // updated attributes
+) {
+	if(exp == NULL) return false;
+
+	int n = sizeof(_entity_readers) / sizeof(_entity_readers[0]);
+	for(int i = 0; i < n; i++) {
+		if(AR_EXP_ContainsFunc(exp, _entity_readers[i])) return true;
+	}
+
+	rax *attributes = raxNew();
+	AR_EXP_CollectAttributes(exp, attributes);
+
+	bool reads = false;
+	raxIterator it;
+	raxStart(&it, attributes);
+	raxSeek(&it, "^", NULL, 0);
+	while(!reads && raxNext(&it)) {
+		reads = raxFind(updated, it.key, it.key_len) != raxNotFound;
+	}
+	raxStop(&it);
+	raxFree(attributes);
+
+	return reads;
+}
+
+// returns true if filter tree reads any of the 'updated' attributes
+static bool _FilterReads
+(
+	const FT_FilterNode *filter,  // filter tree
+	rax *updated                  // updated attributes
+) {
+	if(filter == NULL) return false;
+
+	int n = sizeof(_entity_readers) / sizeof(_entity_readers[0]);
+	for(int i = 0; i < n; i++) {
+		if(FilterTree_ContainsFunc(filter, _entity_readers[i], NULL)) return true;
+	}
+
+	rax *attributes = FilterTree_CollectAttributes(filter);
+
+	bool reads = false;
+	raxIterator it;
+	raxStart(&it, attributes);
+	raxSeek(&it, "^", NULL, 0);
+	while(!reads && raxNext(&it)) {
+		reads = raxFind(updated, it.key, it.key_len) != raxNotFound;
+	}
+	raxStop(&it);
+	raxFree(attributes);
+
+	return reads;
+}
+
+// returns true if op might observe the 'updated' attributes
+// or might be affected by committing updates while it is consumed
+static bool _OpConflicts
+(
+	const OpBase *op,  // operation
+	rax *updated       // updated attributes
+) {
+	switch(op->type) {
+		// scans and traversals iterate over matrices
+		// which aren't modified by attribute updates
+		case OPType_ALL_NODE_SCAN:
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_ID_SEEK:
+		case OPType_EDGE_BY_ID_SEEK:
+		case OPType_EXPAND_INTO:
+		case OPType_RESULTS:
+			return false;
+
+		case OPType_CONDITIONAL_TRAVERSE:
+			// destination filter is resolved via an index
+			return ((const OpCondTraverse *)op)->dest_filter != NULL;
+
+		case OPType_FILTER:
+			return _FilterReads(((const OpFilter *)op)->filterTree, updated);
+
+		case OPType_UNWIND:
+			return _ExpReads(((const OpUnwind *)op)->exp, updated);
+
+		case OPType_PROJECT: {
+			const OpProject *project = (const OpProject *)op;
+			for(uint i = 0; i < project->exp_count; i++) {
+				if(_ExpReads(project->exps[i], updated)) return true;
+			}
+			return false;
+		}
+
+		case OPType_AGGREGATE: {
+			const OpAggregate *aggregate = (const OpAggregate *)op;
+			for(uint i = 0; i < aggregate->key_count; i++) {
+				if(_ExpReads(aggregate->key_exps[i], updated)) return true;
+			}
+			for(uint i = 0; i < aggregate->aggregate_count; i++) {
+				if(_ExpReads(aggregate->aggregate_exps[i], updated)) return true;
+			}
+			return false;
+		}
+
+		// any other operation is assumed to conflict
+		// e.g. index scans hold index locks while consumed
+		// and LIMIT would stop consuming before all updates are applied
+		default:
+			return true;
+	}
+}
+
+// returns true if an op in the sub-tree rooted at 'root' conflicts
+static bool _SubtreeConflicts
+(
+	const OpBase *root,  // sub-tree root
+	rax *updated         // updated attributes
+) {
+	if(_OpConflicts(root, updated)) return true;
+
+	for(int i = 0; i < root->childCount; i++) {
+		if(_SubtreeConflicts(root->children[i], updated)) return true;
+	}
+
+	return false;
+}
+
+// determine if updates can be committed in batches while streaming records
+// instead of being committed once all records were consumed
+//
+// this is the case when the plan can't observe the updates:
+// only attributes are set, none of them is read by the plan
+// or by the update expressions, the operations reading records
+// don't hold resources the commit requires
+// and the operations following the update consume all of its records
+static bool _CanStream
+(
+	OpUpdate *op  // update operation
+) {
+	// collect updated attributes
+	bool stream   = true;
+	rax *updated  = raxNew();
+	raxIterator it;
+	raxStart(&it, op->update_ctxs);
+	raxSeek(&it, "^", NULL, 0);
+	while(stream && raxNext(&it)) {
+		EntityUpdateEvalCtx *ctx = it.data;
+
+		// label updates modify the matrices scanned
+		if(array_len(ctx->add_labels) > 0 || array_len(ctx->remove_labels) > 0) {
+			stream = false;
+			break;
+		}
+
+		uint n = array_len(ctx->properties);
+		for(uint i = 0; i < n; i++) {
+			// SET n = {...} and SET n += {...} update unknown attributes
+			const char *attr = ctx->properties[i].attribute;
+			if(attr == NULL) {
+				stream = false;
+				break;
+			}
+			raxInsert(updated, (unsigned char *)attr, strlen(attr), NULL, NULL);
+		}
+	}
+
+	// update expressions are evaluated against previously committed batches
+	raxSeek(&it, "^", NULL, 0);
+	while(stream && raxNext(&it)) {
+		EntityUpdateEvalCtx *ctx = it.data;
+		uint n = array_len(ctx->properties);
+		for(uint i = 0; i < n && stream; i++) {
+			stream = !_ExpReads(ctx->properties[i].exp, updated);
+		}
+	}
+	raxStop(&it);
+
+	// operations consuming the update's records
+	for(const OpBase *parent = op->op.parent; stream && parent != NULL;
+			parent = parent->parent) {
+		stream = !_OpConflicts(parent, updated);
+	}
+
+	// operations producing the update's records
+	if(stream) stream = !_SubtreeConflicts(op->op.children[0], updated);
+
+	raxFree(updated);
+	return stream;
+}
+
+static OpResult UpdateInit
+(
+	OpBase *opBase
+) {
+	OpUpdate *op = (OpUpdate *)opBase;
+	op->stream = _CanStream(op);
+	return OP_OK;
+}
+
 static Record UpdateConsume
 (
 	OpBase *opBase
@@ -85,7 +312,20 @@ static Record UpdateConsume
 	// updates already performed
 	if(op->updates_committed) return _handoff(op);
 
-	while((r = OpBase_Consume(child))) {
+	// hand off records of the last committed batch
+	if(op->stream && (r = _handoff(op)) != NULL) return r;
+
+	// an eager update commits all records in a single batch
+	uint batch_size = (op->stream) ? UPDATE_BATCH_SIZE : UINT_MAX;
+
+	while(array_len(op->records) < batch_size) {
+		r = OpBase_Consume(child);
+		if(r == NULL) {
+			// child depleted, this is the last batch
+			op->updates_committed = true;
+			break;
+		}
+
 		Record_PersistScalars(r);
 
 		// evaluate update expressions
@@ -105,20 +345,27 @@ static Record UpdateConsume
 		// done reading; we're not going to call Consume any longer
 		// there might be operations like "Index Scan" that need to free the
 		// index R/W lock - as such, free all ExecutionPlan operations up the chain.
-		OpBase_PropagateReset(child);
+		// a streaming update keeps consuming, its child holds no such locks
+		if(!op->stream) OpBase_PropagateReset(child);
 
 		// lock everything
 		QueryCtx_LockForCommit();
 
 		CommitUpdates(op->gc, op->node_updates, ENTITY_NODE);
 		CommitUpdates(op->gc, op->edge_updates, ENTITY_EDGE);
+		op->batches++;
 	}
 
+	// commit every batch but the last on its own, releasing the GIL and the
+	// graph write lock while the next batch is read
+	// readers only observe committed batches, a failure rolls back the
+	// current batch alone, earlier batches are already replicated
+	// the last batch is committed along with the rest of the query
+	if(op->stream && !op->updates_committed) QueryCtx_CommitBatch();
+
 	HashTableEmpty(op->node_updates, NULL);
 	HashTableEmpty(op->edge_updates, NULL);
 
-	op->updates_committed = true;
-
 	return _handoff(op);
 }
 
@@ -19,6 +19,8 @@ typedef struct {
 	GraphContext *gc;
 	rax *update_ctxs;               // Entities to update and their expressions
 	bool updates_committed;         // True if we've already committed updates and are now in handoff mode.
+	bool stream;                    // Commit updates in batches, handing off records of each batch, every batch but the last is committed on its own.
+	uint batches;                   // Number of committed batches.
 	dict *node_updates;             // Enqueued node updates
 	dict *edge_updates;             // Enqueued edge updates
 } OpUpdate;
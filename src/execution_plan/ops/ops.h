@@ -22,17 +22,23 @@
 #include "op_project.h"
 #include "op_foreach.h"
 #include "op_optional.h"
+#include "op_load_csv.h"
 #include "op_argument.h"
 #include "op_distinct.h"
 #include "op_aggregate.h"
 #include "op_semi_apply.h"
 #include "op_expand_into.h"
+#include "op_leapfrog_join.h"
+#include "op_column_aggregate.h"
 #include "op_merge_create.h"
 #include "op_argument_list.h"
 #include "op_all_node_scan.h"
 #include "op_call_subquery.h"
 #include "op_procedure_call.h"
 #include "op_node_by_id_seek.h"
+#include "op_edge_by_id_seek.h"
+#include "op_node_by_distance_scan.h"
+#include "op_ordered_traverse.h"
 #include "op_value_hash_join.h"
 #include "op_apply_multiplexer.h"
 #include "op_cartesian_product.h"
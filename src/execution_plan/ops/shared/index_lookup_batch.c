@@ -0,0 +1,395 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "index_lookup_batch.h"
+#include "../../../util/arr.h"
+#include "../../../datatypes/array.h"
+
+// key index of a record which can't match, e.g. n.v = NULL
+#define LOOKUP_NO_MATCH -1
+// key index of a record resolved by its own lookup
+#define LOOKUP_SEPARATE -2
+
+// returns true if 'v' can be looked up as part of a batch
+static bool _BatchableValue
+(
+	SIValue v
+) {
+	SIType t = SI_TYPE(v);
+
+	// TODO: remove when RediSearch INT64 indexing bug fixed
+	if(t == T_INT64 && v.longval & 0x7FF0000000000000) return false;
+
+	return t & (T_STRING | SI_NUMERIC | T_BOOL);
+}
+
+// returns true if 'exp' refers to 'alias'
+static bool _ExpReferences
+(
+	AR_ExpNode *exp,   // expression
+	const char *alias  // alias
+) {
+	rax *entities = raxNew();
+	AR_EXP_CollectEntities(exp, entities);
+	bool referenced = raxFind(entities, (unsigned char *)alias, strlen(alias))
+		!= raxNotFound;
+	raxFree(entities);
+
+	return referenced;
+}
+
+// returns true if 'exp' accesses an attribute of 'alias'
+static bool _AttributeOf
+(
+	AR_ExpNode *exp,   // expression
+	const char *alias  // alias
+) {
+	if(!AR_EXP_IsAttribute(exp, NULL)) return false;
+
+	AR_ExpNode *entity = exp->op.children[0];
+	return AR_EXP_IsVariadic(entity) &&
+		strcmp(entity->operand.variadic.entity_alias, alias) == 0;
+}
+
+// returns true if 'filter' is an equality between an attribute of 'alias'
+// and an expression over other aliases
+static bool _KeyEquality
+(
+	const FT_FilterNode *filter,  // filter
+	const char *alias,            // scanned alias
+	AR_ExpNode **attr,            // [out] attribute side
+	AR_ExpNode **key              // [out] expression side
+) {
+	if(filter->t != FT_N_PRED || filter->pred.op != OP_EQUAL) return false;
+
+	AR_ExpNode *lhs = filter->pred.lhs;
+	AR_ExpNode *rhs = filter->pred.rhs;
+
+	if(_AttributeOf(lhs, alias) && !_ExpReferences(rhs, alias)) {
+		*attr = lhs;
+		*key  = rhs;
+		return true;
+	}
+
+	if(_AttributeOf(rhs, alias) && !_ExpReferences(lhs, alias)) {
+		*attr = rhs;
+		*key  = lhs;
+		return true;
+	}
+
+	return false;
+}
+
+IndexLookupBatch *IndexLookupBatch_New
+(
+	AR_ExpNode *key,
+	AR_ExpNode *attr,
+	FT_FilterNode *filter,
+	uint stride
+) {
+	ASSERT(key    != NULL);
+	ASSERT(attr   != NULL);
+	ASSERT(stride > 0);
+
+	char *attr_name;
+	bool attribute = AR_EXP_IsAttribute(attr, &attr_name);
+	UNUSED(attribute);
+	ASSERT(attribute == true);
+
+	IndexLookupBatch *batch = rm_calloc(1, sizeof(IndexLookupBatch));
+
+	batch->key         = key;
+	batch->attr        = attr;
+	batch->attr_name   = attr_name;
+	batch->filter      = filter;
+	batch->stride      = stride;
+	batch->records     = array_new(Record, INDEX_LOOKUP_BATCH_SIZE);
+	batch->record_keys = array_new(int, INDEX_LOOKUP_BATCH_SIZE);
+	batch->keys        = array_new(SIValue, 0);
+	batch->next_key    = array_new(int, 0);
+	batch->matches     = array_new(EntityID *, 0);
+	batch->lookup      = HashTableCreate(&def_dt);
+	batch->current_key = LOOKUP_NO_MATCH;
+
+	return batch;
+}
+
+IndexLookupBatch *IndexLookupBatch_FromFilter
+(
+	const FT_FilterNode *filter,
+	const char *alias,
+	uint stride
+) {
+	ASSERT(alias  != NULL);
+	ASSERT(filter != NULL);
+
+	AR_ExpNode *key  = NULL;
+	AR_ExpNode *attr = NULL;
+	bool batchable   = true;
+
+	const FT_FilterNode **trees  = FilterTree_SubTrees(filter);
+	const FT_FilterNode **shared = array_new(const FT_FilterNode *, 0);
+
+	uint n = array_len(trees);
+	for(uint i = 0; i < n && batchable; i++) {
+		const FT_FilterNode *tree = trees[i];
+
+		// filters which refer only to the scanned entity are shared
+		rax *entities = FilterTree_CollectModified(tree);
+		bool shared_filter = raxSize(entities) == 0 ||
+			(raxSize(entities) == 1 &&
+			 raxFind(entities, (unsigned char *)alias, strlen(alias))
+			 != raxNotFound);
+		raxFree(entities);
+
+		if(shared_filter) {
+			array_append(shared, tree);
+		} else if(key != NULL || !_KeyEquality(tree, alias, &attr, &key)) {
+			// multiple per record filters
+			batchable = false;
+		}
+	}
+
+	IndexLookupBatch *batch = NULL;
+	if(batchable && key != NULL) {
+		FT_FilterNode *shared_filters = FilterTree_Combine(shared,
+				array_len(shared));
+		batch = IndexLookupBatch_New(AR_EXP_Clone(key), AR_EXP_Clone(attr),
+				shared_filters, stride);
+	}
+
+	array_free(shared);
+	array_free(trees);
+
+	return batch;
+}
+
+// returns the key index of 'v', adding it to the batch's keys if missing
+static int _AddKey
+(
+	IndexLookupBatch *batch,  // batch
+	SIValue v                 // looked up value
+) {
+	// nothing equals NULL
+	if(SIValue_IsNull(v)) return LOOKUP_NO_MATCH;
+	if(!_BatchableValue(v)) return LOOKUP_SEPARATE;
+
+	XXH64_hash_t hash = SIValue_HashCode(v);
+
+	int head = -1;
+	dictEntry *existing;
+	dictEntry *entry = HashTableAddRaw(batch->lookup, (void *)hash, &existing);
+	if(entry == NULL) {
+		// hash seen before, look for an equal key
+		entry = existing;
+		head = (intptr_t)HashTableGetVal(entry);
+		for(int k = head; k != -1; k = batch->next_key[k]) {
+			if(SIValue_Compare(batch->keys[k], v, NULL) == 0) return k;
+		}
+	}
+
+	int k = array_len(batch->keys);
+	array_append(batch->keys, SI_CloneValue(v));
+	array_append(batch->next_key, head);
+	array_append(batch->matches, array_new(EntityID, 0));
+	HashTableSetVal(batch->lookup, entry, (void *)(intptr_t)k);
+
+	return k;
+}
+
+bool IndexLookupBatch_Fill
+(
+	IndexLookupBatch *batch,
+	OpBase *child
+) {
+	ASSERT(batch != NULL);
+	ASSERT(child != NULL);
+
+	IndexLookupBatch_Clear(batch);
+	if(batch->depleted) return false;
+
+	while(array_len(batch->records) < INDEX_LOOKUP_BATCH_SIZE) {
+		Record r = OpBase_Consume(child);
+		if(r == NULL) {
+			batch->depleted = true;
+			break;
+		}
+
+		array_append(batch->records, r);
+
+		SIValue v = AR_EXP_Evaluate(batch->key, r);
+		array_append(batch->record_keys, _AddKey(batch, v));
+		SIValue_Free(v);
+	}
+
+	return array_len(batch->records) > 0;
+}
+
+RSQNode *IndexLookupBatch_BuildQuery
+(
+	IndexLookupBatch *batch,
+	Index idx
+) {
+	ASSERT(idx   != NULL);
+	ASSERT(batch != NULL);
+
+	uint n = array_len(batch->keys);
+	if(n == 0) return NULL;
+
+	// attr IN [distinct keys]
+	SIValue list = SIArray_New(n);
+	for(uint i = 0; i < n; i++) SIArray_Append(&list, batch->keys[i]);
+
+	AR_ExpNode *in = AR_EXP_NewOpNode("in", true, 2);
+	in->op.children[0] = AR_EXP_Clone(batch->attr);
+	in->op.children[1] = AR_EXP_NewConstOperandNode(list);
+
+	FT_FilterNode *tree = FilterTree_CreateExpressionFilter(in);
+	if(batch->filter != NULL) {
+		FT_FilterNode *and = FilterTree_CreateConditionFilter(OP_AND);
+		FilterTree_AppendLeftChild(and, FilterTree_Clone(batch->filter));
+		FilterTree_AppendRightChild(and, tree);
+		tree = and;
+	}
+
+	RSQNode *root = Index_BuildQueryTree(&batch->unresolved, idx, tree);
+	FilterTree_Free(tree);
+
+	return root;
+}
+
+void IndexLookupBatch_Route
+(
+	IndexLookupBatch *batch,
+	SIValue v,
+	const EntityID *match
+) {
+	ASSERT(batch != NULL);
+	ASSERT(match != NULL);
+
+	if(!(SI_TYPE(v) & (T_STRING | SI_NUMERIC | T_BOOL))) return;
+
+	XXH64_hash_t hash = SIValue_HashCode(v);
+	dictEntry *entry = HashTableFind(batch->lookup, (void *)hash);
+	if(entry == NULL) return;
+
+	for(int k = (intptr_t)HashTableGetVal(entry); k != -1;
+			k = batch->next_key[k]) {
+		if(SIValue_Compare(batch->keys[k], v, NULL) == 0) {
+			for(uint i = 0; i < batch->stride; i++) {
+				array_append(batch->matches[k], match[i]);
+			}
+			return;
+		}
+	}
+}
+
+Record IndexLookupBatch_NextRecord
+(
+	IndexLookupBatch *batch,
+	bool *separate
+) {
+	ASSERT(batch    != NULL);
+	ASSERT(separate != NULL);
+
+	if(batch->record_idx >= array_len(batch->records)) return NULL;
+
+	uint i = batch->record_idx++;
+	Record r = batch->records[i];
+	batch->records[i] = NULL;  // ownership passed to caller
+
+	batch->match_idx   = 0;
+	batch->current_key = batch->record_keys[i];
+	*separate = (batch->current_key == LOOKUP_SEPARATE);
+
+	return r;
+}
+
+const EntityID *IndexLookupBatch_NextMatch
+(
+	IndexLookupBatch *batch
+) {
+	ASSERT(batch != NULL);
+
+	if(batch->current_key < 0) return NULL;
+
+	EntityID *matches = batch->matches[batch->current_key];
+	if(batch->match_idx >= array_len(matches)) return NULL;
+
+	const EntityID *match = matches + batch->match_idx;
+	batch->match_idx += batch->stride;
+
+	return match;
+}
+
+void IndexLookupBatch_Clear
+(
+	IndexLookupBatch *batch
+) {
+	ASSERT(batch != NULL);
+
+	// free records which weren't handed out
+	uint n = array_len(batch->records);
+	for(uint i = batch->record_idx; i < n; i++) {
+		OpBase_DeleteRecord(batch->records[i]);
+	}
+
+	n = array_len(batch->keys);
+	for(uint i = 0; i < n; i++) {
+		SIValue_Free(batch->keys[i]);
+		array_free(batch->matches[i]);
+	}
+
+	if(batch->unresolved != NULL) {
+		FilterTree_Free(batch->unresolved);
+		batch->unresolved = NULL;
+	}
+
+	array_clear(batch->keys);
+	array_clear(batch->matches);
+	array_clear(batch->records);
+	array_clear(batch->next_key);
+	array_clear(batch->record_keys);
+	HashTableEmpty(batch->lookup, NULL);
+
+	batch->match_idx   = 0;
+	batch->record_idx  = 0;
+	batch->current_key = LOOKUP_NO_MATCH;
+}
+
+void IndexLookupBatch_Reset
+(
+	IndexLookupBatch *batch
+) {
+	ASSERT(batch != NULL);
+
+	IndexLookupBatch_Clear(batch);
+	batch->depleted = false;
+}
+
+void IndexLookupBatch_Free
+(
+	IndexLookupBatch *batch
+) {
+	ASSERT(batch != NULL);
+
+	IndexLookupBatch_Clear(batch);
+
+	array_free(batch->keys);
+	array_free(batch->matches);
+	array_free(batch->records);
+	array_free(batch->next_key);
+	array_free(batch->record_keys);
+	HashTableRelease(batch->lookup);
+
+	AR_EXP_Free(batch->key);
+	AR_EXP_Free(batch->attr);
+	if(batch->filter != NULL) FilterTree_Free(batch->filter);
+
+	rm_free(batch);
+}
+
@@ -0,0 +1,118 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../op.h"
+#include "../../../util/dict.h"
+#include "../../../index/index.h"
+#include "../../../filter_tree/filter_tree.h"
+
+// maximum number of input records resolved by a single index query
+#define INDEX_LOOKUP_BATCH_SIZE 1024
+
+// batched index lookups
+// an index scan consuming from a child whose filter compares an indexed
+// attribute with a per-record value issues a single query per batch of
+// input records, looking up all of the batch's distinct values at once
+// each match is routed back to the records holding its value
+typedef struct {
+	AR_ExpNode *key;            // evaluates the looked up value of a record
+	AR_ExpNode *attr;           // looked up attribute access, e.g. n.v
+	const char *attr_name;      // looked up attribute name
+	FT_FilterNode *filter;      // [optional] filters shared by all records
+	FT_FilterNode *unresolved;  // filters the batch query doesn't resolve
+	uint stride;                // number of IDs per match
+	Record *records;            // batched input records
+	int *record_keys;           // key index of each record
+	SIValue *keys;              // distinct looked up values
+	int *next_key;              // next key sharing the same hash
+	EntityID **matches;         // matched IDs per key
+	dict *lookup;               // value hash to key index
+	uint record_idx;            // next record to hand out
+	uint match_idx;             // next match of the current record
+	int current_key;            // key index of the current record
+	bool depleted;              // child is depleted
+} IndexLookupBatch;
+
+// creates a batch looking up 'attr' with the value 'key' evaluates to
+// takes ownership of 'key', 'attr' and 'filter'
+IndexLookupBatch *IndexLookupBatch_New
+(
+	AR_ExpNode *key,        // per record looked up value
+	AR_ExpNode *attr,       // looked up attribute access
+	FT_FilterNode *filter,  // [optional] filters shared by all records
+	uint stride             // number of IDs per match
+);
+
+// creates a batch from 'filter' if it consists of filters on 'alias' only
+// and a single equality between an attribute of 'alias' and an expression
+// over other aliases, returns NULL otherwise
+IndexLookupBatch *IndexLookupBatch_FromFilter
+(
+	const FT_FilterNode *filter,  // index scan filter
+	const char *alias,            // scanned alias
+	uint stride                   // number of IDs per match
+);
+
+// pulls the next batch of records from 'child'
+// returns false if child is depleted
+bool IndexLookupBatch_Fill
+(
+	IndexLookupBatch *batch,  // batch
+	OpBase *child             // operation to pull from
+);
+
+// builds a query looking up each distinct value in the current batch
+// filters the query doesn't resolve are kept in 'batch->unresolved'
+// returns NULL if there's nothing to look up
+RSQNode *IndexLookupBatch_BuildQuery
+(
+	IndexLookupBatch *batch,  // batch
+	Index idx                 // queried index
+);
+
+// routes a match whose looked up attribute holds 'v' to its records
+void IndexLookupBatch_Route
+(
+	IndexLookupBatch *batch,  // batch
+	SIValue v,                // matched attribute value
+	const EntityID *match     // matched IDs, 'stride' long
+);
+
+// hands out the next record of the batch, NULL if the batch is consumed
+// 'separate' is set if the record's value can't be batched and the record
+// must be resolved by its own lookup
+Record IndexLookupBatch_NextRecord
+(
+	IndexLookupBatch *batch,  // batch
+	bool *separate            // [out] record requires its own lookup
+);
+
+// returns the next match of the last handed out record, NULL if none remain
+const EntityID *IndexLookupBatch_NextMatch
+(
+	IndexLookupBatch *batch  // batch
+);
+
+// discards the current batch
+void IndexLookupBatch_Clear
+(
+	IndexLookupBatch *batch  // batch
+);
+
+// discards the current batch and allows pulling from the child again
+void IndexLookupBatch_Reset
+(
+	IndexLookupBatch *batch  // batch
+);
+
+// frees batch
+void IndexLookupBatch_Free
+(
+	IndexLookupBatch *batch  // batch
+);
+
@@ -22,6 +22,10 @@ NodeScanCtx *NodeScanCtx_New
     ctx->label = label;
     ctx->label_id = label_id;
     ctx->n = QGNode_Clone(n);
+    ctx->hint = SCAN_HINT_NONE;
+    ctx->hint_label = NULL;
+    ctx->hint_attr = NULL;
+    ctx->hint_unmet = NULL;
 
     return ctx;
 }
@@ -9,12 +9,23 @@
 #include "../../../graph/entities/node.h"
 #include "../../../graph/entities/qg_node.h"
 
+// planner hint specified for a scanned node
+typedef enum {
+	SCAN_HINT_NONE = 0,  // no hint, planner is free to choose
+	SCAN_HINT_INDEX,     // USING INDEX, resolve node via an index lookup
+	SCAN_HINT_SCAN,      // USING SCAN, resolve node via a label scan
+} ScanHint;
+
 // Storage struct for label data in node and index scans.
 typedef struct {
-	QGNode *n;          // node to scan (might hold multiple labels)
-	LabelID label_id;   // label ID of the node being traversed
-	const char *alias;  // alias of the node being traversed
-	const char *label;  // label of the node being traversed
+	QGNode *n;               // node to scan (might hold multiple labels)
+	LabelID label_id;        // label ID of the node being traversed
+	const char *alias;       // alias of the node being traversed
+	const char *label;       // label of the node being traversed
+	ScanHint hint;           // planner hint
+	const char *hint_label;  // hinted label
+	const char *hint_attr;   // hinted attribute, USING INDEX only
+	const char *hint_unmet;  // reason hint couldn't be honored, NULL if met
 } NodeScanCtx;
 
 // allocates and returns a new context
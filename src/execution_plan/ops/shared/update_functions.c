@@ -38,6 +38,39 @@ static bool _ValidateAttrType
 	return true;
 }
 
+// entities modified under a single schema
+typedef struct {
+	GraphEntity **entities;  // modified entities
+	Attribute_ID **attrs;    // modified attributes of each entity
+} SchemaChanges;
+
+// returns true if 'update' adds the label of schema 's'
+static bool _AddsLabel
+(
+	const PendingUpdateCtx *update,  // update
+	const Schema *s                  // schema
+) {
+	const char *name = Schema_GetName(s);
+	uint n = array_len(update->add_labels);
+	for(uint i = 0; i < n; i++) {
+		if(strcmp(update->add_labels[i], name) == 0) return true;
+	}
+	return false;
+}
+
+// records 'attr_id' as modified by 'update'
+static void _AttributeChanged
+(
+	PendingUpdateCtx *update,  // update
+	Attribute_ID attr_id       // modified attribute
+) {
+	uint n = array_len(update->attrs_changed);
+	for(uint i = 0; i < n; i++) {
+		if(update->attrs_changed[i] == attr_id) return;
+	}
+	array_append(update->attrs_changed, attr_id);
+}
+
 // commits delayed updates
 void CommitUpdates
 (
@@ -49,12 +82,18 @@ void CommitUpdates
 	ASSERT(updates != NULL);
 	ASSERT(type    != ENTITY_UNKNOWN);
 
-	uint update_count         = HashTableElemCount(updates);
-	bool constraint_violation = false;
+	uint update_count = HashTableElemCount(updates);
 
 	// return early if no updates are enqueued
 	if(update_count == 0) return;
 
+	SchemaType stype = type == ENTITY_NODE ? SCHEMA_NODE : SCHEMA_EDGE;
+
+	// modified entities grouped by schema
+	// constraints are enforced once all updates are applied
+	uint schema_count = GraphContext_SchemaCount(gc, stype);
+	SchemaChanges *changes = rm_calloc(schema_count, sizeof(SchemaChanges));
+
 	dictEntry *entry;
 	dictIterator *it = HashTableGetIterator(updates);
 	MATRIX_POLICY policy = Graph_GetMatrixPolicy(gc->g);
@@ -80,41 +119,76 @@ void CommitUpdates
 		}
 
 		//----------------------------------------------------------------------
-		// enforce constraints
+		// collect constraint enforcement
 		//----------------------------------------------------------------------
 
-		if(constraint_violation == false) {
-			// retrieve labels/rel-type
-			uint label_count = 1;
-			if (type == ENTITY_NODE) {
-				label_count = Graph_LabelTypeCount(gc->g);
-			}
-			LabelID labels[label_count];
-			if (type == ENTITY_NODE) {
-				label_count = Graph_GetNodeLabels(gc->g, (Node*)update->ge, labels,
-						label_count);
-			} else {
-				labels[0] = Edge_GetRelationID((Edge*)update->ge);
+		// retrieve labels/rel-type
+		uint label_count = 1;
+		if (type == ENTITY_NODE) {
+			label_count = Graph_LabelTypeCount(gc->g);
+		}
+		LabelID labels[label_count];
+		if (type == ENTITY_NODE) {
+			label_count = Graph_GetNodeLabels(gc->g, (Node*)update->ge, labels,
+					label_count);
+		} else {
+			labels[0] = Edge_GetRelationID((Edge*)update->ge);
+		}
+
+		for(uint i = 0; i < label_count; i ++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[i], stype);
+			if(!Schema_HasConstraints(s)) continue;
+
+			// only constraints over modified attributes are affected
+			// unless the entity is new to the schema
+			Attribute_ID *attrs = update->attrs_changed;
+			if(_AddsLabel(update, s)) {
+				attrs = NULL;
+			} else if(array_len(attrs) == 0) {
+				continue;
 			}
 
-			SchemaType stype = type == ENTITY_NODE ? SCHEMA_NODE : SCHEMA_EDGE;
-			for(uint i = 0; i < label_count; i ++) {
-				Schema *s = GraphContext_GetSchemaByID(gc, labels[i], stype);
-				// TODO: a bit wasteful need to target relevant constraints only
-				char *err_msg = NULL;
-				if(!Schema_EnforceConstraints(s, update->ge, &err_msg)) {
-					// constraint violation
-					ASSERT(err_msg != NULL);
-					constraint_violation = true;
-					ErrorCtx_SetError("%s", err_msg);
-					free(err_msg);
-					break;
-				}
+			// schemas created by this commit hold no constraints
+			ASSERT(labels[i] < schema_count);
+			SchemaChanges *schema_changes = changes + labels[i];
+			if(schema_changes->entities == NULL) {
+				schema_changes->entities = array_new(GraphEntity *, 1);
+				schema_changes->attrs    = array_new(Attribute_ID *, 1);
 			}
+			array_append(schema_changes->entities, update->ge);
+			array_append(schema_changes->attrs, attrs);
 		}
 	}
 	Graph_SetMatrixPolicy(gc->g, policy);
 	HashTableReleaseIterator(it);
+
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
+
+	bool constraint_violation = false;
+	for(uint i = 0; i < schema_count; i++) {
+		SchemaChanges *schema_changes = changes + i;
+		if(schema_changes->entities == NULL) continue;
+
+		if(!constraint_violation) {
+			Schema *s = GraphContext_GetSchemaByID(gc, i, stype);
+			char *err_msg = NULL;
+			if(!Schema_EnforceConstraintsOnChanges(s, schema_changes->entities,
+						schema_changes->attrs,
+						array_len(schema_changes->entities), &err_msg)) {
+				// constraint violation
+				ASSERT(err_msg != NULL);
+				constraint_violation = true;
+				ErrorCtx_SetError("%s", err_msg);
+				free(err_msg);
+			}
+		}
+
+		array_free(schema_changes->entities);
+		array_free(schema_changes->attrs);
+	}
+	rm_free(changes);
 }
 
 // build pending updates in the 'updates' array to match all
@@ -179,9 +253,11 @@ void EvalEntityUpdates
 		// create a new update context
 		update = rm_malloc(sizeof(PendingUpdateCtx));
 		update->ge            = entity;
-		update->attributes    = AttributeSet_ShallowClone(*entity->attributes);
+		update->attributes    = AttributeSet_ShallowClone(
+				GraphEntity_GetAttributes(entity));
 		update->add_labels    = NULL;
 		update->remove_labels = NULL;
+		update->attrs_changed = array_new(Attribute_ID, 0);
 		// add update context to updates dictionary
 		HashTableAdd(updates, (void *)ENTITY_GET_ID(entity), update);
 	} else {
@@ -257,16 +333,19 @@ void EvalEntityUpdates
 					// attribute removed
 					EffectsBuffer_AddEntityRemoveAttributeEffect(eb, entity,
 							attr_id, entity_type);
+					_AttributeChanged(update, attr_id);
 					continue;
 				case CT_ADD:
 					// attribute added
 					EffectsBuffer_AddEntityAddAttributeEffect(eb, entity,
 							attr_id, v, entity_type);
+					_AttributeChanged(update, attr_id);
 					break;
 				case CT_UPDATE:
 					// attribute update
 					EffectsBuffer_AddEntityUpdateAttributeEffect(eb, entity,
 							attr_id, v, entity_type);
+					_AttributeChanged(update, attr_id);
 					break;
 				case CT_NONE:
 					// no change
@@ -296,6 +375,7 @@ void EvalEntityUpdates
 			EffectsBuffer_AddEntityRemoveAttributeEffect(eb, entity,
 							ATTRIBUTE_ID_ALL, entity_type);
 			AttributeSet_Free(entity->attributes);
+			_AttributeChanged(update, ATTRIBUTE_ID_ALL);
 		}
 
 		//----------------------------------------------------------------------
@@ -326,16 +406,19 @@ void EvalEntityUpdates
 						// attribute removed
 						EffectsBuffer_AddEntityRemoveAttributeEffect(eb, entity,
 								attr_id, entity_type);
+						_AttributeChanged(update, attr_id);
 						break;
 					case CT_ADD:
 						// attribute added
 						EffectsBuffer_AddEntityAddAttributeEffect(eb, entity,
 								attr_id, value, entity_type);
+						_AttributeChanged(update, attr_id);
 						break;
 					case CT_UPDATE:
 						// attribute update
 						EffectsBuffer_AddEntityUpdateAttributeEffect(eb, entity,
 								attr_id, value, entity_type);
+						_AttributeChanged(update, attr_id);
 						break;
 					case CT_NONE:
 						// no change
@@ -374,11 +457,13 @@ void EvalEntityUpdates
 					// attribute added
 					EffectsBuffer_AddEntityAddAttributeEffect(eb, entity,
 							attr_id, v, entity_type);
+					_AttributeChanged(update, attr_id);
 					break;
 				case CT_UPDATE:
 					// attribute update
 					EffectsBuffer_AddEntityUpdateAttributeEffect(eb, entity,
 							attr_id, v, entity_type);
+					_AttributeChanged(update, attr_id);
 					break;
 				default:
 					break;
@@ -404,5 +489,6 @@ void PendingUpdateCtx_Free
 	AttributeSet_Free(&ctx->attributes);
 	array_free(ctx->add_labels);
 	array_free(ctx->remove_labels);
+	array_free(ctx->attrs_changed);
 	rm_free(ctx);
 }
@@ -0,0 +1,99 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../execution_plan_build/execution_plan_util.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// aggregate range indexed attributes from index columns
+//
+// MATCH (n:L) RETURN sum(n.v), avg(n.w)
+//
+// Aggregate
+//     Node By Label Scan | (n:L)
+//
+// when both 'v' and 'w' are range indexed the label scan and aggregation
+// are replaced by a single Column Aggregate operation reading the
+// attributes from the columns maintained by the index
+//
+// Column Aggregate | (n:L)
+
+// returns true if each of the aggregation's expressions aggregates
+// a range indexed attribute of the scanned label
+static bool _ColumnsAvailable
+(
+	const OpAggregate *aggregate,  // aggregation
+	const NodeScanCtx *n           // scanned node
+) {
+	if(aggregate->aggregate_count == 0) return false;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, n->label, SCHEMA_NODE);
+	if(s == NULL) return false;
+
+	Index idx = ACTIVE_IDX(s);
+	if(idx == NULL || !Index_Enabled(idx)) return false;
+
+	for(uint i = 0; i < aggregate->aggregate_count; i++) {
+		Attribute_ID attr = ColumnAggregate_AggregatedAttribute(
+				aggregate->aggregate_exps[i], n->alias);
+		if(attr == ATTRIBUTE_ID_NONE) return false;
+		if(Index_GetColumn(idx, attr) == NULL) return false;
+	}
+
+	return true;
+}
+
+void aggregateColumns
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OpBase **aggregations = ExecutionPlan_CollectOps(plan->root,
+			OPType_AGGREGATE);
+
+	uint n = array_len(aggregations);
+	for(uint i = 0; i < n; i++) {
+		OpAggregate *aggregate = (OpAggregate *)aggregations[i];
+
+		// a single group, fed by a label scan
+		if(aggregate->key_count != 0 || aggregate->factor_idx != -1) continue;
+		if(aggregate->op.childCount != 1) continue;
+
+		OpBase *child = aggregate->op.children[0];
+		if(OpBase_Type(child) != OPType_NODE_BY_LABEL_SCAN) continue;
+		if(child->childCount != 0) continue;
+		if(child->plan != aggregate->op.plan) continue;
+
+		NodeByLabelScan *scan = (NodeByLabelScan *)child;
+		if(scan->id_range != NULL) continue;
+
+		// honor USING SCAN
+		if(scan->n->hint == SCAN_HINT_SCAN) continue;
+
+		if(!_ColumnsAvailable(aggregate, scan->n)) continue;
+
+		AR_ExpNode **exps = array_new(AR_ExpNode *, aggregate->aggregate_count);
+		for(uint j = 0; j < aggregate->aggregate_count; j++) {
+			array_append(exps, AR_EXP_Clone(aggregate->aggregate_exps[j]));
+		}
+
+		OpBase *op = NewColumnAggregateOp(aggregate->op.plan, scan->n->alias,
+				scan->n->label, exps);
+
+		ExecutionPlan_RemoveOp(plan, child);
+		OpBase_Free(child);
+
+		ExecutionPlan_ReplaceOp(plan, (OpBase *)aggregate, op);
+		OpBase_Free((OpBase *)aggregate);
+	}
+
+	array_free(aggregations);
+}
+
@@ -33,6 +33,9 @@
 //
 // Scan(B)
 // Traverse A*R
+//
+// a USING INDEX / USING SCAN hint overrides the label selection
+// in which case the hinted label is scanned
 
 static void _costBaseLabelScan
 (
@@ -60,17 +63,34 @@ static void _costBaseLabelScan
 	// find label with minimum entities
 	int min_label_id = n_ctx->label_id;
 	const char *min_label_str = n_ctx->label;
-	uint64_t min_nnz =(uint64_t) Graph_LabeledNodeCount(g, n_ctx->label_id);
-
-	for(uint i = 0; i < label_count; i++) {
-		uint64_t nnz;
-		int label_id = QGNode_GetLabelID(n, i);
-		nnz = Graph_LabeledNodeCount(g, label_id);
-		if(min_nnz > nnz) {
-			// update minimum
-			min_nnz       = nnz;
-			min_label_id  = label_id;
-			min_label_str = QGNode_GetLabel(n, i);
+
+	if(n_ctx->hint != SCAN_HINT_NONE) {
+		// planner hint dictates the scanned label
+		if(strcmp(n_ctx->label, n_ctx->hint_label) == 0) {
+			return;
+		}
+
+		for(uint i = 0; i < label_count; i++) {
+			if(strcmp(QGNode_GetLabel(n, i), n_ctx->hint_label) == 0) {
+				min_label_id  = QGNode_GetLabelID(n, i);
+				min_label_str = QGNode_GetLabel(n, i);
+				break;
+			}
+		}
+	} else {
+		uint64_t min_nnz =
+			(uint64_t) Graph_LabeledNodeCount(g, n_ctx->label_id);
+
+		for(uint i = 0; i < label_count; i++) {
+			uint64_t nnz;
+			int label_id = QGNode_GetLabelID(n, i);
+			nnz = Graph_LabeledNodeCount(g, label_id);
+			if(min_nnz > nnz) {
+				// update minimum
+				min_nnz       = nnz;
+				min_label_id  = label_id;
+				min_label_str = QGNode_GetLabel(n, i);
+			}
 		}
 	}
 
@@ -0,0 +1,277 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../../deps/rax/rax.h"
+#include "../execution_plan_build/execution_plan_util.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// alias under which the body of a decorrelated subquery projects its join key
+#define DECORRELATED_KEY "__decorrelated_key"
+
+// decorrelate subqueries which depend on their single imported variable
+// only through an equality filter
+//
+// UNWIND $ids AS x
+// CALL {
+//     WITH x
+//     MATCH (n:L) WHERE n.k = x
+//     RETURN n.v AS v
+// }
+// RETURN x, v
+//
+// CallSubquery
+//     Unwind
+//     Project
+//         Filter
+//             Node By Label Scan | (n:L)
+//                 Project
+//                     Argument
+//
+// the body is evaluated once per input record, scanning L over and over
+// instead the body is evaluated once without the import, projecting n.k
+// which is joined with the imported variable
+//
+// Value Hash Join | x = __decorrelated_key
+//     Unwind
+//     Project
+//         Node By Label Scan | (n:L)
+//             Project
+//
+// a subquery is left as is when it modifies the graph, is batched, doesn't
+// return, orders, limits, aggregates or refers to the imported variable
+// other than through the equality filter
+// subqueries resolvable via an index lookup per input record are kept too
+
+// returns true if 'exp' refers to 'alias'
+static bool _ExpReferences
+(
+	AR_ExpNode *exp,   // expression
+	const char *alias  // alias
+) {
+	rax *entities = raxNew();
+	AR_EXP_CollectEntities(exp, entities);
+	bool referenced = raxFind(entities, (unsigned char *)alias, strlen(alias))
+		!= raxNotFound;
+	raxFree(entities);
+
+	return referenced;
+}
+
+// returns true if 'filter' refers to 'alias'
+static bool _FilterReferences
+(
+	const FT_FilterNode *filter,  // filter tree
+	const char *alias             // alias
+) {
+	rax *entities = FilterTree_CollectModified(filter);
+	bool referenced = raxFind(entities, (unsigned char *)alias, strlen(alias))
+		!= raxNotFound;
+	raxFree(entities);
+
+	return referenced;
+}
+
+// returns the side of an equality filter 'alias = exp' or 'exp = alias'
+// which doesn't refer to 'alias', NULL if the filter isn't of that form
+static AR_ExpNode *_EqualityKey
+(
+	const FT_FilterNode *filter,  // filter tree
+	const char *alias             // imported alias
+) {
+	if(filter->t != FT_N_PRED || filter->pred.op != OP_EQUAL) return NULL;
+
+	AR_ExpNode *lhs = filter->pred.lhs;
+	AR_ExpNode *rhs = filter->pred.rhs;
+
+	if(AR_EXP_IsVariadic(lhs) &&
+	   strcmp(lhs->operand.variadic.entity_alias, alias) == 0 &&
+	   !_ExpReferences(rhs, alias)) {
+		return rhs;
+	}
+
+	if(AR_EXP_IsVariadic(rhs) &&
+	   strcmp(rhs->operand.variadic.entity_alias, alias) == 0 &&
+	   !_ExpReferences(lhs, alias)) {
+		return lhs;
+	}
+
+	return NULL;
+}
+
+// returns true if 'key' is an attribute of the node scanned by 'scan'
+// which is indexed, in which case each input record is resolved by an
+// index lookup and decorrelation isn't worthwhile
+static bool _IndexedKey
+(
+	AR_ExpNode *key,  // join key expression
+	OpBase *scan      // scan op at the bottom of the body
+) {
+	if(OpBase_Type(scan) != OPType_NODE_BY_LABEL_SCAN) return false;
+
+	char *attr;
+	if(!AR_EXP_IsAttribute(key, &attr)) return false;
+
+	NodeByLabelScan *label_scan = (NodeByLabelScan *)scan;
+	AR_ExpNode *entity = key->op.children[0];
+	if(!AR_EXP_IsVariadic(entity) ||
+	   strcmp(entity->operand.variadic.entity_alias, label_scan->n->alias) != 0) {
+		return false;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return false;
+
+	return GraphContext_GetIndex(gc, label_scan->n->label, &attr_id, 1,
+			INDEX_FLD_RANGE, SCHEMA_NODE) != NULL;
+}
+
+static void _DecorrelateSubquery
+(
+	ExecutionPlan *plan,       // plan to update
+	OpCallSubquery *call       // subquery to decorrelate
+) {
+	if(call->is_eager || !call->is_returning || call->batch_size_exp != NULL) {
+		return;
+	}
+
+	// subquery must import variables from its input stream
+	if(OpBase_ChildCount((OpBase *)call) != 2) return;
+
+	// returning projection
+	OpBase *ret = OpBase_GetChild((OpBase *)call, 1);
+	if(OpBase_Type(ret) != OPType_PROJECT || ret->childCount != 1) return;
+
+	// walk down the body up to the scan tapping into the importing projection
+	OpBase *filter = NULL;
+	OpBase *scan   = NULL;
+	OpBase *op     = OpBase_GetChild(ret, 0);
+	while(scan == NULL) {
+		if(op->childCount != 1) return;
+
+		switch(OpBase_Type(op)) {
+			case OPType_ALL_NODE_SCAN:
+			case OPType_NODE_BY_LABEL_SCAN:
+				scan = op;
+				break;
+			case OPType_FILTER:
+			case OPType_EXPAND_INTO:
+			case OPType_CONDITIONAL_TRAVERSE:
+				op = OpBase_GetChild(op, 0);
+				break;
+			default:
+				return;
+		}
+	}
+
+	// importing projection of a single variable fed by an argument
+	OpProject *import = (OpProject *)OpBase_GetChild(scan, 0);
+	if(OpBase_Type((OpBase *)import) != OPType_PROJECT ||
+	   import->exp_count != 1 ||
+	   import->op.childCount != 1 ||
+	   OpBase_Type(OpBase_GetChild((OpBase *)import, 0)) != OPType_ARGUMENT) {
+		return;
+	}
+
+	AR_ExpNode *imported = import->exps[0];
+	if(!AR_EXP_IsVariadic(imported) ||
+	   strcmp(imported->operand.variadic.entity_alias,
+		   imported->resolved_name) != 0) {
+		return;
+	}
+	const char *alias = imported->resolved_name;
+
+	// the imported variable must only be referenced by a single equality
+	AR_ExpNode *key = NULL;
+	for(op = OpBase_GetChild(ret, 0); op != scan; op = OpBase_GetChild(op, 0)) {
+		if(OpBase_Type(op) == OPType_FILTER) {
+			FT_FilterNode *tree = ((OpFilter *)op)->filterTree;
+			if(!_FilterReferences(tree, alias)) continue;
+
+			// multiple filters refer to the imported variable
+			if(filter != NULL) return;
+
+			key = _EqualityKey(tree, alias);
+			if(key == NULL) return;
+			filter = op;
+		} else {
+			AlgebraicExpression *ae = (OpBase_Type(op) == OPType_EXPAND_INTO) ?
+				((OpExpandInto *)op)->ae :
+				((OpCondTraverse *)op)->ae;
+			if(strcmp(AlgebraicExpression_Src(ae), alias) == 0 ||
+			   strcmp(AlgebraicExpression_Dest(ae), alias) == 0) {
+				return;
+			}
+		}
+	}
+
+	if(filter == NULL) return;
+
+	OpProject *project = (OpProject *)ret;
+	for(uint i = 0; i < project->exp_count; i++) {
+		if(_ExpReferences(project->exps[i], alias)) return;
+	}
+
+	// keep per record index lookups
+	if(_IndexedKey(key, scan)) return;
+
+	//--------------------------------------------------------------------------
+	// rewrite
+	//--------------------------------------------------------------------------
+
+	// project the join key along with the returned expressions
+	AR_ExpNode **exps = array_new(AR_ExpNode *, project->exp_count + 1);
+	for(uint i = 0; i < project->exp_count; i++) {
+		array_append(exps, AR_EXP_Clone(project->exps[i]));
+	}
+	AR_ExpNode *key_exp = AR_EXP_Clone(key);
+	key_exp->resolved_name = DECORRELATED_KEY;
+	array_append(exps, key_exp);
+
+	OpBase *new_ret = NewProjectOp(ret->plan, exps);
+	ExecutionPlan_ReplaceOp(plan, ret, new_ret);
+	OpBase_Free(ret);
+
+	// the correlating filter is replaced by the join
+	ExecutionPlan_RemoveOp(plan, filter);
+	OpBase_Free(filter);
+
+	// the body no longer imports, scan directly
+	OpBase *argument = OpBase_GetChild((OpBase *)import, 0);
+	ExecutionPlan_RemoveOp(plan, argument);
+	OpBase_Free(argument);
+	ExecutionPlan_RemoveOp(plan, (OpBase *)import);
+	OpBase_Free((OpBase *)import);
+
+	// join input records with the body's records on the imported variable
+	OpBase *join = NewValueHashJoin(call->op.plan,
+			AR_EXP_NewVariableOperandNode(alias),
+			AR_EXP_NewVariableOperandNode(DECORRELATED_KEY));
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)call, join);
+	OpBase_Free((OpBase *)call);
+}
+
+void decorrelateSubqueries
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OpBase **calls = ExecutionPlan_CollectOps(plan->root,
+			OPType_CALLSUBQUERY);
+
+	uint n = array_len(calls);
+	for(uint i = 0; i < n; i++) {
+		_DecorrelateSubquery(plan, (OpCallSubquery *)calls[i]);
+	}
+
+	array_free(calls);
+}
+
@@ -0,0 +1,337 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+#include "../execution_plan_build/execution_plan_util.h"
+
+// evaluate repeated subexpressions once per record
+//
+// MATCH (n:L) WHERE n.price * n.qty > 100 RETURN n.price * n.qty AS total
+//
+// Project
+//     Filter
+//         Node By Label Scan | (n:L)
+//
+// both the filter and the projection compute 'n.price * n.qty'
+// instead the first evaluation stores its value in a hidden record entry
+// which the second evaluation shares
+//
+// the scope of the optimization is a projection or an aggregation
+// and the filters below it which operate on the same records,
+// scopes end at operations which modify the graph or merge multiple streams
+//
+// a WITH projection is the first operation of its segment while the records
+// it evaluates are built by the previous segment, cached values are
+// allocated within the record mapping of the records the scope receives
+
+// hidden record entries holding cached values
+static const char *CACHED_ALIASES[] = {
+	"__cse_0",  "__cse_1",  "__cse_2",  "__cse_3",
+	"__cse_4",  "__cse_5",  "__cse_6",  "__cse_7",
+	"__cse_8",  "__cse_9",  "__cse_10", "__cse_11",
+	"__cse_12", "__cse_13", "__cse_14", "__cse_15"
+};
+
+#define CACHED_ALIAS_COUNT (sizeof(CACHED_ALIASES) / sizeof(CACHED_ALIASES[0]))
+
+// a group of identical subexpressions
+typedef struct {
+	const AR_ExpNode *exp;  // representative expression
+	uint count;             // number of occurrences
+	const char *alias;      // hidden alias, NULL if not cached
+} ExpGroup;
+
+// returns true if 'a' and 'b' are structurally identical
+static bool _SameExpression
+(
+	const AR_ExpNode *a,
+	const AR_ExpNode *b
+) {
+	// compare cached expressions by their content
+	if(a->type == AR_EXP_OPERAND && a->operand.type == AR_EXP_CACHED) {
+		a = a->operand.cached.exp;
+	}
+	if(b->type == AR_EXP_OPERAND && b->operand.type == AR_EXP_CACHED) {
+		b = b->operand.cached.exp;
+	}
+
+	if(a->type != b->type) return false;
+
+	if(a->type == AR_EXP_OP) {
+		if(a->op.f != b->op.f || a->op.child_count != b->op.child_count) {
+			return false;
+		}
+		for(int i = 0; i < a->op.child_count; i++) {
+			if(!_SameExpression(a->op.children[i], b->op.children[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	if(a->operand.type != b->operand.type) return false;
+
+	switch(a->operand.type) {
+		case AR_EXP_CONSTANT:
+			return SI_TYPE(a->operand.constant) == SI_TYPE(b->operand.constant) &&
+				SIValue_Compare(a->operand.constant, b->operand.constant, NULL) == 0;
+		case AR_EXP_VARIADIC:
+			return strcmp(a->operand.variadic.entity_alias,
+					b->operand.variadic.entity_alias) == 0;
+		case AR_EXP_PARAM:
+			return strcmp(a->operand.param_name, b->operand.param_name) == 0;
+		default:
+			return false;
+	}
+}
+
+// returns true if the value of 'exp' depends only on the record's bound
+// variables, such that it can be computed once per record
+static bool _Cacheable
+(
+	const AR_ExpNode *exp
+) {
+	if(exp->type == AR_EXP_OPERAND) {
+		return exp->operand.type == AR_EXP_CONSTANT ||
+			exp->operand.type == AR_EXP_VARIADIC     ||
+			exp->operand.type == AR_EXP_PARAM;
+	}
+
+	// aggregations and functions holding private data
+	// e.g. list comprehensions, aren't fully described by their children
+	if(exp->op.f->aggregate || exp->op.private_data != NULL) return false;
+
+	// non-deterministic functions
+	if(strcasecmp(exp->op.f->name, "rand") == 0 ||
+	   strcasecmp(exp->op.f->name, "randomuuid") == 0) {
+		return false;
+	}
+
+	for(int i = 0; i < exp->op.child_count; i++) {
+		if(!_Cacheable(exp->op.children[i])) return false;
+	}
+
+	return true;
+}
+
+// returns true if 'exp' is worth caching
+static inline bool _Candidate
+(
+	const AR_ExpNode *exp
+) {
+	return AR_EXP_IsOperation(exp) && AR_EXP_ContainsVariadic(exp) &&
+		_Cacheable(exp);
+}
+
+static ExpGroup *_GetGroup
+(
+	ExpGroup *groups,
+	const AR_ExpNode *exp
+) {
+	uint n = array_len(groups);
+	for(uint i = 0; i < n; i++) {
+		if(_SameExpression(groups[i].exp, exp)) return groups + i;
+	}
+	return NULL;
+}
+
+// count occurrences of each candidate subexpression of 'exp'
+static void _CountSubexpressions
+(
+	ExpGroup **groups,
+	const AR_ExpNode *exp
+) {
+	if(!AR_EXP_IsOperation(exp)) return;
+
+	if(_Candidate(exp)) {
+		ExpGroup *group = _GetGroup(*groups, exp);
+		if(group != NULL) {
+			group->count++;
+		} else {
+			ExpGroup g = {.exp = exp, .count = 1, .alias = NULL};
+			array_append(*groups, g);
+		}
+	}
+
+	for(int i = 0; i < exp->op.child_count; i++) {
+		_CountSubexpressions(groups, exp->op.children[i]);
+	}
+}
+
+// cache the outermost repeated subexpressions of 'exp'
+static void _CacheSubexpressions
+(
+	ExpGroup *groups,
+	AR_ExpNode *exp,
+	uint *alias_count
+) {
+	if(!AR_EXP_IsOperation(exp)) return;
+
+	if(_Candidate(exp)) {
+		ExpGroup *group = _GetGroup(groups, exp);
+		ASSERT(group != NULL);
+
+		if(group->count > 1 &&
+		   (group->alias != NULL || *alias_count < CACHED_ALIAS_COUNT)) {
+			if(group->alias == NULL) {
+				group->alias = CACHED_ALIASES[(*alias_count)++];
+			}
+			AR_EXP_Cache(exp, group->alias);
+			return;
+		}
+	}
+
+	for(int i = 0; i < exp->op.child_count; i++) {
+		_CacheSubexpressions(groups, exp->op.children[i], alias_count);
+	}
+}
+
+static void _CollectFilterExpressions
+(
+	FT_FilterNode *tree,
+	AR_ExpNode ***exps
+) {
+	switch(tree->t) {
+		case FT_N_EXP:
+			array_append(*exps, tree->exp.exp);
+			break;
+		case FT_N_PRED:
+			array_append(*exps, tree->pred.lhs);
+			array_append(*exps, tree->pred.rhs);
+			break;
+		case FT_N_COND:
+			_CollectFilterExpressions(tree->cond.left, exps);
+			if(tree->cond.right != NULL) {
+				_CollectFilterExpressions(tree->cond.right, exps);
+			}
+			break;
+		default:
+			ASSERT(false);
+	}
+}
+
+// collect the arguments of aggregation functions within 'exp'
+static void _CollectAggregationArguments
+(
+	AR_ExpNode *exp,
+	AR_ExpNode ***exps
+) {
+	if(!AR_EXP_IsOperation(exp)) return;
+
+	for(int i = 0; i < exp->op.child_count; i++) {
+		if(exp->op.f->aggregate) {
+			array_append(*exps, exp->op.children[i]);
+		} else {
+			_CollectAggregationArguments(exp->op.children[i], exps);
+		}
+	}
+}
+
+// returns true if records pass through 'op' with their bound variables intact
+static bool _PassThrough
+(
+	const OpBase *op
+) {
+	switch(OpBase_Type(op)) {
+		case OPType_FILTER:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		case OPType_ORDERED_TRAVERSE:
+		case OPType_LEAPFROG_JOIN:
+		case OPType_UNWIND:
+		case OPType_ALL_NODE_SCAN:
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_INDEX_SCAN:
+		case OPType_NODE_BY_DISTANCE_SCAN:
+		case OPType_EDGE_BY_INDEX_SCAN:
+		case OPType_NODE_BY_ID_SEEK:
+		case OPType_EDGE_BY_ID_SEEK:
+		case OPType_NODE_BY_LABEL_AND_ID_SCAN:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static void _EliminateCommonSubexpressions
+(
+	OpBase *top,       // projection or aggregation
+	uint *alias_count  // number of hidden aliases in use
+) {
+	AR_ExpNode **exps = array_new(AR_ExpNode *, 0);
+
+	// expressions evaluated by the scope's top operation
+	if(OpBase_Type(top) == OPType_PROJECT) {
+		OpProject *project = (OpProject *)top;
+		for(uint i = 0; i < project->exp_count; i++) {
+			array_append(exps, project->exps[i]);
+		}
+	} else {
+		OpAggregate *aggregate = (OpAggregate *)top;
+		for(uint i = 0; i < aggregate->key_count; i++) {
+			array_append(exps, aggregate->key_exps[i]);
+		}
+		for(uint i = 0; i < aggregate->aggregate_count; i++) {
+			_CollectAggregationArguments(aggregate->aggregate_exps[i], &exps);
+		}
+	}
+
+	// filters applied to the records consumed by the top operation
+	// records are produced by the top's child, or by the top itself
+	OpBase *op = (top->childCount == 1) ? OpBase_GetChild(top, 0) : NULL;
+	const ExecutionPlan *scope = (op != NULL) ? op->plan : top->plan;
+	while(op != NULL && op->plan == scope && _PassThrough(op)) {
+		if(OpBase_Type(op) == OPType_FILTER) {
+			_CollectFilterExpressions(((OpFilter *)op)->filterTree, &exps);
+		}
+		op = (op->childCount == 1) ? OpBase_GetChild(op, 0) : NULL;
+	}
+
+	ExpGroup *groups = array_new(ExpGroup, 0);
+	uint n = array_len(exps);
+	for(uint i = 0; i < n; i++) _CountSubexpressions(&groups, exps[i]);
+
+	uint cached = *alias_count;
+	for(uint i = 0; i < n; i++) {
+		_CacheSubexpressions(groups, exps[i], alias_count);
+	}
+
+	// allocate record entries for the cached values
+	rax *mapping = ExecutionPlan_GetMappings(scope);
+	for(uint i = cached; i < *alias_count; i++) {
+		const char *alias = CACHED_ALIASES[i];
+		if(raxFind(mapping, (unsigned char *)alias, strlen(alias)) ==
+				raxNotFound) {
+			raxInsert(mapping, (unsigned char *)alias, strlen(alias),
+					(void *)raxSize(mapping), NULL);
+		}
+	}
+
+	array_free(groups);
+	array_free(exps);
+}
+
+void eliminateCommonSubexpressions
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OpBase **tops = ExecutionPlan_CollectOpsMatchingTypes(plan->root,
+			PROJECT_OPS, PROJECT_OP_COUNT);
+
+	uint alias_count = 0;
+	uint n = array_len(tops);
+	for(uint i = 0; i < n; i++) {
+		_EliminateCommonSubexpressions(tops[i], &alias_count);
+	}
+
+	array_free(tops);
+}
+
@@ -0,0 +1,109 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../../../deps/rax/rax.h"
+#include "../ops/op_aggregate.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../execution_plan_build/execution_plan_util.h"
+
+// factorize traversals feeding a count aggregation
+//
+// MATCH (a:A)-[:R]->(b) RETURN a, count(b)
+//
+// Aggregate
+//     Conditional Traverse | (a:A)->(b)
+//         Node By Label Scan | (a:A)
+//
+// the traversal emits a record per (a, b) pair only for the aggregation
+// to count them, as 'b' isn't used otherwise the traversal can emit a
+// single record per 'a' holding the number of reachable 'b' nodes
+// which the aggregation adds to its counts
+
+// returns true if 'exp' is a non-distinct count of either rows or 'alias'
+static bool _CountsAlias
+(
+	const AR_ExpNode *exp,  // aggregate expression
+	const char *alias       // traversed destination alias
+) {
+	if(exp->type != AR_EXP_OP || !exp->op.f->aggregate) return false;
+	if(strcasecmp(AR_EXP_GetFuncName(exp), "count") != 0) return false;
+	if(exp->op.child_count != 1) return false;
+
+	// count(*) introduces a constant argument
+	AR_ExpNode *arg = exp->op.children[0];
+	if(AR_EXP_IsConstant(arg)) return SI_TYPE(arg->operand.constant) != T_NULL;
+
+	// count(alias), destination nodes are never NULL
+	return (AR_EXP_IsVariadic(arg) &&
+			strcmp(arg->operand.variadic.entity_alias, alias) == 0);
+}
+
+// returns true if 'aggregate' only counts the destinations of 'traverse'
+static bool _FactorizableAggregation
+(
+	const OpAggregate *aggregate,  // aggregation
+	const OpCondTraverse *traverse  // traversal feeding the aggregation
+) {
+	const char *alias = AlgebraicExpression_Dest(traverse->ae);
+	if(aggregate->aggregate_count == 0) return false;
+
+	for(uint i = 0; i < aggregate->aggregate_count; i++) {
+		if(!_CountsAlias(aggregate->aggregate_exps[i], alias)) return false;
+	}
+
+	// grouping keys must not depend on the destination
+	rax *entities = raxNew();
+	for(uint i = 0; i < aggregate->key_count; i++) {
+		AR_EXP_CollectEntities(aggregate->key_exps[i], entities);
+	}
+	bool referenced = raxFind(entities, (unsigned char *)alias, strlen(alias))
+		!= raxNotFound;
+	raxFree(entities);
+
+	return !referenced;
+}
+
+void factorizeTraversal
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	OpBase **aggregations = ExecutionPlan_CollectOps(plan->root,
+			OPType_AGGREGATE);
+
+	uint n = array_len(aggregations);
+	for(uint i = 0; i < n; i++) {
+		OpAggregate *aggregate = (OpAggregate *)aggregations[i];
+		if(aggregate->op.childCount != 1) continue;
+
+		OpBase *child = aggregate->op.children[0];
+		if(OpBase_Type(child) != OPType_CONDITIONAL_TRAVERSE) continue;
+
+		// the emitted edge may be referenced, don't factorize
+		OpCondTraverse *traverse = (OpCondTraverse *)child;
+		if(traverse->edge_ctx != NULL) continue;
+
+		// destination slot must be shared by both operations
+		if(child->plan != aggregate->op.plan) continue;
+
+		// label filtering traversals, e.g. (n:N)->(n:N), emit a single node
+		if(strcmp(AlgebraicExpression_Src(traverse->ae),
+				  AlgebraicExpression_Dest(traverse->ae)) == 0) {
+			continue;
+		}
+
+		if(!_FactorizableAggregation(aggregate, traverse)) continue;
+
+		CondTraverseOp_Factorize(traverse);
+		Aggregate_SetFactorized(aggregate, traverse->destNodeIdx);
+	}
+
+	array_free(aggregations);
+}
+
@@ -0,0 +1,123 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../ops/op_expand_into.h"
+#include "../ops/op_leapfrog_join.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../execution_plan_build/execution_plan_util.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// leapfrog join replaces a traversal which binds a node closing a cycle
+// followed by the expand-into operations checking the closing edges
+//
+// MATCH (a)-[:R]->(b)-[:R]->(c)-[:R]->(a) RETURN a, b, c
+//
+// Expand Into | (c)->(a)
+//     Conditional Traverse | (b)->(c)
+//         Conditional Traverse | (a)->(b)
+//             All Node Scan | (a)
+//
+// the traversal from (b) to (c) materializes every 2-path out of (b) only
+// to discard those which don't lead back to (a), instead candidates for (c)
+// are computed by intersecting b's outgoing and a's incoming adjacency lists
+//
+// Leapfrog Join | (b)-[:R]->(c), (c)-[:R]->(a)
+//     Conditional Traverse | (a)->(b)
+//         All Node Scan | (a)
+
+// collect the expand-into operations above 'traverse' which connect its
+// destination to other bound nodes
+static OpExpandInto **_ClosingExpandInto
+(
+	OpCondTraverse *traverse,  // traversal binding the joined node
+	const char *alias          // joined node alias
+) {
+	OpExpandInto **closing = array_new(OpExpandInto *, 1);
+
+	OpBase *op = traverse->op.parent;
+	while(op != NULL && OpBase_Type(op) == OPType_EXPAND_INTO) {
+		OpExpandInto *expand = (OpExpandInto *)op;
+		if(!LeapfrogJoin_SupportedExpression(expand->ae, alias)) break;
+
+		array_append(closing, expand);
+		op = op->parent;
+	}
+
+	return closing;
+}
+
+static void _ApplyLeapfrogJoin
+(
+	ExecutionPlan *plan,        // plan to update
+	OpCondTraverse *traverse    // traversal binding the joined node
+) {
+	const char *alias = AlgebraicExpression_Dest(traverse->ae);
+	OpExpandInto **closing = _ClosingExpandInto(traverse, alias);
+	uint n = array_len(closing);
+
+	// joined expressions, traversal first
+	AlgebraicExpression **exps = array_new(AlgebraicExpression *, n + 1);
+	array_append(exps, traverse->ae);
+	traverse->ae = NULL;
+	for(uint i = 0; i < n; i++) {
+		array_append(exps, closing[i]->ae);
+		closing[i]->ae = NULL;
+	}
+
+	OpBase *join = NewLeapfrogJoinOp(traverse->op.plan, traverse->graph, alias,
+			exps);
+
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)traverse, join);
+	OpBase_Free((OpBase *)traverse);
+
+	for(uint i = 0; i < n; i++) {
+		ExecutionPlan_RemoveOp(plan, (OpBase *)closing[i]);
+		OpBase_Free((OpBase *)closing[i]);
+	}
+
+	array_free(closing);
+}
+
+void applyLeapfrogJoin
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	// collect traversals directly followed by a supported expand-into
+	// before modifying the plan
+	OpBase **traversals = ExecutionPlan_CollectOps(plan->root,
+			OPType_CONDITIONAL_TRAVERSE);
+	OpCondTraverse **candidates = array_new(OpCondTraverse *, 0);
+
+	uint n = array_len(traversals);
+	for(uint i = 0; i < n; i++) {
+		OpCondTraverse *traverse = (OpCondTraverse *)traversals[i];
+		OpBase *parent = traverse->op.parent;
+		const char *alias = AlgebraicExpression_Dest(traverse->ae);
+
+		if(parent == NULL || OpBase_Type(parent) != OPType_EXPAND_INTO) {
+			continue;
+		}
+
+		if(!LeapfrogJoin_SupportedExpression(traverse->ae, alias) ||
+		   !LeapfrogJoin_SupportedExpression(((OpExpandInto *)parent)->ae,
+			   alias)) {
+			continue;
+		}
+
+		array_append(candidates, traverse);
+	}
+
+	n = array_len(candidates);
+	for(uint i = 0; i < n; i++) _ApplyLeapfrogJoin(plan, candidates[i]);
+
+	array_free(candidates);
+	array_free(traversals);
+}
+
@@ -16,7 +16,8 @@ void orderExpressions(
 	AlgebraicExpression **exps,     // expressions to order
 	uint *exps_count,               // number of expressions
 	const FT_FilterNode *filters,   // filters
-	rax *bound_vars                 // previously-bound variables
+	rax *bound_vars,                // previously-bound variables
+	const char *start               // [optional] forced entry point
 );
 
 void compactFilters(ExecutionPlan *plan);
@@ -28,7 +29,12 @@ void reduceCartesianProductStreamCount(ExecutionPlan *plan);
 void applyJoin(ExecutionPlan *plan);
 void reduceFilters(ExecutionPlan *plan);
 void reduceTraversal(ExecutionPlan *plan);
+void applyLeapfrogJoin(ExecutionPlan *plan);
 void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
+void factorizeTraversal(ExecutionPlan *plan);
+void decorrelateSubqueries(ExecutionPlan *plan);
+void eliminateCommonSubexpressions(ExecutionPlan *plan);
 void costBaseLabelScan(ExecutionPlan *plan);
+void aggregateColumns(ExecutionPlan *plan);
 
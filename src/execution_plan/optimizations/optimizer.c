@@ -41,11 +41,18 @@ void Optimizer_CompileTimeOptimize
 	// into an expand into operation
 	reduceTraversal(plan);
 
+	// bind nodes closing a cycle by intersecting adjacency lists
+	// instead of traversing and then expanding into
+	applyLeapfrogJoin(plan);
+
 	// try to reduce distinct if it follows aggregation
 	reduceDistinct(plan);
 
 	// try to reduce execution plan incase it perform node or edge counting
 	reduceCount(plan);
+
+	// count reachable nodes per source instead of emitting each of them
+	factorizeTraversal(plan);
 }
 
 // apply runtime optimizations
@@ -53,6 +60,11 @@ void Optimizer_RuntimeOptimize
 (
 	ExecutionPlan *plan  // plan to optimize
 ) {
+	// evaluate subqueries correlated through an equality once and join
+	// note: this is a run-time optimization as subqueries which can be
+	// resolved by an index lookup per input record are kept as is
+	decorrelateSubqueries(plan);
+
 	// when possible, replace label scan and filter ops with index scans
 	// note: this is a run-time optimization as indices might be added/remove
 	// over time
@@ -75,5 +87,15 @@ void Optimizer_RuntimeOptimize
 	// depend on the fact that filters are broken down into their simplest form
 	// TODO: turn this into a compile-time optimization
 	reduceFilters(plan);
+
+	// aggregate range indexed attributes from their index columns
+	// note: this is a run-time optimization as indices might be added/remove
+	// over time
+	aggregateColumns(plan);
+
+	// evaluate repeated subexpressions once per record
+	// note: this is the last run-time optimization as it rewrites filter and
+	// projection expressions other optimizations pattern match against
+	eliminateCommonSubexpressions(plan);
 }
 
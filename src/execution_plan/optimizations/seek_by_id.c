@@ -5,10 +5,13 @@
  */
 
 #include "../../util/arr.h"
+#include "../../datatypes/array.h"
 #include "../ops/op_filter.h"
 #include "../ops/op_all_node_scan.h"
 #include "../ops/op_node_by_id_seek.h"
+#include "../ops/op_edge_by_id_seek.h"
 #include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_conditional_traverse.h"
 #include "../../util/range/numeric_range.h"
 #include "../../arithmetic/arithmetic_op.h"
 #include "../execution_plan_build/execution_plan_util.h"
@@ -18,10 +21,15 @@
 // a filter of the form ID(n) = X is applied in which case
 // both the SCAN and FILTER operations can be reduced into a single
 // NODE_BY_ID_SEEK operation
+//
+// similarly, a node scan followed by a single hop traversal on which
+// a filter of the form ID(e) = X is applied are reduced into a single
+// EDGE_BY_ID_SEEK operation resolving the edge and both its endpoints
 
 static bool _idFilter
 (
 	FT_FilterNode *f,
+	const char *alias,
 	AST_Operator *rel,
 	EntityID *id,
 	bool *reverse
@@ -53,6 +61,11 @@ static bool _idFilter
 	// make sure applied function is ID.
 	if(strcasecmp(op->f->name, "id")) return false;
 
+	// make sure ID is applied to the sought entity
+	AR_ExpNode *entity = op->children[0];
+	if(!AR_EXP_IsVariadic(entity)) return false;
+	if(strcmp(entity->operand.variadic.entity_alias, alias)) return false;
+
 	// make sure ID is compared to a constant int64
 	SIValue val;
 	bool reduced = AR_EXP_ReduceToScalar(expr, true, &val);
@@ -65,15 +78,19 @@ static bool _idFilter
 	return true;
 }
 
-static void _UseIdOptimization
+// collects the ID range of filters of the form ID(alias) op X
+// directly above 'op', returns NULL if there are no such filters
+// the collected filters are removed from the plan
+static UnsignedRange *_CollectIdRange
 (
 	ExecutionPlan *plan,
-	OpBase *scan_op
+	OpBase *op,
+	const char *alias
 ) {
 	// see if there's a filter of the form
-	// ID(n) op X
+	// ID(alias) op X
 	// where X is a constant and op in [EQ, GE, LE, GT, LT]
-	OpBase *parent = scan_op->parent;
+	OpBase *parent = op->parent;
 	OpBase *grandparent;
 	UnsignedRange *id_range = NULL;
 	while(parent && parent->type == OPType_FILTER) {
@@ -84,12 +101,12 @@ static void _UseIdOptimization
 
 		bool         reverse;
 		EntityID     id;
-		AST_Operator op;
+		AST_Operator rel;
 
-		if(_idFilter(f, &op, &id, &reverse)) {
+		if(_idFilter(f, alias, &rel, &id, &reverse)) {
 			if(!id_range) id_range = UnsignedRange_New();
-			if(reverse) op = ArithmeticOp_ReverseOp(op);
-			UnsignedRange_TightenRange(id_range, op, id);
+			if(reverse) rel = ArithmeticOp_ReverseOp(rel);
+			UnsignedRange_TightenRange(id_range, rel, id);
 
 			// Free replaced operations.
 			ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
@@ -98,6 +115,108 @@ static void _UseIdOptimization
 		// advance
 		parent = grandparent;
 	}
+
+	return id_range;
+}
+
+// returns the alias of the node resolved by a scan operation
+static const char *_ScanAlias
+(
+	const OpBase *scan_op
+) {
+	if(scan_op->type == OPType_NODE_BY_LABEL_SCAN) {
+		return ((NodeByLabelScan *)scan_op)->n->alias;
+	}
+	return ((AllNodeScan *)scan_op)->alias;
+}
+
+// creates a filter requiring node to possess all of its labels
+// returns NULL if node has no labels
+static OpBase *_LabelsFilter
+(
+	ExecutionPlan *plan,
+	QGNode *n
+) {
+	uint label_count = QGNode_LabelCount(n);
+	if(label_count == 0) return NULL;
+
+	// hasLabels(n, [labels])
+	AR_ExpNode *op = AR_EXP_NewOpNode("hasLabels", true, 2);
+
+	SIValue labels = SI_Array(label_count);
+	for(uint i = 0; i < label_count; i++) {
+		SIArray_Append(&labels, SI_ConstStringVal((char *)n->labels[i]));
+	}
+
+	op->op.children[0] = AR_EXP_NewVariableOperandNode(QGNode_Alias(n));
+	op->op.children[1] = AR_EXP_NewConstOperandNode(labels);
+
+	return NewFilterOp(plan, FilterTree_CreateExpressionFilter(op));
+}
+
+// try to reduce a scan followed by a traversal and a filter of the form
+// ID(e) op X into a single edge by ID seek operation
+static void _UseEdgeIdOptimization
+(
+	ExecutionPlan *plan,
+	OpCondTraverse *cond
+) {
+	// traversal must be fed directly by a scan tap
+	OpBase *scan_op = cond->op.children[0];
+	if(scan_op->type != OPType_ALL_NODE_SCAN &&
+	   scan_op->type != OPType_NODE_BY_LABEL_SCAN) {
+		return;
+	}
+	if(scan_op->childCount > 0) return;
+
+	// factorized traversals don't resolve destinations
+	if(cond->factorized) return;
+
+	const char *alias = AlgebraicExpression_Edge(cond->ae);
+	if(alias == NULL) return;
+
+	QGEdge *e = QueryGraph_GetEdgeByAlias(cond->op.plan->query_graph, alias);
+	ASSERT(e != NULL);
+
+	// undirected edges match in both directions, self loops require
+	// both endpoints to be the same node
+	if(e->bidirectional) return;
+	if(QGEdge_Src(e) == QGEdge_Dest(e)) return;
+
+	// the scanned node must be one of the edge endpoints
+	const char *scanned = _ScanAlias(scan_op);
+	if(strcmp(scanned, QGNode_Alias(QGEdge_Src(e))) != 0 &&
+	   strcmp(scanned, QGNode_Alias(QGEdge_Dest(e))) != 0) {
+		return;
+	}
+
+	UnsignedRange *id_range = _CollectIdRange(plan, (OpBase *)cond, alias);
+	if(id_range == NULL) return;
+
+	OpBase *seek = NewEdgeByIdSeekOp(cond->op.plan, e, id_range);
+	UnsignedRange_Free(id_range);
+
+	// replace both scan and traversal with the seek
+	ExecutionPlan_RemoveOp(plan, scan_op);
+	OpBase_Free(scan_op);
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)cond, seek);
+	OpBase_Free((OpBase *)cond);
+
+	// endpoints labels are no longer enforced by the scan and traversal
+	OpBase *filter = _LabelsFilter(plan, QGEdge_Src(e));
+	if(filter != NULL) ExecutionPlan_PushBelow(seek, filter);
+
+	filter = _LabelsFilter(plan, QGEdge_Dest(e));
+	if(filter != NULL) ExecutionPlan_PushBelow(seek, filter);
+}
+
+static void _UseIdOptimization
+(
+	ExecutionPlan *plan,
+	OpBase *scan_op
+) {
+	UnsignedRange *id_range = _CollectIdRange(plan, scan_op,
+			_ScanAlias(scan_op));
 	if(id_range) {
 		/* Don't replace label scan, but set it to have range query.
 		 * Issue 818 https://github.com/RedisGraph/RedisGraph/issues/818
@@ -124,6 +243,16 @@ void seekByID
 ) {
 	ASSERT(plan != NULL);
 
+	// edge seeks replace scans, apply them first
+	OpBase **traversals = ExecutionPlan_CollectOps(plan->root,
+			OPType_CONDITIONAL_TRAVERSE);
+
+	for(int i = 0; i < array_len(traversals); i++) {
+		_UseEdgeIdOptimization(plan, (OpCondTraverse *)traversals[i]);
+	}
+
+	array_free(traversals);
+
 	const OPType types[] = {OPType_ALL_NODE_SCAN, OPType_NODE_BY_LABEL_SCAN};
 	OpBase **scan_ops = ExecutionPlan_CollectOpsMatchingTypes(plan->root, types, 2);
 
@@ -189,11 +189,29 @@ static void _order_expressions
 (
 	AlgebraicExpression **arrangement,   // arrangement of expressions
 	const ScoredExp *exps,               // input list of expressions
-	uint nexp                            // number of expressions
+	uint nexp,                           // number of expressions
+	const char *start                    // [optional] forced entry point
 ) {
 	// collect all possible expression for first position in arrangement
 	AlgebraicExpression **options = _valid_expressions(exps, nexp, NULL, 0);
 
+	// restrict first position to expressions resolving the entry point
+	if(start != NULL) {
+		uint n = 0;
+		uint count = array_len(options);
+		for(uint i = 0; i < count; i++) {
+			AlgebraicExpression *exp = options[i];
+			if(strcmp(AlgebraicExpression_Src(exp), start)  == 0 ||
+			   strcmp(AlgebraicExpression_Dest(exp), start) == 0) {
+				options[n++] = exp;
+			}
+		}
+		// hinted nodes are never folded into an expression, as such the
+		// entry point is expected to be an end point of some expression
+		// otherwise fall back to the unrestricted set of options
+		if(n > 0) options = array_trimm_len(options, n);
+	}
+
 	// construct arrangement
 	bool res = _arrangement_set_expression(arrangement, exps, nexp, options, 0);
 	ASSERT(res == true);
@@ -210,6 +228,7 @@ static int _score_cmp
 // given a set of algebraic expressions representing a graph traversal
 // we pick the order in which the expressions will be evaluated
 // taking into account filters and transposes
+// when 'start' is specified the traversal is forced to begin at that node
 // 'exps' will be reordered
 void orderExpressions
 (
@@ -217,7 +236,8 @@ void orderExpressions
 	AlgebraicExpression **exps,
 	uint *exp_count,
 	const FT_FilterNode *ft,
-	rax *bound_vars
+	rax *bound_vars,
+	const char *start
 ) {
 	// Validate inputs
 	ASSERT(qg          != NULL);
@@ -252,7 +272,7 @@ void orderExpressions
 	// Find the highest-scoring valid arrangement
 	//--------------------------------------------------------------------------
 
-	_order_expressions(arrangement, scored_exps, _exp_count);
+	_order_expressions(arrangement, scored_exps, _exp_count, start);
 
 	// overwrite the original expressions array with the optimal arrangement
 	memcpy(exps, arrangement, _exp_count * sizeof(AlgebraicExpression *));
@@ -261,10 +281,15 @@ void orderExpressions
 	// the selected order
 	_resolve_winning_sequence(exps, _exp_count);
 
-	// transpose the winning expression if the destination node is a more
-	// efficient starting point
-	if(_should_transpose_entry_point(qg, exps[0], filtered_entities,
+	if(start != NULL) {
+		// make sure traversal begins at the forced entry point
+		if(strcmp(AlgebraicExpression_Src(exps[0]), start) != 0) {
+			AlgebraicExpression_Transpose(exps);
+		}
+	} else if(_should_transpose_entry_point(qg, exps[0], filtered_entities,
 									 bound_vars)) {
+		// transpose the winning expression if the destination node is a more
+		// efficient starting point
 		AlgebraicExpression_Transpose(exps);
 	}
 
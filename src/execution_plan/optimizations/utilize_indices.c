@@ -8,7 +8,11 @@
 #include "../../value.h"
 #include "../../util/arr.h"
 #include "../../query_ctx.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_skip.h"
+#include "../ops/op_limit.h"
 #include "../ops/op_filter.h"
+#include "../ops/op_project.h"
 #include "../../ast/ast_shared.h"
 #include "../../datatypes/array.h"
 #include "../../datatypes/point.h"
@@ -18,6 +22,9 @@
 #include "../ops/op_node_by_label_scan.h"
 #include "../ops/op_edge_by_index_scan.h"
 #include "../ops/op_conditional_traverse.h"
+#include "../ops/op_node_by_distance_scan.h"
+#include "../ops/op_ordered_traverse.h"
+#include "../../ast/ast_build_op_contexts.h"
 #include "../../arithmetic/arithmetic_op.h"
 #include "../../filter_tree/filter_tree_utils.h"
 #include "../../arithmetic/algebraic_expression.h"
@@ -25,6 +32,10 @@
 #include "../execution_plan_build/execution_plan_util.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
+// reasons reported when a USING INDEX hint can't be honored
+#define HINT_NO_INDEX  "index hint ignored: no index on hinted attribute"
+#define HINT_NO_FILTER "index hint ignored: no indexable predicate"
+
 //------------------------------------------------------------------------------
 // Filter normalization
 //------------------------------------------------------------------------------
@@ -314,6 +325,18 @@ void reduce_scan_op
 	uint        filters_count  = 0;           // number of matching filters
 	const char  *min_label_str = NULL;        // tracks min label name
 
+	// USING SCAN, node must be resolved by a label scan
+	ScanHint hint = scan->n->hint;
+	if(hint == SCAN_HINT_SCAN) return;
+
+	// USING INDEX, only the hinted label and attribute are considered
+	uint         nattrs    = 0;
+	Attribute_ID hint_attr = ATTRIBUTE_ID_NONE;
+	if(hint == SCAN_HINT_INDEX) {
+		hint_attr = GraphContext_GetAttributeID(gc, scan->n->hint_attr);
+		nattrs = 1;
+	}
+
 	// see if scanned node has multiple labels
 	const char *node_alias = scan->n->alias;
 	QGNode *qn = QueryGraph_GetNodeByAlias(qg, node_alias);
@@ -329,11 +352,19 @@ void reduce_scan_op
 		// unknown label
 		if(label_id == GRAPH_UNKNOWN_LABEL) continue;
 
-		cur_idx = GraphContext_GetIndexByID(gc, label_id, NULL, 0,
+		// skip labels other than the hinted one
+		if(hint == SCAN_HINT_INDEX && strcmp(label, scan->n->hint_label) != 0) {
+			continue;
+		}
+
+		cur_idx = GraphContext_GetIndexByID(gc, label_id, &hint_attr, nattrs,
 				INDEX_FLD_RANGE, GETYPE_NODE);
 
 		// no index for current label
-		if(cur_idx == NULL) continue;
+		if(cur_idx == NULL) {
+			if(hint == SCAN_HINT_INDEX) scan->n->hint_unmet = HINT_NO_INDEX;
+			continue;
+		}
 
 		ASSERT(Index_Enabled(cur_idx));
 
@@ -347,6 +378,7 @@ void reduce_scan_op
 		uint cur_filters_count = array_len(cur_filters);
 		if(cur_filters_count == 0) {
 			// no filters
+			if(hint == SCAN_HINT_INDEX) scan->n->hint_unmet = HINT_NO_FILTER;
 			array_free(cur_filters);
 			continue;
 		}
@@ -367,7 +399,13 @@ void reduce_scan_op
 	}
 
 	// no label possessed indexed and filtered attributes, return early
-	if(idx == NULL) goto cleanup;
+	if(idx == NULL) {
+		// hinted label is unknown to the graph
+		if(hint == SCAN_HINT_INDEX && scan->n->hint_unmet == NULL) {
+			scan->n->hint_unmet = HINT_NO_INDEX;
+		}
+		goto cleanup;
+	}
 
 	// did we found a better label to utilize? if so swap
 	if(scan->n->label_id != min_label_id) {
@@ -400,6 +438,9 @@ void reduce_scan_op
 		scan->n->label_id = min_label_id;
 	}
 
+	// index is utilized, discard failures recorded for other labels
+	scan->n->hint_unmet = NULL;
+
 	FT_FilterNode *root = _Concat_Filters(filters);
 	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, idx,
 			root);
@@ -539,10 +580,93 @@ static void traversalToIndexScan
 	array_free(condOps);
 }
 
+// try to restrict the destinations of given Conditional Traverse operation
+// using an index resolving the filters which follow it
+// the filters remain in place, the traversal merely avoids producing
+// destinations which are bound to be filtered out
+static void mask_cond_dest
+(
+	OpCondTraverse *cond
+) {
+	// already masked, or destination is also the source e.g. (n:N)->(n:N)
+	if(cond->dest_filter != NULL) return;
+
+	const char *src  = AlgebraicExpression_Src(cond->ae);
+	const char *dest = AlgebraicExpression_Dest(cond->ae);
+	if(strcmp(src, dest) == 0) return;
+
+	// traversal must be followed by filter(s)
+	if(OpBase_Type(cond->op.parent) != OPType_FILTER) return;
+
+	QGNode *n = QueryGraph_GetNodeByAlias(cond->op.plan->query_graph, dest);
+	ASSERT(n != NULL);
+
+	// find destination label with an index resolving filters
+	// prefer the label with the minimum NNZ entries
+	Index    idx           = NULL;  // the index to be applied
+	OpFilter **filters     = NULL;  // indexed filters to apply
+	uint64_t min_nnz       = UINT64_MAX;
+	GraphContext *gc       = QueryCtx_GetGraphCtx();
+
+	uint label_count = QGNode_LabelCount(n);
+	for(uint i = 0; i < label_count; i++) {
+		int label_id = QGNode_GetLabelID(n, i);
+		if(label_id == GRAPH_UNKNOWN_LABEL) continue;
+
+		Index cur_idx = GraphContext_GetIndexByID(gc, label_id, NULL, 0,
+				INDEX_FLD_RANGE, GETYPE_NODE);
+		if(cur_idx == NULL) continue;
+
+		OpFilter **cur_filters = _applicableFilters((OpBase *)cond, dest,
+				cur_idx);
+
+		// discard filters referring to entities other than the destination
+		// the mask is computed once per execution, not per record
+		for(int j = array_len(cur_filters) - 1; j >= 0; j--) {
+			rax *entities = FilterTree_CollectModified(cur_filters[j]->filterTree);
+			if(raxSize(entities) != 1) array_del_fast(cur_filters, j);
+			raxFree(entities);
+		}
+
+		uint64_t nnz = Graph_LabeledNodeCount(cond->graph, label_id);
+		if(array_len(cur_filters) > 0 && nnz < min_nnz) {
+			idx     = cur_idx;
+			min_nnz = nnz;
+			array_free(filters);
+			filters = cur_filters;
+		} else {
+			array_free(cur_filters);
+		}
+	}
+
+	if(idx != NULL) {
+		CondTraverseOp_SetDestinationMask(cond, idx, _Concat_Filters(filters));
+	}
+
+	array_free(filters);
+}
+
+static void traversalDestinationMask
+(
+	ExecutionPlan *plan
+) {
+	// collect all conditional traverse
+	OpBase **condOps = ExecutionPlan_CollectOps(plan->root,
+			OPType_CONDITIONAL_TRAVERSE);
+
+	uint condOpCount = array_len(condOps);
+	for(uint i = 0; i < condOpCount; i++) {
+		mask_cond_dest((OpCondTraverse *)condOps[i]);
+	}
+
+	array_free(condOps);
+}
+
 static void labelScanToIndexScan
 (
 	ExecutionPlan *plan,
-	GraphContext *gc
+	GraphContext *gc,
+	bool has_indices
 ) {
 	// collect all label scans
 	OpBase **scanOps = ExecutionPlan_CollectOps(plan->root,
@@ -551,11 +675,19 @@ static void labelScanToIndexScan
 	int scanOpCount = array_len(scanOps);
 	for(int i = 0; i < scanOpCount; i++) {
 		NodeByLabelScan *scanOp = (NodeByLabelScan *)scanOps[i];
+		bool index_hint = scanOp->n->hint == SCAN_HINT_INDEX;
+
+		// graph has no indices, only report unmet index hints
+		if(!has_indices) {
+			if(index_hint) scanOp->n->hint_unmet = HINT_NO_INDEX;
+			continue;
+		}
 
 		// make sure scan is followed by filter(s)
 		OpBase *parent = scanOp->op.parent;
 		if(parent->type != OPType_FILTER) {
 			// no filters to utilize
+			if(index_hint) scanOp->n->hint_unmet = HINT_NO_FILTER;
 			continue;
 		}
 
@@ -566,22 +698,312 @@ static void labelScanToIndexScan
 	array_free(scanOps);
 }
 
+// number of records consumed from sort
+// skipped and limited by its parents, 0 if all records are consumed
+static uint64_t _SortLimit
+(
+	const OpSort *sort
+) {
+	uint64_t skip = 0;
+	for(OpBase *parent = sort->op.parent; parent != NULL;
+			parent = parent->parent) {
+		if(parent->type == OPType_SKIP) {
+			skip += ((const OpSkip *)parent)->skip;
+		} else if(parent->type == OPType_LIMIT) {
+			return ((const OpLimit *)parent)->limit + skip;
+		} else {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+// determine if exp computes the distance between alias's point attribute
+// and a constant point, e.g. distance(n.loc, point({latitude:1, longitude:2}))
+static bool _isDistanceFromOrigin
+(
+	AR_ExpNode *exp,    // expression to inspect
+	const char *alias,  // scanned node alias
+	char **attr,        // [output] point attribute
+	SIValue *origin     // [output] origin point
+) {
+	if(!AR_EXP_IsOperation(exp) ||
+	   strcasecmp(AR_EXP_GetFuncName(exp), "distance") != 0) {
+		return false;
+	}
+
+	for(int i = 0; i < 2; i++) {
+		AR_ExpNode *attribute = exp->op.children[i];
+		AR_ExpNode *other     = exp->op.children[1 - i];
+
+		// attribute of the scanned node
+		if(!AR_EXP_IsAttribute(attribute, attr)) continue;
+		AR_ExpNode *var = attribute->op.children[0];
+		if(!AR_EXP_IsVariadic(var) ||
+		   strcmp(var->operand.variadic.entity_alias, alias) != 0) {
+			continue;
+		}
+
+		// constant origin
+		if(!AR_EXP_ReduceToScalar(other, true, origin)) continue;
+		if(SI_TYPE(*origin) == T_POINT) return true;
+		SIValue_Free(*origin);
+	}
+
+	return false;
+}
+
+// try to replace a label scan which is projected, sorted by ascending
+// distance from a constant point and limited
+// with a distance scan yielding the nearest nodes
+// MATCH (n:L) RETURN n ORDER BY distance(n.loc, $origin) LIMIT 10
+static void reduce_sort_by_distance
+(
+	ExecutionPlan *plan,
+	GraphContext *gc,
+	OpSort *sort
+) {
+	// sorted by ascending distance only
+	if(array_len(sort->exps) != 1 || sort->directions[0] != DIR_ASC) return;
+
+	// sorted records are limited
+	uint64_t k = _SortLimit(sort);
+	if(k == 0) return;
+
+	// sort is fed by a projection of a label scan
+	OpBase *child = sort->op.children[0];
+	if(child->type != OPType_PROJECT || child->childCount != 1) return;
+	OpProject *project = (OpProject *)child;
+
+	child = child->children[0];
+	if(child->type != OPType_NODE_BY_LABEL_SCAN || child->childCount != 0) {
+		return;
+	}
+	NodeByLabelScan *scan = (NodeByLabelScan *)child;
+	if(scan->n->label_id == GRAPH_UNKNOWN_LABEL) return;
+
+	// locate sort key within projection
+	AR_ExpNode *key = NULL;
+	for(uint i = 0; i < project->exp_count; i++) {
+		if(strcmp(project->exps[i]->resolved_name,
+					sort->exps[0]->resolved_name) == 0) {
+			key = project->exps[i];
+			break;
+		}
+	}
+	if(key == NULL) return;
+
+	char    *attr  = NULL;
+	SIValue origin = SI_NullVal();
+	if(!_isDistanceFromOrigin(key, scan->n->alias, &attr, &origin)) return;
+
+	// point attribute must be indexed
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	Index idx = GraphContext_GetIndexByID(gc, scan->n->label_id, &attr_id, 1,
+			INDEX_FLD_GEO, GETYPE_NODE);
+	if(idx == NULL) return;
+
+	OpBase *distanceOp = NewNodeByDistanceScanOp(scan->op.plan, scan->g,
+			scan->n, idx, attr, origin, k);
+	scan->n = NULL;
+
+	// replace the label scan with the distance scan
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, distanceOp);
+	OpBase_Free((OpBase *)scan);
+}
+
+static void sortByDistanceToDistanceScan
+(
+	ExecutionPlan *plan,
+	GraphContext *gc
+) {
+	// collect all sort operations
+	OpBase **sortOps = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	uint sortOpCount = array_len(sortOps);
+	for(uint i = 0; i < sortOpCount; i++) {
+		reduce_sort_by_distance(plan, gc, (OpSort *)sortOps[i]);
+	}
+
+	array_free(sortOps);
+}
+
+// returns true if 'exp' consists of a single relation operand
+// optionally multiplied by label operands of node 'dest'
+static bool _SingleRelation
+(
+	const AlgebraicExpression *exp,  // traversal expression
+	const char *dest,                // destination alias
+	uint *relations                  // [output] number of relation operands
+) {
+	if(exp->type == AL_OPERAND) {
+		if(!exp->operand.diagonal) {
+			(*relations)++;
+			return true;
+		}
+		return strcmp(exp->operand.src, dest) == 0;
+	}
+
+	if(exp->operation.op != AL_EXP_MUL &&
+	   exp->operation.op != AL_EXP_TRANSPOSE) {
+		return false;
+	}
+
+	uint n = AlgebraicExpression_ChildCount(exp);
+	for(uint i = 0; i < n; i++) {
+		if(!_SingleRelation(exp->operation.children[i], dest, relations)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// try to replace a traversal which is projected, sorted by an attribute
+// of the traversed edge and limited
+// with an ordered traversal visiting the edges in attribute order
+// MATCH (u)-[r:POSTED]->(p) RETURN p ORDER BY r.ts DESC LIMIT 20
+static void reduce_sort_by_edge_attribute
+(
+	ExecutionPlan *plan,
+	GraphContext *gc,
+	OpSort *sort
+) {
+	// sorted by a single key
+	if(array_len(sort->exps) != 1) return;
+
+	// sorted records are limited
+	uint64_t k = _SortLimit(sort);
+	if(k == 0) return;
+
+	// sort is fed by a projection of a traversal
+	OpBase *child = sort->op.children[0];
+	if(child->type != OPType_PROJECT || child->childCount != 1) return;
+	OpProject *project = (OpProject *)child;
+
+	child = child->children[0];
+	if(child->type != OPType_CONDITIONAL_TRAVERSE) return;
+	OpCondTraverse *traverse = (OpCondTraverse *)child;
+
+	// traversal emits the edge and doesn't filter destinations via an index
+	if(traverse->edge_ctx == NULL || traverse->dest_filter != NULL) return;
+
+	// single hop over a single relationship type in a single direction
+	const char *alias = AlgebraicExpression_Edge(traverse->ae);
+	QGEdge *e = QueryGraph_GetEdgeByAlias(traverse->op.plan->query_graph,
+			alias);
+	if(e == NULL || QGEdge_VariableLength(e) || e->bidirectional) return;
+	if(array_len(e->reltypeIDs) != 1) return;
+
+	RelationID relation = e->reltypeIDs[0];
+	if(relation == GRAPH_UNKNOWN_RELATION) return;
+
+	// source labels are resolved by preceding operations
+	const char *dest = AlgebraicExpression_Dest(traverse->ae);
+	uint relations = 0;
+	if(!_SingleRelation(traverse->ae, dest, &relations) || relations != 1) {
+		return;
+	}
+
+	// destination labels must exist
+	QGNode *n = QueryGraph_GetNodeByAlias(traverse->op.plan->query_graph, dest);
+	uint label_count = QGNode_LabelCount(n);
+	for(uint i = 0; i < label_count; i++) {
+		if(QGNode_GetLabelID(n, i) == GRAPH_UNKNOWN_LABEL) return;
+	}
+
+	// locate sort key within projection
+	AR_ExpNode *key = NULL;
+	for(uint i = 0; i < project->exp_count; i++) {
+		if(strcmp(project->exps[i]->resolved_name,
+					sort->exps[0]->resolved_name) == 0) {
+			key = project->exps[i];
+			break;
+		}
+	}
+	if(key == NULL) return;
+
+	// sort key is an attribute of the traversed edge
+	char *attr = NULL;
+	if(!AR_EXP_IsAttribute(key, &attr)) return;
+	AR_ExpNode *var = key->op.children[0];
+	if(!AR_EXP_IsVariadic(var) ||
+	   strcmp(var->operand.variadic.entity_alias, alias) != 0) {
+		return;
+	}
+
+	// attribute must be range indexed
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	Index idx = GraphContext_GetIndexByID(gc, relation, &attr_id, 1,
+			INDEX_FLD_RANGE, GETYPE_EDGE);
+	if(idx == NULL || !Index_Enabled(idx)) return;
+
+	// index keeps an adjacency ordered by the attribute
+	// see the ORDERED_ADJACENCY configuration
+	if(Index_GetAdjacency(idx, attr_id) == NULL) return;
+
+	// the traversal expression is handed over to the ordered traversal
+	OpBase *orderedOp = NewOrderedTraverseOp(traverse->op.plan, traverse->graph,
+			traverse->ae, idx, attr_id, relation,
+			traverse->edge_ctx->direction, sort->directions[0] == DIR_DESC, k);
+	traverse->ae = NULL;
+
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)traverse, orderedOp);
+	OpBase_Free((OpBase *)traverse);
+}
+
+static void sortByEdgeAttributeToOrderedTraverse
+(
+	ExecutionPlan *plan,
+	GraphContext *gc
+) {
+	// collect all sort operations
+	OpBase **sortOps = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	uint sortOpCount = array_len(sortOps);
+	for(uint i = 0; i < sortOpCount; i++) {
+		reduce_sort_by_edge_attribute(plan, gc, (OpSort *)sortOps[i]);
+	}
+
+	array_free(sortOps);
+}
+
 void utilizeIndices
 (
 	ExecutionPlan *plan
 ) {
-	// return immediately if the graph has no indices
 	GraphContext *gc = QueryCtx_GetGraphCtx();
-	if(!GraphContext_HasIndices(gc)) return;
+	bool has_indices = GraphContext_HasIndices(gc);
 
-	// indices are utilized in three sections:
+	// indices are utilized in five sections:
 	// 1. label scan followed by filter(s)
-	// 2. traversal followed by filter(s)
+	// 2. traversal followed by filter(s) on the traversed edge
+	// 3. traversal followed by filter(s) on the destination node
+	// 4. label scan sorted by distance from a point and limited
+	// 5. traversal sorted by an attribute of the traversed edge and limited
 
 	// convert label scan into a index scan
-	labelScanToIndexScan(plan, gc);
+	// when the graph has no indices this only reports unmet USING INDEX hints
+	labelScanToIndexScan(plan, gc, has_indices);
+
+	// return if the graph has no indices
+	if(!has_indices) return;
 
 	// convert traversal into a index scan
 	traversalToIndexScan(plan, gc);
+
+	// mask traversal destinations using an index
+	traversalDestinationMask(plan);
+
+	// yield nearest nodes using a geo index
+	sortByDistanceToDistanceScan(plan, gc);
+
+	// visit edges in attribute order using an edge range index
+	sortByEdgeAttributeToOrderedTraverse(plan, gc);
 }
 
@@ -0,0 +1,258 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "xxhash.h"
+#include "attribute_map.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+// initial number of attributes the map can hold without growing
+#define ATTRIBUTE_MAP_INITIAL_CAP 64
+
+// marks the slot of a removed attribute, probes continue past it
+static const char _tombstone;
+#define TOMBSTONE (&_tombstone)
+
+typedef struct {
+	const char *name;  // attribute name, NULL if the slot is empty
+	Attribute_ID id;   // attribute ID
+} AttributeSlot;
+
+// name to ID table, open addressing with linear probing
+// kept at most half full, tombstones included
+typedef struct {
+	uint64_t mask;          // number of slots - 1
+	AttributeSlot slots[];  // slots
+} NameTable;
+
+// ID to name table
+typedef struct {
+	uint cap;       // number of names the table can hold
+	char *names[];  // attribute names
+} IDTable;
+
+struct _AttributeMap {
+	NameTable *name_table;  // published name to ID table
+	IDTable *id_table;      // published ID to name table
+	uint count;             // number of published attributes
+	uint name_count;        // number of allocated names, removed included
+	uint tombstones;        // number of tombstones in name to ID table
+	void **retired;         // replaced tables and names
+};
+
+static NameTable *_NameTable_New
+(
+	uint64_t slot_count  // number of slots, power of 2
+) {
+	NameTable *t = rm_calloc(1, sizeof(NameTable) +
+			slot_count * sizeof(AttributeSlot));
+	t->mask = slot_count - 1;
+	return t;
+}
+
+// inserts attribute into table, the slot is published with a release store
+// such that readers observing the name observe its ID
+// returns true if a tombstone was reused
+static bool _NameTable_Insert
+(
+	NameTable *t,      // table
+	const char *name,  // attribute name
+	Attribute_ID id    // attribute ID
+) {
+	uint64_t i = XXH64(name, strlen(name), 0) & t->mask;
+	while(t->slots[i].name != NULL && t->slots[i].name != TOMBSTONE) {
+		i = (i + 1) & t->mask;
+	}
+
+	bool reused = t->slots[i].name == TOMBSTONE;
+	t->slots[i].id = id;
+	__atomic_store_n(&t->slots[i].name, name, __ATOMIC_RELEASE);
+
+	return reused;
+}
+
+static IDTable *_IDTable_New
+(
+	uint cap  // number of names the table can hold
+) {
+	IDTable *t = rm_malloc(sizeof(IDTable) + cap * sizeof(char *));
+	t->cap = cap;
+	return t;
+}
+
+// publishes a name to ID table holding the first 'count' attributes
+// the replaced table is retired
+static void _PublishNameTable
+(
+	AttributeMap *map,   // attribute map
+	uint64_t slot_count  // number of slots
+) {
+	NameTable *t = _NameTable_New(slot_count);
+	for(uint i = 0; i < map->count; i++) {
+		_NameTable_Insert(t, map->id_table->names[i], i);
+	}
+
+	// tombstones are dropped
+	map->tombstones = 0;
+	array_append(map->retired, map->name_table);
+	__atomic_store_n(&map->name_table, t, __ATOMIC_RELEASE);
+}
+
+AttributeMap *AttributeMap_New(void) {
+	AttributeMap *map = rm_malloc(sizeof(AttributeMap));
+
+	map->count      = 0;
+	map->name_count = 0;
+	map->tombstones = 0;
+	map->retired    = array_new(void *, 0);
+	map->id_table   = _IDTable_New(ATTRIBUTE_MAP_INITIAL_CAP);
+	map->name_table = _NameTable_New(ATTRIBUTE_MAP_INITIAL_CAP * 2);
+
+	return map;
+}
+
+uint AttributeMap_Count
+(
+	const AttributeMap *map
+) {
+	ASSERT(map != NULL);
+	return __atomic_load_n(&map->count, __ATOMIC_ACQUIRE);
+}
+
+Attribute_ID AttributeMap_GetID
+(
+	const AttributeMap *map,
+	const char *name
+) {
+	ASSERT(map  != NULL);
+	ASSERT(name != NULL);
+
+	NameTable *t = __atomic_load_n(&map->name_table, __ATOMIC_ACQUIRE);
+
+	uint64_t i = XXH64(name, strlen(name), 0) & t->mask;
+	while(true) {
+		AttributeSlot *slot = t->slots + i;
+		const char *slot_name = __atomic_load_n(&slot->name, __ATOMIC_ACQUIRE);
+
+		// tables are never full, an empty slot ends the probe
+		if(slot_name == NULL) return ATTRIBUTE_ID_NONE;
+		if(slot_name != TOMBSTONE && strcmp(slot_name, name) == 0) {
+			return slot->id;
+		}
+
+		i = (i + 1) & t->mask;
+	}
+}
+
+const char *AttributeMap_GetName
+(
+	const AttributeMap *map,
+	Attribute_ID id
+) {
+	ASSERT(map != NULL);
+	ASSERT(id < AttributeMap_Count(map));
+
+	IDTable *t = __atomic_load_n(&map->id_table, __ATOMIC_ACQUIRE);
+	return t->names[id];
+}
+
+Attribute_ID AttributeMap_Add
+(
+	AttributeMap *map,
+	const char *name
+) {
+	ASSERT(map  != NULL);
+	ASSERT(name != NULL);
+	ASSERT(AttributeMap_GetID(map, name) == ATTRIBUTE_ID_NONE);
+
+	Attribute_ID id = map->count;
+	ASSERT(id < ATTRIBUTE_ID_ALL);
+
+	// grow ID to name table
+	IDTable *ids = map->id_table;
+	if(id == ids->cap) {
+		IDTable *t = _IDTable_New(ids->cap * 2);
+		memcpy(t->names, ids->names, map->name_count * sizeof(char *));
+		array_append(map->retired, ids);
+		__atomic_store_n(&map->id_table, t, __ATOMIC_RELEASE);
+		ids = t;
+	}
+
+	// readers don't access IDs beyond count
+	// reuse the name of a removed attribute, e.g. a query adding the same
+	// attribute was rolled back
+	char *attr = NULL;
+	if(id < map->name_count && strcmp(ids->names[id], name) == 0) {
+		attr = ids->names[id];
+	} else {
+		if(id < map->name_count) {
+			// readers might still hold the removed name
+			array_append(map->retired, ids->names[id]);
+		} else {
+			map->name_count = id + 1;
+		}
+		attr = rm_strdup(name);
+		ids->names[id] = attr;
+	}
+
+	// grow name to ID table, keeping it at most half full
+	uint64_t slot_count = map->name_table->mask + 1;
+	if((uint64_t)(id + 1 + map->tombstones) * 2 > slot_count) {
+		// tables holding mostly tombstones aren't grown
+		if((uint64_t)(id + 1) * 4 > slot_count) slot_count *= 2;
+		_PublishNameTable(map, slot_count);
+	}
+
+	if(_NameTable_Insert(map->name_table, attr, id)) map->tombstones--;
+	__atomic_store_n(&map->count, id + 1, __ATOMIC_RELEASE);
+
+	return id;
+}
+
+void AttributeMap_RemoveLast
+(
+	AttributeMap *map
+) {
+	ASSERT(map != NULL);
+	ASSERT(map->count > 0);
+
+	uint id = map->count - 1;
+	__atomic_store_n(&map->count, id, __ATOMIC_RELEASE);
+
+	// tombstone the removed attribute's slot in place
+	// the name is kept for readers still holding it, and reused if the
+	// attribute is added again
+	NameTable *t = map->name_table;
+	const char *name = map->id_table->names[id];
+	uint64_t i = XXH64(name, strlen(name), 0) & t->mask;
+	while(t->slots[i].name != name) i = (i + 1) & t->mask;
+
+	__atomic_store_n(&t->slots[i].name, TOMBSTONE, __ATOMIC_RELEASE);
+	map->tombstones++;
+}
+
+void AttributeMap_Free
+(
+	AttributeMap *map
+) {
+	ASSERT(map != NULL);
+
+	for(uint i = 0; i < map->name_count; i++) {
+		rm_free(map->id_table->names[i]);
+	}
+
+	uint n = array_len(map->retired);
+	for(uint i = 0; i < n; i++) {
+		rm_free(map->retired[i]);
+	}
+	array_free(map->retired);
+
+	rm_free(map->id_table);
+	rm_free(map->name_table);
+	rm_free(map);
+}
+
@@ -0,0 +1,66 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "entities/attribute_set.h"
+
+// bidirectional mapping between attribute names and attribute IDs
+//
+// attributes are append-only, an attribute's ID is the number of attributes
+// added before it, readers resolve names and IDs without taking locks
+// writers publish new entries with release stores, when a table is full
+// a larger copy is published in its place, replaced tables are retired
+// and freed along with the map, as readers may still be accessing them
+// removing the last attribute, e.g. on rollback, tombstones its slot in place
+//
+// writers must be serialized by the caller
+typedef struct _AttributeMap AttributeMap;
+
+// create a new attribute map
+AttributeMap *AttributeMap_New(void);
+
+// returns the number of attributes in the map
+uint AttributeMap_Count
+(
+	const AttributeMap *map  // attribute map
+);
+
+// returns the ID of attribute 'name'
+// ATTRIBUTE_ID_NONE if the attribute doesn't exist
+Attribute_ID AttributeMap_GetID
+(
+	const AttributeMap *map,  // attribute map
+	const char *name          // attribute name
+);
+
+// returns the name of attribute 'id'
+const char *AttributeMap_GetName
+(
+	const AttributeMap *map,  // attribute map
+	Attribute_ID id           // attribute ID
+);
+
+// adds attribute 'name' to the map, returns its ID
+// the attribute must not be in the map
+Attribute_ID AttributeMap_Add
+(
+	AttributeMap *map,  // attribute map
+	const char *name    // attribute name
+);
+
+// removes the last added attribute from the map
+void AttributeMap_RemoveLast
+(
+	AttributeMap *map  // attribute map
+);
+
+// free attribute map
+void AttributeMap_Free
+(
+	AttributeMap *map  // attribute map
+);
+
@@ -8,6 +8,7 @@
 
 #include "RG.h"
 #include "attribute_set.h"
+#include "attribute_spill.h"
 #include "../../util/rmalloc.h"
 #include "../../errors/errors.h"
 
@@ -24,6 +25,62 @@ SIValue *ATTRIBUTE_NOTFOUND = &(SIValue) {
 	.longval = 0, .type = T_NULL
 };
 
+// frees the attribute values of set and set itself
+static void _AttributeSet_FreeSet
+(
+	AttributeSet set  // set to free
+) {
+	for(uint16_t i = 0; i < set->attr_count; ++i) {
+		SIValue_Free(set->attributes[i].value);
+	}
+
+	rm_free(set);
+}
+
+// loads spilled set back into memory, replacing its handle
+// returns the loaded set
+static AttributeSet _AttributeSet_FaultIn
+(
+	AttributeSet *set,   // stored attribute-set
+	AttributeSet handle  // spilled set handle
+) {
+	uint64_t offset = ATTRIBUTE_SET_SPILL_OFFSET(handle);
+
+	// a concurrent reader which already faulted in the set drops its record
+	// pin records such that the dropped record isn't reused while read
+	AttributeSpill_Pin();
+	AttributeSet current = __atomic_load_n(set, __ATOMIC_SEQ_CST);
+	if(current != handle) {
+		AttributeSpill_Unpin();
+		return current;
+	}
+
+	AttributeSet loaded = AttributeSpill_Read(offset);
+	AttributeSpill_Unpin();
+
+	// readers may fault in the same set concurrently, first one wins
+	AttributeSet expected = handle;
+	if(!__atomic_compare_exchange_n(set, &expected, loaded, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+		_AttributeSet_FreeSet(loaded);
+		return expected;
+	}
+
+	AttributeSpill_Drop(offset);
+	return loaded;
+}
+
+// makes sure set is in memory before it is modified
+static inline void _AttributeSet_Load
+(
+	AttributeSet *set  // stored attribute-set
+) {
+	AttributeSet _set = *set;
+	if(unlikely(ATTRIBUTE_SET_IS_SPILLED(_set))) {
+		_AttributeSet_FaultIn(set, _set);
+	}
+}
+
 // removes an attribute from set
 // returns true if attribute was removed false otherwise
 static bool _AttributeSet_Remove
@@ -158,6 +215,7 @@ static AttributeSet AttributeSet_AddPrepare
 	if(_set == NULL) {
 		_set = rm_malloc(sizeof(_AttributeSet) + n * sizeof(Attribute));
 		_set->attr_count = n;
+		_set->accessed   = 1;
 	} else {
 		_set->attr_count += n;
 		_set = rm_realloc(_set, ATTRIBUTESET_BYTE_SIZE(_set));
@@ -177,6 +235,8 @@ void AttributeSet_AddNoClone
 ) {
 	ASSERT(set != NULL);
 
+	_AttributeSet_Load(set);
+
 	// return if set is read-only
 	if(unlikely(ATTRIBUTE_SET_IS_READONLY(*set))) {
 		return;
@@ -223,6 +283,8 @@ void AttributeSet_Add
 ) {
 	ASSERT(set != NULL);
 
+	_AttributeSet_Load(set);
+
 	// return if set is read-only
 	if(unlikely(ATTRIBUTE_SET_IS_READONLY(*set))) {
 		return;
@@ -258,6 +320,7 @@ AttributeSetChangeType AttributeSet_Set_Allow_Null
 	ASSERT(set != NULL);
 	ASSERT(attr_id != ATTRIBUTE_ID_NONE);
 
+	_AttributeSet_Load(set);
 	AttributeSet _set = *set;
 
 	// return if set is read-only
@@ -310,6 +373,8 @@ bool AttributeSet_UpdateNoClone
 	ASSERT(set != NULL);
 	ASSERT(attr_id != ATTRIBUTE_ID_NONE);
 
+	_AttributeSet_Load(set);
+
 	// return if set is read-only
 	if(unlikely(ATTRIBUTE_SET_IS_READONLY(*set))) {
 		return false;
@@ -341,6 +406,7 @@ bool AttributeSet_Update
 	ASSERT(set != NULL);
 	ASSERT(attr_id != ATTRIBUTE_ID_NONE);
 
+	_AttributeSet_Load(set);
 	AttributeSet _set = *set;
 
 	// return if set is read-only
@@ -383,6 +449,7 @@ AttributeSet AttributeSet_ShallowClone
 	size_t n = ATTRIBUTESET_BYTE_SIZE(set);
 	AttributeSet clone = rm_malloc(n);
 	clone->attr_count  = _set->attr_count;
+	clone->accessed    = 1;
 
 	for(uint16_t i = 0; i < _set->attr_count; ++i) {
 		Attribute *attr       = _set->attributes  + i;
@@ -431,12 +498,72 @@ void AttributeSet_Free
 		return;
 	}
 
-	// free all allocated properties
-	for(uint16_t i = 0; i < _set->attr_count; ++i) {
-		SIValue_Free(_set->attributes[i].value);
+	// spilled set, discard its record
+	if(ATTRIBUTE_SET_IS_SPILLED(_set)) {
+		AttributeSpill_Drop(ATTRIBUTE_SET_SPILL_OFFSET(_set));
+		*set = NULL;
+		return;
 	}
 
-	rm_free(_set);
+	_AttributeSet_FreeSet(_set);
 	*set = NULL;
 }
 
+// returns the attribute-set stored at 'set'
+// a spilled set is faulted back in from disk
+// the access is recorded for eviction
+AttributeSet AttributeSet_Access
+(
+	AttributeSet *set  // stored attribute-set
+) {
+	ASSERT(set != NULL);
+
+	AttributeSet _set = __atomic_load_n(set, __ATOMIC_ACQUIRE);
+
+	if(!AttributeSpill_Enabled()) return _set;
+
+	if(unlikely(ATTRIBUTE_SET_IS_SPILLED(_set))) {
+		return _AttributeSet_FaultIn(set, _set);
+	}
+
+	// mark set as accessed, avoid writing when already marked
+	AttributeSet s = (AttributeSet)ATTRIBUTE_SET_CLEAR_MSB(_set);
+	if(s != NULL && s->accessed == 0) s->accessed = 1;
+
+	return _set;
+}
+
+// eviction sweep step, spills the set to disk
+// if it wasn't accessed since the previous sweep
+// returns true if the set was spilled
+bool AttributeSet_Spill
+(
+	AttributeSet *set  // stored attribute-set
+) {
+	ASSERT(set != NULL);
+	ASSERT(AttributeSpill_Enabled());
+
+	AttributeSet _set = *set;
+
+	// nothing to spill, or set is owned by the undo-log
+	if(_set == NULL                   ||
+	   ATTRIBUTE_SET_IS_SPILLED(_set) ||
+	   ATTRIBUTE_SET_IS_READONLY(_set)) {
+		return false;
+	}
+
+	// set was accessed recently, give it another round
+	if(_set->accessed) {
+		_set->accessed = 0;
+		return false;
+	}
+
+	uint64_t offset;
+	if(!AttributeSpill_Write(_set, &offset)) return false;
+
+	_AttributeSet_FreeSet(_set);
+	*set = ATTRIBUTE_SET_SPILLED(offset);
+
+	return true;
+}
+
@@ -21,6 +21,16 @@
 // check if attribute-set is read-only
 #define ATTRIBUTE_SET_IS_READONLY(set) ((intptr_t)(set) & MSB_MASK)
 
+// handle of an attribute-set spilled to disk at offset
+// sets are word aligned, a handle is told apart by its LSB
+#define ATTRIBUTE_SET_SPILLED(offset) ((AttributeSet)(((offset) << 1) | 1))
+
+// check if attribute-set is spilled to disk
+#define ATTRIBUTE_SET_IS_SPILLED(set) ((intptr_t)(set) & 1)
+
+// offset of a spilled attribute-set within the spill file
+#define ATTRIBUTE_SET_SPILL_OFFSET(set) ((uint64_t)(intptr_t)(set) >> 1)
+
 typedef unsigned short Attribute_ID;
 
 // type of change performed on the attribute-set
@@ -38,6 +48,7 @@ typedef struct {
 
 typedef struct {
 	uint16_t attr_count;     // number of attributes
+	uint8_t accessed;        // accessed since last eviction sweep
 	Attribute attributes[];  // key value pair of attributes
 } _AttributeSet;
 
@@ -124,6 +135,22 @@ void AttributeSet_PersistValues
 	const AttributeSet set  // set to persist
 );
 
+// returns the attribute-set stored at 'set'
+// a spilled set is faulted back in from disk
+// the access is recorded for eviction
+AttributeSet AttributeSet_Access
+(
+	AttributeSet *set  // stored attribute-set
+);
+
+// eviction sweep step, spills the set to disk
+// if it wasn't accessed since the previous sweep
+// returns true if the set was spilled
+bool AttributeSet_Spill
+(
+	AttributeSet *set  // stored attribute-set
+);
+
 // free attribute set
 void AttributeSet_Free
 (
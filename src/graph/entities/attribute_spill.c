@@ -0,0 +1,326 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "attribute_spill.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "../../configuration/config.h"
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// records are stored in extents rounded up to a size class
+// four classes per power of two, at most 25% of an extent is slack
+#define SPILL_MIN_SHIFT 5  // smallest extent, 32 bytes
+#define SPILL_CLASSES   (1 + 4 * (64 - SPILL_MIN_SHIFT))
+
+// extent of a dropped record
+typedef struct {
+	uint64_t offset;  // extent offset
+	uint32_t class;   // extent size class
+} SpillExtent;
+
+// spill file
+static struct {
+	int fd;                             // spill file descriptor, -1 when disabled
+	uint64_t size;                      // spill file size
+	uint64_t count;                     // number of spilled sets
+	uint64_t drops;                     // number of discarded spilled sets, ever
+	uint64_t pins;                      // number of records being faulted in
+	bool forked;                        // a forked child might read the file
+	SpillExtent *pending;               // dropped extents not yet reusable
+	uint64_t *reusable[SPILL_CLASSES];  // reusable extents offsets per class
+	pthread_mutex_t lock;               // serializes extents allocation
+} _spill = {
+	.fd       = -1,
+	.size     = 0,
+	.count    = 0,
+	.drops    = 0,
+	.pins     = 0,
+	.forked   = false,
+	.pending  = NULL,
+	.reusable = {NULL},
+	.lock     = PTHREAD_MUTEX_INITIALIZER
+};
+
+// returns the size class of a 'len' bytes record
+// and sets 'cap' to the class extent size
+static uint32_t _SizeClass
+(
+	uint64_t len,  // record length
+	uint64_t *cap  // [output] extent size
+) {
+	ASSERT(len > 0);
+
+	if(len <= (1ULL << SPILL_MIN_SHIFT)) {
+		*cap = 1ULL << SPILL_MIN_SHIFT;
+		return 0;
+	}
+
+	// len is in (2^(e-1), 2^e], rounded up to a multiple of 2^(e-3)
+	uint32_t e    = 64 - __builtin_clzll(len - 1);
+	uint64_t step = 1ULL << (e - 3);
+	uint64_t k    = (len + step - 1) >> (e - 3);  // 5 to 8
+
+	*cap = k * step;
+	return 1 + (e - SPILL_MIN_SHIFT - 1) * 4 + (k - 5);
+}
+
+// makes pending extents reusable
+// extents are pending while they might still be read
+// either by a reader which lost a fault-in race or by a forked child
+// expects the spill lock to be held
+static void _PromotePending(void) {
+	if(_spill.pending == NULL || array_len(_spill.pending) == 0) return;
+
+	// a forked child holds on to the records it was forked with
+	if(__atomic_load_n(&_spill.forked, __ATOMIC_SEQ_CST)) return;
+
+	// a concurrent fault-in might be reading a dropped record
+	if(__atomic_load_n(&_spill.pins, __ATOMIC_SEQ_CST) > 0) return;
+
+	uint32_t n = array_len(_spill.pending);
+	for(uint32_t i = 0; i < n; i++) {
+		SpillExtent *ext = _spill.pending + i;
+		if(_spill.reusable[ext->class] == NULL) {
+			_spill.reusable[ext->class] = array_new(uint64_t, 1);
+		}
+		array_append(_spill.reusable[ext->class], ext->offset);
+	}
+
+	array_clear(_spill.pending);
+}
+
+// allocates an extent for a 'len' bytes record
+// reusing a dropped extent of the same size class if one is available
+// returns the extent offset
+static uint64_t _AllocExtent
+(
+	uint64_t len  // record length
+) {
+	uint64_t cap;
+	uint32_t class = _SizeClass(len, &cap);
+
+	pthread_mutex_lock(&_spill.lock);
+
+	_PromotePending();
+
+	uint64_t offset;
+	uint64_t *exts = _spill.reusable[class];
+	if(exts != NULL && array_len(exts) > 0) {
+		offset = array_pop(exts);
+	} else {
+		offset = _spill.size;
+		_spill.size += cap;
+	}
+
+	pthread_mutex_unlock(&_spill.lock);
+
+	return offset;
+}
+
+// returns extent to its size class free list
+static void _FreeExtent
+(
+	uint64_t offset,  // extent offset
+	uint64_t len,     // length of the record stored in the extent
+	bool pending      // extent might still be read
+) {
+	uint64_t cap;
+	SpillExtent ext = {.offset = offset, .class = _SizeClass(len, &cap)};
+
+	pthread_mutex_lock(&_spill.lock);
+
+	if(pending) {
+		if(_spill.pending == NULL) _spill.pending = array_new(SpillExtent, 1);
+		array_append(_spill.pending, ext);
+	} else {
+		if(_spill.reusable[ext.class] == NULL) {
+			_spill.reusable[ext.class] = array_new(uint64_t, 1);
+		}
+		array_append(_spill.reusable[ext.class], offset);
+	}
+
+	pthread_mutex_unlock(&_spill.lock);
+}
+
+bool AttributeSpill_Init
+(
+	RedisModuleCtx *ctx  // redis module context
+) {
+	ASSERT(_spill.fd == -1);
+
+	const char *folder = NULL;
+	Config_Option_get(Config_ATTRIBUTE_SPILL_FOLDER, &folder);
+
+	// spilling is disabled
+	if(folder == NULL || strlen(folder) == 0) return true;
+
+	char *path = NULL;
+	int rc __attribute__((unused));
+	rc = asprintf(&path, "%s/falkordb-attributes-%d.spill", folder, getpid());
+
+	_spill.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if(_spill.fd == -1) {
+		RedisModule_Log(ctx, "warning",
+				"Failed to create attribute spill file %s", path);
+		free(path);
+		return false;
+	}
+
+	// the file is only reachable through its descriptor
+	// which forked processes inherit
+	unlink(path);
+
+	RedisModule_Log(ctx, "notice", "Spilling cold attributes to %s", folder);
+	free(path);
+
+	return true;
+}
+
+bool AttributeSpill_Enabled(void) {
+	return _spill.fd != -1;
+}
+
+// record format:
+//    payload length
+//    attribute count
+//    attributes: id, value
+bool AttributeSpill_Write
+(
+	const AttributeSet set,  // set to spill
+	uint64_t *offset         // [output] offset of the spilled set
+) {
+	ASSERT(set    != NULL);
+	ASSERT(offset != NULL);
+	ASSERT(AttributeSpill_Enabled());
+
+	char   *buf = NULL;
+	size_t  len = 0;
+	FILE *stream = open_memstream(&buf, &len);
+	if(stream == NULL) return false;
+
+	// payload length, set once the record is serialized
+	uint32_t n = 0;
+	fwrite_assert(&n, sizeof(uint32_t), stream);
+
+	fwrite_assert(&set->attr_count, sizeof(uint16_t), stream);
+	for(uint16_t i = 0; i < set->attr_count; i++) {
+		const Attribute *attr = set->attributes + i;
+		fwrite_assert(&attr->id, sizeof(Attribute_ID), stream);
+		SIValue_ToBinary(stream, &attr->value);
+	}
+
+	fclose(stream);
+
+	n = len - sizeof(uint32_t);
+	memcpy(buf, &n, sizeof(uint32_t));
+
+	// write record into a reused or newly appended extent
+	uint64_t at = _AllocExtent(len);
+	bool written = pwrite(_spill.fd, buf, len, at) == (ssize_t)len;
+
+	// the extent was never referenced, it can be reused right away
+	if(!written) _FreeExtent(at, len, false);
+
+	free(buf);
+
+	if(!written) return false;
+
+	__atomic_fetch_add(&_spill.count, 1, __ATOMIC_RELAXED);
+	*offset = at;
+
+	return true;
+}
+
+AttributeSet AttributeSpill_Read
+(
+	uint64_t offset  // offset of the spilled set
+) {
+	ASSERT(AttributeSpill_Enabled());
+
+	// spilled attributes can't be recovered, losing them is fatal
+	uint32_t n;
+	ssize_t nread = pread(_spill.fd, &n, sizeof(uint32_t), offset);
+	RedisModule_Assert(nread == sizeof(uint32_t));
+
+	char *buf = rm_malloc(n);
+	nread = pread(_spill.fd, buf, n, offset + sizeof(uint32_t));
+	RedisModule_Assert(nread == n);
+
+	FILE *stream = fmemopen(buf, n, "r");
+	RedisModule_Assert(stream != NULL);
+
+	uint16_t attr_count;
+	fread_assert(&attr_count, sizeof(uint16_t), stream);
+
+	AttributeSet set =
+		rm_malloc(sizeof(_AttributeSet) + attr_count * sizeof(Attribute));
+	set->attr_count = attr_count;
+	set->accessed   = 1;
+
+	for(uint16_t i = 0; i < attr_count; i++) {
+		Attribute *attr = set->attributes + i;
+		fread_assert(&attr->id, sizeof(Attribute_ID), stream);
+		attr->value = SIValue_FromBinary(stream);
+	}
+
+	fclose(stream);
+	rm_free(buf);
+
+	return set;
+}
+
+void AttributeSpill_Drop
+(
+	uint64_t offset  // offset of the spilled set
+) {
+	ASSERT(AttributeSpill_Enabled());
+
+	// the record length determines its extent size class
+	uint32_t n;
+	ssize_t nread = pread(_spill.fd, &n, sizeof(uint32_t), offset);
+	RedisModule_Assert(nread == sizeof(uint32_t));
+
+	_FreeExtent(offset, n + sizeof(uint32_t), true);
+
+	__atomic_fetch_sub(&_spill.count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&_spill.drops, 1, __ATOMIC_RELAXED);
+}
+
+void AttributeSpill_Pin(void) {
+	__atomic_fetch_add(&_spill.pins, 1, __ATOMIC_SEQ_CST);
+}
+
+void AttributeSpill_Unpin(void) {
+	__atomic_fetch_sub(&_spill.pins, 1, __ATOMIC_SEQ_CST);
+}
+
+void AttributeSpill_ForkPrepare(void) {
+	__atomic_store_n(&_spill.forked, true, __ATOMIC_SEQ_CST);
+}
+
+void AttributeSpill_ForkDone(void) {
+	__atomic_store_n(&_spill.forked, false, __ATOMIC_SEQ_CST);
+}
+
+uint64_t AttributeSpill_FileSize(void) {
+	pthread_mutex_lock(&_spill.lock);
+	uint64_t size = _spill.size;
+	pthread_mutex_unlock(&_spill.lock);
+
+	return size;
+}
+
+uint64_t AttributeSpill_SpilledCount(void) {
+	return __atomic_load_n(&_spill.count, __ATOMIC_RELAXED);
+}
+
+uint64_t AttributeSpill_DropCount(void) {
+	return __atomic_load_n(&_spill.drops, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "attribute_set.h"
+#include "../../redismodule.h"
+
+// attribute-sets of rarely accessed entities can be spilled to disk
+// a spilled set is replaced by a handle, see ATTRIBUTE_SET_SPILLED
+// and loaded back into memory once accessed
+//
+// spilled sets are written to a per process file
+// created within the configured ATTRIBUTE_SPILL_FOLDER
+// the file is unlinked on creation and is discarded once the process exits
+// extents of dropped records are reused by later spills of the same size class
+// once no concurrent fault-in or forked child might still read them
+
+// initialize attribute spilling
+// spilling is disabled when no spill folder is configured
+// returns false if the spill file couldn't be created
+bool AttributeSpill_Init
+(
+	RedisModuleCtx *ctx  // redis module context
+);
+
+// returns true if attribute spilling is enabled
+bool AttributeSpill_Enabled(void);
+
+// writes set to the spill file
+// returns false if set couldn't be written
+bool AttributeSpill_Write
+(
+	const AttributeSet set,  // set to spill
+	uint64_t *offset         // [output] offset of the spilled set
+);
+
+// reads spilled set from the spill file
+AttributeSet AttributeSpill_Read
+(
+	uint64_t offset  // offset of the spilled set
+);
+
+// discards spilled set, its record is no longer referenced
+void AttributeSpill_Drop
+(
+	uint64_t offset  // offset of the spilled set
+);
+
+// pins spill records while a spilled set is faulted in
+// records dropped by a concurrent fault-in aren't reused while pinned
+void AttributeSpill_Pin(void);
+
+// releases a pin taken by AttributeSpill_Pin
+void AttributeSpill_Unpin(void);
+
+// called before the process forks
+// records dropped from now on aren't reused until the child exits
+void AttributeSpill_ForkPrepare(void);
+
+// called once the forked child exited
+void AttributeSpill_ForkDone(void);
+
+// returns spill file size in bytes
+uint64_t AttributeSpill_FileSize(void);
+
+// returns number of spilled attribute-sets
+uint64_t AttributeSpill_SpilledCount(void);
+
+// returns number of spilled attribute-sets discarded since startup
+// e.g. loaded back into memory
+uint64_t AttributeSpill_DropCount(void);
@@ -41,7 +41,7 @@ SIValue *GraphEntity_GetProperty
  		return ATTRIBUTE_NOTFOUND;
  	}
 
-	return AttributeSet_Get(*e->attributes, attr_id);
+	return AttributeSet_Get(AttributeSet_Access(e->attributes), attr_id);
 }
 
 // returns an SIArray of all keys in graph entity properties
@@ -228,7 +228,7 @@ inline AttributeSet GraphEntity_GetAttributes
 ) {
 	ASSERT(e != NULL);
 
-	return *e->attributes;
+	return AttributeSet_Access(e->attributes);
 }
 
 inline int GraphEntity_ClearAttributes
@@ -237,7 +237,7 @@ inline int GraphEntity_ClearAttributes
 ) {
 	ASSERT(e != NULL);
 
-	int count = AttributeSet_Count(*e->attributes);
+	int count = AttributeSet_Count(GraphEntity_GetAttributes(e));
 
 	AttributeSet_Free(e->attributes);
 
@@ -0,0 +1,164 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "entity_expiry.h"
+#include "../util/rmalloc.h"
+
+#include <endian.h>
+
+// entry key: big-endian expiration time, entity type and entity ID
+// such that the rax lexicographic order is the expiration order
+#define KEY_LEN (sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint64_t))
+
+// flip sign bit, negative times order before positive ones
+#define SIGN_BIT (1ULL << 63)
+
+static void _EncodeKey
+(
+	unsigned char *key,  // [output] encoded key
+	GraphEntityType t,   // entity type
+	EntityID id,         // entity ID
+	int64_t expires      // expiration time
+) {
+	uint64_t ts = htobe64((uint64_t)expires ^ SIGN_BIT);
+	uint64_t be_id = htobe64(id);
+
+	memcpy(key, &ts, sizeof(uint64_t));
+	key[sizeof(uint64_t)] = (uint8_t)t;
+	memcpy(key + sizeof(uint64_t) + sizeof(uint8_t), &be_id, sizeof(uint64_t));
+}
+
+static void _DecodeKey
+(
+	const unsigned char *key,  // encoded key
+	GraphEntityType *t,        // [output] entity type
+	EntityID *id,              // [output] entity ID
+	int64_t *expires           // [output] expiration time
+) {
+	uint64_t ts;
+	uint64_t be_id;
+
+	memcpy(&ts, key, sizeof(uint64_t));
+	memcpy(&be_id, key + sizeof(uint64_t) + sizeof(uint8_t), sizeof(uint64_t));
+
+	*expires = (int64_t)(be64toh(ts) ^ SIGN_BIT);
+	*t       = (GraphEntityType)key[sizeof(uint64_t)];
+	*id      = be64toh(be_id);
+}
+
+// retrieves the earliest entry
+// returns false if there are no entries
+static bool _Earliest
+(
+	EntityExpiry *ex,       // entity expiry
+	unsigned char *key,     // [output] encoded key
+	int64_t *expires        // [output] expiration time
+) {
+	if(raxSize(ex->entries) == 0) return false;
+
+	raxIterator it;
+	raxStart(&it, ex->entries);
+	raxSeek(&it, "^", NULL, 0);
+
+	bool found = raxNext(&it);
+	if(found) {
+		ASSERT(it.key_len == KEY_LEN);
+		memcpy(key, it.key, KEY_LEN);
+
+		GraphEntityType t;
+		EntityID id;
+		_DecodeKey(key, &t, &id, expires);
+	}
+
+	raxStop(&it);
+	return found;
+}
+
+EntityExpiry *EntityExpiry_New(void) {
+	EntityExpiry *ex = rm_malloc(sizeof(EntityExpiry));
+
+	ex->entries = raxNew();
+	int res = pthread_mutex_init(&ex->lock, NULL);
+	ASSERT(res == 0);
+
+	return ex;
+}
+
+void EntityExpiry_Add
+(
+	EntityExpiry *ex,
+	GraphEntityType t,
+	EntityID id,
+	int64_t expires
+) {
+	ASSERT(ex != NULL);
+	ASSERT(t == GETYPE_NODE || t == GETYPE_EDGE);
+
+	unsigned char key[KEY_LEN];
+	_EncodeKey(key, t, id, expires);
+
+	pthread_mutex_lock(&ex->lock);
+	raxInsert(ex->entries, key, KEY_LEN, NULL, NULL);
+	pthread_mutex_unlock(&ex->lock);
+}
+
+bool EntityExpiry_Due
+(
+	EntityExpiry *ex,
+	int64_t now
+) {
+	ASSERT(ex != NULL);
+
+	int64_t expires;
+	unsigned char key[KEY_LEN];
+
+	pthread_mutex_lock(&ex->lock);
+	bool due = _Earliest(ex, key, &expires) && expires <= now;
+	pthread_mutex_unlock(&ex->lock);
+
+	return due;
+}
+
+bool EntityExpiry_Pop
+(
+	EntityExpiry *ex,
+	int64_t now,
+	GraphEntityType *t,
+	EntityID *id
+) {
+	ASSERT(ex != NULL);
+	ASSERT(t  != NULL);
+	ASSERT(id != NULL);
+
+	int64_t expires;
+	unsigned char key[KEY_LEN];
+
+	pthread_mutex_lock(&ex->lock);
+
+	bool due = _Earliest(ex, key, &expires) && expires <= now;
+	if(due) {
+		raxRemove(ex->entries, key, KEY_LEN, NULL);
+		_DecodeKey(key, t, id, &expires);
+	}
+
+	pthread_mutex_unlock(&ex->lock);
+
+	return due;
+}
+
+void EntityExpiry_Free
+(
+	EntityExpiry *ex
+) {
+	ASSERT(ex != NULL);
+
+	raxFree(ex->entries);
+	int res = pthread_mutex_destroy(&ex->lock);
+	ASSERT(res == 0);
+
+	rm_free(ex);
+}
+
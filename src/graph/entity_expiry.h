@@ -0,0 +1,62 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "rax.h"
+#include "entities/graph_entity.h"
+
+#include <pthread.h>
+
+// entities pending expiry, ordered by expiration time
+//
+// an entity expires once the value of its ENTITY_EXPIRY_ATTRIBUTE
+// an integer holding milliseconds since epoch, see timestamp()
+// is in the past
+//
+// an entry is added whenever an entity is assigned an expiration time
+// entries aren't updated nor removed when the entity is modified or deleted
+// instead each entry is validated once due, the entity is expired only if
+// it still holds an expiration time which has passed
+typedef struct {
+	rax *entries;          // (expiration time, entity type, entity ID)
+	pthread_mutex_t lock;  // guards entries
+} EntityExpiry;
+
+// create a new entity expiry structure
+EntityExpiry *EntityExpiry_New(void);
+
+// add an entry for entity expiring at 'expires'
+void EntityExpiry_Add
+(
+	EntityExpiry *ex,   // entity expiry
+	GraphEntityType t,  // entity type
+	EntityID id,        // entity ID
+	int64_t expires     // expiration time, ms since epoch
+);
+
+// returns true if an entry is due by 'now'
+bool EntityExpiry_Due
+(
+	EntityExpiry *ex,  // entity expiry
+	int64_t now        // current time, ms since epoch
+);
+
+// removes the earliest entry due by 'now'
+// returns false if no entry is due
+bool EntityExpiry_Pop
+(
+	EntityExpiry *ex,    // entity expiry
+	int64_t now,         // current time, ms since epoch
+	GraphEntityType *t,  // [output] entity type
+	EntityID *id         // [output] entity ID
+);
+
+// free entity expiry
+void EntityExpiry_Free
+(
+	EntityExpiry *ex  // entity expiry
+);
+
@@ -66,6 +66,34 @@ void Graph_AcquireWriteLock(Graph *g) {
 
 	pthread_rwlock_wrlock(&g->_rwlock);
 	g->_writelocked = true;
+	g->_write_version++;
+}
+
+// tries to acquire the write lock without blocking
+// the acquisition isn't counted as a write
+bool Graph_TryAcquireWriteLock
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+
+	if(pthread_rwlock_trywrlock(&g->_rwlock) != 0) return false;
+
+	ASSERT(g->_writelocked == false);
+	g->_writelocked = true;
+
+	return true;
+}
+
+// counts a write performed under a lock acquired by Graph_TryAcquireWriteLock
+void Graph_CountWrite
+(
+	Graph *g
+) {
+	ASSERT(g != NULL);
+	ASSERT(g->_writelocked == true);
+
+	g->_write_version++;
 }
 
 // Release the held lock
@@ -86,6 +114,110 @@ void Graph_ReleaseLock
 	pthread_rwlock_unlock(&g->_rwlock);
 }
 
+// returns the number of times the graph's write lock was acquired
+uint64_t Graph_WriteVersion
+(
+	const Graph *g
+) {
+	ASSERT(g != NULL);
+
+	return g->_write_version;
+}
+
+// stamps entry 'idx' of 'versions' with the current write version
+static void _Touch
+(
+	const Graph *g,       // graph
+	uint64_t **versions,  // write version per label or relation
+	int idx               // label or relation ID
+) {
+	ASSERT(g != NULL);
+	ASSERT(idx >= 0);
+	ASSERT(g->_writelocked == true);
+
+	while(array_len(*versions) <= (uint32_t)idx) array_append(*versions, 0);
+	(*versions)[idx] = g->_write_version;
+}
+
+// returns true if entry 'idx' of 'versions' was stamped after 'version'
+static bool _ModifiedSince
+(
+	const Graph *g,             // graph
+	uint64_t *versions,         // write version per label or relation
+	int idx,                    // label or relation ID
+	uint64_t version            // write version
+) {
+	ASSERT(g != NULL);
+	ASSERT(idx >= 0);
+
+	if(g->_all_version > version) return true;
+	if(array_len(versions) <= (uint32_t)idx) return false;
+	return versions[idx] > version;
+}
+
+// marks the nodes of label 'l' as modified by the current write
+void Graph_TouchLabel
+(
+	Graph *g,   // graph
+	LabelID l   // modified label
+) {
+	_Touch(g, &g->_label_versions, l);
+}
+
+// marks the edges of relation 'r' as modified by the current write
+void Graph_TouchRelation
+(
+	Graph *g,     // graph
+	RelationID r  // modified relation
+) {
+	_Touch(g, &g->_relation_versions, r);
+}
+
+// marks every label of node 'id' as modified by the current write
+void Graph_TouchNode
+(
+	Graph *g,  // graph
+	NodeID id  // modified node
+) {
+	Node n = GE_NEW_NODE();
+	n.id = id;
+
+	uint label_count;
+	NODE_GET_LABELS(g, &n, label_count);
+	for(uint i = 0; i < label_count; i++) Graph_TouchLabel(g, labels[i]);
+}
+
+// marks every entity as modified by the current write
+void Graph_TouchAll
+(
+	Graph *g  // graph
+) {
+	ASSERT(g != NULL);
+	ASSERT(g->_writelocked == true);
+
+	g->_all_version = g->_write_version;
+}
+
+// returns true if a node of label 'l' was modified after write 'version'
+bool Graph_LabelModifiedSince
+(
+	const Graph *g,   // graph
+	LabelID l,        // label
+	uint64_t version  // write version
+) {
+	return _ModifiedSince(g, g->_label_versions, l, version);
+}
+
+// returns true if an edge of relation 'r' was modified after write 'version'
+bool Graph_RelationModifiedSince
+(
+	const Graph *g,   // graph
+	RelationID r,     // relation
+	uint64_t version  // write version
+) {
+	return _ModifiedSince(g, g->_relation_versions, r, version);
+}
+
 //------------------------------------------------------------------------------
 // Graph utility functions
 //------------------------------------------------------------------------------
@@ -161,6 +293,38 @@ static inline AttributeSet *_Graph_GetEntity(const DataBlock *entities, EntityID
 	return DataBlock_GetItem(entities, id);
 }
 
+// records edge endpoints and relation type
+// used by edge creation and decoding
+void Graph_SetEdgeMeta
+(
+	Graph *g,
+	EdgeID id,
+	NodeID src,
+	NodeID dest,
+	RelationID r
+) {
+	// grow metadata, unset entries are marked with an invalid relation
+	if(id >= g->edge_meta_cap) {
+		uint64_t cap = MAX(g->edge_meta_cap * 2, id + 1);
+		g->edge_meta = rm_realloc(g->edge_meta, cap * sizeof(EdgeMeta));
+		memset(g->edge_meta + g->edge_meta_cap, 0xFF,
+				(cap - g->edge_meta_cap) * sizeof(EdgeMeta));
+		g->edge_meta_cap = cap;
+	}
+
+	g->edge_meta[id] = (EdgeMeta) {.src = src, .dest = dest, .relation = r};
+}
+
+// returns edge metadata, NULL if edge ID was never set
+static inline const EdgeMeta *_Graph_GetEdgeMeta
+(
+	const Graph *g,
+	EdgeID id
+) {
+	if(id >= g->edge_meta_cap) return NULL;
+	return g->edge_meta + id;
+}
+
 //------------------------------------------------------------------------------
 // Matrix synchronization and resizing functions
 //------------------------------------------------------------------------------
@@ -466,7 +630,11 @@ Graph *Graph_New
 
 	// initialize a read-write lock scoped to the individual graph
 	_CreateRWLock(g);
-	g->_writelocked = false;
+	g->_writelocked       = false;
+	g->_write_version     = 0;
+	g->_all_version       = 0;
+	g->_label_versions    = array_new(uint64_t, 0);
+	g->_relation_versions = array_new(uint64_t, 0);
 
 	// force GraphBLAS updates and resize matrices to node count by default
 	g->SynchronizeMatrix = _MatrixSynchronize;
@@ -494,6 +662,44 @@ size_t Graph_UncompactedNodeCount(const Graph *g) {
 	return Graph_NodeCount(g) + Graph_DeletedNodeCount(g);
 }
 
+bool Graph_SpillAttributes
+(
+	Graph *g,
+	GraphEntityType t,
+	uint64_t *cursor,
+	uint64_t n,
+	uint64_t *spilled,
+	uint64_t *resident
+) {
+	ASSERT(g        != NULL);
+	ASSERT(cursor   != NULL);
+	ASSERT(spilled  != NULL);
+	ASSERT(resident != NULL);
+	ASSERT(t == GETYPE_NODE || t == GETYPE_EDGE);
+
+	// number of existing and deleted entities
+	DataBlock *entities = (t == GETYPE_NODE) ? g->nodes : g->edges;
+	uint64_t total = DataBlock_ItemCount(entities) +
+		DataBlock_DeletedItemsCount(entities);
+
+	uint64_t i   = MIN(*cursor, total);
+	uint64_t end = (total - i > n) ? i + n : total;
+
+	for(; i < end; i++) {
+		AttributeSet *set = DataBlock_GetItem(entities, i);
+		if(set == NULL || *set == NULL) continue;
+
+		if(AttributeSet_Spill(set)) {
+			(*spilled)++;
+		} else if(!ATTRIBUTE_SET_IS_SPILLED(*set)) {
+			(*resident)++;
+		}
+	}
+
+	*cursor = i;
+	return i == total;
+}
+
 uint64_t Graph_LabeledNodeCount
 (
 	const Graph *g,
@@ -565,8 +771,16 @@ bool Graph_GetEdge
 
 	e->id         = id;
 	e->attributes = _Graph_GetEntity(g->edges, id);
+	if(e->attributes == NULL) return false;
+
+	const EdgeMeta *meta = _Graph_GetEdgeMeta(g, id);
+	ASSERT(meta != NULL);
 
-	return (e->attributes != NULL);
+	e->src_id     = meta->src;
+	e->dest_id    = meta->dest;
+	e->relationID = meta->relation;
+
+	return true;
 }
 
 RelationID Graph_GetEdgeRelation
@@ -577,44 +791,14 @@ RelationID Graph_GetEdgeRelation
 	ASSERT(g);
 	ASSERT(e);
 
-	GrB_Info info;
-	RelationID rel     = GRAPH_NO_RELATION;
-	EdgeID     id      = ENTITY_GET_ID(e);
-	NodeID     src_id  = Edge_GetSrcNodeID(e);
-	NodeID     dest_id = Edge_GetDestNodeID(e);
-
-	// search for relation mapping matrix M, where M[dest,src] == edge ID
-	uint n = array_len(g->relations);
-	for(uint i = 0; i < n; i++) {
-		EdgeID edgeId = 0;
-		RG_Matrix M = Graph_GetRelationMatrix(g, i, false);
-		info = RG_Matrix_extractElement_UINT64(&edgeId, M, src_id, dest_id);
-		if(info != GrB_SUCCESS) continue;
-
-		if(SINGLE_EDGE(edgeId)) {
-			EdgeID curEdgeID = edgeId;
-			if(curEdgeID == id) {
-				Edge_SetRelationID(e, i);
-				rel = i;
-				break;
-			}
-		} else {
-			// multiple edges exists between src and dest
-			// see if given edge is one of them
-			EdgeID *edges = (EdgeID *)(CLEAR_MSB(edgeId));
-			int edge_count = array_len(edges);
-			for(int j = 0; j < edge_count; j++) {
-				if(edges[j] == id) {
-					Edge_SetRelationID(e, i);
-					rel = i;
-					break;
-				}
-			}
-		}
-	}
+	const EdgeMeta *meta = _Graph_GetEdgeMeta(g, ENTITY_GET_ID(e));
+	ASSERT(meta != NULL);
 
 	// we must be able to find edge relation
+	RelationID rel = meta->relation;
 	ASSERT(rel != GRAPH_NO_RELATION);
+
+	Edge_SetRelationID(e, rel);
 	return rel;
 }
 
@@ -851,6 +1035,7 @@ void Graph_CreateEdge
 	e->attributes = set;
 	e->relationID = r;
 
+	Graph_SetEdgeMeta(g, id, src, dest, r);
 	Graph_FormConnection(g, src, dest, id, r);
 }
 
@@ -1110,8 +1295,11 @@ void Graph_DeleteEdges
 		int         r         =  Edge_GetRelationID(e);
 		NodeID      src_id    =  Edge_GetSrcNodeID(e);
 		NodeID      dest_id   =  Edge_GetDestNodeID(e);
+		EdgeMeta   *meta      =  g->edge_meta + ENTITY_GET_ID(e);
 
 		ASSERT(!DataBlock_ItemIsDeleted((void *)e->attributes));
+		ASSERT(meta->relation == r);
+		ASSERT(meta->src == src_id && meta->dest == dest_id);
 
 		// an edge of type r has just been deleted, update statistics
 		GraphStatistics_DecEdgeCount(&g->stats, r, 1);
@@ -1150,6 +1338,7 @@ void Graph_DeleteEdges
 
 		// free and remove edges from datablock.
 		DataBlock_DeleteItem(g->edges, ENTITY_GET_ID(e));
+		meta->relation = GRAPH_NO_RELATION;
 	}
 
 	Graph_SetMatrixPolicy(g, policy);
@@ -1380,6 +1569,9 @@ static void _Graph_Free
 	array_free(g->labels);
 	RG_Matrix_free(&g->node_labels);
 
+	array_free(g->_label_versions);
+	array_free(g->_relation_versions);
+
 	it = is_full_graph ? Graph_ScanNodes(g) : DataBlock_FullScan(g->nodes);
 	while((set = (AttributeSet *)DataBlockIterator_Next(it, NULL)) != NULL) {
 		if(*set != NULL) {
@@ -1400,6 +1592,7 @@ static void _Graph_Free
 	// free blocks
 	DataBlock_Free(g->nodes);
 	DataBlock_Free(g->edges);
+	rm_free(g->edge_meta);
 
 	int res;
 	UNUSED(res);
@@ -38,6 +38,14 @@ typedef enum {
 	SYNC_POLICY_NOP,
 } MATRIX_POLICY;
 
+// edge endpoints and relation type, kept per edge ID
+// allows resolving an edge without probing relation matrices
+typedef struct {
+	NodeID src;           // source node ID
+	NodeID dest;          // destination node ID
+	RelationID relation;  // relation type ID
+} EdgeMeta;
+
 // forward declaration of Graph struct
 typedef struct Graph Graph;
 // typedef for synchronization function pointer
@@ -47,6 +55,8 @@ struct Graph {
 	int reserved_node_count;           // number of nodes not commited yet
 	DataBlock *nodes;                  // graph nodes stored in blocks
 	DataBlock *edges;                  // graph edges stored in blocks
+	EdgeMeta *edge_meta;               // edges metadata, indexed by edge ID
+	uint64_t edge_meta_cap;            // number of entries in edge_meta
 	RG_Matrix adjacency_matrix;        // adjacency matrix, holds all graph connections
 	RG_Matrix *labels;                 // label matrices
 	RG_Matrix node_labels;             // mapping of all node IDs to all labels possessed by each node
@@ -54,6 +64,10 @@ struct Graph {
 	RG_Matrix _zero_matrix;            // zero matrix
 	pthread_rwlock_t _rwlock;          // read-write lock scoped to this specific graph
 	bool _writelocked;                 // true if the read-write lock was acquired by a writer
+	uint64_t _write_version;           // number of times the write lock was acquired
+	uint64_t *_label_versions;         // write version last modifying each label
+	uint64_t *_relation_versions;      // write version last modifying each relation
+	uint64_t _all_version;             // write version last modifying any entity
 	SyncMatrixFunc SynchronizeMatrix;  // function pointer to matrix synchronization routine
 	GraphStatistics stats;             // graph related statistics
 };
@@ -73,12 +87,84 @@ void Graph_AcquireWriteLock
 	Graph *g
 );
 
+// tries to acquire the write lock without blocking
+// unlike Graph_AcquireWriteLock the acquisition isn't counted as a write
+// callers modifying the graph must call Graph_CountWrite
+// returns true if the lock was acquired
+bool Graph_TryAcquireWriteLock
+(
+	Graph *g
+);
+
+// counts a write performed under a lock acquired by Graph_TryAcquireWriteLock
+// interleaving optimistic writes detect it, see Graph_WriteVersion
+void Graph_CountWrite
+(
+	Graph *g
+);
+
 // release the held lock
 void Graph_ReleaseLock
 (
 	Graph *g
 );
 
+// returns the number of times the graph's write lock was acquired
+// a reader holding the read lock can use it to detect interleaving writes
+uint64_t Graph_WriteVersion
+(
+	const Graph *g
+);
+
+// marks the nodes of label 'l' as modified by the current write
+// must be called while holding the write lock
+void Graph_TouchLabel
+(
+	Graph *g,   // graph
+	LabelID l   // modified label
+);
+
+// marks the edges of relation 'r' as modified by the current write
+// must be called while holding the write lock
+void Graph_TouchRelation
+(
+	Graph *g,     // graph
+	RelationID r  // modified relation
+);
+
+// marks every label of node 'id' as modified by the current write
+// must be called while holding the write lock
+void Graph_TouchNode
+(
+	Graph *g,  // graph
+	NodeID id  // modified node
+);
+
+// marks every entity as modified by the current write
+// used by writes which don't track the labels and relations they modify
+void Graph_TouchAll
+(
+	Graph *g  // graph
+);
+
+// returns true if a node of label 'l' was modified by a write
+// committed after write 'version', see Graph_WriteVersion
+bool Graph_LabelModifiedSince
+(
+	const Graph *g,   // graph
+	LabelID l,        // label
+	uint64_t version  // write version
+);
+
+// returns true if an edge of relation 'r' was modified by a write
+// committed after write 'version', see Graph_WriteVersion
+bool Graph_RelationModifiedSince
+(
+	const Graph *g,   // graph
+	RelationID r,     // relation
+	uint64_t version  // write version
+);
+
 // synchronize and resize all matrices in graph
 void Graph_ApplyAllPending
 (
@@ -270,6 +356,20 @@ size_t Graph_UncompactedNodeCount
 	const Graph *g
 );
 
+// eviction sweep over the attribute-sets of up to 'n' entities
+// of type 't' starting at '*cursor', see AttributeSet_Spill
+// advances '*cursor' past the last visited entity
+// returns true once all entities were visited
+bool Graph_SpillAttributes
+(
+	Graph *g,            // graph
+	GraphEntityType t,   // type of entities to sweep
+	uint64_t *cursor,    // [input/output] next entity to visit
+	uint64_t n,          // max number of entities to visit
+	uint64_t *spilled,   // [output] incremented per spilled set
+	uint64_t *resident   // [output] incremented per set left in memory
+);
+
 // returns number of nodes with given label
 uint64_t Graph_LabeledNodeCount
 (
@@ -326,8 +426,8 @@ bool Graph_GetNode
 	Node *n
 );
 
-// retrieves edge with given id from graph,
-// returns NULL if edge wasn't found
+// retrieves edge with given id from graph, including its endpoints
+// and relation type, returns false if edge wasn't found
 bool Graph_GetEdge
 (
 	const Graph *g,
@@ -335,7 +435,7 @@ bool Graph_GetEdge
 	Edge *e
 );
 
-// retrieves edge relation type
+// retrieves edge relation type in constant time
 // returns GRAPH_NO_RELATION if edge has no relation type
 RelationID Graph_GetEdgeRelation
 (
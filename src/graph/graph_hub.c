@@ -113,8 +113,12 @@ void CreateNode
 		Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
 		ASSERT(s);
 		Schema_AddNodeToIndex(s, n);
+		Graph_TouchLabel(gc->g, labels[i]);
 	}
 
+	// schedule node expiry
+	GraphContext_TrackExpiry(gc, (GraphEntity *)n, GETYPE_NODE);
+
 	// add node creation operation to undo log
 	if(log == true) {
 		UndoLog undo_log = QueryCtx_GetUndoLog();
@@ -140,11 +144,19 @@ void CreateEdge
 	Graph_CreateEdge(gc->g, src, dst, r, e);
 	*e->attributes = set;
 
+	// the edge changes the degree of its endpoints
+	Graph_TouchRelation(gc->g, r);
+	Graph_TouchNode(gc->g, src);
+	Graph_TouchNode(gc->g, dst);
+
 	Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
 	// all schemas have been created in the edge blueprint loop or earlier
 	ASSERT(s != NULL);
 	Schema_AddEdgeToIndex(s, e);
 
+	// schedule edge expiry
+	GraphContext_TrackExpiry(gc, (GraphEntity *)e, GETYPE_EDGE);
+
 	// add edge creation operation to undo log
 	if(log == true) {
 		UndoLog undo_log = QueryCtx_GetUndoLog();
@@ -184,6 +196,8 @@ void DeleteNodes
 		if(has_indices) {
 			_DeleteNodeFromIndices(gc, n);
 		}
+
+		Graph_TouchNode(gc->g, ENTITY_GET_ID(n));
 	}
 
 	Graph_DeleteNodes(gc->g, nodes, n);
@@ -219,6 +233,14 @@ void DeleteEdges
 		}
 	}
 
+	// deleted edges change the degree of their endpoints
+	for(uint64_t i = 0; i < n; i++) {
+		Edge *e = edges + i;
+		Graph_TouchRelation(gc->g, Edge_GetRelationID(e));
+		Graph_TouchNode(gc->g, Edge_GetSrcNodeID(e));
+		Graph_TouchNode(gc->g, Edge_GetDestNodeID(e));
+	}
+
 	Graph_DeleteEdges(gc->g, edges, n);
 }
 
@@ -246,9 +268,13 @@ void UpdateEntityProperties
 
 	if(entity_type == GETYPE_NODE) {
 		_AddNodeToIndices(gc, (Node *)ge);
+		Graph_TouchNode(gc->g, ENTITY_GET_ID(ge));
 	} else {
 		_AddEdgeToIndices(gc, (Edge *)ge);
+		Graph_TouchRelation(gc->g, Edge_GetRelationID((Edge *)ge));
 	}
+
+	GraphContext_TrackExpiry(gc, ge, entity_type);
 }
 
 void UpdateNodeProperty
@@ -293,6 +319,9 @@ void UpdateNodeProperty
 			if(idx) Schema_AddNodeToIndex(s, &n);
 		}
 	}
+
+	Graph_TouchNode(gc->g, id);
+	GraphContext_TrackExpiry(gc, (GraphEntity *)&n, GETYPE_NODE);
 }
 
 void UpdateEdgeProperty
@@ -331,8 +360,9 @@ void UpdateEdgeProperty
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(e.attributes);
 
-		// remove edge from index
-		Schema_RemoveEdgeFromIndex(s, &e);
+		// reindex edge, removing it from RediSearch indices
+		// while ordered adjacencies keep track of the attribute-less edge
+		Schema_AddEdgeToIndex(s, &e);
 		return;
 	}
 
@@ -353,6 +383,9 @@ void UpdateEdgeProperty
 		Index idx = Schema_GetIndex(s, &attr_id, 1, INDEX_FLD_ANY, true);
 		if(idx) Schema_AddEdgeToIndex(s, &e);
 	}
+
+	Graph_TouchRelation(gc->g, r_id);
+	GraphContext_TrackExpiry(gc, ge, GETYPE_EDGE);
 }
 
 void UpdateNodeLabels
@@ -384,6 +417,9 @@ void UpdateNodeLabels
 	EffectsBuffer *eb = NULL; 
 	UndoLog undo_log  = NULL;
 
+	// both the labels removed from and added to the node are modified
+	Graph_TouchNode(gc->g, ENTITY_GET_ID(node));
+
 	if(log == true) {
 		eb = QueryCtx_GetEffectsBuffer();
 		undo_log = QueryCtx_GetUndoLog();
@@ -471,6 +507,8 @@ void UpdateNodeLabels
 			}
 		}
 	}
+
+	Graph_TouchNode(gc->g, ENTITY_GET_ID(node));
 }
 
 Schema *AddSchema
@@ -503,6 +541,14 @@ Attribute_ID FindOrAddAttribute
 	ASSERT(gc != NULL);
 	ASSERT(attribute != NULL);
 
+	// an optimistic write can't extend the schema while reading
+	// hand the query over to the writer thread
+	if(log == true && QueryCtx_OptimisticRead()) {
+		Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
+		if(attr_id == ATTRIBUTE_ID_NONE) QueryCtx_RaiseWriteConflict();
+		return attr_id;
+	}
+
 	bool created;
 	Attribute_ID attr_id = GraphContext_FindOrAddAttribute(gc, attribute,
 			&created);
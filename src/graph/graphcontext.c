@@ -98,9 +98,8 @@ GraphContext *GraphContext_New
 	gc->slowlog          = SlowLog_New();
 	gc->queries_log      = QueriesLog_New();
 	gc->ref_count        = 0;  // no refences
-	gc->attributes       = raxNew();
+	gc->attributes       = AttributeMap_New();
 	gc->index_count      = 0;  // no indicies
-	gc->string_mapping   = array_new(char *, 64);
 	gc->encoding_context = GraphEncodeContext_New();
 	gc->decoding_context = GraphDecodeContext_New();
 
@@ -123,8 +122,8 @@ GraphContext *GraphContext_New
 	gc->node_schemas = array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
 	gc->relation_schemas = array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
 
-	// initialize the read-write lock to protect access to the attributes rax
-	int rc1 = pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
+	// initialize the lock serializing attribute additions
+	int rc1 = pthread_mutex_init(&gc->_attribute_mutex, NULL);
 	assert(rc1 == 0);
 
 	// build the execution plans cache
@@ -133,6 +132,15 @@ GraphContext *GraphContext_New
 	gc->cache = Cache_New(cache_size, (CacheEntryFreeFunc)ExecutionCtx_Free,
 						  (CacheEntryCopyFunc)ExecutionCtx_Clone);
 
+	// track entity expiry if an expiry attribute is configured
+	const char *expiry_attr;
+	Config_Option_get(Config_ENTITY_EXPIRY_ATTRIBUTE, &expiry_attr);
+	gc->expiry = (strlen(expiry_attr) > 0) ? EntityExpiry_New() : NULL;
+
+	// graph wasn't swept yet, see CronTask_spillAttributes
+	gc->spilled_version = UINT64_MAX;
+	gc->spilled_drops   = 0;
+
 	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_FLUSH_RESIZE);
 
 	return gc;
@@ -456,10 +464,7 @@ const char *GraphContext_GetEdgeRelationType(const GraphContext *gc, Edge *e) {
 }
 
 uint GraphContext_AttributeCount(GraphContext *gc) {
-	pthread_rwlock_rdlock(&gc->_attribute_rwlock);
-	uint size = raxSize(gc->attributes);
-	pthread_rwlock_unlock(&gc->_attribute_rwlock);
-	return size;
+	return AttributeMap_Count(gc->attributes);
 }
 
 Attribute_ID GraphContext_FindOrAddAttribute
@@ -471,47 +476,36 @@ Attribute_ID GraphContext_FindOrAddAttribute
 	ASSERT(gc);
 
 	bool created_flag = false;
-	unsigned char *attr = (unsigned char*)attribute;
-	uint l = strlen(attribute);
-
-	// acquire a read lock for looking up the attribute
-	pthread_rwlock_rdlock(&gc->_attribute_rwlock);
 
 	// see if attribute already exists
-	void *attribute_id = raxFind(gc->attributes, attr, l);
+	Attribute_ID attribute_id = AttributeMap_GetID(gc->attributes, attribute);
 
-	if(attribute_id == raxNotFound) {
+	if(attribute_id == ATTRIBUTE_ID_NONE) {
 		// we are writing to the shared GraphContext
-		// release the held lock and re-acquire as a writer
-		pthread_rwlock_unlock(&gc->_attribute_rwlock);
-		pthread_rwlock_wrlock(&gc->_attribute_rwlock);
+		pthread_mutex_lock(&gc->_attribute_mutex);
 
 		// lookup the attribute again now that we are in a critical region
-		attribute_id = raxFind(gc->attributes, attr, l);
+		attribute_id = AttributeMap_GetID(gc->attributes, attribute);
 
 		// if set by another thread, use the retrieved value
-		if(attribute_id == raxNotFound) {
+		if(attribute_id == ATTRIBUTE_ID_NONE) {
 			// otherwise, it will be assigned an ID
 			// equal to the current mapping size
-			attribute_id = (void *)raxSize(gc->attributes);
-			// insert the new attribute key and ID
-			raxInsert(gc->attributes, attr, l, attribute_id, NULL);
-			array_append(gc->string_mapping, rm_strdup(attribute));
+			attribute_id = AttributeMap_Add(gc->attributes, attribute);
 			created_flag = true;
 
 			// new attribute been added, update graph version
 			_GraphContext_UpdateVersion(gc, attribute);
 		}
-	}
 
-	// release the lock
-	pthread_rwlock_unlock(&gc->_attribute_rwlock);
+		pthread_mutex_unlock(&gc->_attribute_mutex);
+	}
 
 	if(created) {
 		*created = created_flag;
 	}
 
-	return (uintptr_t)attribute_id;
+	return attribute_id;
 }
 
 const char *GraphContext_GetAttributeString
@@ -520,12 +514,8 @@ const char *GraphContext_GetAttributeString
 	Attribute_ID id
 ) {
 	ASSERT(gc != NULL);
-	ASSERT(id >= 0 && id < array_len(gc->string_mapping));
 
-	pthread_rwlock_rdlock(&gc->_attribute_rwlock);
-	const char *name = gc->string_mapping[id];
-	pthread_rwlock_unlock(&gc->_attribute_rwlock);
-	return name;
+	return AttributeMap_GetName(gc->attributes, id);
 }
 
 Attribute_ID GraphContext_GetAttributeID
@@ -533,16 +523,9 @@ Attribute_ID GraphContext_GetAttributeID
 	GraphContext *gc,
 	const char *attribute
 ) {
-	// Acquire a read lock for looking up the attribute.
-	pthread_rwlock_rdlock(&gc->_attribute_rwlock);
-	// Look up the attribute ID.
-	void *id = raxFind(gc->attributes, (unsigned char *)attribute, strlen(attribute));
-	// Release the lock.
-	pthread_rwlock_unlock(&gc->_attribute_rwlock);
-
-	if(id == raxNotFound) return ATTRIBUTE_ID_NONE;
+	ASSERT(gc != NULL);
 
-	return (uintptr_t)id;
+	return AttributeMap_GetID(gc->attributes, attribute);
 }
 
 void GraphContext_RemoveAttribute
@@ -551,14 +534,10 @@ void GraphContext_RemoveAttribute
 	Attribute_ID id
 ) {
 	ASSERT(gc);
-	ASSERT(id == array_len(gc->string_mapping) - 1);
-	pthread_rwlock_wrlock(&gc->_attribute_rwlock);
-	const char *attribute = gc->string_mapping[id];
-	int ret = raxRemove(gc->attributes,  (unsigned char *)attribute, strlen(attribute), NULL);
-	ASSERT(ret == 1);
-	rm_free(gc->string_mapping[id]);
-	gc->string_mapping = array_del(gc->string_mapping, id);
-	pthread_rwlock_unlock(&gc->_attribute_rwlock);
+	ASSERT(id == AttributeMap_Count(gc->attributes) - 1);
+	pthread_mutex_lock(&gc->_attribute_mutex);
+	AttributeMap_RemoveLast(gc->attributes);
+	pthread_mutex_unlock(&gc->_attribute_mutex);
 }
 
 //------------------------------------------------------------------------------
@@ -741,6 +720,52 @@ Cache *GraphContext_GetCache(const GraphContext *gc) {
 	return gc->cache;
 }
 
+//------------------------------------------------------------------------------
+// Entity expiry API
+//------------------------------------------------------------------------------
+
+bool GraphContext_GetEntityExpiry
+(
+	GraphContext *gc,
+	const GraphEntity *ge,
+	int64_t *expires
+) {
+	ASSERT(gc      != NULL);
+	ASSERT(ge      != NULL);
+	ASSERT(expires != NULL);
+
+	if(gc->expiry == NULL) return false;
+
+	const char *expiry_attr;
+	Config_Option_get(Config_ENTITY_EXPIRY_ATTRIBUTE, &expiry_attr);
+
+	// no entity holds the expiry attribute
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, expiry_attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return false;
+
+	// expiration time must be an integer
+	SIValue *v = GraphEntity_GetProperty(ge, attr_id);
+	if(v == ATTRIBUTE_NOTFOUND || SI_TYPE(*v) != T_INT64) return false;
+
+	*expires = v->longval;
+	return true;
+}
+
+void GraphContext_TrackExpiry
+(
+	GraphContext *gc,
+	const GraphEntity *ge,
+	GraphEntityType t
+) {
+	ASSERT(gc != NULL);
+	ASSERT(ge != NULL);
+
+	int64_t expires;
+	if(GraphContext_GetEntityExpiry(gc, ge, &expires)) {
+		EntityExpiry_Add(gc->expiry, t, ENTITY_GET_ID(ge), expires);
+	}
+}
+
 //------------------------------------------------------------------------------
 // Free routine
 //------------------------------------------------------------------------------
@@ -842,17 +867,9 @@ static void _GraphContext_Free(void *arg) {
 	// free attribute mappings
 	//--------------------------------------------------------------------------
 
-	if(gc->attributes) raxFree(gc->attributes);
-
-	if(gc->string_mapping) {
-		len = array_len(gc->string_mapping);
-		for(uint32_t i = 0; i < len; i ++) {
-			rm_free(gc->string_mapping[i]);
-		}
-		array_free(gc->string_mapping);
-	}
+	if(gc->attributes) AttributeMap_Free(gc->attributes);
 
-	int res = pthread_rwlock_destroy(&gc->_attribute_rwlock);
+	int res = pthread_mutex_destroy(&gc->_attribute_mutex);
 	ASSERT(res == 0);
 
 	if(gc->slowlog) SlowLog_Free(gc->slowlog);
@@ -863,6 +880,8 @@ static void _GraphContext_Free(void *arg) {
 
 	if(gc->cache) Cache_Free(gc->cache);
 
+	if(gc->expiry != NULL) EntityExpiry_Free(gc->expiry);
+
 	GraphEncodeContext_Free(gc->encoding_context);
 	GraphDecodeContext_Free(gc->decoding_context);
 	rm_free(gc->graph_name);
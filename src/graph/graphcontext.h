@@ -7,6 +7,8 @@
 #pragma once
 
 #include "graph.h"
+#include "attribute_map.h"
+#include "entity_expiry.h"
 #include "../redismodule.h"
 #include "../index/index.h"
 #include "../schema/schema.h"
@@ -29,10 +31,9 @@
 typedef struct {
 	Graph *g;                              // container for all matrices and entity properties
 	int ref_count;                         // number of active references
-	rax *attributes;                       // from strings to attribute IDs
-	pthread_rwlock_t _attribute_rwlock;    // read-write lock to protect access to the attribute maps
+	AttributeMap *attributes;              // attribute names to IDs and back
+	pthread_mutex_t _attribute_mutex;      // serializes attribute additions
 	char *graph_name;                      // string associated with graph
-	char **string_mapping;                 // from attribute IDs to strings
 	Schema **node_schemas;                 // array of schemas for each node label
 	Schema **relation_schemas;             // array of schemas for each relation type
 	unsigned short index_count;            // number of indicies
@@ -43,6 +44,9 @@ typedef struct {
 	Cache *cache;                          // global cache of execution plans
 	XXH32_hash_t version;                  // graph version
 	RedisModuleString *telemetry_stream;   // telemetry stream name
+	EntityExpiry *expiry;                  // entities pending expiry, NULL if disabled
+	uint64_t spilled_version;              // write version once fully spilled, UINT64_MAX if unknown
+	uint64_t spilled_drops;                // spilled sets dropped as of spilled_version
 } GraphContext;
 
 //------------------------------------------------------------------------------
@@ -302,6 +306,28 @@ void GraphContext_DeleteEdgeFromIndices
 	Edge *e
 );
 
+//------------------------------------------------------------------------------
+// Entity expiry API
+//------------------------------------------------------------------------------
+
+// retrieve entity's expiration time
+// returns false if the entity doesn't hold an expiration time
+bool GraphContext_GetEntityExpiry
+(
+	GraphContext *gc,       // graph context
+	const GraphEntity *ge,  // entity
+	int64_t *expires        // [output] expiration time, ms since epoch
+);
+
+// schedule entity's expiry if it holds an expiration time
+// called whenever an entity's attributes are set
+void GraphContext_TrackExpiry
+(
+	GraphContext *gc,       // graph context
+	const GraphEntity *ge,  // entity
+	GraphEntityType t       // entity type
+);
+
 // add GraphContext to global array
 void GraphContext_RegisterWithModule
 (
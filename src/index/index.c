@@ -12,6 +12,7 @@
 #include "../util/rmalloc.h"
 #include "../datatypes/point.h"
 #include "../datatypes/vector.h"
+#include "../configuration/config.h"
 
 #include <stdatomic.h>
 
@@ -64,6 +65,8 @@ struct _Index {
 	GraphEntityType entity_type;   // entity type (node/edge) indexed
 	RSIndex *rsIdx;                // RediSearch index
 	uint _Atomic pending_changes;  // number of pending changes
+	IndexColumn **columns;         // sparse copies of range indexed attributes
+	IndexAdjacency **adjacency;    // edges ordered by range indexed attributes
 };
 
 // merge field 'b' into 'a'
@@ -377,6 +380,8 @@ Index Index_New
 	idx->stopwords       = NULL;
 	idx->entity_type     = entity_type;
 	idx->pending_changes = ATOMIC_VAR_INIT(0);
+	idx->columns         = NULL;
+	idx->adjacency       = NULL;
 
 	return idx;
 }
@@ -398,8 +403,10 @@ Index Index_Clone
 
 	clone->rsIdx           = NULL;
 	clone->label           = rm_strdup(idx->label);
+	clone->columns         = NULL;
+	clone->adjacency       = NULL;
 	clone->pending_changes = ATOMIC_VAR_INIT(0);
-	
+
 	if(clone->stopwords != NULL) {
 		array_clone_with_cb(clone->stopwords, idx->stopwords, rm_strdup);
 	}
@@ -434,6 +441,77 @@ int Index_PendingChanges
 	return idx->pending_changes;
 }
 
+// free index columns
+static void _Index_FreeColumns
+(
+	Index idx
+) {
+	if(idx->columns == NULL) return;
+
+	uint n = array_len(idx->columns);
+	for(uint i = 0; i < n; i++) {
+		IndexColumn_Free(idx->columns[i]);
+	}
+	array_free(idx->columns);
+	idx->columns = NULL;
+}
+
+// free index adjacencies
+static void _Index_FreeAdjacency
+(
+	Index idx
+) {
+	if(idx->adjacency == NULL) return;
+
+	uint n = array_len(idx->adjacency);
+	for(uint i = 0; i < n; i++) {
+		IndexAdjacency_Free(idx->adjacency[i]);
+	}
+	array_free(idx->adjacency);
+	idx->adjacency = NULL;
+}
+
+// create an empty column for each range indexed node attribute
+// if enabled by the INDEX_COLUMNS configuration
+// and an empty adjacency for each range indexed edge attribute
+// if enabled by the ORDERED_ADJACENCY configuration
+static void _Index_ConstructColumns
+(
+	Index idx
+) {
+	_Index_FreeColumns(idx);
+	_Index_FreeAdjacency(idx);
+
+	uint n = array_len(idx->fields);
+
+	if(idx->entity_type == GETYPE_EDGE) {
+		bool ordered_adjacency = false;
+		Config_Option_get(Config_ORDERED_ADJACENCY, &ordered_adjacency);
+		if(!ordered_adjacency) return;
+
+		idx->adjacency = array_new(IndexAdjacency *, n);
+		for(uint i = 0; i < n; i++) {
+			IndexField *field = idx->fields + i;
+			if(field->type & INDEX_FLD_RANGE) {
+				array_append(idx->adjacency, IndexAdjacency_New(field->id));
+			}
+		}
+		return;
+	}
+
+	bool index_columns = false;
+	Config_Option_get(Config_INDEX_COLUMNS, &index_columns);
+	if(!index_columns) return;
+
+	idx->columns = array_new(IndexColumn *, n);
+	for(uint i = 0; i < n; i++) {
+		IndexField *field = idx->fields + i;
+		if(field->type & INDEX_FLD_RANGE) {
+			array_append(idx->columns, IndexColumn_New(field->id));
+		}
+	}
+}
+
 // disable index by increasing the number of pending changes
 // and re-creating the internal RediSearch index
 void Index_Disable
@@ -452,6 +530,108 @@ void Index_Disable
 
 	// construct index structure
 	Index_ConstructStructure(idx);
+
+	// columns and adjacencies are rebuilt as the index is populated
+	_Index_ConstructColumns(idx);
+}
+
+// update node's entries in index columns
+void Index_SetNodeColumns
+(
+	Index idx,     // index to update
+	const Node *n  // indexed node
+) {
+	if(idx->columns == NULL) return;
+
+	EntityID id = ENTITY_GET_ID(n);
+	uint count = array_len(idx->columns);
+	for(uint i = 0; i < count; i++) {
+		IndexColumn *col = idx->columns[i];
+		IndexColumn_Set(col, id,
+				GraphEntity_GetProperty((const GraphEntity *)n, col->attr_id));
+	}
+}
+
+// clear node's entries in index columns
+void Index_ClearNodeColumns
+(
+	Index idx,   // index to update
+	EntityID id  // removed node ID
+) {
+	if(idx->columns == NULL) return;
+
+	uint count = array_len(idx->columns);
+	for(uint i = 0; i < count; i++) {
+		IndexColumn_Clear(idx->columns[i], id);
+	}
+}
+
+// returns the column holding attribute 'attr_id'
+// NULL if attribute isn't range indexed
+const IndexColumn *Index_GetColumn
+(
+	const Index idx,      // index to query
+	Attribute_ID attr_id  // column attribute
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->columns == NULL) return NULL;
+
+	uint n = array_len(idx->columns);
+	for(uint i = 0; i < n; i++) {
+		if(idx->columns[i]->attr_id == attr_id) return idx->columns[i];
+	}
+
+	return NULL;
+}
+
+// update edge's entries in index adjacencies
+void Index_SetEdgeAdjacency
+(
+	Index idx,     // index to update
+	const Edge *e  // indexed edge
+) {
+	if(idx->adjacency == NULL) return;
+
+	uint count = array_len(idx->adjacency);
+	for(uint i = 0; i < count; i++) {
+		IndexAdjacency *adj = idx->adjacency[i];
+		IndexAdjacency_Set(adj, e,
+				GraphEntity_GetProperty((const GraphEntity *)e, adj->attr_id));
+	}
+}
+
+// remove edge from index adjacencies
+void Index_ClearEdgeAdjacency
+(
+	Index idx,     // index to update
+	const Edge *e  // removed edge
+) {
+	if(idx->adjacency == NULL) return;
+
+	uint count = array_len(idx->adjacency);
+	for(uint i = 0; i < count; i++) {
+		IndexAdjacency_Clear(idx->adjacency[i], e);
+	}
+}
+
+// returns the adjacency ordered by attribute 'attr_id'
+// NULL if attribute isn't range indexed
+const IndexAdjacency *Index_GetAdjacency
+(
+	const Index idx,      // index to query
+	Attribute_ID attr_id  // attribute edges are ordered by
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->adjacency == NULL) return NULL;
+
+	uint n = array_len(idx->adjacency);
+	for(uint i = 0; i < n; i++) {
+		if(idx->adjacency[i]->attr_id == attr_id) return idx->adjacency[i];
+	}
+
+	return NULL;
 }
 
 // try to enable index by dropping number of pending changes by 1
@@ -764,6 +944,9 @@ void Index_Free
 		array_free_cb(idx->stopwords, rm_free);
 	}
 
+	_Index_FreeColumns(idx);
+	_Index_FreeAdjacency(idx);
+
 	rm_free(idx->label);
 	rm_free(idx);
 }
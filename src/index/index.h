@@ -7,6 +7,8 @@
 #pragma once
 
 #include "index_field.h"
+#include "index_column.h"
+#include "index_adjacency.h"
 #include "redisearch_api.h"
 #include "../graph/graph.h"
 #include "../graph/entities/node.h"
@@ -105,6 +107,25 @@ bool Index_Enabled
 	const Index idx  // index to get state of
 );
 
+// returns the column holding attribute 'attr_id'
+// NULL if attribute isn't range indexed
+// columns are kept for node indices only, when enabled by the INDEX_COLUMNS
+// configuration, and are populated along with the index
+const IndexColumn *Index_GetColumn
+(
+	const Index idx,      // index to query
+	Attribute_ID attr_id  // column attribute
+);
+
+// returns the adjacency ordered by attribute 'attr_id'
+// NULL if attribute isn't range indexed
+// adjacencies are kept for edge indices only, populated along with the index
+const IndexAdjacency *Index_GetAdjacency
+(
+	const Index idx,      // index to query
+	Attribute_ID attr_id  // attribute edges are ordered by
+);
+
 // returns RediSearch index
 RSIndex *Index_RSIndex
 (
@@ -190,6 +211,16 @@ RSQNode *Index_BuildVectorQueryTree
 	int k			    // number of results to return
 );
 
+// construct a geo query tree
+// matching points within radius meters of origin
+RSQNode *Index_BuildGeoQueryTree
+(
+	const Index idx,    // index to query
+	const char *field,  // field to query
+	SIValue origin,     // center point
+	double radius       // radius in meters
+);
+
 // construct a unique constraint query tree
 RSQNode *Index_BuildUniqueConstraintQuery
 (
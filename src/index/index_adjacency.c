@@ -0,0 +1,286 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "index_adjacency.h"
+#include "../util/rmalloc.h"
+#include <math.h>
+#include <endian.h>
+
+// integers beyond this magnitude lose precision as doubles
+#define MAX_EXACT_INT (1LL << 53)
+
+// key of an edge lacking a numeric value
+// encoded values are never all ones, see _EncodeValue
+#define ADJ_OTHER UINT64_MAX
+
+// list entry key length, encoded value followed by edge ID
+#define ADJ_KEY_LEN (2 * sizeof(uint64_t))
+
+// fake hash function
+// hash of key is simply key
+static uint64_t _id_hash
+(
+	const void *key
+) {
+	return ((uint64_t)key);
+}
+
+// hashtable entry free callback
+static void _ListFree
+(
+	dict *d,
+	void *val
+) {
+	AdjacencyList *list = (AdjacencyList *)val;
+	raxFree(list->entries);
+	rm_free(list);
+}
+
+// edge ID to entry key
+static dictType _keys_dt = {_id_hash, NULL, NULL, NULL, NULL, NULL, NULL,
+	NULL, NULL, NULL};
+
+// node ID to adjacency list
+static dictType _lists_dt = {_id_hash, NULL, NULL, NULL, NULL, _ListFree,
+	NULL, NULL, NULL, NULL};
+
+// encodes a double such that encoded values order as the doubles they encode
+static uint64_t _EncodeValue
+(
+	double v  // value to encode, not NaN
+) {
+	// -0 and 0 compare equal
+	if(v == 0) v = 0;
+
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+
+	// negative values order in reverse
+	return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+// list entry key: big-endian encoded value and edge ID
+// such that the rax lexicographic order is the (value, edge ID) order
+static void _EntryKey
+(
+	unsigned char *buf,  // [output] ADJ_KEY_LEN bytes buffer
+	uint64_t key,        // encoded value
+	EdgeID id            // edge ID
+) {
+	uint64_t be_key = htobe64(key);
+	uint64_t be_id  = htobe64(id);
+
+	memcpy(buf, &be_key, sizeof(uint64_t));
+	memcpy(buf + sizeof(uint64_t), &be_id, sizeof(uint64_t));
+}
+
+IndexAdjacency *IndexAdjacency_New
+(
+	Attribute_ID attr_id
+) {
+	IndexAdjacency *adj = rm_calloc(1, sizeof(IndexAdjacency));
+
+	adj->in      = HashTableCreate(&_lists_dt);
+	adj->out     = HashTableCreate(&_lists_dt);
+	adj->keys    = HashTableCreate(&_keys_dt);
+	adj->attr_id = attr_id;
+
+	return adj;
+}
+
+// adds edge entry to node's list
+static void _AdjacencyList_Add
+(
+	dict *lists,     // lists by node ID
+	NodeID node_id,  // node to update
+	NodeID other,    // node on the other end of the edge
+	EdgeID id,       // edge ID
+	uint64_t key     // encoded value
+) {
+	AdjacencyList *list = HashTableFetchValue(lists, (void *)node_id);
+	if(list == NULL) {
+		list = rm_calloc(1, sizeof(AdjacencyList));
+		list->entries = raxNew();
+		HashTableAdd(lists, (void *)node_id, list);
+	}
+
+	if(key == ADJ_OTHER) {
+		list->others++;
+		return;
+	}
+
+	unsigned char buf[ADJ_KEY_LEN];
+	_EntryKey(buf, key, id);
+	raxInsert(list->entries, buf, ADJ_KEY_LEN, (void *)other, NULL);
+}
+
+// removes edge entry from node's list
+// lists left empty are dropped
+static void _AdjacencyList_Remove
+(
+	dict *lists,     // lists by node ID
+	NodeID node_id,  // node to update
+	EdgeID id,       // edge ID
+	uint64_t key     // encoded value
+) {
+	AdjacencyList *list = HashTableFetchValue(lists, (void *)node_id);
+	ASSERT(list != NULL);
+
+	if(key == ADJ_OTHER) {
+		ASSERT(list->others > 0);
+		list->others--;
+	} else {
+		unsigned char buf[ADJ_KEY_LEN];
+		_EntryKey(buf, key, id);
+		int removed = raxRemove(list->entries, buf, ADJ_KEY_LEN, NULL);
+		UNUSED(removed);
+		ASSERT(removed == 1);
+	}
+
+	if(list->others == 0 && raxSize(list->entries) == 0) {
+		HashTableDelete(lists, (void *)node_id);
+	}
+}
+
+void IndexAdjacency_Set
+(
+	IndexAdjacency *adj,
+	const Edge *e,
+	const SIValue *v
+) {
+	ASSERT(v   != NULL);
+	ASSERT(e   != NULL);
+	ASSERT(adj != NULL);
+
+	EdgeID id   = ENTITY_GET_ID(e);
+	NodeID src  = Edge_GetSrcNodeID(e);
+	NodeID dest = Edge_GetDestNodeID(e);
+
+	// only values which compare exactly as doubles are ordered
+	uint64_t key = ADJ_OTHER;
+	if(v != ATTRIBUTE_NOTFOUND) {
+		if(SI_TYPE(*v) == T_INT64 && llabs(v->longval) <= MAX_EXACT_INT) {
+			key = _EncodeValue(v->longval);
+		} else if(SI_TYPE(*v) == T_DOUBLE && !isnan(v->doubleval)) {
+			key = _EncodeValue(v->doubleval);
+		}
+	}
+
+	dictEntry *de = HashTableFind(adj->keys, (void *)id);
+	if(de != NULL) {
+		// entry is unchanged
+		uint64_t prev = (uint64_t)HashTableGetVal(de);
+		if(prev == key) return;
+
+		_AdjacencyList_Remove(adj->out, src, id, prev);
+		_AdjacencyList_Remove(adj->in, dest, id, prev);
+		HashTableSetVal(adj->keys, de, (void *)key);
+	} else {
+		HashTableAdd(adj->keys, (void *)id, (void *)key);
+	}
+
+	_AdjacencyList_Add(adj->out, src, dest, id, key);
+	_AdjacencyList_Add(adj->in, dest, src, id, key);
+}
+
+void IndexAdjacency_Clear
+(
+	IndexAdjacency *adj,
+	const Edge *e
+) {
+	ASSERT(e   != NULL);
+	ASSERT(adj != NULL);
+
+	EdgeID id = ENTITY_GET_ID(e);
+	dictEntry *de = HashTableFind(adj->keys, (void *)id);
+	if(de == NULL) return;
+
+	uint64_t key = (uint64_t)HashTableGetVal(de);
+	_AdjacencyList_Remove(adj->out, Edge_GetSrcNodeID(e), id, key);
+	_AdjacencyList_Remove(adj->in, Edge_GetDestNodeID(e), id, key);
+	HashTableDelete(adj->keys, (void *)id);
+}
+
+const AdjacencyList *IndexAdjacency_GetList
+(
+	const IndexAdjacency *adj,
+	NodeID id,
+	GRAPH_EDGE_DIR dir
+) {
+	ASSERT(adj != NULL);
+	ASSERT(dir != GRAPH_EDGE_DIR_BOTH);
+
+	dict *lists = (dir == GRAPH_EDGE_DIR_OUTGOING) ? adj->out : adj->in;
+	return HashTableFetchValue(lists, (void *)id);
+}
+
+void IndexAdjacency_Free
+(
+	IndexAdjacency *adj
+) {
+	ASSERT(adj != NULL);
+
+	HashTableRelease(adj->keys);
+	HashTableRelease(adj->out);
+	HashTableRelease(adj->in);
+
+	rm_free(adj);
+}
+
+void AdjacencyIterator_Attach
+(
+	AdjacencyIterator *iter,
+	const AdjacencyList *list,
+	bool desc
+) {
+	ASSERT(iter != NULL);
+
+	AdjacencyIterator_Detach(iter);
+	if(list == NULL) return;
+
+	raxStart(&iter->it, list->entries);
+	raxSeek(&iter->it, desc ? "$" : "^", NULL, 0);
+
+	iter->desc     = desc;
+	iter->attached = true;
+}
+
+bool AdjacencyIterator_Next
+(
+	AdjacencyIterator *iter,
+	EdgeID *edge_id,
+	NodeID *node_id
+) {
+	ASSERT(iter    != NULL);
+	ASSERT(edge_id != NULL);
+	ASSERT(node_id != NULL);
+
+	if(!iter->attached) return false;
+
+	int res = iter->desc ? raxPrev(&iter->it) : raxNext(&iter->it);
+	if(res == 0) return false;
+
+	ASSERT(iter->it.key_len == ADJ_KEY_LEN);
+	uint64_t be_id;
+	memcpy(&be_id, iter->it.key + sizeof(uint64_t), sizeof(uint64_t));
+
+	*edge_id = be64toh(be_id);
+	*node_id = (NodeID)iter->it.data;
+
+	return true;
+}
+
+void AdjacencyIterator_Detach
+(
+	AdjacencyIterator *iter
+) {
+	ASSERT(iter != NULL);
+
+	if(!iter->attached) return;
+
+	raxStop(&iter->it);
+	iter->attached = false;
+}
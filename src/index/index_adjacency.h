@@ -0,0 +1,99 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "rax.h"
+#include "../value.h"
+#include "../util/dict.h"
+#include "../graph/graph.h"
+#include "../graph/entities/edge.h"
+
+// edges incident to a single node
+typedef struct {
+	rax *entries;     // numeric edges keyed by (value, edge ID), maps to node
+	                  // on the other end of the edge
+	uint64_t others;  // number of edges lacking a numeric value
+} AdjacencyList;
+
+// per node adjacency of the indexed edges ordered by a single attribute
+// allowing traversals to visit a node's edges in attribute order
+// and stop once enough edges were visited
+//
+// only the relation's indexed edges and their endpoints are tracked
+typedef struct {
+	Attribute_ID attr_id;  // attribute edges are ordered by
+	dict *keys;            // entry key per tracked edge ID
+	dict *out;             // outgoing edges per source node ID
+	dict *in;              // incoming edges per destination node ID
+} IndexAdjacency;
+
+// iterates over the numeric edges of a node in attribute order
+typedef struct {
+	raxIterator it;  // list entries iterator
+	bool desc;       // visit entries in descending order
+	bool attached;   // iterator is attached to a list
+} AdjacencyIterator;
+
+// create a new adjacency ordered by attribute 'attr_id'
+IndexAdjacency *IndexAdjacency_New
+(
+	Attribute_ID attr_id  // attribute edges are ordered by
+);
+
+// sets the entry of edge 'e' to 'v'
+// ATTRIBUTE_NOTFOUND keeps track of the edge as lacking a value
+void IndexAdjacency_Set
+(
+	IndexAdjacency *adj,  // adjacency to update
+	const Edge *e,        // edge
+	const SIValue *v      // attribute value
+);
+
+// removes edge 'e' from the adjacency
+void IndexAdjacency_Clear
+(
+	IndexAdjacency *adj,  // adjacency to update
+	const Edge *e         // removed edge
+);
+
+// returns the edges of node 'id' in direction 'dir'
+// NULL if node has no tracked edges
+const AdjacencyList *IndexAdjacency_GetList
+(
+	const IndexAdjacency *adj,  // adjacency to query
+	NodeID id,                  // node ID
+	GRAPH_EDGE_DIR dir          // either incoming or outgoing
+);
+
+// free adjacency
+void IndexAdjacency_Free
+(
+	IndexAdjacency *adj  // adjacency to free
+);
+
+// attach iterator to the numeric edges of 'list'
+// a NULL list yields no edges
+void AdjacencyIterator_Attach
+(
+	AdjacencyIterator *iter,    // iterator to attach
+	const AdjacencyList *list,  // list to iterate over
+	bool desc                   // visit entries in descending order
+);
+
+// advance iterator to the next edge
+// returns false once the list is depleted
+bool AdjacencyIterator_Next
+(
+	AdjacencyIterator *iter,  // iterator
+	EdgeID *edge_id,          // [output] edge ID
+	NodeID *node_id           // [output] node on the other end of the edge
+);
+
+// detach iterator from its list
+void AdjacencyIterator_Detach
+(
+	AdjacencyIterator *iter  // iterator to detach
+);
@@ -0,0 +1,122 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "index_column.h"
+#include "../util/rmalloc.h"
+
+IndexColumn *IndexColumn_New
+(
+	Attribute_ID attr_id
+) {
+	IndexColumn *col = rm_calloc(1, sizeof(IndexColumn));
+
+	col->attr_id = attr_id;
+
+	return col;
+}
+
+// returns the block holding entry 'id', allocating it if missing
+static ColumnBlock *_IndexColumn_GetBlock
+(
+	IndexColumn *col,  // column to grow
+	EntityID id        // entity ID
+) {
+	uint64_t b = id / COLUMN_BLOCK_SIZE;
+
+	if(b >= col->block_count) {
+		uint64_t n = col->block_count * 2;
+		if(n <= b) n = b + 1;
+
+		col->blocks = rm_realloc(col->blocks, n * sizeof(ColumnBlock *));
+
+		// new ranges are empty
+		memset(col->blocks + col->block_count, 0,
+				(n - col->block_count) * sizeof(ColumnBlock *));
+		col->block_count = n;
+	}
+
+	if(col->blocks[b] == NULL) {
+		col->blocks[b] = rm_calloc(1, sizeof(ColumnBlock));
+	}
+
+	return col->blocks[b];
+}
+
+void IndexColumn_Set
+(
+	IndexColumn *col,
+	EntityID id,
+	const SIValue *v
+) {
+	ASSERT(v   != NULL);
+	ASSERT(col != NULL);
+
+	if(v == ATTRIBUTE_NOTFOUND) {
+		IndexColumn_Clear(col, id);
+		return;
+	}
+
+	ColumnBlock *block = _IndexColumn_GetBlock(col, id);
+	uint64_t i = id % COLUMN_BLOCK_SIZE;
+
+	block->count += (block->types[i] == COL_NONE);
+
+	switch(SI_TYPE(*v)) {
+		case T_INT64:
+			block->types[i]    = COL_INT;
+			block->values[i].i = v->longval;
+			break;
+		case T_DOUBLE:
+			block->types[i]    = COL_DOUBLE;
+			block->values[i].d = v->doubleval;
+			break;
+		case T_BOOL:
+			block->types[i]    = COL_BOOL;
+			block->values[i].i = v->longval;
+			break;
+		default:
+			block->types[i] = COL_OTHER;
+			break;
+	}
+}
+
+void IndexColumn_Clear
+(
+	IndexColumn *col,
+	EntityID id
+) {
+	ASSERT(col != NULL);
+
+	uint64_t b = id / COLUMN_BLOCK_SIZE;
+	if(b >= col->block_count || col->blocks[b] == NULL) return;
+
+	ColumnBlock *block = col->blocks[b];
+	uint64_t i = id % COLUMN_BLOCK_SIZE;
+	if(block->types[i] == COL_NONE) return;
+
+	block->types[i] = COL_NONE;
+
+	// release emptied blocks
+	if(--block->count == 0) {
+		rm_free(block);
+		col->blocks[b] = NULL;
+	}
+}
+
+void IndexColumn_Free
+(
+	IndexColumn *col
+) {
+	ASSERT(col != NULL);
+
+	for(uint64_t b = 0; b < col->block_count; b++) {
+		if(col->blocks[b] != NULL) rm_free(col->blocks[b]);
+	}
+
+	if(col->blocks != NULL) rm_free(col->blocks);
+
+	rm_free(col);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "../graph/entities/graph_entity.h"
+#include "../graph/entities/attribute_set.h"
+
+// type of a column entry
+typedef enum {
+	COL_NONE = 0,  // entity doesn't hold the attribute
+	COL_INT,       // integer value
+	COL_DOUBLE,    // floating point value
+	COL_BOOL,      // boolean value
+	COL_OTHER,     // value of any other type, must be read from the entity
+} ColumnEntryType;
+
+typedef union {
+	int64_t i;  // COL_INT and COL_BOOL value
+	double d;   // COL_DOUBLE value
+} ColumnValue;
+
+// number of entries held by a single column block
+#define COLUMN_BLOCK_SIZE 1024
+
+// entries of a contiguous range of entity IDs
+typedef struct {
+	uint8_t types[COLUMN_BLOCK_SIZE];       // entry type, ColumnEntryType
+	ColumnValue values[COLUMN_BLOCK_SIZE];  // entry value
+	uint32_t count;                         // number of non empty entries
+} ColumnBlock;
+
+// sparse copy of a single numeric attribute of the indexed entities
+// entries are addressed by entity ID, blocks are allocated only for ID
+// ranges holding indexed entities, allowing aggregations to read the
+// attribute without fetching each entity's attribute set
+typedef struct {
+	Attribute_ID attr_id;  // attribute held by the column
+	ColumnBlock **blocks;  // blocks by ID range, NULL if range is empty
+	uint64_t block_count;  // number of blocks
+} IndexColumn;
+
+// create a new column holding attribute 'attr_id'
+IndexColumn *IndexColumn_New
+(
+	Attribute_ID attr_id  // attribute held by the column
+);
+
+// sets the entry of entity 'id' to 'v'
+// ATTRIBUTE_NOTFOUND clears the entry
+void IndexColumn_Set
+(
+	IndexColumn *col,  // column to update
+	EntityID id,       // entity ID
+	const SIValue *v   // attribute value
+);
+
+// clears the entry of entity 'id'
+void IndexColumn_Clear
+(
+	IndexColumn *col,  // column to update
+	EntityID id        // entity ID
+);
+
+// returns the type of entity 'id' entry, and sets 'v' to its value
+static inline ColumnEntryType IndexColumn_Get
+(
+	const IndexColumn *col,  // column to query
+	EntityID id,             // entity ID
+	ColumnValue *v           // [output] entry value
+) {
+	uint64_t b = id / COLUMN_BLOCK_SIZE;
+	if(b >= col->block_count || col->blocks[b] == NULL) return COL_NONE;
+
+	const ColumnBlock *block = col->blocks[b];
+	uint64_t i = id % COLUMN_BLOCK_SIZE;
+	*v = block->values[i];
+	return block->types[i];
+}
+
+// free column
+void IndexColumn_Free
+(
+	IndexColumn *col  // column to free
+);
+
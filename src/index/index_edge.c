@@ -13,6 +13,8 @@
 
 extern RSDoc *Index_IndexGraphEntity(Index idx,const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
+extern void Index_SetEdgeAdjacency(Index idx, const Edge *e);
+extern void Index_ClearEdgeAdjacency(Index idx, const Edge *e);
 
 void Index_IndexEdge
 (
@@ -40,6 +42,9 @@ void Index_IndexEdge
 		// remove entity from index and delete document
 		Index_RemoveEdge(idx, e);
 		RediSearch_FreeDocument(doc);
+
+		// adjacencies track edges lacking the attribute as well
+		Index_SetEdgeAdjacency(idx, e);
 		return;
 	}
 
@@ -51,6 +56,8 @@ void Index_IndexEdge
 			dest_id, RSFLDTYPE_NUMERIC);
 	int res = RediSearch_SpecAddDocument(rsIdx, doc);
 	ASSERT(res == REDISMODULE_OK);
+
+	Index_SetEdgeAdjacency(idx, e);
 }
 
 void Index_RemoveEdge
@@ -69,5 +76,6 @@ void Index_RemoveEdge
 	EdgeIndexKey key = {.src_id = src_id, .dest_id = dest_id, .edge_id = edge_id};
 	size_t key_len = sizeof(EdgeIndexKey);
 	RediSearch_DeleteDocument(rsIdx, &key, key_len);
+	Index_ClearEdgeAdjacency(idx, e);
 }
 
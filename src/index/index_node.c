@@ -13,6 +13,8 @@
 
 extern RSDoc *Index_IndexGraphEntity(Index idx, const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
+extern void Index_SetNodeColumns(Index idx, const Node *n);
+extern void Index_ClearNodeColumns(Index idx, EntityID id);
 
 void Index_IndexNode
 (
@@ -37,12 +39,17 @@ void Index_IndexNode
 		// remove entity from index and delete document
 		Index_RemoveNode(idx, n);
 		RediSearch_FreeDocument(doc);
+
+		// columns hold non-indexable values as well
+		Index_SetNodeColumns(idx, n);
 		return;
 	}
 
 	// add document to RediSearch index
 	int res = RediSearch_SpecAddDocument(rsIdx, doc);
 	ASSERT(res == REDISMODULE_OK);
+
+	Index_SetNodeColumns(idx, n);
 }
 
 void Index_RemoveNode
@@ -57,5 +64,6 @@ void Index_RemoveNode
 	RSIndex  *rsIdx = Index_RSIndex(idx);
 
 	RediSearch_DeleteDocument(rsIdx, &id, sizeof(EntityID));
+	Index_ClearNodeColumns(idx, id);
 }
 
@@ -674,6 +674,29 @@ RSQNode *Index_BuildVectorQueryTree
 	return root;
 }
 
+// construct a geo query tree
+// matching points within radius meters of origin
+RSQNode *Index_BuildGeoQueryTree
+(
+	const Index idx,    // index to query
+	const char *field,  // field to query
+	SIValue origin,     // center point
+	double radius       // radius in meters
+) {
+	ASSERT(idx    != NULL);
+	ASSERT(field  != NULL);
+	ASSERT(radius >= 0);
+	ASSERT(SI_TYPE(origin) == T_POINT);
+
+	RSIndex *rsIdx = Index_RSIndex(idx);
+
+	char type_aware_field_name[512];
+	Index_RangeFieldName(type_aware_field_name, field);
+
+	return RediSearch_CreateGeoNode(rsIdx, type_aware_field_name,
+			Point_lat(origin), Point_lon(origin), radius, RS_GEO_DISTANCE_M);
+}
+
 // construct a unique constraint query tree
 RSQNode *Index_BuildUniqueConstraintQuery
 (
@@ -28,6 +28,7 @@
 #include "module_event_handlers.h"
 #include "serializers/graphmeta_type.h"
 #include "configuration/reconf_handler.h"
+#include "graph/entities/attribute_spill.h"
 #include "serializers/graphcontext_type.h"
 #include "arithmetic/arithmetic_expression.h"
 
@@ -128,6 +129,9 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	Config_Subscribe_Changes(reconf_handler);
 	if(Config_Init(ctx, argv, argc) != REDISMODULE_OK) return REDISMODULE_ERR;
 
+	// spill cold attribute-sets to disk, if configured
+	if(!AttributeSpill_Init(ctx)) return REDISMODULE_ERR;
+
 	RegisterEventHandlers(ctx);
 
 	// create thread local storage keys for query and error contexts
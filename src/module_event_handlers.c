@@ -15,6 +15,7 @@
 #include "util/redis_version.h"
 #include "graph/graphcontext.h"
 #include "configuration/config.h"
+#include "graph/entities/attribute_spill.h"
 #include "serializers/graphmeta_type.h"
 #include "serializers/graphcontext_type.h"
 
@@ -362,6 +363,20 @@ static void _ShutdownEventHandler
 	Globals_Free();
 }
 
+// fork child event handler
+static void _ForkChildEventHandler
+(
+	RedisModuleCtx *ctx,
+	RedisModuleEvent eid,
+	uint64_t subevent,
+	void *data
+) {
+	// the child no longer reads spilled records
+	if(subevent == REDISMODULE_SUBEVENT_FORK_CHILD_DIED) {
+		AttributeSpill_ForkDone();
+	}
+}
+
 static void _ModuleLoadedHandler
 (
 	RedisModuleCtx *ctx,
@@ -396,6 +411,11 @@ static void _RegisterServerEvents(RedisModuleCtx *ctx) {
 			_PersistenceEventHandler);
 	ASSERT(res == REDISMODULE_OK);
 
+	res = RedisModule_SubscribeToServerEvent(ctx,
+			RedisModuleEvent_ForkChild,
+			_ForkChildEventHandler);
+	ASSERT(res == REDISMODULE_OK);
+
 	// TODO: try to use RedisModuleEvent_ModuleChange to start cron
 	//res = RedisModule_SubscribeToServerEvent(ctx,
 	//		RedisModuleEvent_ModuleChange,
@@ -430,6 +450,10 @@ static void RG_ForkPrepare() {
 	//
 	// in the case of RediSearch GC fork, quickly return
 
+	// the child inherits the attribute spill file
+	// records it references mustn't be reused until it exits
+	AttributeSpill_ForkPrepare();
+
 	// BGSAVE is invoked from Redis main thread
 	if(!pthread_equal(pthread_self(), redis_main_thread_id)) return;
 
@@ -53,6 +53,7 @@ struct ProcedureCtx {
 	ProcInvoke Invoke;          //
 	ProcFree Free;              //
 	bool readOnly;              // Indicates if the procedure is able to mutate the graph.
+	uint64_t top_k;             // Number of highest scored rows required, 0 for all rows.
 };
 typedef struct ProcedureCtx ProcedureCtx;
 
@@ -8,6 +8,7 @@
 #include "RG.h"
 #include "../value.h"
 #include "../util/arr.h"
+#include "../util/heap.h"
 #include "../query_ctx.h"
 #include "../index/index.h"
 #include "../util/rmalloc.h"
@@ -26,10 +27,79 @@ typedef struct {
 	SIValue *output;
 	Index idx;
 	RSResultsIterator *iter;
+	ScoredMatch *top;        // highest scored matches, by descending score
+	uint top_idx;            // next match to yield from top
 	SIValue *yield_node;     // yield node
 	SIValue *yield_score;    // yield score
 } QueryNodeContext;
 
+// heap items are 1-based positions within the matches array
+// which might be reallocated as it grows
+#define MATCH_AT(matches, item) ((matches) + (uintptr_t)(item) - 1)
+
+// heap compare function, lowest score is at the top of the heap
+static int _match_cmp
+(
+	const void *a,
+	const void *b,
+	void *udata
+) {
+	ScoredMatch *matches = *(ScoredMatch **)udata;
+	double score_a = MATCH_AT(matches, a)->score;
+	double score_b = MATCH_AT(matches, b)->score;
+	return (score_a < score_b) - (score_a > score_b);
+}
+
+// consumes the entire index iterator retaining only the k highest
+// scored matches, avoiding producing a row per match
+// returns matches sorted by descending score
+ScoredMatch *Proc_FulltextTopK
+(
+	RSResultsIterator *iter,  // index iterator
+	RSIndex *idx,             // queried index
+	uint64_t k                // number of matches to retain
+) {
+	ASSERT(k    > 0);
+	ASSERT(idx  != NULL);
+	ASSERT(iter != NULL);
+
+	ScoredMatch *matches = array_new(ScoredMatch, 32);
+	heap_t *heap = Heap_new(_match_cmp, &matches);
+
+	NodeID *id;
+	size_t len = 0;
+	while((id = (NodeID *)RediSearch_ResultsIteratorNext(iter, idx, &len))
+			!= NULL) {
+		ScoredMatch match = {.id = *id,
+			.score = RediSearch_ResultsIteratorGetScore(iter)};
+
+		if(Heap_count(heap) < k) {
+			array_append(matches, match);
+			Heap_offer(&heap, (void *)(uintptr_t)array_len(matches));
+		} else {
+			// replace lowest scored match
+			void *lowest = Heap_peek(heap);
+			if(MATCH_AT(matches, lowest)->score >= match.score) continue;
+
+			Heap_poll(heap);
+			*MATCH_AT(matches, lowest) = match;
+			Heap_offer(&heap, lowest);
+		}
+	}
+
+	// order matches by descending score
+	uint n = Heap_count(heap);
+	ScoredMatch *top = array_newlen(ScoredMatch, n);
+	for(uint i = n; i > 0; i--) {
+		top[i - 1] = *MATCH_AT(matches, Heap_poll(heap));
+	}
+
+	Heap_free(heap);
+	array_free(matches);
+
+	return top;
+}
+
 static void _process_yield
 (
 	QueryNodeContext *ctx,
@@ -79,10 +149,12 @@ ProcedureResult Proc_FulltextQueryNodeInvoke
 	ctx->privateData = rm_malloc(sizeof(QueryNodeContext));
 	QueryNodeContext *pdata = ctx->privateData;
 
-	pdata->g      = gc->g;
-	pdata->n      = GE_NEW_NODE();
-	pdata->idx    = idx;
-	pdata->output = array_new(SIValue,  2);
+	pdata->g       = gc->g;
+	pdata->n       = GE_NEW_NODE();
+	pdata->idx     = idx;
+	pdata->top     = NULL;
+	pdata->top_idx = 0;
+	pdata->output  = array_new(SIValue,  2);
 
 	_process_yield(pdata, yield);
 
@@ -103,6 +175,16 @@ ProcedureResult Proc_FulltextQueryNodeInvoke
 
 	ASSERT(pdata->iter != NULL);
 
+	// only the highest scored matches are consumed
+	if(ctx->top_k > 0) {
+		pdata->top = Proc_FulltextTopK(pdata->iter, Index_RSIndex(idx),
+				ctx->top_k);
+
+		// release index read lock as soon as possible
+		RediSearch_ResultsIteratorFree(pdata->iter);
+		pdata->iter = NULL;
+	}
+
 	return PROCEDURE_OK;
 }
 
@@ -113,22 +195,37 @@ SIValue *Proc_FulltextQueryNodeStep
 	if(!ctx->privateData) return NULL; // no index was attached to this procedure
 
 	QueryNodeContext *pdata = (QueryNodeContext *)ctx->privateData;
-	if(!pdata || !pdata->iter) return NULL;
+	if(!pdata) return NULL;
 
-	// try to get a result out of the iterator
-	// NULL is returned if iterator id depleted
-	size_t len = 0;
-	NodeID *id = (NodeID *)RediSearch_ResultsIteratorNext(pdata->iter,
-			Index_RSIndex(pdata->idx), &len);
+	NodeID id;
+	double score;
+
+	if(pdata->top != NULL) {
+		// yield collected top matches
+		if(pdata->top_idx == array_len(pdata->top)) return NULL;
 
-	// depleted
-	if(!id) return NULL;
+		ScoredMatch *match = pdata->top + pdata->top_idx++;
+		id    = match->id;
+		score = match->score;
+	} else {
+		if(!pdata->iter) return NULL;
 
-	double score = RediSearch_ResultsIteratorGetScore(pdata->iter);
+		// try to get a result out of the iterator
+		// NULL is returned if iterator id depleted
+		size_t len = 0;
+		NodeID *node_id = (NodeID *)RediSearch_ResultsIteratorNext(pdata->iter,
+				Index_RSIndex(pdata->idx), &len);
+
+		// depleted
+		if(!node_id) return NULL;
+
+		id    = *node_id;
+		score = RediSearch_ResultsIteratorGetScore(pdata->iter);
+	}
 
 	// get node
 	Node *n = &pdata->n;
-	Graph_GetNode(pdata->g, *id, n);
+	Graph_GetNode(pdata->g, id, n);
 
 	if(pdata->yield_node)  *pdata->yield_node  = SI_Node(n);
 	if(pdata->yield_score) *pdata->yield_score = SI_DoubleVal(score);
@@ -145,6 +242,7 @@ ProcedureResult Proc_FulltextQueryNodeFree
 
 	QueryNodeContext *pdata = ctx->privateData;
 	array_free(pdata->output);
+	if(pdata->top) array_free(pdata->top);
 	if(pdata->iter) RediSearch_ResultsIteratorFree(pdata->iter);
 	rm_free(pdata);
 
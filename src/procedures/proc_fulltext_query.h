@@ -7,5 +7,21 @@
 #pragma once
 
 #include "proc_ctx.h"
+#include "../index/index.h"
+
+// scored index match
+typedef struct {
+	NodeID id;     // matching node ID
+	double score;  // match score
+} ScoredMatch;
+
+// consumes the entire index iterator retaining only the k highest
+// scored matches, returns matches sorted by descending score
+ScoredMatch *Proc_FulltextTopK
+(
+	RSResultsIterator *iter,  // index iterator
+	RSIndex *idx,             // queried index
+	uint64_t k                // number of matches to retain
+);
 
 ProcedureCtx *Proc_FulltextQueryNodeGen();
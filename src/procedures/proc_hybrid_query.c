@@ -0,0 +1,451 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../graph/graph.h"
+#include "../index/index.h"
+#include "proc_hybrid_query.h"
+#include "proc_fulltext_query.h"
+#include "../datatypes/map.h"
+#include "../datatypes/vector.h"
+#include "../graph/graphcontext.h"
+#include <string.h>
+#include <limits.h>
+
+// rank constant of reciprocal rank fusion
+// dampens the impact of top ranked matches
+#define RRF_K 60
+
+// ranking fusion method
+typedef enum {
+	FUSION_RRF,      // reciprocal rank fusion
+	FUSION_WEIGHTED  // weighted sum of normalized scores
+} FusionMethod;
+
+// hybrid query arguments
+typedef struct {
+	const char *label;      // node label
+	const char *query;      // full-text query
+	const char *attribute;  // vector attribute
+	SIValue vector;         // query vector
+	int64_t k;              // number of results to return
+	FusionMethod fusion;    // ranking fusion method
+	double alpha;           // full-text weight in weighted fusion
+} HybridQueryArgs;
+
+// hybrid query context
+typedef struct {
+	Node n;                 // retrieved node
+	Graph *g;               // graph
+	ScoredMatch *matches;   // fused matches, by descending score
+	uint idx;               // next match to yield
+	SIValue output[2];      // yield array
+	SIValue *yield_node;    // yield node
+	SIValue *yield_score;   // yield score
+} HybridQueryCtx;
+
+// process user's yield arguments
+static void _process_yield
+(
+	HybridQueryCtx *ctx,
+	const char **yield
+) {
+	ctx->yield_node  = NULL;
+	ctx->yield_score = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("score", yield[i]) == 0) {
+			ctx->yield_score = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+// extract hybrid query arguments from map
+static bool _extractArgs
+(
+	const SIValue map,     // map holding query arguments
+	HybridQueryArgs *args  // [output] query arguments
+) {
+	// expecting a map with the following structure:
+	//
+	// {
+	//     label: 'Document'
+	//     query: 'fast fox'
+	//     attribute: 'embedding'
+	//     vector: vector32f([1,2])
+	//     k: 10
+	//     fusion: 'RRF'/'WEIGHTED'  (optional)
+	//     alpha: 0.5                (optional)
+	// }
+
+	SIValue v;                  // current map argument
+	uint key_count = 5;         // number of expected keys
+	args->fusion   = FUSION_RRF;
+	args->alpha    = 0.5;
+
+	// extract "label"
+	if(!MAP_GET(map, "label", v) || SI_TYPE(v) != T_STRING) return false;
+	args->label = v.stringval;
+
+	// extract "query"
+	if(!MAP_GET(map, "query", v) || SI_TYPE(v) != T_STRING) return false;
+	args->query = v.stringval;
+
+	// extract "attribute"
+	if(!MAP_GET(map, "attribute", v) || SI_TYPE(v) != T_STRING) return false;
+	args->attribute = v.stringval;
+
+	// extract "vector"
+	if(!MAP_GET(map, "vector", v) || SI_TYPE(v) != T_VECTOR32F) return false;
+	args->vector = v;
+
+	// extract "k"
+	// the vector query accepts an int
+	if(!MAP_GET(map, "k", v) || SI_TYPE(v) != T_INT64 || v.longval <= 0 ||
+	   v.longval > INT_MAX) {
+		return false;
+	}
+	args->k = v.longval;
+
+	// extract optional "fusion"
+	if(MAP_GET(map, "fusion", v)) {
+		key_count++;
+		if(SI_TYPE(v) != T_STRING) return false;
+		if(strcasecmp(v.stringval, "rrf") == 0) {
+			args->fusion = FUSION_RRF;
+		} else if(strcasecmp(v.stringval, "weighted") == 0) {
+			args->fusion = FUSION_WEIGHTED;
+		} else {
+			return false;
+		}
+	}
+
+	// extract optional "alpha"
+	if(MAP_GET(map, "alpha", v)) {
+		key_count++;
+		if(!(SI_TYPE(v) & SI_NUMERIC)) return false;
+		args->alpha = SI_GET_NUMERIC(v);
+		if(args->alpha < 0 || args->alpha > 1) return false;
+	}
+
+	// unknown arguments
+	return Map_KeyCount(map) == key_count;
+}
+
+// compare matches by ascending score
+static int _score_asc_cmp
+(
+	const void *a,
+	const void *b
+) {
+	double score_a = ((const ScoredMatch *)a)->score;
+	double score_b = ((const ScoredMatch *)b)->score;
+	return (score_a > score_b) - (score_a < score_b);
+}
+
+// compare matches by descending score, ties are ordered by ID
+static int _score_desc_cmp
+(
+	const void *a,
+	const void *b
+) {
+	const ScoredMatch *match_a = (const ScoredMatch *)a;
+	const ScoredMatch *match_b = (const ScoredMatch *)b;
+	if(match_a->score != match_b->score) {
+		return (match_a->score < match_b->score) -
+			(match_a->score > match_b->score);
+	}
+	return (match_a->id > match_b->id) - (match_a->id < match_b->id);
+}
+
+// compare matches by ascending ID
+static int _id_cmp
+(
+	const void *a,
+	const void *b
+) {
+	NodeID id_a = ((const ScoredMatch *)a)->id;
+	NodeID id_b = ((const ScoredMatch *)b)->id;
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+// collect the k nearest neighbors of the query vector
+// returns matches sorted by ascending distance
+static ScoredMatch *_vector_matches
+(
+	Index idx,                   // vector index
+	const HybridQueryArgs *args  // query arguments
+) {
+	float  *vec   = SIVector_Elements(args->vector);
+	size_t nbytes = SIVector_ElementsByteSize(args->vector);
+
+	RSIndex *rsIdx = Index_RSIndex(idx);
+	RSQNode *root  = Index_BuildVectorQueryTree(idx, args->attribute, vec,
+			nbytes, args->k);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(root, rsIdx);
+	ASSERT(iter != NULL);
+
+	// k is user provided, grow as neighbors are reported
+	ScoredMatch *matches = array_new(ScoredMatch, 32);
+
+	NodeID *id;
+	size_t len = 0;
+	while((id = (NodeID *)RediSearch_ResultsIteratorNext(iter, rsIdx, &len))
+			!= NULL) {
+		ScoredMatch match = {.id = *id,
+			.score = RediSearch_ResultsIteratorGetScore(iter)};
+		array_append(matches, match);
+	}
+
+	RediSearch_ResultsIteratorFree(iter);
+
+	// neighbors aren't necessarily reported by distance
+	qsort(matches, array_len(matches), sizeof(ScoredMatch), _score_asc_cmp);
+
+	return matches;
+}
+
+// scale score into [0, 1] given the range of scores it belongs to
+static inline double _normalize
+(
+	double score,  // score to normalize
+	double min,    // lowest score
+	double max     // highest score
+) {
+	return (max == min) ? 1 : (score - min) / (max - min);
+}
+
+// fuse ranked full-text and vector matches into a single ranking
+// a node matched by both sides accumulates both contributions
+// returns at most n matches sorted by descending fused score
+static ScoredMatch *_fuse
+(
+	ScoredMatch *text,            // full-text matches, by descending score
+	ScoredMatch *vec,             // vector matches, by ascending distance
+	const HybridQueryArgs *args,  // query arguments
+	uint64_t n                    // number of matches to return
+) {
+	uint text_count = array_len(text);
+	uint vec_count  = array_len(vec);
+	ScoredMatch *fused = array_new(ScoredMatch, text_count + vec_count);
+
+	for(uint i = 0; i < text_count; i++) {
+		double score;
+		if(args->fusion == FUSION_RRF) {
+			score = 1.0 / (RRF_K + i + 1);
+		} else {
+			score = args->alpha * _normalize(text[i].score,
+					text[text_count - 1].score, text[0].score);
+		}
+		ScoredMatch match = {.id = text[i].id, .score = score};
+		array_append(fused, match);
+	}
+
+	for(uint i = 0; i < vec_count; i++) {
+		double score;
+		if(args->fusion == FUSION_RRF) {
+			score = 1.0 / (RRF_K + i + 1);
+		} else {
+			// shorter distances score higher
+			score = (1 - args->alpha) * _normalize(-vec[i].score,
+					-vec[vec_count - 1].score, -vec[0].score);
+		}
+		ScoredMatch match = {.id = vec[i].id, .score = score};
+		array_append(fused, match);
+	}
+
+	// merge contributions of nodes matched by both sides
+	uint count = array_len(fused);
+	qsort(fused, count, sizeof(ScoredMatch), _id_cmp);
+
+	uint merged = 0;
+	for(uint i = 0; i < count; i++) {
+		if(merged > 0 && fused[merged - 1].id == fused[i].id) {
+			fused[merged - 1].score += fused[i].score;
+		} else {
+			fused[merged++] = fused[i];
+		}
+	}
+
+	qsort(fused, merged, sizeof(ScoredMatch), _score_desc_cmp);
+	fused = array_trimm_len(fused, MIN(merged, n));
+
+	return fused;
+}
+
+// step function, yields fused matches
+static SIValue *Proc_HybridQueryStep
+(
+	ProcedureCtx *ctx
+) {
+	HybridQueryCtx *pdata = (HybridQueryCtx *)ctx->privateData;
+
+	ASSERT(pdata != NULL);
+
+	// depleted
+	if(pdata->idx == array_len(pdata->matches)) return NULL;
+
+	ScoredMatch *match = pdata->matches + pdata->idx++;
+
+	if(pdata->yield_node) {
+		Node *n = &pdata->n;
+		bool res = Graph_GetNode(pdata->g, match->id, n);
+		ASSERT(res == true);
+		*pdata->yield_node = SI_Node(n);
+	}
+
+	if(pdata->yield_score) {
+		*pdata->yield_score = SI_DoubleVal(match->score);
+	}
+
+	return pdata->output;
+}
+
+// procedure invocation
+// validate arguments, query both indexes and fuse their rankings
+ProcedureResult Proc_HybridQueryInvoke
+(
+	ProcedureCtx *ctx,    // procedure context
+	const SIValue *args,  // procedure arguments
+	const char **yield    // procedure output
+) {
+	ctx->privateData = NULL;
+
+	// expecting a single map argument
+	if(array_len((SIValue *)args) != 1 || SI_TYPE(args[0]) != T_MAP) {
+		ErrorCtx_SetError(EMSG_PROC_INVALID_ARGUMENTS, ctx->name);
+		return PROCEDURE_ERR;
+	}
+
+	HybridQueryArgs query_args;
+	if(!_extractArgs(args[0], &query_args)) {
+		ErrorCtx_SetError(EMSG_PROC_INVALID_ARGUMENTS, ctx->name);
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	//--------------------------------------------------------------------------
+	// make sure both full-text and vector indexes exist
+	//--------------------------------------------------------------------------
+
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc,
+			query_args.attribute);
+	if(attr_id == ATTRIBUTE_ID_NONE) {
+		ErrorCtx_SetError(EMSG_ACCESS_UNDEFINED_ATTRIBUTE);
+		return PROCEDURE_ERR;
+	}
+
+	Index vec_idx = GraphContext_GetIndex(gc, query_args.label, &attr_id, 1,
+			INDEX_FLD_VECTOR, SCHEMA_NODE);
+	Index text_idx = GraphContext_GetIndex(gc, query_args.label, NULL, 0,
+			INDEX_FLD_FULLTEXT, SCHEMA_NODE);
+	if(vec_idx == NULL || text_idx == NULL) {
+		ErrorCtx_SetError(EMSG_HYBRID_MISSING_INDEX, query_args.label,
+				query_args.label, query_args.attribute);
+		return PROCEDURE_ERR;
+	}
+
+	//--------------------------------------------------------------------------
+	// collect candidates from both sides
+	//--------------------------------------------------------------------------
+
+	// each side contributes at most k candidates
+	char *err = NULL;
+	RSResultsIterator *iter = Index_Query(text_idx, query_args.query, &err);
+	if(err) {
+		// RediSearch error message is allocated using `rm_strdup`
+		ErrorCtx_SetError(EMSG_REDISEARCH, err);
+		rm_free(err);
+		// raise the exception, we expect an exception handler to be set
+		// as procedure invocation is done at runtime
+		ErrorCtx_RaiseRuntimeException(NULL);
+	}
+	ASSERT(iter != NULL);
+
+	ScoredMatch *text = Proc_FulltextTopK(iter, Index_RSIndex(text_idx),
+			query_args.k);
+	RediSearch_ResultsIteratorFree(iter);
+
+	ScoredMatch *vec = _vector_matches(vec_idx, &query_args);
+
+	//--------------------------------------------------------------------------
+	// fuse rankings
+	//--------------------------------------------------------------------------
+
+	// only the highest scored rows might be consumed
+	uint64_t n = query_args.k;
+	if(ctx->top_k > 0) n = MIN(n, ctx->top_k);
+
+	HybridQueryCtx *pdata = rm_calloc(1, sizeof(HybridQueryCtx));
+	pdata->g       = gc->g;
+	pdata->n       = GE_NEW_NODE();
+	pdata->matches = _fuse(text, vec, &query_args, n);
+
+	array_free(text);
+	array_free(vec);
+
+	_process_yield(pdata, yield);
+	ctx->privateData = pdata;
+
+	return PROCEDURE_OK;
+}
+
+// free procedure private data
+ProcedureResult Proc_HybridQueryFree
+(
+	ProcedureCtx *ctx  // procedure context
+) {
+	// no private data, nothing to do
+	if(!ctx->privateData) return PROCEDURE_OK;
+
+	HybridQueryCtx *pdata = (HybridQueryCtx *)ctx->privateData;
+	array_free(pdata->matches);
+	rm_free(pdata);
+
+	return PROCEDURE_OK;
+}
+
+// hybrid full-text and vector query procedure
+//
+// usage:
+//
+// CALL db.idx.hybrid.queryNodes( {
+// label: 'Document',
+// query: 'fast fox',
+// attribute: 'embedding',
+// vector: vector32f([1,2]),
+// k: 10,
+// fusion: 'RRF'/'WEIGHTED',
+// alpha: 0.5 } ) YIELD node, score
+
+ProcedureCtx *Proc_HybridQueryGen() {
+	ProcedureOutput *output   = array_new(ProcedureOutput, 2);
+	ProcedureOutput out_node  = {.name = "node", .type = T_NODE};
+	ProcedureOutput out_score = {.name = "score", .type = T_DOUBLE};
+	array_append(output, out_node);
+	array_append(output, out_score);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.hybrid.queryNodes",
+								   1,
+								   output,
+								   Proc_HybridQueryStep,
+								   Proc_HybridQueryInvoke,
+								   Proc_HybridQueryFree,
+								   NULL,
+								   true);
+	return ctx;
+}
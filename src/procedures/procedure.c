@@ -46,6 +46,9 @@ void Proc_Register() {
 
 	// register vector search generator
 	_procRegister("db.idx.vector.query", Proc_VectorKNNGen);
+
+	// register hybrid full-text and vector search generator
+	_procRegister("db.idx.hybrid.queryNodes", Proc_HybridQueryGen);
 }
 
 ProcedureCtx *ProcCtxNew(const char *name,
@@ -67,6 +70,7 @@ ProcedureCtx *ProcCtxNew(const char *name,
 	ctx->Invoke      = fInvoke;
 	ctx->privateData = privateData;
 	ctx->readOnly    = readOnly;
+	ctx->top_k       = 0;
 
 	return ctx;
 }
@@ -153,6 +157,11 @@ bool Procedure_IsReadOnly(const ProcedureCtx *proc) {
 	return proc->readOnly;
 }
 
+void Proc_SetTopK(ProcedureCtx *proc, uint64_t k) {
+	ASSERT(proc != NULL);
+	proc->top_k = k;
+}
+
 void Proc_Free(ProcedureCtx *proc) {
 	if(proc == NULL) {
 		return;
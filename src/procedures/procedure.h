@@ -41,6 +41,10 @@ const char *Procedure_GetOutput(const ProcedureCtx *proc, uint output_idx);
 /* Returns true if given output can be yield by procedure */
 bool Procedure_ContainsOutput(const ProcedureCtx *proc, const char *output);
 
+/* Hints the procedure only its k highest scored rows are consumed,
+ * procedures yielding a score may avoid producing the rest. */
+void Proc_SetTopK(ProcedureCtx *proc, uint64_t k);
+
 // Free procedure context.
 void Proc_Free(ProcedureCtx *proc);
 
@@ -20,4 +20,5 @@
 #include "proc_fulltext_drop_index.h"
 #include "proc_fulltext_create_index.h"
 #include "proc_vector_query.h"
+#include "proc_hybrid_query.h"
 
@@ -7,6 +7,7 @@
 #include "query_ctx.h"
 #include "RG.h"
 #include "errors.h"
+#include "util/arr.h"
 #include "util/simple_timer.h"
 #include "arithmetic/arithmetic_expression.h"
 #include "serializers/graphcontext_type.h"
@@ -17,6 +18,68 @@ extern RedisModuleType *GraphContextRedisModuleType;
 
 pthread_key_t _tlsQueryCtxKey;  // thread local storage query context key
 
+// locks kept on behalf of a commit group
+// consecutive write queries against the same graph executed by the writer
+// thread share a single lock acquisition, see QueryCtx_DeferUnlock
+static __thread struct {
+	GraphContext *gc;           // locked graph
+	RedisModuleKey *key;        // graph key opened for write
+	RedisModuleCtx *redis_ctx;  // context used to acquire the GIL
+	bool bc;                    // GIL was acquired via a blocked client
+	simple_timer_t lock_timer;  // started once the group's GIL was acquired
+} _commit_group = {0};
+
+// serializes writers, see QueryCtx_LockWriters
+static pthread_mutex_t _writers_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread bool _writers_locked = false;
+
+// frees the read set of an optimistic write
+static void _QueryCtx_FreeReadSet
+(
+	QueryCtx *ctx
+) {
+	if(ctx->internal_exec_ctx.read_labels != NULL) {
+		array_free(ctx->internal_exec_ctx.read_labels);
+		ctx->internal_exec_ctx.read_labels = NULL;
+	}
+
+	if(ctx->internal_exec_ctx.read_relations != NULL) {
+		array_free(ctx->internal_exec_ctx.read_relations);
+		ctx->internal_exec_ctx.read_relations = NULL;
+	}
+}
+
+// returns true if a write committed since the read phase of an optimistic
+// write started modified entities the read phase depends on
+static bool _QueryCtx_OptimisticConflict
+(
+	const QueryCtx *ctx
+) {
+	const Graph *g   = ctx->gc->g;
+	uint64_t version = ctx->internal_exec_ctx.read_version;
+
+	// no write was committed in the meantime, the write lock acquired for
+	// this commit is the only one since the read phase started
+	if(Graph_WriteVersion(g) == version + 1) return false;
+
+	// read phase might depend on any entity
+	LabelID *labels = ctx->internal_exec_ctx.read_labels;
+	if(labels == NULL) return true;
+
+	uint n = array_len(labels);
+	for(uint i = 0; i < n; i++) {
+		if(Graph_LabelModifiedSince(g, labels[i], version)) return true;
+	}
+
+	RelationID *relations = ctx->internal_exec_ctx.read_relations;
+	n = array_len(relations);
+	for(uint i = 0; i < n; i++) {
+		if(Graph_RelationModifiedSince(g, relations[i], version)) return true;
+	}
+
+	return false;
+}
+
 // retrieve or instantiate new QueryCtx
 static inline QueryCtx *_QueryCtx_GetCreateCtx(void) {
 	QueryCtx *ctx = pthread_getspecific(_tlsQueryCtxKey);
@@ -270,6 +333,9 @@ void QueryCtx_Rollback(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx != NULL);
 
+	// optimistic write still reading, nothing was modified
+	if(ctx->internal_exec_ctx.optimistic) return;
+
 	Graph_ResetReservedNode(ctx->gc->g);
 
 	if(ctx->undo_log == NULL) return;
@@ -354,12 +420,33 @@ bool QueryCtx_LockForCommit(void) {
 	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
 	if(ctx->internal_exec_ctx.locked_for_commit) return true;
 
+	// adopt the locks kept by the previous query of the commit group
+	if(_commit_group.key != NULL) {
+		ASSERT(_commit_group.gc == ctx->gc);
+		ctx->internal_exec_ctx.key = _commit_group.key;
+		ctx->internal_exec_ctx.locked_for_commit = true;
+		simple_timer_copy(_commit_group.lock_timer,
+				ctx->internal_exec_ctx.lock_timer);
+		_commit_group.key = NULL;
+		return true;
+	}
+
+	// optimistic write, exchange the read lock for the write lock
+	// the GIL must not be requested while holding the read lock
+	bool optimistic = ctx->internal_exec_ctx.optimistic;
+	if(optimistic) {
+		Graph_ReleaseLock(ctx->gc->g);
+		ctx->internal_exec_ctx.optimistic = false;
+		QueryCtx_LockWriters();
+	}
+
 	// lock GIL
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 	GraphContext *gc = ctx->gc;
 	RedisModuleString *graphID = RedisModule_CreateString(redis_ctx, gc->graph_name,
 														  strlen(gc->graph_name));
 	_QueryCtx_ThreadSafeContextLock(ctx);
+	simple_tic(ctx->internal_exec_ctx.lock_timer);
 
 	// open key and verify
 	RedisModuleKey *key = RedisModule_OpenKey(redis_ctx, graphID, REDISMODULE_WRITE);
@@ -383,6 +470,17 @@ bool QueryCtx_LockForCommit(void) {
 	Graph_AcquireWriteLock(gc->g);
 	ctx->internal_exec_ctx.locked_for_commit = true;
 
+	// another write committed since the optimistic read phase started
+	// modified entities the read phase depends on
+	if(optimistic) {
+		bool conflict = _QueryCtx_OptimisticConflict(ctx);
+		_QueryCtx_FreeReadSet(ctx);
+		if(conflict) {
+			QueryCtx_RaiseWriteConflict();
+			return false;
+		}
+	}
+
 	return true;
 
 clean_up:
@@ -433,6 +531,212 @@ void QueryCtx_UnlockCommit() {
 	_QueryCtx_UnlockCommit(ctx);
 }
 
+// commits the modifications performed by the query so far
+void QueryCtx_CommitBatch(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	// nothing was modified since the last commit
+	if(!ctx->internal_exec_ctx.locked_for_commit) return;
+
+	ctx->internal_exec_ctx.committed_batch = true;
+
+	// replicate batch via effects, replicas must not re-run the query
+	// as a later batch might fail
+	EffectsBuffer *eb = ctx->effects_buffer;
+	if(eb != NULL && EffectsBuffer_Length(eb) > 0) {
+		size_t effects_len = 0;
+		u_char *effects = EffectsBuffer_Buffer(eb, &effects_len);
+		ASSERT(effects_len > 0 && effects != NULL);
+
+		RedisModule_Replicate(ctx->global_exec_ctx.redis_ctx, "GRAPH.EFFECT",
+				"cb!", ctx->gc->graph_name, effects, effects_len);
+		rm_free(effects);
+		EffectsBuffer_Reset(eb);
+	}
+
+	// committed changes are no longer subject to rollback
+	UndoLog_Free(&ctx->undo_log);
+
+	_QueryCtx_UnlockCommit(ctx);
+}
+
+// returns true if the query committed some of its modifications
+bool QueryCtx_CommittedBatch(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	return ctx->internal_exec_ctx.committed_batch;
+}
+
+// keeps the locks acquired by QueryCtx_LockForCommit once the current query
+// is done, the next query against the same graph adopts them
+bool QueryCtx_DeferUnlock(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	// locks are already held by the group
+	if(_commit_group.key != NULL) {
+		ASSERT(_commit_group.gc == ctx->gc);
+		ASSERT(!ctx->internal_exec_ctx.locked_for_commit);
+		return true;
+	}
+
+	// nothing to defer
+	if(!ctx->internal_exec_ctx.locked_for_commit) return false;
+
+	_commit_group.gc        = ctx->gc;
+	_commit_group.key       = ctx->internal_exec_ctx.key;
+	_commit_group.redis_ctx = ctx->global_exec_ctx.redis_ctx;
+	_commit_group.bc        = ctx->global_exec_ctx.bc != NULL;
+	simple_timer_copy(ctx->internal_exec_ctx.lock_timer,
+			_commit_group.lock_timer);
+
+	ctx->internal_exec_ctx.key = NULL;
+	ctx->internal_exec_ctx.locked_for_commit = false;
+
+	return true;
+}
+
+// returns true if locks are held on behalf of a commit group
+bool QueryCtx_CommitGroupLocked(void) {
+	return _commit_group.key != NULL;
+}
+
+// returns the number of milliseconds the commit locks were held for
+double QueryCtx_CommitLockHeldTime(void) {
+	if(_commit_group.key != NULL) {
+		return TIMER_GET_ELAPSED_MILLISECONDS(_commit_group.lock_timer);
+	}
+
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(ctx == NULL || !ctx->internal_exec_ctx.locked_for_commit) return 0;
+
+	return TIMER_GET_ELAPSED_MILLISECONDS(ctx->internal_exec_ctx.lock_timer);
+}
+
+// releases the locks held on behalf of a commit group, if any
+void QueryCtx_UnlockCommitGroup(void) {
+	if(_commit_group.key == NULL) return;
+
+	// release graph R/W lock
+	Graph_ReleaseLock(_commit_group.gc->g);
+
+	// close Key
+	RedisModule_CloseKey(_commit_group.key);
+
+	// unlock GIL
+	if(_commit_group.bc) {
+		RedisModule_ThreadSafeContextUnlock(_commit_group.redis_ctx);
+	}
+
+	_commit_group.key = NULL;
+	_commit_group.gc  = NULL;
+}
+
+// starts the read phase of an optimistic write
+void QueryCtx_BeginOptimisticWrite
+(
+	LabelID *labels,       // labels read, NULL if any, taken by the QueryCtx
+	RelationID *relations  // relations read, taken by the QueryCtx
+) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+	ASSERT(!ctx->internal_exec_ctx.locked_for_commit);
+	ASSERT(labels == NULL || relations != NULL);
+
+	Graph *g = ctx->gc->g;
+	Graph_AcquireReadLock(g);
+
+	ctx->internal_exec_ctx.optimistic     = true;
+	ctx->internal_exec_ctx.write_conflict = false;
+	ctx->internal_exec_ctx.read_version   = Graph_WriteVersion(g);
+	ctx->internal_exec_ctx.read_labels    = labels;
+	ctx->internal_exec_ctx.read_relations = relations;
+}
+
+// releases the read lock if the optimistic write never locked for commit
+void QueryCtx_EndOptimisticWrite(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	_QueryCtx_FreeReadSet(ctx);
+	if(!ctx->internal_exec_ctx.optimistic) return;
+
+	ctx->internal_exec_ctx.optimistic = false;
+	Graph_ReleaseLock(ctx->gc->g);
+}
+
+// returns true if an optimistic write is in its read phase
+bool QueryCtx_OptimisticRead(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	return (ctx != NULL && ctx->internal_exec_ctx.optimistic);
+}
+
+// fails the optimistic write, it will be re-executed by the writer thread
+void QueryCtx_RaiseWriteConflict(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	ctx->internal_exec_ctx.write_conflict = true;
+	ErrorCtx_SetError(EMSG_WRITE_CONFLICT, ctx->gc->graph_name);
+	ErrorCtx_RaiseRuntimeException(NULL);
+}
+
+// returns true if the optimistic write conflicted with another write
+bool QueryCtx_WriteConflict(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	return ctx->internal_exec_ctx.write_conflict;
+}
+
+// discards the modifications of a conflicting optimistic write
+void QueryCtx_AbortOptimisticWrite(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+	ASSERT(ctx->internal_exec_ctx.write_conflict);
+
+	if(ctx->internal_exec_ctx.optimistic) {
+		// conflict raised while reading, nothing was modified
+		QueryCtx_EndOptimisticWrite();
+	} else {
+		// rollback while holding the write lock
+		QueryCtx_Rollback();
+		QueryCtx_UnlockCommit();
+	}
+
+	if(ctx->effects_buffer != NULL) EffectsBuffer_Reset(ctx->effects_buffer);
+	QueryCtx_UnlockWriters();
+
+	ctx->internal_exec_ctx.write_conflict = false;
+}
+
+// serializes writers
+void QueryCtx_LockWriters(void) {
+	if(_writers_locked) return;
+
+	pthread_mutex_lock(&_writers_lock);
+	_writers_locked = true;
+}
+
+// tries to acquire the writers lock without blocking
+// returns true if the lock is held by the calling thread
+bool QueryCtx_TryLockWriters(void) {
+	if(_writers_locked) return true;
+
+	_writers_locked = (pthread_mutex_trylock(&_writers_lock) == 0);
+	return _writers_locked;
+}
+
+// releases the writers lock if held by the calling thread
+void QueryCtx_UnlockWriters(void) {
+	if(!_writers_locked) return;
+
+	_writers_locked = false;
+	pthread_mutex_unlock(&_writers_lock);
+}
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
@@ -464,6 +768,7 @@ void QueryCtx_Free(void) {
 
 	UndoLog_Free(&ctx->undo_log);
 	EffectsBuffer_Free(ctx->effects_buffer);
+	_QueryCtx_FreeReadSet(ctx);
 
 	if(ctx->query_data.params != NULL) {
 		raxFreeWithCallback(ctx->query_data.params, _ParameterFreeCallback);
@@ -55,9 +55,16 @@ typedef struct {
 } QueryCtx_QueryData;
 
 typedef struct {
-	RedisModuleKey *key;     // graph open key, for later extraction and closing
-	ResultSet *result_set;   // execution result set
-	bool locked_for_commit;  // indicates if QueryCtx_LockForCommit been called
+	RedisModuleKey *key;         // graph open key, for later extraction and closing
+	ResultSet *result_set;       // execution result set
+	bool locked_for_commit;      // indicates if QueryCtx_LockForCommit been called
+	bool committed_batch;        // indicates if QueryCtx_CommitBatch been called
+	bool optimistic;             // write query reading under the graph's read lock
+	bool write_conflict;         // optimistic write interleaved with another write
+	uint64_t read_version;       // graph write version observed by the read phase
+	LabelID *read_labels;        // labels the read phase depends on, NULL if any
+	RelationID *read_relations;  // relations the read phase depends on
+	simple_timer_t lock_timer;   // started once the GIL is acquired for commit
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -228,6 +235,84 @@ bool QueryCtx_LockForCommit(void);
 // 4. unlock GIL
 void QueryCtx_UnlockCommit(void);
 
+// commits the modifications performed by the query so far
+// used by CALL {} IN TRANSACTIONS to commit each batch on its own
+// Commit flow:
+// 1. replicate pending effects
+// 2. discard the undo-log, committed changes are never rolled back
+// 3. unlock as in QueryCtx_UnlockCommit
+void QueryCtx_CommitBatch(void);
+
+// returns true if the query committed some of its modifications
+// via QueryCtx_CommitBatch, in which case the query string must not be
+// replicated as a whole
+bool QueryCtx_CommittedBatch(void);
+
+// group commit
+// keeps the locks acquired by QueryCtx_LockForCommit held once the current
+// query is done, the next query executed by this thread against the same
+// graph adopts them instead of acquiring its own
+// returns false if no locks are held
+bool QueryCtx_DeferUnlock(void);
+
+// returns true if locks are held on behalf of a commit group
+bool QueryCtx_CommitGroupLocked(void);
+
+// returns the number of milliseconds the commit locks held by this thread
+// were held for, either the current query's or its commit group's
+// 0 if no locks are held
+double QueryCtx_CommitLockHeldTime(void);
+
+// releases the locks held on behalf of a commit group, if any
+// the group's replicated commands are propagated together once the GIL
+// is released
+void QueryCtx_UnlockCommitGroup(void);
+
+// optimistic write
+// the read phase of a write query runs on a reader thread under the graph's
+// read lock, QueryCtx_LockForCommit exchanges it for the write lock and
+// validates no write committed in the meantime modified a node of 'labels'
+// or an edge of 'relations', when 'labels' is NULL any committed write
+// conflicts
+// on conflict the query fails with EMSG_WRITE_CONFLICT and
+// QueryCtx_WriteConflict returns true, the query should then be discarded
+// via QueryCtx_AbortOptimisticWrite and re-executed by the writer thread
+void QueryCtx_BeginOptimisticWrite
+(
+	LabelID *labels,       // labels read, NULL if any, taken by the QueryCtx
+	RelationID *relations  // relations read, taken by the QueryCtx
+);
+
+// releases the read lock if the optimistic write never locked for commit
+void QueryCtx_EndOptimisticWrite(void);
+
+// returns true if an optimistic write is in its read phase
+bool QueryCtx_OptimisticRead(void);
+
+// fails the optimistic write with EMSG_WRITE_CONFLICT
+// used when the read phase can't proceed without modifying shared state
+void QueryCtx_RaiseWriteConflict(void);
+
+// returns true if the optimistic write conflicted with another write
+bool QueryCtx_WriteConflict(void);
+
+// discards the modifications of a conflicting optimistic write
+// and releases its locks
+void QueryCtx_AbortOptimisticWrite(void);
+
+// serializes writers
+// the writer thread reads the graph without locking it, optimistic writes
+// must not commit while it executes a query
+// no-op if the lock is already held by the calling thread
+void QueryCtx_LockWriters(void);
+
+// tries to acquire the writers lock without blocking
+// returns true if the lock is held by the calling thread
+bool QueryCtx_TryLockWriters(void);
+
+// releases the writers lock if held by the calling thread
+void QueryCtx_UnlockWriters(void);
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
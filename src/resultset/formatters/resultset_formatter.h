@@ -40,10 +40,14 @@ typedef void (*EmitHeaderFunc)(ResultSet *set);
 // Typedef for row formatters.
 typedef void (*EmitRowFunc)(ResultSet *set, SIValue **row);
 
+// Typedef for columnar formatters, emitting all rows at once.
+typedef void (*EmitRowsFunc)(ResultSet *set);
+
 typedef void (*EmitStatsFunc)(ResultSet *set);
 							   
 typedef struct {
 	EmitRowFunc    EmitRow;
+	EmitRowsFunc   EmitRows;  // overrides EmitRow when set
 	EmitStatsFunc  EmitStats;
 	EmitHeaderFunc EmitHeader;
 } ResultSetFormatter;
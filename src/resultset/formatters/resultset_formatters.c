@@ -21,6 +21,9 @@ ResultSetFormatter *ResultSetFormatter_GetFormatter(ResultSetFormatterType t) {
 	case FORMATTER_BOLT:
 		formatter = &ResultSetFormatterBolt;
 		break;
+	case FORMATTER_ARROW:
+		formatter = &ResultSetFormatterArrow;
+		break;
 	default:
 		RedisModule_Assert(false && "Unknown formatter");
 	}
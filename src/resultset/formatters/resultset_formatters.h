@@ -9,6 +9,7 @@
 #include "resultset_formatter.h"
 #include "resultset_replynop.h"
 #include "resultset_replybolt.h"
+#include "resultset_replyarrow.h"
 #include "resultset_replycompact.h"
 #include "resultset_replyverbose.h"
 
@@ -17,6 +18,7 @@ typedef enum {
 	FORMATTER_VERBOSE = 1,
 	FORMATTER_COMPACT = 2,
 	FORMATTER_BOLT    = 3,
+	FORMATTER_ARROW   = 4,
 } ResultSetFormatterType;
 
 /* Retrieves result-set formatter.
@@ -52,3 +54,10 @@ static ResultSetFormatter ResultSetFormatterBolt __attribute__((used)) = {
 	.EmitHeader = ResultSet_ReplyWithBoltHeader
 };
 
+/* Arrow reply formatter, emits rows as a single Arrow IPC stream. */
+static ResultSetFormatter ResultSetFormatterArrow __attribute__((used)) = {
+	.EmitRows = ResultSet_EmitArrowRows,
+	.EmitStats = ResultSet_EmitCompactStats,
+	.EmitHeader = ResultSet_ReplyWithArrowHeader
+};
+
@@ -0,0 +1,755 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rax.h"
+#include "../resultset.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "resultset_formatters.h"
+#include "../../configuration/config.h"
+
+// Apache Arrow IPC streaming format
+// https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format
+//
+// the stream is a sequence of encapsulated messages:
+// <continuation> <metadata length> <flatbuffer Message> <padding> <body>
+// a schema, a dictionary batch per string column and a record batch per
+// ARROW_BATCH_SIZE rows, followed by an end-of-stream marker
+//
+// message metadata is a flatbuffer, written front to back:
+// a table is written ahead of the objects it refers to
+// and their offsets are patched in once these are written
+//
+// NOTE: both flatbuffers and arrow buffers are little-endian
+// values are written in host byte order
+
+#define ARROW_CONTINUATION 0xFFFFFFFF  // message prefix
+#define ARROW_ALIGNMENT    8           // body buffers alignment
+#define ARROW_METADATA_V5  4           // metadata version
+
+// message header types
+#define ARROW_HEADER_SCHEMA     1
+#define ARROW_HEADER_DICTIONARY 2
+#define ARROW_HEADER_BATCH      3
+
+// field types
+#define ARROW_TYPE_NULL  1
+#define ARROW_TYPE_INT   2
+#define ARROW_TYPE_FLOAT 3
+#define ARROW_TYPE_UTF8  5
+#define ARROW_TYPE_BOOL  6
+
+// floating point precision
+#define ARROW_PRECISION_DOUBLE 2
+
+// column type, determined by the column's non-null values
+typedef enum {
+	ARROW_COL_NULL,    // no values
+	ARROW_COL_INT64,   // integers
+	ARROW_COL_DOUBLE,  // floating points, possibly mixed with integers
+	ARROW_COL_BOOL,    // booleans
+	ARROW_COL_STRING,  // dictionary-encoded strings, other values stringified
+} ArrowColumnType;
+
+// growable byte buffer
+typedef struct {
+	char *data;  // content
+	size_t len;  // number of bytes written
+	size_t cap;  // number of bytes allocated
+} ArrowBuffer;
+
+typedef struct {
+	ArrowColumnType type;  // column type
+	int32_t *indices;      // row dictionary index, -1 for null
+	int32_t *offsets;      // dictionary value offsets
+	ArrowBuffer values;    // dictionary values
+} ArrowColumn;
+
+// record batch under construction
+typedef struct {
+	ArrowBuffer body;  // buffers content
+	int64_t *nodes;    // (length, null count) pair per field
+	int64_t *buffers;  // (offset, length) pair per buffer
+} ArrowBatch;
+
+// flatbuffer table field
+typedef struct {
+	uint16_t id;     // field id
+	uint8_t size;    // field size in bytes
+	uint64_t value;  // scalar value, offsets are patched later
+} FBField;
+
+//------------------------------------------------------------------------------
+// byte buffer
+//------------------------------------------------------------------------------
+
+static void _Buffer_Reserve
+(
+	ArrowBuffer *b,  // buffer
+	size_t n         // number of bytes to reserve
+) {
+	if(b->len + n <= b->cap) return;
+
+	b->cap = (b->cap * 2 > b->len + n) ? b->cap * 2 : b->len + n;
+	b->data = rm_realloc(b->data, b->cap);
+}
+
+// appends 'n' zero bytes, returns their position
+static size_t _Buffer_Zeros
+(
+	ArrowBuffer *b,  // buffer
+	size_t n         // number of bytes
+) {
+	size_t pos = b->len;
+	if(n == 0) return pos;
+
+	_Buffer_Reserve(b, n);
+	memset(b->data + pos, 0, n);
+	b->len += n;
+
+	return pos;
+}
+
+// appends 'n' bytes, returns their position
+static size_t _Buffer_Append
+(
+	ArrowBuffer *b,   // buffer
+	const void *src,  // bytes to append
+	size_t n          // number of bytes
+) {
+	size_t pos = b->len;
+	if(n == 0) return pos;
+
+	_Buffer_Reserve(b, n);
+	memcpy(b->data + pos, src, n);
+	b->len += n;
+
+	return pos;
+}
+
+// pads buffer with zeros until its length % align equals 'rem'
+static void _Buffer_Align
+(
+	ArrowBuffer *b,  // buffer
+	size_t align,    // alignment
+	size_t rem       // remainder
+) {
+	size_t pad = (align + rem - (b->len % align)) % align;
+	_Buffer_Zeros(b, pad);
+}
+
+//------------------------------------------------------------------------------
+// flatbuffer
+//------------------------------------------------------------------------------
+
+// sets the offset at 'pos' to refer to 'target'
+static void _FB_Patch
+(
+	ArrowBuffer *fb,  // flatbuffer
+	size_t pos,       // offset position
+	size_t target     // referred object position
+) {
+	ASSERT(target > pos);
+
+	uint32_t offset = target - pos;
+	memcpy(fb->data + pos, &offset, sizeof(uint32_t));
+}
+
+// writes a table, preceded by its vtable
+// sets pos[i] to the position of fields[i]
+// returns the table position
+static size_t _FB_Table
+(
+	ArrowBuffer *fb,        // flatbuffer
+	const FBField *fields,  // table fields
+	uint n,                 // number of fields
+	size_t *pos             // [output] fields position, optional
+) {
+	uint16_t slots = 0;
+	for(uint i = 0; i < n; i++) {
+		if(fields[i].id >= slots) slots = fields[i].id + 1;
+	}
+
+	// vtable: vtable size, table size and a field offset per slot
+	uint16_t vtable[2 + slots];
+	memset(vtable, 0, sizeof(vtable));
+	vtable[0] = sizeof(vtable);
+
+	// fields follow the table's vtable offset, by decreasing size
+	// the table starts 4 bytes past an 8 bytes boundary
+	// such that each field is aligned to its size
+	uint16_t offset = sizeof(int32_t);
+	for(uint8_t size = 8; size > 0; size /= 2) {
+		for(uint i = 0; i < n; i++) {
+			if(fields[i].size != size) continue;
+			vtable[2 + fields[i].id] = offset;
+			offset += size;
+		}
+	}
+	vtable[1] = offset;
+
+	_Buffer_Align(fb, sizeof(uint16_t), 0);
+	size_t vtable_pos = _Buffer_Append(fb, vtable, sizeof(vtable));
+
+	_Buffer_Align(fb, 8, 4);
+	int32_t soffset = fb->len - vtable_pos;
+	size_t table_pos = _Buffer_Append(fb, &soffset, sizeof(int32_t));
+	_Buffer_Zeros(fb, offset - sizeof(int32_t));
+
+	for(uint i = 0; i < n; i++) {
+		size_t field_pos = table_pos + vtable[2 + fields[i].id];
+		memcpy(fb->data + field_pos, &fields[i].value, fields[i].size);
+		if(pos != NULL) pos[i] = field_pos;
+	}
+
+	return table_pos;
+}
+
+// writes a string, returns its position
+static size_t _FB_String
+(
+	ArrowBuffer *fb,  // flatbuffer
+	const char *str   // string
+) {
+	uint32_t len = strlen(str);
+
+	_Buffer_Align(fb, sizeof(uint32_t), 0);
+	size_t pos = _Buffer_Append(fb, &len, sizeof(uint32_t));
+	_Buffer_Append(fb, str, len);
+	_Buffer_Zeros(fb, 1);  // null terminator
+
+	return pos;
+}
+
+// writes a vector of 'n' offsets, returns its position
+// element i, at pos + 4 * (i + 1), is patched once its object is written
+static size_t _FB_OffsetVector
+(
+	ArrowBuffer *fb,  // flatbuffer
+	uint32_t n        // number of elements
+) {
+	_Buffer_Align(fb, sizeof(uint32_t), 0);
+	size_t pos = _Buffer_Append(fb, &n, sizeof(uint32_t));
+	_Buffer_Zeros(fb, n * sizeof(uint32_t));
+
+	return pos;
+}
+
+// writes a vector of 'n' structs, each a pair of int64, returns its position
+static size_t _FB_PairVector
+(
+	ArrowBuffer *fb,       // flatbuffer
+	const int64_t *pairs,  // struct fields
+	uint32_t n             // number of structs
+) {
+	_Buffer_Align(fb, 8, 4);
+	size_t pos = _Buffer_Append(fb, &n, sizeof(uint32_t));
+	_Buffer_Append(fb, pairs, n * 2 * sizeof(int64_t));
+
+	return pos;
+}
+
+// writes an Int type table
+static size_t _FB_Int
+(
+	ArrowBuffer *fb,  // flatbuffer
+	int32_t width     // bit width
+) {
+	FBField fields[2] = {
+		{0, 4, width},  // bitWidth
+		{1, 1, true}    // is_signed
+	};
+
+	return _FB_Table(fb, fields, 2, NULL);
+}
+
+// writes column's type table
+static size_t _FB_Type
+(
+	ArrowBuffer *fb,     // flatbuffer
+	ArrowColumnType type // column type
+) {
+	switch(type) {
+		case ARROW_COL_INT64:
+			return _FB_Int(fb, 64);
+		case ARROW_COL_DOUBLE: {
+			FBField precision = {0, 2, ARROW_PRECISION_DOUBLE};
+			return _FB_Table(fb, &precision, 1, NULL);
+		}
+		default:
+			// Null, Bool and Utf8 tables have no fields
+			return _FB_Table(fb, NULL, 0, NULL);
+	}
+}
+
+static uint8_t _TypeID
+(
+	ArrowColumnType type  // column type
+) {
+	switch(type) {
+		case ARROW_COL_NULL:   return ARROW_TYPE_NULL;
+		case ARROW_COL_INT64:  return ARROW_TYPE_INT;
+		case ARROW_COL_DOUBLE: return ARROW_TYPE_FLOAT;
+		case ARROW_COL_BOOL:   return ARROW_TYPE_BOOL;
+		case ARROW_COL_STRING: return ARROW_TYPE_UTF8;
+		default:
+			ASSERT(false && "unknown column type");
+			return ARROW_TYPE_NULL;
+	}
+}
+
+// writes a Field table describing column 'idx'
+static size_t _FB_Field
+(
+	ArrowBuffer *fb,         // flatbuffer
+	const char *name,        // column name
+	ArrowColumnType type,    // column type
+	int64_t idx              // column index, used as dictionary id
+) {
+	bool dictionary = (type == ARROW_COL_STRING);
+
+	FBField fields[6] = {
+		{0, 4, 0},               // name
+		{1, 1, true},            // nullable
+		{2, 1, _TypeID(type)},   // type type
+		{3, 4, 0},               // type
+		{5, 4, 0},               // children
+		{4, 4, 0}                // dictionary
+	};
+	size_t pos[6];
+
+	size_t table = _FB_Table(fb, fields, dictionary ? 6 : 5, pos);
+	_FB_Patch(fb, pos[0], _FB_String(fb, name));
+	_FB_Patch(fb, pos[3], _FB_Type(fb, type));
+	_FB_Patch(fb, pos[4], _FB_OffsetVector(fb, 0));
+
+	if(dictionary) {
+		// values are int32 indices into dictionary 'idx'
+		FBField encoding[2] = {
+			{0, 8, idx},  // id
+			{1, 4, 0}     // indexType
+		};
+		size_t encoding_pos[2];
+
+		_FB_Patch(fb, pos[5], _FB_Table(fb, encoding, 2, encoding_pos));
+		_FB_Patch(fb, encoding_pos[1], _FB_Int(fb, 32));
+	}
+
+	return table;
+}
+
+// writes a RecordBatch table
+static size_t _FB_RecordBatch
+(
+	ArrowBuffer *fb,          // flatbuffer
+	const ArrowBatch *batch,  // record batch
+	int64_t length            // number of rows
+) {
+	FBField fields[3] = {
+		{0, 8, length},  // length
+		{1, 4, 0},       // nodes
+		{2, 4, 0}        // buffers
+	};
+	size_t pos[3];
+
+	size_t table = _FB_Table(fb, fields, 3, pos);
+	_FB_Patch(fb, pos[1], _FB_PairVector(fb, batch->nodes,
+				array_len(batch->nodes) / 2));
+	_FB_Patch(fb, pos[2], _FB_PairVector(fb, batch->buffers,
+				array_len(batch->buffers) / 2));
+
+	return table;
+}
+
+//------------------------------------------------------------------------------
+// messages
+//------------------------------------------------------------------------------
+
+// starts a message's metadata, returns the position of its header offset
+static size_t _Message_Begin
+(
+	ArrowBuffer *fb,      // flatbuffer
+	uint8_t header_type,  // message header type
+	int64_t body_len      // message body length
+) {
+	fb->len = 0;
+
+	FBField fields[4] = {
+		{0, 2, ARROW_METADATA_V5},  // version
+		{1, 1, header_type},        // header type
+		{2, 4, 0},                  // header
+		{3, 8, body_len}            // bodyLength
+	};
+	size_t pos[4];
+
+	size_t root = _Buffer_Zeros(fb, sizeof(uint32_t));
+	_FB_Patch(fb, root, _FB_Table(fb, fields, 4, pos));
+
+	return pos[2];
+}
+
+// appends message to stream
+static void _Message_End
+(
+	ArrowBuffer *stream,     // arrow stream
+	ArrowBuffer *fb,         // message metadata
+	const ArrowBuffer *body  // message body, optional
+) {
+	// metadata is padded such that the body is aligned
+	_Buffer_Align(fb, ARROW_ALIGNMENT, 0);
+
+	uint32_t prefix[2] = {ARROW_CONTINUATION, fb->len};
+	_Buffer_Append(stream, prefix, sizeof(prefix));
+	_Buffer_Append(stream, fb->data, fb->len);
+
+	if(body != NULL) _Buffer_Append(stream, body->data, body->len);
+}
+
+// adds a zeroed buffer of 'len' bytes to batch's body
+// returns the buffer's position within the body
+static size_t _Batch_AddBuffer
+(
+	ArrowBatch *batch,  // record batch
+	size_t len          // buffer length
+) {
+	_Buffer_Align(&batch->body, ARROW_ALIGNMENT, 0);
+	size_t pos = _Buffer_Zeros(&batch->body, len);
+
+	array_append(batch->buffers, pos);
+	array_append(batch->buffers, len);
+
+	return pos;
+}
+
+// appends batch to stream as either a record batch or a dictionary batch
+// and resets batch
+static void _Batch_Flush
+(
+	ArrowBuffer *stream,  // arrow stream
+	ArrowBuffer *fb,      // message metadata
+	ArrowBatch *batch,    // record batch
+	int64_t length,       // number of rows
+	int64_t dictionary    // dictionary id, -1 for a record batch
+) {
+	_Buffer_Align(&batch->body, ARROW_ALIGNMENT, 0);
+
+	if(dictionary < 0) {
+		size_t header = _Message_Begin(fb, ARROW_HEADER_BATCH, batch->body.len);
+		_FB_Patch(fb, header, _FB_RecordBatch(fb, batch, length));
+	} else {
+		FBField fields[2] = {
+			{0, 8, dictionary},  // id
+			{1, 4, 0}            // data
+		};
+		size_t pos[2];
+
+		size_t header = _Message_Begin(fb, ARROW_HEADER_DICTIONARY,
+				batch->body.len);
+		_FB_Patch(fb, header, _FB_Table(fb, fields, 2, pos));
+		_FB_Patch(fb, pos[1], _FB_RecordBatch(fb, batch, length));
+	}
+
+	_Message_End(stream, fb, &batch->body);
+
+	batch->body.len = 0;
+	array_clear(batch->nodes);
+	array_clear(batch->buffers);
+}
+
+//------------------------------------------------------------------------------
+// columns
+//------------------------------------------------------------------------------
+
+static inline SIValue *_Cell
+(
+	const ResultSet *set,  // result-set
+	uint64_t row,          // row index
+	uint col               // column index
+) {
+	return DataBlock_GetItem(set->cells, row * set->column_count + col);
+}
+
+// determine column type from its non-null values
+static ArrowColumnType _Column_Type
+(
+	const ResultSet *set,  // result-set
+	uint col,              // column index
+	uint64_t nrows         // number of rows
+) {
+	SIType types = 0;
+	for(uint64_t i = 0; i < nrows; i++) {
+		SIValue *v = _Cell(set, i, col);
+		if(!SIValue_IsNull(*v)) types |= SI_TYPE(*v);
+	}
+
+	if(types == 0)                             return ARROW_COL_NULL;
+	if(types == T_INT64)                       return ARROW_COL_INT64;
+	if((types & ~(T_INT64 | T_DOUBLE)) == 0)   return ARROW_COL_DOUBLE;
+	if(types == T_BOOL)                        return ARROW_COL_BOOL;
+
+	return ARROW_COL_STRING;
+}
+
+// builds a dictionary of the column's distinct string representations
+static void _Column_BuildDictionary
+(
+	ArrowColumn *column,   // column
+	const ResultSet *set,  // result-set
+	uint col,              // column index
+	uint64_t nrows         // number of rows
+) {
+	rax *lookup = raxNew();  // value to dictionary index
+
+	column->indices = rm_malloc(sizeof(int32_t) * nrows);
+	column->offsets = array_new(int32_t, 1);
+	array_append(column->offsets, 0);
+
+	size_t buf_len = 64;
+	char *buf = rm_malloc(buf_len);
+
+	for(uint64_t i = 0; i < nrows; i++) {
+		SIValue *v = _Cell(set, i, col);
+		if(SIValue_IsNull(*v)) {
+			column->indices[i] = -1;
+			continue;
+		}
+
+		const char *str = buf;
+		size_t len = 0;
+		if(SI_TYPE(*v) == T_STRING) {
+			str = v->stringval;
+			len = strlen(str);
+		} else {
+			SIValue_ToString(*v, &buf, &buf_len, &len);
+			str = buf;
+		}
+
+		void *idx = raxFind(lookup, (unsigned char *)str, len);
+		if(idx == raxNotFound) {
+			idx = (void *)(intptr_t)(array_len(column->offsets) - 1);
+			raxInsert(lookup, (unsigned char *)str, len, idx, NULL);
+
+			_Buffer_Append(&column->values, str, len);
+			ASSERT(column->values.len <= INT32_MAX);
+			array_append(column->offsets, (int32_t)column->values.len);
+		}
+
+		column->indices[i] = (intptr_t)idx;
+	}
+
+	rm_free(buf);
+	raxFree(lookup);
+}
+
+// adds column's dictionary batch to stream
+static void _Column_WriteDictionary
+(
+	ArrowBuffer *stream,         // arrow stream
+	ArrowBuffer *fb,             // message metadata
+	ArrowBatch *batch,           // record batch
+	const ArrowColumn *column,   // column
+	uint col                     // column index
+) {
+	uint32_t count = array_len(column->offsets) - 1;
+
+	array_append(batch->nodes, count);  // length
+	array_append(batch->nodes, 0);      // null count
+
+	_Batch_AddBuffer(batch, 0);  // validity, no nulls
+	size_t offsets = _Batch_AddBuffer(batch, sizeof(int32_t) * (count + 1));
+	size_t values  = _Batch_AddBuffer(batch, column->values.len);
+
+	memcpy(batch->body.data + offsets, column->offsets,
+			sizeof(int32_t) * (count + 1));
+	if(column->values.len > 0) {
+		memcpy(batch->body.data + values, column->values.data,
+				column->values.len);
+	}
+
+	_Batch_Flush(stream, fb, batch, count, col);
+}
+
+// adds rows [start, start + n) of column to batch
+static void _Column_WriteBatch
+(
+	ArrowBatch *batch,          // record batch
+	const ResultSet *set,       // result-set
+	const ArrowColumn *column,  // column
+	uint col,                   // column index
+	uint64_t start,             // first row
+	uint64_t n                  // number of rows
+) {
+	int64_t nulls = 0;
+	for(uint64_t i = start; i < start + n; i++) {
+		if(SIValue_IsNull(*_Cell(set, i, col))) nulls++;
+	}
+
+	array_append(batch->nodes, n);      // length
+	array_append(batch->nodes, nulls);  // null count
+
+	// null arrays have no buffers
+	if(column->type == ARROW_COL_NULL) return;
+
+	// validity bitmap, omitted when there are no nulls
+	size_t bitmap_len = (n + 7) / 8;
+	size_t validity = _Batch_AddBuffer(batch, nulls > 0 ? bitmap_len : 0);
+
+	size_t data;
+	switch(column->type) {
+		case ARROW_COL_INT64:
+			data = _Batch_AddBuffer(batch, sizeof(int64_t) * n);
+			break;
+		case ARROW_COL_DOUBLE:
+			data = _Batch_AddBuffer(batch, sizeof(double) * n);
+			break;
+		case ARROW_COL_BOOL:
+			data = _Batch_AddBuffer(batch, bitmap_len);
+			break;
+		default:
+			data = _Batch_AddBuffer(batch, sizeof(int32_t) * n);
+			break;
+	}
+
+	// buffers are zeroed, nulls are left unset
+	uint8_t *bitmap = (uint8_t *)batch->body.data + validity;
+	char    *values = batch->body.data + data;
+
+	for(uint64_t i = 0; i < n; i++) {
+		SIValue *v = _Cell(set, start + i, col);
+		if(SIValue_IsNull(*v)) continue;
+
+		if(nulls > 0) bitmap[i / 8] |= 1 << (i % 8);
+
+		switch(column->type) {
+			case ARROW_COL_INT64:
+				((int64_t *)values)[i] = v->longval;
+				break;
+			case ARROW_COL_DOUBLE:
+				((double *)values)[i] = SI_GET_NUMERIC(*v);
+				break;
+			case ARROW_COL_BOOL:
+				if(v->longval) values[i / 8] |= 1 << (i % 8);
+				break;
+			default:
+				((int32_t *)values)[i] = column->indices[start + i];
+				break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// formatter
+//------------------------------------------------------------------------------
+
+void ResultSet_ReplyWithArrowHeader
+(
+	ResultSet *set
+) {
+	// prepare a response containing the arrow stream and statistics
+	// column names and types are part of the stream's schema
+	if(set->column_count > 0) {
+		RedisModule_ReplyWithArray(set->ctx, 2);
+	} else {
+		// prepare a response containing only statistics
+		RedisModule_ReplyWithArray(set->ctx, 1);
+	}
+}
+
+void ResultSet_EmitArrowRows
+(
+	ResultSet *set
+) {
+	ASSERT(set != NULL);
+
+	uint ncols     = set->column_count;
+	uint64_t nrows = ResultSet_RowCount(set);
+
+	uint64_t batch_size;
+	Config_Option_get(Config_ARROW_BATCH_SIZE, &batch_size);
+	ASSERT(batch_size > 0);
+
+	ArrowColumn *columns = rm_calloc(ncols, sizeof(ArrowColumn));
+	for(uint i = 0; i < ncols; i++) {
+		columns[i].type = _Column_Type(set, i, nrows);
+		if(columns[i].type == ARROW_COL_STRING) {
+			_Column_BuildDictionary(columns + i, set, i, nrows);
+		}
+	}
+
+	ArrowBuffer fb     = {0};
+	ArrowBuffer stream = {0};
+	ArrowBatch  batch  = {
+		.body    = {0},
+		.nodes   = array_new(int64_t, ncols * 2),
+		.buffers = array_new(int64_t, ncols * 6)
+	};
+
+	//--------------------------------------------------------------------------
+	// schema
+	//--------------------------------------------------------------------------
+
+	FBField schema = {1, 4, 0};  // fields
+	size_t fields;
+
+	size_t header = _Message_Begin(&fb, ARROW_HEADER_SCHEMA, 0);
+	_FB_Patch(&fb, header, _FB_Table(&fb, &schema, 1, &fields));
+
+	size_t vec = _FB_OffsetVector(&fb, ncols);
+	_FB_Patch(&fb, fields, vec);
+
+	for(uint i = 0; i < ncols; i++) {
+		size_t field = _FB_Field(&fb, set->columns[i], columns[i].type, i);
+		_FB_Patch(&fb, vec + sizeof(uint32_t) * (i + 1), field);
+	}
+
+	_Message_End(&stream, &fb, NULL);
+
+	//--------------------------------------------------------------------------
+	// dictionaries
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < ncols; i++) {
+		if(columns[i].type != ARROW_COL_STRING) continue;
+		_Column_WriteDictionary(&stream, &fb, &batch, columns + i, i);
+	}
+
+	//--------------------------------------------------------------------------
+	// record batches
+	//--------------------------------------------------------------------------
+
+	for(uint64_t start = 0; start < nrows; start += batch_size) {
+		uint64_t n = (nrows - start < batch_size) ? nrows - start : batch_size;
+		for(uint i = 0; i < ncols; i++) {
+			_Column_WriteBatch(&batch, set, columns + i, i, start, n);
+		}
+		_Batch_Flush(&stream, &fb, &batch, n, -1);
+	}
+
+	// end of stream
+	uint32_t eos[2] = {ARROW_CONTINUATION, 0};
+	_Buffer_Append(&stream, eos, sizeof(eos));
+
+	RedisModule_ReplyWithStringBuffer(set->ctx, stream.data, stream.len);
+
+	//--------------------------------------------------------------------------
+	// clean up
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < ncols; i++) {
+		if(columns[i].type != ARROW_COL_STRING) continue;
+		rm_free(columns[i].indices);
+		array_free(columns[i].offsets);
+		rm_free(columns[i].values.data);
+	}
+	rm_free(columns);
+
+	rm_free(fb.data);
+	rm_free(stream.data);
+	rm_free(batch.body.data);
+	array_free(batch.nodes);
+	array_free(batch.buffers);
+}
+
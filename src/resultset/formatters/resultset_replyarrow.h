@@ -0,0 +1,21 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// Formatter for Apache Arrow IPC stream replies
+
+// emit a header
+void ResultSet_ReplyWithArrowHeader
+(
+	ResultSet *set
+);
+
+// emit all rows as a single Arrow IPC stream
+void ResultSet_EmitArrowRows
+(
+	ResultSet *set
+);
+
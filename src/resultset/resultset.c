@@ -238,7 +238,10 @@ void ResultSet_Reply
 	_ResultSet_ReplyWithPreamble(set);
 
 	// emit resultset
-	if(set->column_count > 0) {
+	if(set->column_count > 0 && set->formatter->EmitRows != NULL) {
+		// columnar formatter, emit all rows at once
+		set->formatter->EmitRows(set);
+	} else if(set->column_count > 0) {
 		RedisModule_ReplyWithArray(set->ctx, row_count);
 		SIValue *row[set->column_count];
 		uint64_t cells = DataBlock_ItemCount(set->cells);
@@ -26,7 +26,7 @@ typedef struct ResultSet {
 	DataBlock *cells;               // accumulated cells
 	double timer[2];                // query runtime tracker
 	ResultSetStatistics stats;      // result set statistics
-	ResultSetFormatterType format;  // result set format; compact/verbose/nop
+	ResultSetFormatterType format;  // result set format; compact/verbose/arrow/nop
 	ResultSetFormatter *formatter;  // result set data formatter
 	SIAllocation cells_allocation;  // encountered values allocation
 } ResultSet;
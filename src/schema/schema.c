@@ -67,6 +67,8 @@ Schema *Schema_New
 	s->name        = rm_strdup(name);
 	s->constraints = array_new(Constraint, 0);
 
+	s->attr_constraints = HashTableCreate(&def_dt);
+
 	return s;
 }
 
@@ -496,6 +498,55 @@ void Schema_AddConstraint
 	ASSERT(s != NULL);
 	ASSERT(c != NULL);
 	array_append(s->constraints, c);
+
+	// index constraint by each of its attributes
+	const Attribute_ID *attrs;
+	uint8_t n = Constraint_GetAttributes(c, &attrs, NULL);
+	for(uint8_t i = 0; i < n; i++) {
+		void *key = (void *)(intptr_t)attrs[i];
+		Constraint *constraints;
+		dictEntry *existing;
+		dictEntry *entry = HashTableAddRaw(s->attr_constraints, key, &existing);
+		if(entry == NULL) {
+			// attribute already enforced by other constraints
+			entry = existing;
+			constraints = HashTableGetVal(entry);
+		} else {
+			constraints = array_new(Constraint, 1);
+		}
+
+		array_append(constraints, c);
+		HashTableSetVal(s->attr_constraints, entry, constraints);
+	}
+}
+
+// removes constraint from the schema's attribute to constraints lookup
+static void _RemoveAttributeConstraint
+(
+	Schema *s,    // schema
+	Constraint c  // removed constraint
+) {
+	const Attribute_ID *attrs;
+	uint8_t n = Constraint_GetAttributes(c, &attrs, NULL);
+	for(uint8_t i = 0; i < n; i++) {
+		void *key = (void *)(intptr_t)attrs[i];
+		dictEntry *entry = HashTableFind(s->attr_constraints, key);
+		ASSERT(entry != NULL);
+
+		Constraint *constraints = HashTableGetVal(entry);
+		uint m = array_len(constraints);
+		for(uint j = 0; j < m; j++) {
+			if(constraints[j] == c) {
+				array_del_fast(constraints, j);
+				break;
+			}
+		}
+
+		if(array_len(constraints) == 0) {
+			array_free(constraints);
+			HashTableDelete(s->attr_constraints, key);
+		}
+	}
 }
 
 // removes constraint from schema
@@ -514,6 +565,7 @@ void Schema_RemoveConstraint
 		if(c == s->constraints[i]) {
 			Constraint_IncPendingChanges(c);
 			array_del_fast(s->constraints, i);
+			_RemoveAttributeConstraint(s, c);
 			return;
 		}
 	}
@@ -547,6 +599,104 @@ bool Schema_EnforceConstraints
 	return true;
 }
 
+// returns true if one of the modified attributes 'attrs' is enforced by 'c'
+static bool _ConstraintAffected
+(
+	Constraint c,        // constraint
+	Attribute_ID *attrs  // modified attributes, NULL if all
+) {
+	if(attrs == NULL) return true;
+
+	uint n = array_len(attrs);
+	for(uint i = 0; i < n; i++) {
+		if(attrs[i] == ATTRIBUTE_ID_ALL ||
+		   Constraint_ContainsAttribute(c, attrs[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// adds the constraints enforcing the modified attributes 'attrs'
+// to 'affected' if missing
+static void _CollectAffectedConstraints
+(
+	const Schema *s,       // schema
+	Attribute_ID *attrs,   // modified attributes, NULL if all
+	Constraint **affected  // [in/out] affected constraints
+) {
+	uint n = array_len(s->constraints);
+	if(array_len(*affected) == n) return;  // all constraints affected
+
+	if(attrs == NULL) {
+		array_clear(*affected);
+		for(uint i = 0; i < n; i++) array_append(*affected, s->constraints[i]);
+		return;
+	}
+
+	uint attr_count = array_len(attrs);
+	for(uint i = 0; i < attr_count; i++) {
+		if(attrs[i] == ATTRIBUTE_ID_ALL) {
+			_CollectAffectedConstraints(s, NULL, affected);
+			return;
+		}
+
+		dictEntry *entry = HashTableFind(s->attr_constraints,
+				(void *)(intptr_t)attrs[i]);
+		if(entry == NULL) continue;
+
+		Constraint *constraints = HashTableGetVal(entry);
+		uint m = array_len(constraints);
+		for(uint j = 0; j < m; j++) {
+			Constraint c = constraints[j];
+			uint k = 0;
+			uint affected_count = array_len(*affected);
+			while(k < affected_count && (*affected)[k] != c) k++;
+			if(k == affected_count) array_append(*affected, c);
+		}
+	}
+}
+
+// enforce constraints under given schema on a batch of modified entities
+bool Schema_EnforceConstraintsOnChanges
+(
+	const Schema *s,         // schema
+	GraphEntity **entities,  // modified entities
+	Attribute_ID **attrs,    // modified attributes of each entity
+	uint n,                  // number of entities
+	char **err_msg           // report error message
+) {
+	// validations
+	ASSERT(s        != NULL);
+	ASSERT(attrs    != NULL);
+	ASSERT(entities != NULL);
+
+	if(!Schema_HasConstraints(s)) return true;
+
+	// determine which constraints are affected by the batch
+	Constraint *affected = array_new(Constraint, 0);
+	for(uint i = 0; i < n; i++) {
+		_CollectAffectedConstraints(s, attrs[i], &affected);
+	}
+
+	// enforce each affected constraint on the entities which modified it
+	bool valid = true;
+	uint m = array_len(affected);
+	for(uint i = 0; i < m && valid; i++) {
+		Constraint c = affected[i];
+		if(Constraint_GetStatus(c) == CT_FAILED) continue;
+
+		for(uint j = 0; j < n && valid; j++) {
+			if(!_ConstraintAffected(c, attrs[j])) continue;
+			valid = Constraint_EnforceEntity(c, entities[j], err_msg);
+		}
+	}
+
+	array_free(affected);
+	return valid;
+}
+
 void Schema_Free
 (
 	Schema *s
@@ -566,6 +716,15 @@ void Schema_Free
 		array_free(s->constraints);
 	}
 
+	// free attribute to constraints lookup
+	dictEntry *entry;
+	dictIterator *it = HashTableGetIterator(s->attr_constraints);
+	while((entry = HashTableNext(it)) != NULL) {
+		array_free(HashTableGetVal(entry));
+	}
+	HashTableReleaseIterator(it);
+	HashTableRelease(s->attr_constraints);
+
 	// free indicies
 	if(PENDING_IDX(s) != NULL) {
 		Index_Free(PENDING_IDX(s));
@@ -9,6 +9,7 @@
 #include "../redismodule.h"
 #include "../index/index.h"
 #include "redisearch_api.h"
+#include "../util/dict.h"
 #include "../constraint/constraint.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/entities/attribute_set.h"
@@ -30,6 +31,7 @@ typedef struct {
 	SchemaType type;          // schema type (node/edge)
 	Index index[2];           // active/pending index
 	Constraint *constraints;  // constraints array
+	dict *attr_constraints;   // attribute ID to constraints enforcing it
 } Schema;
 
 // creates a new schema
@@ -206,3 +208,16 @@ bool Schema_EnforceConstraints
 	char **err_msg         // report error message
 );
 
+// enforce constraints under given schema on a batch of modified entities
+// a constraint is only enforced on entities which modified one of its
+// attributes, 'attrs[i]' is an array of the attributes modified on
+// 'entities[i]', NULL enforces all constraints on the entity
+bool Schema_EnforceConstraintsOnChanges
+(
+	const Schema *s,         // schema
+	GraphEntity **entities,  // modified entities
+	Attribute_ID **attrs,    // modified attributes of each entity
+	uint n,                  // number of entities
+	char **err_msg           // report error message
+);
+
@@ -161,6 +161,8 @@ void RdbLoadNodes_v14
 
 			if(PENDING_IDX(s)) Index_IndexNode(PENDING_IDX(s), &n);
 		}
+
+		GraphContext_TrackExpiry(gc, (GraphEntity *)&n, GETYPE_NODE);
 	}
 }
 
@@ -211,6 +213,8 @@ void RdbLoadEdges_v14
 		ASSERT(s != NULL);
 
 		if(PENDING_IDX(s)) Index_IndexEdge(PENDING_IDX(s), &e);
+
+		GraphContext_TrackExpiry(gc, (GraphEntity *)&e, GETYPE_EDGE);
 	}
 }
 
@@ -20,7 +20,7 @@ static void _RdbSaveAttributeKeys
 	uint count = GraphContext_AttributeCount(gc);
 	RedisModule_SaveUnsigned(rdb, count);
 	for(uint i = 0; i < count; i ++) {
-		char *key = gc->string_mapping[i];
+		const char *key = GraphContext_GetAttributeString(gc, i);
 		RedisModule_SaveStringBuffer(rdb, key, strlen(key) + 1);
 	}
 }
@@ -10,6 +10,7 @@
 
 // functions declerations - implemented in graph.c
 bool Graph_FormConnection(Graph *g, NodeID src, NodeID dest, EdgeID edge_id, int r);
+void Graph_SetEdgeMeta(Graph *g, EdgeID id, NodeID src, NodeID dest, RelationID r);
 
 void Graph_EnsureNodeCap
 (
@@ -202,6 +203,8 @@ void Serializer_Graph_SetEdge
 	e->attributes =  set;
 	e->relationID =  r;
 
+	Graph_SetEdgeMeta(g, edge_id, src, dest, r);
+
 	if(multi_edge) {
 		if(!Graph_FormConnection(g, src, dest, edge_id, r)) {
 			// resize matrices
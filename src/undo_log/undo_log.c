@@ -146,6 +146,10 @@ static void _UndoLog_Rollback_Update_Entity
 
 			// update indices
 			_index_node(ctx, &update_op->n);
+
+			// restored expiration time
+			GraphContext_TrackExpiry(ctx->gc, (GraphEntity *)&update_op->n,
+					GETYPE_NODE);
 		} else {
 			// free current entity attribute-set
 			AttributeSet_Free(update_op->e.attributes);
@@ -155,6 +159,10 @@ static void _UndoLog_Rollback_Update_Entity
 
 			// update indices
 			_index_edge(ctx, &update_op->e);
+
+			// restored expiration time
+			GraphContext_TrackExpiry(ctx->gc, (GraphEntity *)&update_op->e,
+					GETYPE_EDGE);
 		}
 	}
 }
@@ -269,6 +277,7 @@ static void _UndoLog_Rollback_Delete_Node
 
 		// re-introduce node to indices
 		_index_node(ctx, &n);
+		GraphContext_TrackExpiry(ctx->gc, (GraphEntity *)&n, GETYPE_NODE);
 
 		// cleanup after undo rollback, as the op D'tor is not called
 		rm_free(delete_op->labels);
@@ -292,6 +301,7 @@ static void _UndoLog_Rollback_Delete_Edge
 		*e.attributes = delete_op.set;
 
 		_index_edge(ctx, &e);
+		GraphContext_TrackExpiry(ctx->gc, (GraphEntity *)&e, GETYPE_EDGE);
 	}
 }
 
@@ -413,7 +423,7 @@ void UndoLog_DeleteNode
 	op.delete_node_op.id = node->id;
 
 	// take ownership over node's attribute-set
-	op.delete_node_op.set = *node->attributes;
+	op.delete_node_op.set = GraphEntity_GetAttributes((GraphEntity *)node);
 	
 	// mark node's attribute-set as read-only
 	*node->attributes =
@@ -450,7 +460,7 @@ void UndoLog_DeleteEdge
 	op.delete_edge_op.relationID = Edge_GetRelationID(edge);
 
 	// take ownership over edge's attribute-set
-	op.delete_edge_op.set = *edge->attributes;
+	op.delete_edge_op.set = GraphEntity_GetAttributes((GraphEntity *)edge);
 
 	// mark edge's attribute-set as read-only
 	*edge->attributes =
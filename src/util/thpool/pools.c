@@ -165,6 +165,18 @@ int ThreadPools_AddWorkWriter
 	return thpool_add_work(_writers_thpool, function_p, arg_p);
 }
 
+// returns the argument of the next queued write task
+// if it is handled by 'handler', NULL otherwise
+void *ThreadPools_PeekWriterTask
+(
+	void (*handler)(void *)  // task handler to match
+) {
+	ASSERT(handler         != NULL);
+	ASSERT(_writers_thpool != NULL);
+
+	return thpool_peek_task(_writers_thpool, handler);
+}
+
 void ThreadPools_SetMaxPendingWork(uint64_t val) {
 	if(_readers_thpool != NULL) thpool_set_jobqueue_cap(_readers_thpool, val);
 	if(_writers_thpool != NULL) thpool_set_jobqueue_cap(_writers_thpool, val);
@@ -59,6 +59,13 @@ int ThreadPools_AddWorkWriter
 	int force                    // true will add task even if internal queue is full
 );
 
+// returns the argument of the next queued write task
+// if it is handled by 'handler', NULL otherwise
+void *ThreadPools_PeekWriterTask
+(
+	void (*handler)(void *)  // task handler to match
+);
+
 // sets the limit on max queued queries in each thread pool
 void ThreadPools_SetMaxPendingWork
 (
@@ -348,6 +348,31 @@ void thpool_get_tasks
 	*num_tasks = i;
 }
 
+// returns the argument of the task at the front of the queue
+// if it is handled by 'handler', NULL otherwise
+void *thpool_peek_task
+(
+	thpool_* thpool_p,       // thread pool
+	void (*handler)(void *)  // handler function
+) {
+	ASSERT(handler  != NULL);
+	ASSERT(thpool_p != NULL);
+
+	jobqueue *jobqueue_p = &thpool_p->jobqueue;
+	void *arg = NULL;
+
+	pthread_mutex_lock(&jobqueue_p->rwmutex);
+
+	job *job = jobqueue_p->front;
+	if(job != NULL && job->function == handler) {
+		arg = job->arg;
+	}
+
+	pthread_mutex_unlock(&jobqueue_p->rwmutex);
+
+	return arg;
+}
+
 /* ============================ THREAD ============================== */
 
 /* Initialize a thread in the thread pool
@@ -254,6 +254,14 @@ void thpool_get_tasks
 	void (*match)(void*)      // [optional] executed on every match task
 );
 
+// returns the argument of the task at the front of the queue
+// if it is handled by 'handler', NULL otherwise
+void *thpool_peek_task
+(
+	threadpool thpool_p,     // thread pool
+	void (*handler)(void *)  // handler function
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -798,6 +798,60 @@ XXH64_hash_t SIValue_HashCode(SIValue v) {
 	return XXH64_digest(&state);
 }
 
+// writes a binary representation of v to stream
+// this is the reverse of SIValue_FromBinary
+void SIValue_ToBinary
+(
+	FILE *stream,     // stream to write to
+	const SIValue *v  // value to write
+) {
+	ASSERT(v      != NULL);
+	ASSERT(stream != NULL);
+
+	// format:
+	//    type
+	//    value
+	bool b;
+	size_t len;
+	SIType t = v->type;
+
+	// write type
+	fwrite_assert(&t, sizeof(SIType), stream);
+
+	// write value
+	switch(t) {
+		case T_POINT:
+			fwrite_assert(&v->point, sizeof(Point), stream);
+			break;
+		case T_ARRAY:
+			SIArray_ToBinary(stream, v);
+			break;
+		case T_STRING:
+			len = strlen(v->stringval) + 1;
+			fwrite_assert(&len, sizeof(len), stream);
+			fwrite_assert(v->stringval, len, stream);
+			break;
+		case T_BOOL:
+			b = SIValue_IsTrue(*v);
+			fwrite_assert(&b, sizeof(b), stream);
+			break;
+		case T_INT64:
+			fwrite_assert(&v->longval, sizeof(v->longval), stream);
+			break;
+		case T_DOUBLE:
+			fwrite_assert(&v->doubleval, sizeof(v->doubleval), stream);
+			break;
+		case T_VECTOR32F:
+			SIVector_ToBinary(stream, v);
+			break;
+		case T_NULL:
+			// no additional data is required to represent NULL
+			break;
+		default:
+			assert(false && "unknown SIValue type");
+	}
+}
+
 // reads SIValue off of binary stream
 SIValue SIValue_FromBinary
 (
@@ -210,6 +210,14 @@ void SIValue_HashUpdate(SIValue v, XXH64_state_t *state);
 /* Returns a hash code for a given SIValue. */
 XXH64_hash_t SIValue_HashCode(SIValue v);
 
+// writes a binary representation of v to stream
+// this is the reverse of SIValue_FromBinary
+void SIValue_ToBinary
+(
+	FILE *stream,     // stream to write to
+	const SIValue *v  // value to write
+);
+
 // reads SIValue off of binary stream
 SIValue SIValue_FromBinary
 (
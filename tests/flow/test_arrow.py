@@ -0,0 +1,100 @@
+import pyarrow as pa
+import pyarrow.ipc as ipc
+from common import *
+
+GRAPH_ID = "arrow"
+
+class testArrowResultSet():
+    def __init__(self):
+        # arrow stream is binary, don't decode replies
+        self.env = Env(decodeResponses=False)
+        self.conn = self.env.getConnection()
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = """UNWIND range(0, 99) AS i
+               CREATE (:N {i: i, d: i / 2.0, b: i % 2 = 0,
+                           s: CASE WHEN i % 10 = 0 THEN NULL
+                                   ELSE 'v' + toString(i % 3) END})"""
+        self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q)
+
+    def arrow_query(self, q):
+        res = self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q, "--arrow")
+        # reply holds the arrow stream followed by statistics
+        self.env.assertEquals(len(res), 2)
+
+        reader = ipc.open_stream(pa.py_buffer(res[0]))
+        batches = list(reader)
+        table = pa.Table.from_batches(batches, schema=reader.schema)
+        table.validate(full=True)
+        return table, batches
+
+    def test01_column_types(self):
+        q = "MATCH (n:N) RETURN n.i AS i, n.d AS d, n.b AS b, n.s AS s, n.x AS x ORDER BY n.i"
+        table, _ = self.arrow_query(q)
+
+        schema = table.schema
+        self.env.assertEquals(schema.names, ['i', 'd', 'b', 's', 'x'])
+        self.env.assertEquals(schema.field('i').type, pa.int64())
+        self.env.assertEquals(schema.field('d').type, pa.float64())
+        self.env.assertEquals(schema.field('b').type, pa.bool_())
+        self.env.assertEquals(schema.field('s').type,
+                              pa.dictionary(pa.int32(), pa.string()))
+        self.env.assertEquals(schema.field('x').type, pa.null())
+
+        res = table.to_pydict()
+        self.env.assertEquals(res['i'], list(range(100)))
+        self.env.assertEquals(res['d'], [i / 2.0 for i in range(100)])
+        self.env.assertEquals(res['b'], [i % 2 == 0 for i in range(100)])
+        self.env.assertEquals(res['s'], [None if i % 10 == 0 else 'v' + str(i % 3)
+                                         for i in range(100)])
+        self.env.assertEquals(res['x'], [None] * 100)
+
+        # strings are dictionary-encoded, each distinct value is stored once
+        dictionary = table.column('s').chunk(0).dictionary
+        self.env.assertEquals(sorted(dictionary.to_pylist()), ['v0', 'v1', 'v2'])
+
+    def test02_mixed_types(self):
+        # integers and floats are widened to doubles
+        q = "UNWIND [1, 2.5, NULL, 3] AS x RETURN x"
+        table, _ = self.arrow_query(q)
+        self.env.assertEquals(table.schema.field('x').type, pa.float64())
+        self.env.assertEquals(table.column('x').to_pylist(), [1.0, 2.5, None, 3.0])
+
+        # other mixes are emitted as strings
+        q = "UNWIND [1, 'a', true, NULL] AS x RETURN x"
+        table, _ = self.arrow_query(q)
+        self.env.assertEquals(table.schema.field('x').type,
+                              pa.dictionary(pa.int32(), pa.string()))
+        self.env.assertEquals(table.column('x').to_pylist(), ['1', 'a', 'true', None])
+
+    def test03_batch_size(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "ARROW_BATCH_SIZE", 30)
+        try:
+            q = "MATCH (n:N) RETURN n.i AS i ORDER BY n.i"
+            table, batches = self.arrow_query(q)
+            self.env.assertEquals([b.num_rows for b in batches], [30, 30, 30, 10])
+            self.env.assertEquals(table.column('i').to_pylist(), list(range(100)))
+        finally:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "ARROW_BATCH_SIZE", 65536)
+
+        # batch size must be positive
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "ARROW_BATCH_SIZE", 0)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+    def test04_empty_result(self):
+        q = "MATCH (n:N) WHERE n.i < 0 RETURN n.i AS i"
+        table, batches = self.arrow_query(q)
+        self.env.assertEquals(table.schema.names, ['i'])
+        self.env.assertEquals(len(batches), 0)
+        self.env.assertEquals(table.num_rows, 0)
+
+    def test05_no_columns(self):
+        # queries without projections reply with statistics only
+        q = "CREATE (:M)"
+        res = self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q, "--arrow")
+        self.env.assertEquals(len(res), 1)
+        self.env.assertIn(b"Nodes created: 1", res[0])
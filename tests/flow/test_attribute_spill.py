@@ -0,0 +1,175 @@
+import time
+import tempfile
+from common import *
+
+GRAPH_ID = "attribute_spill"
+
+# attribute-sets not accessed between two eviction sweeps are spilled to disk
+# and loaded back into memory once accessed
+SPILL_FOLDER   = tempfile.gettempdir()
+SPILL_INTERVAL = 100  # ms
+
+class testAttributeSpill():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f"ATTRIBUTE_SPILL_FOLDER {SPILL_FOLDER} "
+                                  f"ATTRIBUTE_SPILL_INTERVAL {SPILL_INTERVAL}")
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = """UNWIND range(0, 99) AS i
+               CREATE (:A {i: i, s: 'str_' + toString(i), arr: [i, toFloat(i), 'a'],
+                           p: point({latitude: 1.5, longitude: 2.5}), v: vecf32([i, 1])})
+                      -[:R {i: i, b: i % 2 = 0}]->
+                      (:B)"""
+        self.graph.query(q)
+
+    def spilled(self):
+        return self.conn.execute_command("GRAPH.DEBUG", "SPILLED")
+
+    def wait_for_spill(self, expected):
+        # wait for eviction sweeps to spill at least 'expected' sets
+        for _ in range(100):
+            if self.spilled() >= expected:
+                return
+            time.sleep(SPILL_INTERVAL / 1000)
+        self.env.assertGreaterEqual(self.spilled(), expected)
+
+    def test01_config(self):
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "ATTRIBUTE_SPILL_FOLDER")
+        self.env.assertEquals(res, ["ATTRIBUTE_SPILL_FOLDER", SPILL_FOLDER])
+
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "ATTRIBUTE_SPILL_INTERVAL")
+        self.env.assertEquals(res, ["ATTRIBUTE_SPILL_INTERVAL", SPILL_INTERVAL])
+
+        # spill folder can only be set on load
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "ATTRIBUTE_SPILL_FOLDER", "/tmp")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+    def test02_fault_in(self):
+        # all 100 nodes and 100 edges holding attributes are spilled
+        self.wait_for_spill(200)
+
+        # accessing spilled sets loads them back in
+        q = """MATCH (a:A)-[r:R]->() RETURN a.i, a.s, a.arr, a.p, a.v, r.i, r.b
+               ORDER BY a.i"""
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(len(res), 100)
+        for i, row in enumerate(res):
+            self.env.assertEquals(row[0], i)
+            self.env.assertEquals(row[1], f"str_{i}")
+            self.env.assertEquals(row[2], [i, float(i), 'a'])
+            self.env.assertEquals(row[3], {'latitude': 1.5, 'longitude': 2.5})
+            self.env.assertEquals(row[4], [float(i), 1.0])
+            self.env.assertEquals(row[5], i)
+            self.env.assertEquals(row[6], i % 2 == 0)
+
+        self.env.assertLess(self.spilled(), 200)
+
+    def test03_traversal(self):
+        # traversals which don't access attributes keep sets on disk
+        self.wait_for_spill(200)
+
+        res = self.graph.query("MATCH (a:A)-[:R]->(b:B) RETURN count(b)").result_set
+        self.env.assertEquals(res[0][0], 100)
+        self.env.assertGreaterEqual(self.spilled(), 200)
+
+    def test04_modify_spilled(self):
+        # update, remove and delete spilled entities
+        self.wait_for_spill(200)
+        self.graph.query("MATCH (a:A) WHERE a.i % 4 = 0 SET a.i = -1")
+
+        self.wait_for_spill(200)
+        self.graph.query("MATCH (a:A) WHERE a.i % 4 = 2 SET a = {x: 1}")
+
+        self.wait_for_spill(200)
+        self.graph.query("MATCH (a:A)-[r:R]->() WHERE a.i % 4 = 1 DELETE r")
+
+        self.wait_for_spill(175)
+        self.graph.query("MATCH (a:A) WHERE a.i % 4 = 3 DETACH DELETE a")
+
+        # 75 nodes and 50 edges holding attributes remain
+        self.wait_for_spill(125)
+
+        q = "MATCH (a:A) WHERE a.i = -1 RETURN count(a)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], 25)
+
+        q = "MATCH (a:A) WHERE a.x = 1 RETURN count(a), collect(a.s)"
+        self.env.assertEquals(self.graph.query(q).result_set[0], [25, []])
+
+        q = "MATCH ()-[r:R]->() RETURN count(r), sum(r.i)"
+        self.env.assertEquals(self.graph.query(q).result_set[0], [50, 2450])
+
+        # rolled back query restores spilled sets
+        q = "MATCH (a:A) OPTIONAL MATCH (a)-[r]->() RETURN a, r ORDER BY id(a)"
+        expected = self.graph.query(q).result_set
+
+        self.wait_for_spill(125)
+        try:
+            self.graph.query("""MATCH (a:A) SET a.i = 1 WITH a
+                                DETACH DELETE a RETURN 1 / 0""")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+        self.env.assertEquals(self.graph.query(q).result_set, expected)
+
+    def test05_persistence(self):
+        q = "MATCH (a:A)-[r:R]->() RETURN a, r ORDER BY id(a)"
+        expected = self.graph.query(q).result_set
+
+        # spilled sets are encoded as any other set
+        self.wait_for_spill(1)
+        self.env.dumpAndReload()
+        self.env.assertEquals(self.graph.query(q).result_set, expected)
+
+        # reloaded sets are spilled again
+        self.wait_for_spill(1)
+        self.env.assertEquals(self.graph.query(q).result_set, expected)
+
+    def test06_fully_spilled(self):
+        # fully spilled graphs are skipped by sweeps until they are modified
+        # or their sets are loaded back into memory
+        self.wait_for_spill(1)
+
+        # sets of new entities are spilled
+        spilled = self.spilled()
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:C {i: i})")
+        self.wait_for_spill(spilled + 10)
+
+        # faulted in sets are spilled again
+        spilled = self.spilled()
+        res = self.graph.query("MATCH (c:C) RETURN sum(c.i)").result_set
+        self.env.assertEquals(res[0][0], 45)
+        self.env.assertLess(self.spilled(), spilled)
+        self.wait_for_spill(spilled)
+
+    def test07_spill_file_bounded(self):
+        # extents of faulted in sets are reused by later spills
+        # repeated spill / fault-in cycles don't grow the spill file
+        q = "MATCH (n) WHERE size(keys(n)) > 0 RETURN count(n)"
+        total = self.graph.query(q).result_set[0][0]
+        q = "MATCH ()-[r]->() WHERE size(keys(r)) > 0 RETURN count(r)"
+        total += self.graph.query(q).result_set[0][0]
+
+        def cycle():
+            # wait for every set to be spilled, then fault them all in
+            self.wait_for_spill(total)
+            self.graph.query("MATCH (n) OPTIONAL MATCH (n)-[r]->() RETURN n, r")
+            self.env.assertLess(self.spilled(), total)
+
+        cycle()
+        self.wait_for_spill(total)
+        size = self.conn.execute_command("GRAPH.DEBUG", "SPILL_SIZE")
+        self.env.assertGreater(size, 0)
+
+        for _ in range(5):
+            cycle()
+            self.wait_for_spill(total)
+            self.env.assertLessEqual(
+                self.conn.execute_command("GRAPH.DEBUG", "SPILL_SIZE"), size)
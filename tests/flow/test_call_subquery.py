@@ -2130,3 +2130,154 @@ updating clause.")
         plan = graph.explain(query)
         scan = locate_operation(plan.structured_plan, "Conditional Traverse")
         self.env.assertEquals(str(scan), "Conditional Traverse | (n:N)->(n:N)")
+
+    def test32_in_transactions(self):
+        """Tests that CALL {} IN TRANSACTIONS commits its modifications in
+        batches"""
+
+        # clean the db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        # validations
+        queries_errors = [
+            ("UNWIND range(1, 3) AS x CALL {WITH x RETURN x AS y} IN TRANSACTIONS RETURN y",
+             "CALL {} IN TRANSACTIONS must contain an updating clause"),
+            ("CALL {CALL {CREATE (:N)} IN TRANSACTIONS} RETURN 1",
+             "CALL {} IN TRANSACTIONS can not be nested in a subquery"),
+            ("WITH 2 AS n UNWIND range(1, 3) AS x CALL {WITH x CREATE (:N)} IN TRANSACTIONS OF n ROWS",
+             "CALL {} IN TRANSACTIONS batch size must be an integer literal or a parameter"),
+            ("UNWIND range(1, 3) AS x CALL {WITH x CREATE (:N)} IN TRANSACTIONS OF 0 ROWS",
+             "CALL {} IN TRANSACTIONS batch size must be a positive integer"),
+        ]
+        for query, err in queries_errors:
+            self.expect_error(query, err)
+
+        # batches of 2 records
+        res = graph.query("""
+            UNWIND range(1, 5) AS x
+            CALL {
+                WITH x
+                CREATE (:N {v: x})
+            } IN TRANSACTIONS OF 2 ROWS
+            RETURN count(x)
+            """)
+        self.env.assertEquals(res.result_set, [[5]])
+        self.env.assertEquals(res.nodes_created, 5)
+
+        # default batch size, parameterized batch size and a returning body
+        res = graph.query("""
+            MATCH (n:N)
+            CALL {
+                WITH n
+                SET n.v = n.v * 10
+                RETURN n.v AS v
+            } IN TRANSACTIONS
+            RETURN v ORDER BY v
+            """)
+        self.env.assertEquals(res.result_set, [[10], [20], [30], [40], [50]])
+
+        res = graph.query("""
+            MATCH (n:N)
+            CALL {
+                WITH n
+                DELETE n
+            } IN TRANSACTIONS OF $n ROWS
+            """, {'n': 3})
+        self.env.assertEquals(res.nodes_deleted, 5)
+
+        # a failing batch only rolls back its own modifications, previously
+        # committed batches remain
+        try:
+            graph.query("""
+                UNWIND [1, 2, 3, 0] AS x
+                CALL {
+                    WITH x
+                    CREATE (:N {v: 1 / x})
+                } IN TRANSACTIONS OF 3 ROWS
+                """)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
+
+        res = graph.query("MATCH (n:N) RETURN count(n)")
+        self.env.assertEquals(res.result_set, [[3]])
+
+        # the lhs is depleted before the first batch, nodes created by
+        # earlier batches are not fed to later ones
+        res = graph.query("""
+            MATCH (n:N)
+            CALL {
+                WITH n
+                CREATE (:N {v: n.v})
+            } IN TRANSACTIONS OF 1 ROWS
+            """)
+        self.env.assertEquals(res.nodes_created, 3)
+
+        res = graph.query("MATCH (n:N) RETURN count(n)")
+        self.env.assertEquals(res.result_set, [[6]])
+
+    def test33_decorrelated_subquery(self):
+        """Tests that a subquery depending on its imported variable only
+        through an equality is evaluated once and joined"""
+
+        # clean the db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("UNWIND range(1, 5) AS i CREATE (:L {k: i % 3, v: i})")
+
+        query = """
+            UNWIND [0, 1, 2, 3, NULL] AS x
+            CALL {
+                WITH x
+                MATCH (n:L)
+                WHERE n.k = x AND n.v > 1
+                RETURN n.v AS v
+            }
+            RETURN x, v ORDER BY x, v
+            """
+
+        plan = graph.explain(query)
+        self.env.assertIsNone(locate_operation(plan.structured_plan,
+            "CallSubquery"))
+        self.env.assertIsNotNone(locate_operation(plan.structured_plan,
+            "Value Hash Join"))
+
+        expected = [[0, 3], [1, 4], [2, 2], [2, 5]]
+        self.get_res_and_assertEquals(query, expected)
+
+        # queries which are kept as is
+        queries = [
+            # imported variable used beyond the equality
+            """UNWIND [0, 1] AS x
+               CALL { WITH x MATCH (n:L) WHERE n.k = x RETURN n.v + x AS v }
+               RETURN x, v""",
+            # non-equality correlation
+            """UNWIND [0, 1] AS x
+               CALL { WITH x MATCH (n:L) WHERE n.k > x RETURN n.v AS v }
+               RETURN x, v""",
+            # limited body
+            """UNWIND [0, 1] AS x
+               CALL { WITH x MATCH (n:L) WHERE n.k = x RETURN n.v AS v LIMIT 1 }
+               RETURN x, v""",
+            # aggregating body
+            """UNWIND [0, 1] AS x
+               CALL { WITH x MATCH (n:L) WHERE n.k = x RETURN count(n) AS c }
+               RETURN x, c""",
+            # updating body
+            """UNWIND [0, 1] AS x
+               CALL { WITH x MATCH (n:L) WHERE n.k = x SET n.w = 1 RETURN n.v AS v }
+               RETURN x, v""",
+        ]
+        for q in queries:
+            plan = graph.explain(q)
+            self.env.assertIsNotNone(locate_operation(plan.structured_plan,
+                "CallSubquery"))
+
+        # an indexed key is resolved per input record
+        create_node_range_index(graph, 'L', 'k', sync=True)
+        plan = graph.explain(query)
+        self.env.assertIsNotNone(locate_operation(plan.structured_plan,
+            "CallSubquery"))
+        self.get_res_and_assertEquals(query, expected)
@@ -0,0 +1,135 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "column_aggregate"
+
+# aggregations over range indexed attributes of a label are computed from
+# the columns maintained by the index instead of scanning the label
+# results are compared against the same aggregation fed through a WITH
+# clause, which keeps the label scan and aggregate plan
+# columns are opt-in, enabled by the INDEX_COLUMNS configuration
+
+class testColumnAggregate():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs="INDEX_COLUMNS yes")
+        self.con = self.env.getConnection()
+        self.graph = Graph(self.con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # integer, floating point and missing values
+        q = """UNWIND range(0, 99) AS i
+               CREATE (:L {i: i, d: i / 7.0, o: CASE WHEN i % 5 = 0 THEN NULL
+                                                    ELSE i % 13 END})"""
+        self.graph.query(q)
+
+        create_node_range_index(self.graph, 'L', 'i', 'd', 'o', sync=True)
+
+    def assert_column_aggregate(self, returns, optimized=True):
+        q   = f"MATCH (n:L) RETURN {returns}"
+        ref = f"MATCH (n:L) WITH n RETURN {returns}"
+
+        plan = self.graph.execution_plan(q)
+        self.env.assertEquals("Column Aggregate" in plan, optimized)
+
+        actual   = self.graph.query(q).result_set
+        expected = self.graph.query(ref).result_set
+        self.env.assertEquals(actual, expected)
+        return actual
+
+    def test01_aggregations(self):
+        self.assert_column_aggregate("count(n.i), sum(n.i), avg(n.i), min(n.i), max(n.i)")
+        self.assert_column_aggregate("count(n.d), sum(n.d), avg(n.d), min(n.d), max(n.d)")
+        self.assert_column_aggregate("count(n.o), sum(n.o), avg(n.o), min(n.o), max(n.o)")
+
+        res = self.assert_column_aggregate("count(n.i), sum(n.i)")
+        self.env.assertEquals(res, [[100, 4950]])
+
+    def test02_unsupported(self):
+        # attribute isn't indexed
+        self.assert_column_aggregate("sum(n.x)", optimized=False)
+
+        # distinct, grouping, expressions and unsupported functions
+        self.assert_column_aggregate("count(DISTINCT n.o)", optimized=False)
+        self.assert_column_aggregate("n.o, sum(n.i)", optimized=False)
+        self.assert_column_aggregate("sum(n.i + 1)", optimized=False)
+        self.assert_column_aggregate("collect(n.o)", optimized=False)
+
+        # filtered scan
+        q = "MATCH (n:L) WHERE n.i > 10 RETURN sum(n.d)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Column Aggregate", plan)
+
+    def test03_missing_label(self):
+        q = "MATCH (n:Missing) RETURN count(n.i), sum(n.i)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[0, 0]])
+
+    def test04_updates(self):
+        returns = "count(n.i), sum(n.i), avg(n.d), min(n.o), max(n.o)"
+
+        # create, update, remove and delete
+        self.graph.query("CREATE (:L {i: 1000, d: 0.5, o: -1})")
+        self.graph.query("MATCH (n:L) WHERE n.i < 10 SET n.i = n.i * 2, n.d = n.i")
+        self.graph.query("MATCH (n:L) WHERE n.i % 9 = 0 SET n.o = NULL")
+        self.graph.query("MATCH (n:L) WHERE n.i > 90 AND n.i < 95 DELETE n")
+        self.assert_column_aggregate(returns)
+
+        # label removal and addition
+        self.graph.query("MATCH (n:L) WHERE n.i % 4 = 0 REMOVE n:L SET n:K")
+        self.assert_column_aggregate(returns)
+        self.graph.query("MATCH (n:K) WHERE n.i % 8 = 0 SET n:L")
+        self.assert_column_aggregate(returns)
+
+    def test05_mixed_types(self):
+        # values not held by the columns are aggregated from the nodes
+        self.graph.query("CREATE (:L {o: true}), (:L {o: 'str'}), (:L {o: [1]})")
+        self.assert_column_aggregate("count(n.o), min(n.o), max(n.o)")
+
+        # type errors are reported as usual
+        try:
+            self.graph.query("MATCH (n:L) RETURN sum(n.o)")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Type mismatch", str(e))
+
+    def test06_index_rebuilt(self):
+        returns = "count(n.i), sum(n.i), avg(n.d)"
+        expected = self.assert_column_aggregate(returns)
+
+        # columns are repopulated along with the index on load
+        self.env.dumpAndReload()
+        wait_for_indices_to_sync(self.graph)
+        self.env.assertEquals(self.assert_column_aggregate(returns), expected)
+
+        # dropping the index reverts to scanning the label
+        drop_node_range_index(self.graph, 'L', 'i')
+        self.assert_column_aggregate(returns, optimized=False)
+
+    def test07_sparse_ids(self):
+        # labeled nodes are spread over a wide range of node IDs
+        self.graph.query("UNWIND range(0, 4999) AS i CREATE (:Other {i: i})")
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:L {i: i, d: i * 0.5})")
+        self.graph.query("MATCH (n:Other) WHERE n.i < 4000 DELETE n")
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:L {i: i, d: i * 0.5})")
+
+        create_node_range_index(self.graph, 'L', 'i', sync=True)
+        self.assert_column_aggregate("count(n.i), sum(n.i), min(n.d), max(n.d)")
+
+class testColumnAggregateDisabled():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.con = self.env.getConnection()
+        self.graph = Graph(self.con, GRAPH_ID)
+
+    def test01_not_optimized(self):
+        # without INDEX_COLUMNS indices don't maintain columns
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:L {i: i})")
+        create_node_range_index(self.graph, 'L', 'i', sync=True)
+
+        q = "MATCH (n:L) RETURN count(n.i), sum(n.i)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Column Aggregate", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[10, 45]])
@@ -372,3 +372,119 @@ class testConcurrentQueryFlow(FlowTestsBase):
 
         loop.run_until_complete(asyncio.wait(tasks))
 
+
+    # concurrent writes, some failing
+    # queued writes against the same graph may share a single lock acquisition
+    # a failing query must only roll back its own changes
+    def test_12_concurrent_write_error_isolation(self):
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+        queries = []
+        for i in range(CLIENT_COUNT):
+            if i % 2 == 0:
+                q = "CREATE (g:group_commit {v: %d}) RETURN g.v" % i
+            else:
+                q = "CREATE (g:group_commit {v: %d}) RETURN g.v / 0" % i
+            queries.append(q)
+
+        results = run_concurrent(queries, thread_run_query)
+        for i, result in enumerate(results):
+            if i % 2 == 0:
+                self.env.assertEqual(result["nodes_created"], 1)
+            else:
+                self.env.assertIn("Division by zero", result)
+
+        res = self.graph.query("MATCH (g:group_commit) RETURN g.v ORDER BY g.v")
+        expected = [[i] for i in range(0, CLIENT_COUNT, 2)]
+        self.env.assertEqual(res.result_set, expected)
+
+    def test_13_concurrent_optimistic_update(self):
+        # MATCH ... SET queries read on reader threads and commit on
+        # validation, conflicting updates must be re-executed and never lost
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.graph.query("CREATE (:counter {v: 0})")
+
+        q = "MATCH (c:counter) SET c.v = c.v + 1 RETURN c.v"
+        queries = [q] * CLIENT_COUNT
+        results = run_concurrent(queries, thread_run_query)
+
+        values = sorted(result["result_set"][0][0] for result in results)
+        self.env.assertEqual(values, list(range(1, CLIENT_COUNT + 1)))
+
+        res = self.graph.query("MATCH (c:counter) RETURN c.v")
+        self.env.assertEqual(res.result_set[0][0], CLIENT_COUNT)
+
+        # introducing a new attribute is deferred to the writer thread
+        q = "MATCH (c:counter) SET c.w = coalesce(c.w, 0) + 1"
+        queries = [q] * CLIENT_COUNT
+        results = run_concurrent(queries, thread_run_query)
+        for result in results:
+            self.env.assertEqual(result["properties_set"], 1)
+
+        res = self.graph.query("MATCH (c:counter) RETURN c.w")
+        self.env.assertEqual(res.result_set[0][0], CLIENT_COUNT)
+
+    # concurrent writes and a read
+    # queued writes may share a single lock acquisition, a group must release
+    # its locks once they were held for a while such that a read issued while
+    # the writes are queued isn't delayed until all of them complete
+    def test_14_group_commit_reader_not_starved(self):
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.graph.query("CREATE (:starve)")
+        pool = Pool(nodes=CLIENT_COUNT)
+
+        Wq = """UNWIND range(0, 20000) AS x CREATE (:starve {v: x})
+                WITH count(x) AS c RETURN 'W', timestamp()"""
+        Rq = "MATCH (n:starve) WITH n LIMIT 1 RETURN 'R', timestamp()"
+
+        # inject a single read query in the middle of the write sequence
+        queries = [Wq] * CLIENT_COUNT * 4
+        queries[CLIENT_COUNT * 2] = Rq
+        nulls = [None] * len(queries)
+
+        results = pool.map(thread_run_query, queries, nulls)
+
+        # count how many writes completed after the read
+        read_ts = results[CLIENT_COUNT * 2]["result_set"][0][1]
+        count = 0
+        for result in results:
+            row = result["result_set"][0]
+            if row[0] == 'W' and row[1] > read_ts:
+                count += 1
+
+        # make sure the read wasn't delayed until the writes depleted
+        self.env.assertGreater(count, 0)
+
+        pool.clear()
+
+    def test_15_concurrent_optimistic_update_disjoint_labels(self):
+        # optimistic writes validate against the labels and relations they
+        # read, updates of other labels don't conflict while updates of the
+        # same label, reached either way, must never be lost
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.graph.query("""CREATE (:counter_a {v: 0}), (:counter_b {v: 0}),
+                            (:anchor)-[:R]->(:counter_c {v: 0})""")
+
+        queries = []
+        for i in range(CLIENT_COUNT):
+            if i % 4 == 0:
+                q = "MATCH (c:counter_a) SET c.v = c.v + 1 RETURN c.v"
+            elif i % 4 == 1:
+                q = "MATCH (c:counter_b) SET c.v = c.v + 1 RETURN c.v"
+            elif i % 4 == 2:
+                q = "MATCH (c:counter_c) SET c.v = c.v + 1 RETURN c.v"
+            else:
+                q = """MATCH (:anchor)-[:R]->(c:counter_c)
+                       SET c.v = c.v + 1 RETURN c.v"""
+            queries.append(q)
+
+        results = run_concurrent(queries, thread_run_query)
+        for result in results:
+            self.env.assertEqual(len(result["result_set"]), 1)
+
+        q = """MATCH (a:counter_a), (b:counter_b), (c:counter_c)
+               RETURN a.v, b.v, c.v"""
+        res = self.graph.query(q)
+        self.env.assertEqual(res.result_set, [[CLIENT_COUNT // 4,
+                                               CLIENT_COUNT // 4,
+                                               CLIENT_COUNT // 2]])
@@ -550,6 +550,60 @@ class testConstraintNodes():
         drop_node_range_index(self.g, "Author", "nickname")
         drop_node_range_index(self.g, "Author", "birthdate")
 
+    def test09_change_aware_enforcement(self):
+        create_unique_node_constraint(self.g, "Band", "name", sync=True)
+        create_mandatory_node_constraint(self.g, "Band", "name", sync=True)
+        self.g.query("CREATE (:Band {name: 'A'}), (:Band {name: 'B'}), (:Musician)")
+
+        # constraints are enforced once all updates are applied
+        # swapping unique values within a single query is allowed
+        self.g.query("""MATCH (a:Band {name: 'A'}), (b:Band {name: 'B'})
+                        SET a.name = 'B', b.name = 'A'""")
+        res = self.g.query("MATCH (b:Band) RETURN b.name ORDER BY b.name").result_set
+        self.env.assertEqual(res, [['A'], ['B']])
+
+        # updating an attribute which isn't constrained
+        res = self.g.query("MATCH (b:Band) SET b.genre = 'rock'")
+        self.env.assertEqual(res.properties_set, 2)
+
+        # modified constrained attribute
+        try:
+            self.g.query("MATCH (b:Band {name: 'A'}) SET b.name = 'B'")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type Band", str(e))
+
+        # removed constrained attribute
+        try:
+            self.g.query("MATCH (b:Band {name: 'A'}) SET b.name = NULL")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("mandatory constraint violation: node with label Band missing property name", str(e))
+
+        # cleared attributes
+        try:
+            self.g.query("MATCH (b:Band {name: 'A'}) SET b = {genre: 'pop'}")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("mandatory constraint violation: node with label Band missing property name", str(e))
+
+        # an added label enforces all of its constraints
+        try:
+            self.g.query("MATCH (m:Musician) SET m:Band")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("mandatory constraint violation: node with label Band missing property name", str(e))
+
+        try:
+            self.g.query("MATCH (m:Musician) SET m:Band, m.name = 'A'")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type Band", str(e))
+
+        self.g.query("MATCH (m:Musician) SET m:Band, m.name = 'C'")
+        res = self.g.query("MATCH (b:Band) RETURN b.name ORDER BY b.name").result_set
+        self.env.assertEqual(res, [['A'], ['B'], ['C']])
+
 class testConstraintEdges():
     def __init__(self):
         self.env = Env(decodeResponses=True)
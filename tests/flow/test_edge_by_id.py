@@ -0,0 +1,116 @@
+from common import *
+
+GRAPH_ID = "edge_by_id"
+
+class testEdgeByIDFlow():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # edges of two relation types between labeled nodes
+        q = """UNWIND range(0, 9) AS i
+               CREATE (:A {i: i})-[:R {i: i}]->(:B {i: i}),
+                      (:B {i: i + 10})-[:S {i: i + 10}]->(:A {i: i + 10})"""
+        self.graph.query(q)
+
+        # make sure edge id attribute matches edge's internal ID
+        self.graph.query("MATCH ()-[e]->() SET e.id = ID(e)")
+
+    def seek(self, q):
+        # returns the result of query q and the same query without the seek
+        plan = str(self.graph.explain(q))
+        self.env.assertIn("Edge By Id Seek", plan)
+
+        expected_q = q.replace("ID(e)", "e.id")
+        plan = str(self.graph.explain(expected_q))
+        self.env.assertNotIn("Edge By Id Seek", plan)
+
+        actual   = self.graph.query(q).result_set
+        expected = self.graph.query(expected_q).result_set
+        self.env.assertEquals(actual, expected)
+        return actual
+
+    def test01_seek(self):
+        # a single edge
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) = 4 RETURN a.i, e.i, b.i"
+        res = self.seek(q)
+        self.env.assertEquals(len(res), 1)
+
+        # ranges
+        for cond in ["ID(e) > 5", "5 < ID(e)", "ID(e) >= 3 AND ID(e) < 12",
+                     "ID(e) <= 7"]:
+            q = f"MATCH (a)-[e]->(b) WHERE {cond} RETURN a.i, e.i, b.i ORDER BY e.i"
+            self.seek(q)
+
+        # missing edges
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) = 1000 RETURN e"
+        self.env.assertEquals(self.seek(q), [])
+
+    def test02_relation_types(self):
+        # only edges of the specified relation types are returned
+        q = "MATCH (a)-[e:R]->(b) WHERE ID(e) >= 0 RETURN type(e), count(e)"
+        self.env.assertEquals(self.seek(q), [['R', 10]])
+
+        q = "MATCH (a)-[e:S|R]->(b) WHERE ID(e) >= 0 RETURN type(e), count(e) ORDER BY type(e)"
+        self.env.assertEquals(self.seek(q), [['R', 10], ['S', 10]])
+
+        q = "MATCH (a)-[e:Z]->(b) WHERE ID(e) >= 0 RETURN count(e)"
+        self.env.assertEquals(self.seek(q), [[0]])
+
+    def test03_endpoint_labels(self):
+        # endpoint labels are enforced
+        q = "MATCH (a:A)-[e]->(b:B) WHERE ID(e) >= 0 RETURN count(e)"
+        self.env.assertEquals(self.seek(q), [[10]])
+
+        q = "MATCH (a:B)-[e]->(b) WHERE ID(e) >= 0 RETURN count(e)"
+        self.env.assertEquals(self.seek(q), [[10]])
+
+        # traversal in the opposite direction
+        q = "MATCH (b:B)<-[e]-(a:A) WHERE ID(e) >= 0 RETURN a.i, b.i ORDER BY a.i"
+        self.seek(q)
+
+    def test04_not_applicable(self):
+        # undirected edges match in both directions
+        q = "MATCH (a)-[e]-(b) WHERE ID(e) = 0 RETURN count(e)"
+        plan = str(self.graph.explain(q))
+        self.env.assertNotIn("Edge By Id Seek", plan)
+        self.env.assertEquals(self.graph.query(q).result_set, [[2]])
+
+        # filter on a node ID isn't used to seek an edge
+        q = "MATCH (a)-[e]->(b) WHERE ID(b) = 1 RETURN count(e)"
+        plan = str(self.graph.explain(q))
+        self.env.assertNotIn("Edge By Id Seek", plan)
+        self.env.assertEquals(self.graph.query(q).result_set, [[1]])
+
+    def test05_delete_by_id(self):
+        q = "MATCH ()-[e]->() WHERE ID(e) = 0 DELETE e"
+        self.env.assertIn("Edge By Id Seek", str(self.graph.explain(q)))
+        res = self.graph.query(q)
+        self.env.assertEquals(res.relationships_deleted, 1)
+
+        q = "MATCH ()-[e]->() RETURN count(e)"
+        self.env.assertEquals(self.graph.query(q).result_set, [[19]])
+
+        # deleted edge is no longer sought
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) <= 1 RETURN ID(e)"
+        self.env.assertEquals(self.graph.query(q).result_set, [[1]])
+
+    def test06_empty_ranges(self):
+        # exclusive upper bound of 0 matches no edge
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) < 0 RETURN e"
+        self.env.assertEquals(self.seek(q), [])
+
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) > 3 AND ID(e) < 2 RETURN e"
+        self.env.assertEquals(self.seek(q), [])
+
+    def test07_graph_growth(self):
+        # cached plans reflect edges created after they were first executed
+        q = "MATCH (a)-[e]->(b) WHERE ID(e) >= 0 RETURN count(e)"
+        before = self.seek(q)[0][0]
+
+        self.graph.query("CREATE (:A)-[:R]->(:B), (:A)-[:R]->(:B)")
+        after = self.graph.query(q).result_set[0][0]
+        self.env.assertEquals(after, before + 2)
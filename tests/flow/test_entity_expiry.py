@@ -0,0 +1,182 @@
+import time
+from common import *
+from index_utils import *
+
+GRAPH_ID = "entity_expiry"
+
+# entities holding an expiration time (ms since epoch) in the configured
+# ENTITY_EXPIRY_ATTRIBUTE are deleted once that time passed
+EXPIRY_ATTRIBUTE = "expires"
+
+def wait_for_count(graph, q, expected, timeout=5):
+    # wait for expiry task to delete entities
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        actual = graph.query(q).result_set[0][0]
+        if actual == expected:
+            return actual
+        time.sleep(0.1)
+    return graph.query(q).result_set[0][0]
+
+class testEntityExpiry():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f"ENTITY_EXPIRY_ATTRIBUTE {EXPIRY_ATTRIBUTE}")
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+    def test01_config(self):
+        res = self.conn.execute_command("GRAPH.CONFIG", "GET", "ENTITY_EXPIRY_ATTRIBUTE")
+        self.env.assertEquals(res, ["ENTITY_EXPIRY_ATTRIBUTE", EXPIRY_ATTRIBUTE])
+
+        # expiry attribute can only be set on load
+        try:
+            self.conn.execute_command("GRAPH.CONFIG", "SET", "ENTITY_EXPIRY_ATTRIBUTE", "ttl")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+    def test02_expire_nodes(self):
+        self.conn.delete(GRAPH_ID)
+
+        # half the nodes expire shortly, others never
+        q = """UNWIND range(0, 99) AS i
+               CREATE (:N {i: i, expires: CASE WHEN i % 2 = 0
+                                          THEN timestamp() + 500
+                                          ELSE timestamp() + 3600000 END})"""
+        self.graph.query(q)
+
+        # nodes without an integer expiration time are kept
+        self.graph.query("CREATE (:N {i: -1}), (:N {i: -2, expires: 'never'})")
+
+        count = wait_for_count(self.graph, "MATCH (n:N) RETURN count(n)", 52)
+        self.env.assertEquals(count, 52)
+
+        q = "MATCH (n:N) WHERE n.i >= 0 AND n.i % 2 = 0 RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], 0)
+
+    def test03_expire_detaches(self):
+        self.conn.delete(GRAPH_ID)
+
+        # expired nodes are deleted along with their edges
+        q = """CREATE (a:A {expires: timestamp() + 200})-[:R]->(b:B),
+                      (b)-[:R]->(:C)"""
+        self.graph.query(q)
+
+        count = wait_for_count(self.graph, "MATCH (a:A) RETURN count(a)", 0)
+        self.env.assertEquals(count, 0)
+
+        q = "MATCH ()-[r:R]->() RETURN count(r)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], 1)
+
+    def test04_expire_edges(self):
+        self.conn.delete(GRAPH_ID)
+
+        q = """UNWIND range(0, 9) AS i
+               CREATE (:A)-[:R {i: i, expires: timestamp() + i * 100}]->(:B)"""
+        self.graph.query(q)
+
+        count = wait_for_count(self.graph, "MATCH ()-[r:R]->() RETURN count(r)", 0)
+        self.env.assertEquals(count, 0)
+
+        # endpoints aren't deleted
+        q = "MATCH (n) RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], 20)
+
+        # multiple relationship types and multiple edges between two nodes
+        q = """CREATE (a:A)-[:R {expires: timestamp() + 100}]->(b:B),
+                      (a)-[:R {expires: timestamp() + 200}]->(b),
+                      (a)-[:R]->(b),
+                      (b)-[:S {expires: timestamp() + 100}]->(a),
+                      (b)-[:S]->(a)"""
+        self.graph.query(q)
+
+        q = "MATCH ()-[r]->() WHERE r.expires IS NOT NULL RETURN count(r)"
+        count = wait_for_count(self.graph, q, 0)
+        self.env.assertEquals(count, 0)
+
+        q = "MATCH (a)-[r]->(b) RETURN labels(a), type(r), labels(b) ORDER BY type(r)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[['A'], 'R', ['B']], [['B'], 'S', ['A']]])
+
+    def test05_update_expiry(self):
+        self.conn.delete(GRAPH_ID)
+
+        q = """UNWIND range(0, 9) AS i
+               CREATE (:N {i: i, expires: timestamp() + 300})"""
+        self.graph.query(q)
+
+        # postpone, remove and advance expiration times
+        self.graph.query("MATCH (n:N) WHERE n.i < 3 SET n.expires = timestamp() + 3600000")
+        self.graph.query("MATCH (n:N) WHERE n.i >= 3 AND n.i < 6 REMOVE n.expires")
+        self.graph.query("CREATE (:N {i: 10, expires: timestamp() + 3600000})")
+        self.graph.query("MATCH (n:N {i: 10}) SET n.expires = 0")
+
+        # rolled back update doesn't postpone expiry
+        try:
+            self.graph.query("""MATCH (n:N) WHERE n.i >= 6
+                                SET n.expires = timestamp() + 3600000
+                                RETURN 1 / 0""")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError:
+            pass
+
+        count = wait_for_count(self.graph, "MATCH (n:N) RETURN count(n)", 6)
+        self.env.assertEquals(count, 6)
+
+        q = "MATCH (n:N) RETURN n.i ORDER BY n.i"
+        res = [row[0] for row in self.graph.query(q).result_set]
+        self.env.assertEquals(res, [0, 1, 2, 3, 4, 5])
+
+    def test06_indexed_entities(self):
+        self.conn.delete(GRAPH_ID)
+
+        # expired entities are removed from indexes
+        self.graph.query("CREATE (:I {v: 1, expires: timestamp() + 200})")
+        create_node_range_index(self.graph, 'I', 'v', sync=True)
+
+        count = wait_for_count(self.graph, "MATCH (n:I) RETURN count(n)", 0)
+        self.env.assertEquals(count, 0)
+
+        q = "MATCH (n:I) WHERE n.v = 1 RETURN count(n)"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Index Scan", plan)
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], 0)
+
+    def test07_persistence(self):
+        self.conn.delete(GRAPH_ID)
+
+        q = "CREATE (:N {expires: timestamp() + 2000}), (:N)"
+        self.graph.query(q)
+
+        # expiration times are restored on load
+        self.env.dumpAndReload()
+
+        count = wait_for_count(self.graph, "MATCH (n:N) RETURN count(n)", 1)
+        self.env.assertEquals(count, 1)
+
+class testEntityExpiryReplication():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, env='oss', useSlaves=True,
+                       moduleArgs=f"ENTITY_EXPIRY_ATTRIBUTE {EXPIRY_ATTRIBUTE}")
+        self.master = self.env.getConnection()
+        self.replica = self.env.getSlaveConnection()
+        self.master_graph = Graph(self.master, GRAPH_ID)
+        self.replica_graph = Graph(self.replica, GRAPH_ID)
+
+    def test01_replicated_expiry(self):
+        q = """UNWIND range(0, 9) AS i
+               CREATE (:N {i: i, expires: timestamp() + 300})-[:R]->(:M)"""
+        self.master_graph.query(q)
+        self.master.wait(1, 0)
+
+        count = wait_for_count(self.master_graph, "MATCH (n:N) RETURN count(n)", 0)
+        self.env.assertEquals(count, 0)
+
+        # deletions are replicated
+        self.master.wait(1, 0)
+        q = "MATCH (n) OPTIONAL MATCH (n)-[r]->() RETURN count(n), count(r)"
+        master_res  = self.master_graph.query(q).result_set
+        replica_res = self.replica_graph.query(q, read_only=True).result_set
+        self.env.assertEquals(master_res, [[10, 0]])
+        self.env.assertEquals(replica_res, master_res)
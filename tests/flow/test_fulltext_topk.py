@@ -0,0 +1,72 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "fulltext_topk"
+
+class testFulltextTopK():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        create_node_fulltext_index(self.graph, 'L', 'v', sync=True)
+
+        # term frequency varies across documents, producing different scores
+        q = """UNWIND range(1, 200) AS i
+               CREATE (:L {i: i, v: reduce(s = 'fox', x IN range(1, i % 17) | s + ' fox') + ' dog'})"""
+        self.graph.query(q)
+
+    def expected(self, q):
+        # evaluate q without pushing the limit into the procedure
+        q = q.replace("YIELD node, score", "YIELD node, score WITH node, score WHERE true")
+        return self.graph.query(q).result_set
+
+    def profile(self, q):
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        return [x[0:x.index(',')].strip() for x in profile]
+
+    def scores(self, rows):
+        return [row[1] for row in rows]
+
+    def test01_top_k(self):
+        for k in [1, 5, 17, 200, 500]:
+            q = f"""CALL db.idx.fulltext.queryNodes('L', 'fox') YIELD node, score
+                    RETURN node.i, score ORDER BY score DESC LIMIT {k}"""
+            actual = self.graph.query(q).result_set
+            expected = self.expected(q)
+            self.env.assertEquals(len(actual), min(k, 200))
+            # ties might be ordered differently, compare scores
+            self.env.assertEquals(self.scores(actual), self.scores(expected))
+
+    def test02_skip(self):
+        q = """CALL db.idx.fulltext.queryNodes('L', 'fox') YIELD node, score
+               RETURN node.i, score ORDER BY score DESC SKIP 10 LIMIT 5"""
+        actual = self.graph.query(q).result_set
+        expected = self.expected(q)
+        self.env.assertEquals(len(actual), 5)
+        self.env.assertEquals(self.scores(actual), self.scores(expected))
+
+    def test03_records_produced(self):
+        # procedure produces only the required rows
+        q = """CALL db.idx.fulltext.queryNodes('L', 'fox') YIELD node, score
+               RETURN node.i, score ORDER BY score DESC LIMIT 3"""
+        plan = self.profile(q)
+        self.env.assertIn("ProcedureCall | Records produced: 3", plan)
+
+        # ascending order consumes all rows
+        q = """CALL db.idx.fulltext.queryNodes('L', 'fox') YIELD node, score
+               RETURN node.i, score ORDER BY score LIMIT 3"""
+        plan = self.profile(q)
+        self.env.assertIn("ProcedureCall | Records produced: 200", plan)
+
+    def test04_per_record_invocation(self):
+        # procedure invoked once per input record
+        q = """UNWIND range(1, 3) AS x
+               CALL db.idx.fulltext.queryNodes('L', 'fox') YIELD node, score
+               RETURN x, score ORDER BY score DESC LIMIT 4"""
+        actual = self.graph.query(q).result_set
+        expected = self.expected(q)
+        self.env.assertEquals(len(actual), 4)
+        self.env.assertEquals(self.scores(actual), self.scores(expected))
@@ -0,0 +1,142 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "hybrid_query"
+
+# rank constant of reciprocal rank fusion
+RRF_K = 60
+
+class testHybridQuery():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 'fox' frequency decreases with i, 'dog' is the most frequent term
+        # such that full-text scores are distinct
+        # embeddings are distinct and ordered differently
+        q = """UNWIND range(0, 19) AS i
+               CREATE (:Doc {i: i,
+                       text: reduce(s = 'dog dog dog dog dog dog dog dog dog dog',
+                                    x IN range(1, 9 - i) | s + ' fox'),
+                       embedding: vector32f([(i * 7) % 20, 0])})"""
+        self.graph.query(q)
+
+        create_node_fulltext_index(self.graph, 'Doc', 'text')
+        create_node_vector_index(self.graph, 'Doc', 'embedding', dim=2)
+        wait_for_indices_to_sync(self.graph)
+
+    def hybrid(self, k, fusion=None, alpha=None, suffix="RETURN node.i, score"):
+        args = "label: 'Doc', query: 'fox', attribute: 'embedding', vector: vector32f([0, 0]), k: $k"
+        if fusion is not None:
+            args += f", fusion: '{fusion}'"
+        if alpha is not None:
+            args += f", alpha: {alpha}"
+        q = f"CALL db.idx.hybrid.queryNodes({{{args}}}) YIELD node, score {suffix}"
+        return self.graph.query(q, params={'k': k}).result_set
+
+    def expected(self, k, fusion='RRF', alpha=0.5):
+        # fuse the rankings of the individual indexes
+        q = """CALL db.idx.fulltext.queryNodes('Doc', 'fox') YIELD node, score
+               RETURN node.i, score ORDER BY score DESC LIMIT $k"""
+        text = self.graph.query(q, params={'k': k}).result_set
+
+        q = """CALL db.idx.vector.query({type: 'NODE', label: 'Doc',
+               attribute: 'embedding', query: vector32f([0, 0]), k: $k})
+               YIELD entity, score RETURN entity.i, score ORDER BY score"""
+        vec = self.graph.query(q, params={'k': k}).result_set
+
+        def normalize(score, lo, hi):
+            return 1 if lo == hi else (score - lo) / (hi - lo)
+
+        fused = {}
+        for rank, (i, score) in enumerate(text):
+            if fusion == 'RRF':
+                score = 1 / (RRF_K + rank + 1)
+            else:
+                score = alpha * normalize(score, text[-1][1], text[0][1])
+            fused[i] = fused.get(i, 0) + score
+
+        for rank, (i, score) in enumerate(vec):
+            if fusion == 'RRF':
+                score = 1 / (RRF_K + rank + 1)
+            else:
+                score = (1 - alpha) * normalize(-score, -vec[-1][1], -vec[0][1])
+            fused[i] = fused.get(i, 0) + score
+
+        # node IDs match i, ties are ordered by ID
+        fused = sorted(fused.items(), key=lambda x: (-x[1], x[0]))[:k]
+        return [[i, round(score, 9)] for i, score in fused]
+
+    def rounded(self, rows):
+        return [[i, round(score, 9)] for i, score in rows]
+
+    def test01_rrf(self):
+        for k in [1, 3, 5, 20]:
+            actual = self.hybrid(k)
+            self.env.assertEquals(self.rounded(actual), self.expected(k))
+
+        # explicit fusion method
+        self.env.assertEquals(self.rounded(self.hybrid(5, 'rrf')), self.expected(5))
+
+    def test02_weighted(self):
+        for alpha in [0, 0.3, 0.5, 1]:
+            actual = self.hybrid(5, 'WEIGHTED', alpha)
+            self.env.assertEquals(self.rounded(actual),
+                                  self.expected(5, 'WEIGHTED', alpha))
+
+    def test03_limit(self):
+        # limit is pushed into the procedure
+        q = """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 10})
+               YIELD node, score RETURN node.i, score ORDER BY score DESC LIMIT 2"""
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("ProcedureCall | Records produced: 2", profile)
+
+        actual = self.graph.query(q).result_set
+        self.env.assertEquals(self.rounded(actual), self.expected(10)[:2])
+
+    def test04_invalid_arguments(self):
+        queries = [
+            # missing query vector
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', k: 3})""",
+            # unknown argument
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 3, x: 1})""",
+            # unknown fusion method
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 3,
+               fusion: 'max'})""",
+            # alpha out of range
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 3,
+               alpha: 2})""",
+            # non positive k
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 0})""",
+            # k beyond the supported range
+            """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'embedding', vector: vector32f([0, 0]), k: 10000000000})""",
+        ]
+
+        for q in queries:
+            try:
+                self.graph.query(q)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError as e:
+                self.env.assertIn("Invalid arguments for procedure", str(e))
+
+    def test05_missing_index(self):
+        # vector attribute isn't indexed
+        self.graph.query("CREATE (:Doc {other: vector32f([0, 0])})")
+        q = """CALL db.idx.hybrid.queryNodes({label: 'Doc', query: 'fox',
+               attribute: 'other', vector: vector32f([0, 0]), k: 3})"""
+        try:
+            self.graph.query(q)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Hybrid query requires a full-text index", str(e))
@@ -741,3 +741,124 @@ class testIndexScanFlow():
         self.env.assertIn('Boaz Arad', names)
         self.env.assertIn('Valerie Abigail Arad', names)
 
+
+    def test_25_traversal_destination_index_mask(self):
+        # filters on an indexed traversal destination are resolved
+        # into a mask applied while traversing
+        g = Graph(self.env.getConnection(), 'destination_mask')
+
+        g.query("""UNWIND range(0, 9) AS i
+                   CREATE (:A {v: i})-[:R]->(:B {v: i}),
+                          (:A {v: i})-[:R]->(:C {v: i})""")
+        create_node_range_index(g, 'B', 'v', sync=True)
+
+        q = """MATCH (a:A) WITH a
+               MATCH (a)-[:R]->(b:B)
+               WHERE b.v > 5
+               RETURN b.v ORDER BY b.v"""
+        plan = g.execution_plan(q)
+        self.env.assertIn('(index mask)', plan)
+        # filter is still applied after the traversal
+        self.env.assertIn('Filter', plan)
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[6], [7], [8], [9]])
+
+        # parameterized filter
+        q = """MATCH (a:A) WITH a
+               MATCH (a)-[:R]->(b:B)
+               WHERE b.v IN $vs
+               RETURN b.v ORDER BY b.v"""
+        plan = g.execution_plan(q, {'vs': [1, 3]})
+        self.env.assertIn('(index mask)', plan)
+        result = g.query(q, {'vs': [1, 3]}).result_set
+        self.env.assertEqual(result, [[1], [3]])
+
+        # filter referring to the traversal's source can't be masked
+        q = """MATCH (a:A) WITH a
+               MATCH (a)-[:R]->(b:B)
+               WHERE b.v = a.v
+               RETURN count(b)"""
+        plan = g.execution_plan(q)
+        self.env.assertNotIn('(index mask)', plan)
+        self.env.assertEqual(g.query(q).result_set, [[10]])
+
+        # destination without an index
+        q = """MATCH (a:A) WITH a
+               MATCH (a)-[:R]->(c:C)
+               WHERE c.v > 5
+               RETURN count(c)"""
+        plan = g.execution_plan(q)
+        self.env.assertNotIn('(index mask)', plan)
+        self.env.assertEqual(g.query(q).result_set, [[4]])
+
+        # index updates are reflected in subsequent executions
+        g.query("MATCH (b:B {v: 0}) SET b.v = 100")
+        q = """MATCH (a:A) WITH a
+               MATCH (a)-[:R]->(b:B)
+               WHERE b.v > 50
+               RETURN b.v"""
+        self.env.assertEqual(g.query(q).result_set, [[100]])
+
+    def test_26_batched_index_lookups(self):
+        # index scans consuming from a child look up the values of
+        # multiple input records with a single index query
+        g = Graph(self.env.getConnection(), 'batched_lookups')
+
+        g.query("""UNWIND range(0, 2999) AS i
+                   CREATE (:L {v: i, s: 'k' + toString(i % 100)})""")
+        g.query("""MATCH (a:L), (b:L) WHERE b.v = a.v + 1 AND a.v < 10
+                   CREATE (a)-[:R {w: a.v}]->(b)""")
+        create_node_range_index(g, 'L', 'v', 's', sync=True)
+        create_edge_range_index(g, 'R', 'w', sync=True)
+
+        # more input records than a single batch holds
+        q = """UNWIND range(0, 3999) AS x
+               MATCH (n:L {v: x})
+               RETURN count(n), sum(n.v)"""
+        plan = g.execution_plan(q)
+        self.env.assertIn('Node By Index Scan', plan)
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[3000, sum(range(3000))]])
+
+        # records are emitted in input order
+        q = """UNWIND [5, 3, 5, 1] AS x
+               MATCH (n:L {v: x})
+               RETURN x, n.v"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[5, 5], [3, 3], [5, 5], [1, 1]])
+
+        # each string value matches multiple nodes
+        q = """UNWIND ['k1', 'k2', 'missing'] AS x
+               MATCH (n:L) WHERE n.s = x
+               RETURN x, count(n) ORDER BY x"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [['k1', 30], ['k2', 30]])
+
+        # equal numeric values of different types, nulls and
+        # values which can't be batched
+        q = """UNWIND [1, 1.0, null, 2.5, [1], 'x', true] AS x
+               MATCH (n:L) WHERE n.v = x
+               RETURN n.v"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[1], [1]])
+
+        # additional filter shared by all input records
+        q = """UNWIND range(0, 99) AS x
+               MATCH (n:L) WHERE n.v = x AND n.s = 'k7'
+               RETURN n.v"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[7]])
+
+        # edges looked up by attribute
+        q = """UNWIND range(0, 20) AS x
+               MATCH (a)-[e:R]->(b) WHERE e.w = x
+               RETURN count(e), sum(b.v - a.v)"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[10, 10]])
+
+        # edges looked up by a resolved endpoint
+        q = """MATCH (a:L) WHERE a.v < 20 WITH a
+               MATCH (a)-[e:R]->(b) WHERE e.w >= 0
+               RETURN count(e)"""
+        result = g.query(q).result_set
+        self.env.assertEqual(result, [[10]])
@@ -0,0 +1,122 @@
+from common import *
+
+GRAPH_ID = "leapfrog_join"
+
+# leapfrog join binds a node closing a cycle, e.g. 'c' in
+# (a)-[:R]->(b)-[:R]->(c)-[:R]->(a) by intersecting the adjacency lists of
+# 'b' and 'a' instead of traversing from 'b' and expanding into 'a'
+# results are compared against the same pattern split by a WITH clause
+# which keeps the traverse and expand-into plan
+
+class testLeapfrogJoin():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.con = self.env.getConnection()
+        self.graph = Graph(self.con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # 30 nodes, every third labeled L, connected by a handful of
+        # deterministic "random" edges
+        q = """UNWIND range(0, 29) AS i
+               CREATE (:N {v: i})"""
+        self.graph.query(q)
+
+        q = """MATCH (n:N) WHERE n.v % 3 = 0 SET n:L"""
+        self.graph.query(q)
+
+        q = """MATCH (a:N), (b:N)
+               WHERE b.v = (a.v * 7 + 3) % 30 OR b.v = (a.v * 11 + 5) % 30
+               OR b.v = (a.v + 1) % 30 OR b.v = (a.v * 13) % 30
+               CREATE (a)-[:R]->(b)"""
+        self.graph.query(q)
+
+        # a few more edges which remain pending in the delta matrices
+        q = """MATCH (a:N), (b:N)
+               WHERE b.v = (a.v * 17 + 2) % 30 AND a.v < 10
+               CREATE (a)-[:R]->(b)"""
+        self.graph.query(q)
+
+    def assert_join(self, query, reference, join_count=1):
+        plan = self.graph.execution_plan(query)
+        self.env.assertEquals(plan.count("Leapfrog Join"), join_count)
+
+        actual   = self.graph.query(query).result_set
+        expected = self.graph.query(reference).result_set
+        self.env.assertEquals(sorted(actual), sorted(expected))
+        return actual
+
+    def test01_triangle(self):
+        q = """MATCH (a)-[:R]->(b)-[:R]->(c)-[:R]->(a)
+               RETURN a.v, b.v, c.v"""
+        ref = """MATCH (a)-[:R]->(b)-[:R]->(c) WITH a, b, c
+                 MATCH (c)-[:R]->(a) RETURN a.v, b.v, c.v"""
+        res = self.assert_join(q, ref)
+        self.env.assertGreater(len(res), 0)
+
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Expand Into", plan)
+
+    def test02_four_cycle(self):
+        q = """MATCH (a)-[:R]->(b)-[:R]->(c)-[:R]->(d)-[:R]->(a)
+               RETURN a.v, b.v, c.v, d.v"""
+        ref = """MATCH (a)-[:R]->(b)-[:R]->(c)-[:R]->(d) WITH a, b, c, d
+                 MATCH (d)-[:R]->(a) RETURN a.v, b.v, c.v, d.v"""
+        res = self.assert_join(q, ref)
+        self.env.assertGreater(len(res), 0)
+
+    def test03_directions(self):
+        q = """MATCH (a)<-[:R]-(b)-[:R]->(c)<-[:R]-(a)
+               RETURN a.v, b.v, c.v"""
+        ref = """MATCH (a)<-[:R]-(b)-[:R]->(c) WITH a, b, c
+                 MATCH (c)<-[:R]-(a) RETURN a.v, b.v, c.v"""
+        self.assert_join(q, ref)
+
+    def test04_labeled_joined_node(self):
+        q = """MATCH (a)-[:R]->(b)-[:R]->(c:L)-[:R]->(a)
+               RETURN a.v, b.v, c.v"""
+        ref = """MATCH (a)-[:R]->(b)-[:R]->(c:L) WITH a, b, c
+                 MATCH (c)-[:R]->(a) RETURN a.v, b.v, c.v"""
+        res = self.assert_join(q, ref)
+        for row in res:
+            self.env.assertEquals(row[2] % 3, 0)
+
+    def test05_clique(self):
+        # 'd' is connected to three bound nodes
+        q = """MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c),
+               (a)-[:R]->(d), (b)-[:R]->(d), (c)-[:R]->(d)
+               RETURN a.v, b.v, c.v, d.v"""
+        ref = """MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c) WITH a, b, c
+                 MATCH (a)-[:R]->(d) WITH a, b, c, d
+                 MATCH (b)-[:R]->(d), (c)-[:R]->(d)
+                 RETURN a.v, b.v, c.v, d.v"""
+        actual   = self.graph.query(q).result_set
+        expected = self.graph.query(ref).result_set
+        self.env.assertEquals(sorted(actual), sorted(expected))
+
+    def test06_missing_relationship(self):
+        q = """MATCH (a)-[:R]->(b)-[:R]->(c)-[:MISSING]->(a)
+               RETURN a.v, b.v, c.v"""
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Leapfrog Join", plan)
+        self.env.assertEquals(self.graph.query(q).result_set, [])
+
+    def test07_referenced_edges(self):
+        # referenced edges must be bound, keep traversing and expanding into
+        q = """MATCH (a)-[x:R]->(b)-[y:R]->(c)-[z:R]->(a)
+               RETURN a.v, b.v, c.v, type(x), type(y), type(z)"""
+        plan = self.graph.execution_plan(q)
+        self.env.assertNotIn("Leapfrog Join", plan)
+        self.env.assertIn("Expand Into", plan)
+
+    def test08_bound_by_optional_match(self):
+        q = """MATCH (a:L) OPTIONAL MATCH (a)-[:R]->(b:L)
+               WITH a, b
+               MATCH (b)-[:R]->(c)-[:R]->(a)
+               RETURN a.v, b.v, c.v"""
+        ref = """MATCH (a:L) OPTIONAL MATCH (a)-[:R]->(b:L)
+                 WITH a, b
+                 MATCH (b)-[:R]->(c) WITH a, b, c
+                 MATCH (c)-[:R]->(a)
+                 RETURN a.v, b.v, c.v"""
+        self.assert_join(q, ref)
@@ -0,0 +1,124 @@
+import os
+import tempfile
+from common import *
+
+graph = None
+GRAPH_ID = "load_csv"
+IMPORT_FOLDER = tempfile.mkdtemp()
+
+def write_csv(name, content):
+    path = os.path.join(IMPORT_FOLDER, name)
+    with open(path, 'w') as f:
+        f.write(content)
+    return 'file://' + name
+
+class testLoadCSV():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs='IMPORT_FOLDER ' + IMPORT_FOLDER + '/')
+        global graph
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, GRAPH_ID)
+
+    def test01_rows_as_lists(self):
+        uri = write_csv('rows.csv', 'a,b,c\n1,2,3\n')
+        q = "LOAD CSV FROM $uri AS row RETURN row"
+        res = graph.query(q, {'uri': uri}).result_set
+        self.env.assertEquals(res, [[['a', 'b', 'c']], [['1', '2', '3']]])
+
+    def test02_with_headers(self):
+        uri = write_csv('headers.csv', 'name,age\nAlice,32\nBob,\n')
+        q = """LOAD CSV WITH HEADERS FROM $uri AS row
+               RETURN row.name, row.age ORDER BY row.name"""
+        res = graph.query(q, {'uri': uri}).result_set
+        self.env.assertEquals(res, [['Alice', '32'], ['Bob', None]])
+
+    def test03_field_terminator(self):
+        uri = write_csv('semicolon.csv', 'x;y\r\nz;w\r\n')
+        q = "LOAD CSV FROM $uri AS row FIELDTERMINATOR ';' RETURN row"
+        res = graph.query(q, {'uri': uri}).result_set
+        self.env.assertEquals(res, [[['x', 'y']], [['z', 'w']]])
+
+    def test04_quoted_fields(self):
+        uri = write_csv('quoted.csv', '"a,b","say ""hi""","multi\nline"\n')
+        q = "LOAD CSV FROM $uri AS row RETURN row"
+        res = graph.query(q, {'uri': uri}).result_set
+        self.env.assertEquals(res, [[['a,b', 'say "hi"', 'multi\nline']]])
+
+    def test05_create_from_csv(self):
+        uri = write_csv('people.csv', 'id,name\n1,a\n2,b\n3,c\n')
+        q = """LOAD CSV WITH HEADERS FROM $uri AS row
+               CREATE (:Person {id: toInteger(row.id), name: row.name})"""
+        res = graph.query(q, {'uri': uri})
+        self.env.assertEquals(res.nodes_created, 3)
+
+        q = "MATCH (p:Person) RETURN p.id, p.name ORDER BY p.id"
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [[1, 'a'], [2, 'b'], [3, 'c']])
+
+    def test06_per_record_uri(self):
+        write_csv('f1.csv', '1\n2\n')
+        write_csv('f2.csv', '3\n')
+        q = """UNWIND ['file://f1.csv', 'file://f2.csv'] AS uri
+               LOAD CSV FROM uri AS row
+               RETURN uri, row[0] ORDER BY row[0]"""
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [['file://f1.csv', '1'],
+                                    ['file://f1.csv', '2'],
+                                    ['file://f2.csv', '3']])
+
+    def test07_large_file(self):
+        # file spans multiple read blocks and is parsed by several threads
+        n = 500000
+        lines = ['%d,"value %d",%d' % (i, i, i * 2) for i in range(n)]
+        uri = write_csv('large.csv', '\n'.join(lines) + '\n')
+        q = """LOAD CSV FROM $uri AS row
+               RETURN count(row), sum(toInteger(row[0])),
+               max(toInteger(row[2]))"""
+        res = graph.query(q, {'uri': uri}).result_set
+        self.env.assertEquals(res, [[n, n * (n - 1) // 2, (n - 1) * 2]])
+
+    def test08_invalid_uri(self):
+        queries = ["LOAD CSV FROM 'http://example.com/a.csv' AS row RETURN row",
+                   "LOAD CSV FROM 'file://../../etc/passwd' AS row RETURN row",
+                   "LOAD CSV FROM 'file://missing.csv' AS row RETURN row"]
+        for q in queries:
+            try:
+                graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains("LOAD CSV", str(e))
+
+    def test09_invalid_field_terminator(self):
+        try:
+            graph.query("LOAD CSV FROM 'file://rows.csv' AS row FIELDTERMINATOR ';;' RETURN row")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("field terminator", str(e))
+
+    def test10_malformed_csv(self):
+        uri = write_csv('malformed.csv', 'a,b"c\n')
+        try:
+            graph.query("LOAD CSV FROM $uri AS row RETURN row", {'uri': uri})
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("LOAD CSV", str(e))
+
+class testLoadCSVSingleThread():
+    def __init__(self):
+        # the query occupies the only reader thread
+        # parsing tasks must not wait on a free worker
+        self.env = Env(decodeResponses=True,
+                       moduleArgs='THREAD_COUNT 1 IMPORT_FOLDER ' + IMPORT_FOLDER + '/')
+        global graph
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, GRAPH_ID)
+
+    def test01_large_file(self):
+        n = 500000
+        lines = ['%d,%d' % (i, i * 2) for i in range(n)]
+        uri = write_csv('single.csv', '\n'.join(lines) + '\n')
+        q = """LOAD CSV FROM $uri AS row
+               RETURN count(row), sum(toInteger(row[0]))"""
+        res = graph.query(q, {'uri': uri}, read_only=True).result_set
+        self.env.assertEquals(res, [[n, n * (n - 1) // 2]])
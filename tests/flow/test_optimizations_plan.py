@@ -542,3 +542,145 @@ class testOptimizationsPlan(FlowTestsBase):
         # labels with label `M`
         self.env.assertIn("Node By Label Scan | (n:N)", plan)
         self.env.assertIn("Conditional Traverse | (n:M)->(n:M)", plan)
+
+    def test32_factorize_counted_traversal(self):
+        """Tests that a traversal feeding a count aggregation emits a neighbor
+        count per source node instead of a record per neighbor"""
+
+        # clean db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("""UNWIND range(0, 9) AS i
+                       CREATE (:A {v: i % 3})-[:R]->(b:B {v: i})
+                       WITH b, i
+                       UNWIND range(0, i) AS j
+                       CREATE (b)-[:S]->(:C {v: j})""")
+
+        # counting the last traversal's destination is factorized
+        queries = [
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, count(c) ORDER BY a.v",
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, count(*) ORDER BY a.v",
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, count(c), count(*) AS x ORDER BY a.v",
+        ]
+        expected = [[0, 22], [1, 15], [2, 18]]
+
+        for q in queries:
+            plan = graph.execution_plan(q)
+            self.env.assertIn("(factorized)", plan)
+            res = graph.query(q)
+            self.env.assertEquals(len(res.result_set), 3)
+            for row, exp in zip(res.result_set, expected):
+                self.env.assertEquals(row[:2], exp)
+
+        # no grouping key
+        q = "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN count(c)"
+        self.env.assertIn("(factorized)", graph.execution_plan(q))
+        self.env.assertEquals(graph.query(q).result_set, [[55]])
+
+        # no destinations at all
+        q = "MATCH (a:A)-[:R]->(b)-[:S]->(c) WHERE a.v > 10 RETURN count(c)"
+        self.env.assertEquals(graph.query(q).result_set, [[0]])
+
+        # destination used beyond counting, traversal isn't factorized
+        queries = [
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, count(DISTINCT c)",
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, sum(c.v)",
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN c.v, count(c)",
+            "MATCH (a:A)-[:R]->(b)-[e:S]->(c) RETURN a.v, count(e)",
+            "MATCH (a:A)-[:R]->(b)-[:S]->(c) RETURN a.v, count(c), collect(c.v)",
+        ]
+        for q in queries:
+            plan = graph.execution_plan(q)
+            self.env.assertNotIn("(factorized)", plan)
+
+    def test33_common_subexpressions(self):
+        """Tests that repeated expressions evaluated once per record produce
+        the same results as evaluating each occurrence"""
+
+        # clean db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("""UNWIND range(0, 9) AS i
+                       CREATE (:P {price: i, qty: i + 1, name: 'Item' + i})""")
+
+        # expression shared by a filter and a projection
+        q = """MATCH (n:P) WHERE n.price * n.qty > 50
+               RETURN n.price * n.qty AS total ORDER BY total"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[56], [72], [90]])
+
+        # expression shared by multiple filters and projected twice
+        q = """MATCH (n:P)
+               WHERE toLower(n.name) STARTS WITH 'item' AND
+                     toLower(n.name) <> 'item3' AND n.price < 5
+               RETURN toLower(n.name), toUpper(toLower(n.name))
+               ORDER BY toLower(n.name)"""
+        res = graph.query(q)
+        expected = [['item0', 'ITEM0'], ['item1', 'ITEM1'], ['item2', 'ITEM2'],
+                    ['item4', 'ITEM4']]
+        self.env.assertEquals(res.result_set, expected)
+
+        # expression shared by a grouping key and an aggregation
+        q = """MATCH (n:P) WHERE n.price % 3 <> 1
+               RETURN n.price % 3 AS k, sum(n.price % 3), count(n)
+               ORDER BY k"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[0, 0, 4], [2, 6, 3]])
+
+        # shared expression evaluated per traversed record
+        graph.query("""MATCH (a:P {price: 0}), (b:P) WHERE b.price > 6
+                       CREATE (a)-[:R]->(b)""")
+        q = """MATCH (a:P)-[:R]->(b) WHERE a.qty + b.qty > 9
+               RETURN a.qty + b.qty, b.price ORDER BY b.price"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[10, 8], [11, 9]])
+
+        # non-deterministic expressions are evaluated per occurrence
+        q = """UNWIND range(0, 99) AS i WITH rand() AS a, rand() AS b
+               WHERE a = b RETURN count(1)"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[0]])
+
+    def test34_common_subexpressions_across_segments(self):
+        """Tests repeated expressions evaluated by a WITH projection, whose
+        records are built by the previous segment"""
+
+        # clean db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("""UNWIND range(0, 9) AS i
+                       CREATE (:P {price: i, qty: i + 1})""")
+
+        # expression projected twice by WITH
+        q = """MATCH (n:P)
+               WITH n.price * n.qty AS x, n.price * n.qty AS y
+               RETURN x, y ORDER BY x"""
+        res = graph.query(q)
+        expected = [[i * (i + 1), i * (i + 1)] for i in range(10)]
+        self.env.assertEquals(res.result_set, expected)
+
+        # expression shared by a filter and a WITH projection
+        q = """MATCH (n:P) WHERE n.price * n.qty > 50
+               WITH n.price * n.qty AS total, n
+               WHERE total < 90
+               RETURN total, n.price ORDER BY total"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[56, 7], [72, 8]])
+
+        # expression repeated within WITH ... WHERE and the following RETURN
+        q = """MATCH (n:P)
+               WITH n, n.price + n.qty AS s
+               WHERE n.price + n.qty > 15 AND n.price + n.qty < 19
+               RETURN n.price + n.qty, n.price + n.qty, s ORDER BY s"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[17, 17, 17]])
+
+        # aggregating WITH
+        q = """MATCH (n:P)
+               WITH n.price % 3 AS k, sum(n.price % 3) AS total
+               RETURN k, total ORDER BY k"""
+        res = graph.query(q)
+        self.env.assertEquals(res.result_set, [[0, 0], [1, 3], [2, 6]])
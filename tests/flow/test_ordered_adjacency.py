@@ -0,0 +1,238 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "ordered_adjacency"
+
+# number of posts by the first user
+POST_COUNT = 100
+
+# number of followers of the first user
+FAN_COUNT = 30
+
+class testOrderedAdjacency():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs="ORDERED_ADJACENCY yes")
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        self.graph.query("CREATE (:User {id: 0}), (:User {id: 1}), (:User {id: 2})")
+
+        # distinct timestamps, posts are created out of timestamp order
+        # odd posts are drafts
+        q = """MATCH (u:User {id: 0})
+               UNWIND range(0, $n - 1, 2) AS i
+               CREATE (u)-[:POSTED {ts: (i * 37) % $n}]->(:Post {i: i})"""
+        self.graph.query(q, params={'n': POST_COUNT})
+
+        q = """MATCH (u:User {id: 0})
+               UNWIND range(1, $n - 1, 2) AS i
+               CREATE (u)-[:POSTED {ts: (i * 37) % $n}]->(:Draft {i: i})"""
+        self.graph.query(q, params={'n': POST_COUNT})
+
+        # floating point timestamps
+        q = """MATCH (u:User {id: 1})
+               UNWIND range(1000, 1049) AS i
+               CREATE (u)-[:POSTED {ts: i * 1.5}]->(:Post {i: i})"""
+        self.graph.query(q)
+
+        q = """MATCH (u:User {id: 0})
+               UNWIND range(0, $n - 1) AS i
+               CREATE (:Fan {i: i})-[:FOLLOWS {ts: (i * 7) % $n}]->(u)"""
+        self.graph.query(q, params={'n': FAN_COUNT})
+
+        create_edge_range_index(self.graph, 'POSTED', 'ts', sync=True)
+        create_edge_range_index(self.graph, 'FOLLOWS', 'ts', sync=True)
+
+    def latest(self, pattern, order, k, skip=0):
+        # compare against the same query sorted by an additional key
+        # which doesn't utilize the ordered traversal
+        q = f"""MATCH {pattern}
+                RETURN p.i, r.ts ORDER BY r.ts {order} SKIP {skip} LIMIT {k}"""
+        plan = str(self.graph.explain(q))
+        self.env.assertIn("Ordered Traverse", plan)
+
+        expected_q = q.replace(f"ORDER BY r.ts {order}",
+                               f"ORDER BY r.ts {order}, p.i")
+        plan = str(self.graph.explain(expected_q))
+        self.env.assertNotIn("Ordered Traverse", plan)
+
+        actual   = self.graph.query(q).result_set
+        expected = self.graph.query(expected_q).result_set
+        self.env.assertEquals(actual, expected)
+        return actual
+
+    def test01_latest(self):
+        pattern = "(u:User {id: 0})-[r:POSTED]->(p)"
+        for order in ["DESC", "ASC"]:
+            for k in [1, 5, 20]:
+                res = self.latest(pattern, order, k)
+                self.env.assertEquals(len(res), k)
+
+        res = self.latest(pattern, "DESC", 10, skip=5)
+        self.env.assertEquals(len(res), 10)
+
+        # more edges requested than available
+        res = self.latest(pattern, "DESC", POST_COUNT + 10)
+        self.env.assertEquals(len(res), POST_COUNT)
+
+        # floating point values
+        res = self.latest("(u:User {id: 1})-[r:POSTED]->(p)", "DESC", 5)
+        self.env.assertEquals(len(res), 5)
+
+        # multiple sources
+        res = self.latest("(u:User)-[r:POSTED]->(p)", "DESC", 10)
+        self.env.assertEquals(len(res), 10)
+
+        # source without edges
+        res = self.latest("(u:User {id: 2})-[r:POSTED]->(p)", "DESC", 10)
+        self.env.assertEquals(len(res), 0)
+
+    def test02_destination_labels(self):
+        res = self.latest("(u:User {id: 0})-[r:POSTED]->(p:Post)", "DESC", 10)
+        self.env.assertEquals(len(res), 10)
+        for row in res:
+            self.env.assertEquals(row[0] % 2, 0)
+
+    def test03_incoming(self):
+        pattern = "(u:User {id: 0})<-[r:FOLLOWS]-(p)"
+        for order in ["DESC", "ASC"]:
+            res = self.latest(pattern, order, 5)
+            self.env.assertEquals(len(res), 5)
+
+    def test04_records_produced(self):
+        # only the latest edges are traversed
+        q = """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY r.ts DESC LIMIT 3"""
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        ops = [x for x in profile if x.startswith("Ordered Traverse")]
+        self.env.assertEquals(len(ops), 1)
+        self.env.assertTrue(ops[0].endswith("Records produced: 3"))
+
+    def test05_updates(self):
+        pattern = "(u:User {id: 0})-[r:POSTED]->(p)"
+
+        # move an edge to the top
+        q = "MATCH (:User {id: 0})-[r:POSTED]->(p {i: 3}) SET r.ts = 1000"
+        self.graph.query(q)
+        res = self.latest(pattern, "DESC", 5)
+        self.env.assertEquals(res[0], [3, 1000])
+
+        # move it to the bottom
+        q = "MATCH (:User {id: 0})-[r:POSTED]->(p {i: 3}) SET r.ts = -1"
+        self.graph.query(q)
+        res = self.latest(pattern, "ASC", 5)
+        self.env.assertEquals(res[0], [3, -1])
+
+        # delete the latest edge
+        q = "MATCH (:User {id: 0})-[r:POSTED]->(p) WITH r ORDER BY r.ts DESC LIMIT 1 DELETE r"
+        self.graph.query(q)
+        self.latest(pattern, "DESC", 5)
+
+        # delete the destination of the latest edge
+        q = "MATCH (:User {id: 0})-[r:POSTED]->(p) WITH p, r ORDER BY r.ts DESC LIMIT 1 DETACH DELETE p"
+        self.graph.query(q)
+        self.latest(pattern, "DESC", 5)
+
+        # create a new latest edge
+        q = "MATCH (u:User {id: 0}) CREATE (u)-[:POSTED {ts: 2000}]->(:Post {i: 2000})"
+        self.graph.query(q)
+        res = self.latest(pattern, "DESC", 5)
+        self.env.assertEquals(res[0], [2000, 2000])
+
+    def test06_missing_values(self):
+        # edges lacking a numeric value are ordered by the sort
+        pattern = "(u:User {id: 1})-[r:POSTED]->(p)"
+
+        q = "MATCH (:User {id: 1})-[r:POSTED]->(p {i: 1010}) SET r.ts = NULL"
+        self.graph.query(q)
+        for order in ["DESC", "ASC"]:
+            self.latest(pattern, order, 5)
+
+        q = "MATCH (:User {id: 1})-[r:POSTED]->(p {i: 1020}) SET r.ts = 'x'"
+        self.graph.query(q)
+        for order in ["DESC", "ASC"]:
+            self.latest(pattern, order, 5)
+
+        q = "MATCH (:User {id: 1})-[r:POSTED]->(p {i: 1030}) SET r = {}"
+        self.graph.query(q)
+        for order in ["DESC", "ASC"]:
+            self.latest(pattern, order, 60)
+
+        # restore numeric values, edges are ordered again
+        q = """MATCH (:User {id: 1})-[r:POSTED]->(p)
+               WHERE p.i IN [1010, 1020, 1030]
+               SET r.ts = p.i * 1.5"""
+        self.graph.query(q)
+        res = self.latest(pattern, "DESC", 5)
+        self.env.assertEquals(len(res), 5)
+
+    def test07_not_applicable(self):
+        queries = [
+            # no limit
+            """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY r.ts DESC""",
+            # multiple sort keys
+            """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY r.ts DESC, p.i LIMIT 3""",
+            # sorted by a destination attribute
+            """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY p.i DESC LIMIT 3""",
+            # sorted by a non indexed attribute
+            """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY r.x DESC LIMIT 3""",
+            # undirected edge
+            """MATCH (u:User {id: 0})-[r:POSTED]-(p)
+               RETURN p.i ORDER BY r.ts DESC LIMIT 3""",
+            # multiple relationship types
+            """MATCH (u:User {id: 0})-[r:POSTED|FOLLOWS]->(p)
+               RETURN p.i ORDER BY r.ts DESC LIMIT 3""",
+            # filtered traversal
+            """MATCH (u:User {id: 0})-[r:POSTED]->(p) WHERE p.i > 10
+               RETURN p.i ORDER BY r.ts DESC LIMIT 3""",
+        ]
+
+        for q in queries:
+            plan = str(self.graph.explain(q))
+            self.env.assertNotIn("Ordered Traverse", plan)
+
+    def test08_hub(self):
+        # a single node with many edges, created out of timestamp order
+        q = """CREATE (:User {id: 3})"""
+        self.graph.query(q)
+
+        # distinct timestamps, 7919 and 10000 are coprime
+        q = """MATCH (u:User {id: 3})
+               UNWIND range(0, 9999) AS i
+               CREATE (u)-[:POSTED {ts: (i * 7919) % 10000}]->(:Post {i: i})"""
+        self.graph.query(q)
+
+        pattern = "(u:User {id: 3})-[r:POSTED]->(p)"
+        for order in ["DESC", "ASC"]:
+            res = self.latest(pattern, order, 20)
+            self.env.assertEquals(len(res), 20)
+
+class testOrderedAdjacencyDisabled():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+    def test01_not_optimized(self):
+        # without ORDERED_ADJACENCY edge indices don't maintain an adjacency
+        q = """CREATE (u:User {id: 0})
+               WITH u
+               UNWIND range(0, 9) AS i
+               CREATE (u)-[:POSTED {ts: i}]->(:Post {i: i})"""
+        self.graph.query(q)
+        create_edge_range_index(self.graph, 'POSTED', 'ts', sync=True)
+
+        q = """MATCH (u:User {id: 0})-[r:POSTED]->(p)
+               RETURN p.i ORDER BY r.ts DESC LIMIT 3"""
+        plan = str(self.graph.explain(q))
+        self.env.assertNotIn("Ordered Traverse", plan)
+
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[9], [8], [7]])
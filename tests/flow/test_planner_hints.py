@@ -0,0 +1,112 @@
+from common import *
+from index_utils import *
+
+graph = None
+GRAPH_ID = "planner_hints"
+
+
+class testPlannerHints():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        global graph
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # (:A:B {v})-[:R]->(:C {v})-[:S]->(:D {v})
+        graph.query("""UNWIND range(0, 9) AS x
+                       CREATE (:A:B {v: x})-[:R]->(c:C {v: x})-[:S]->(:D {v: x})""")
+        create_node_range_index(graph, 'A', 'v', sync=True)
+        create_node_range_index(graph, 'C', 'v', sync=True)
+
+    def plan(self, q):
+        return str(graph.explain(q))
+
+    def test01_using_scan(self):
+        # without hint the index is utilized
+        q = "MATCH (a:A) WHERE a.v = 1 RETURN a.v"
+        plan = self.plan(q)
+        self.env.assertIn("Node By Index Scan", plan)
+
+        # USING SCAN forces a label scan
+        q = "MATCH (a:A) USING SCAN a:A WHERE a.v = 1 RETURN a.v"
+        plan = self.plan(q)
+        self.env.assertNotIn("Node By Index Scan", plan)
+        self.env.assertIn("Node By Label Scan | (a:A)", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[1]])
+
+        # hinted label is the one scanned
+        q = "MATCH (a:A:B) USING SCAN a:B RETURN count(a)"
+        plan = self.plan(q)
+        self.env.assertIn("Node By Label Scan | (a:B)", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[10]])
+
+    def test02_using_index(self):
+        # index hint determines the traversal entry point
+        q = """MATCH (a:A)-[:R]->(c:C) USING INDEX c:C(v)
+               WHERE a.v > 0 AND c.v = 3 RETURN a.v, c.v"""
+        plan = self.plan(q)
+        self.env.assertIn("Node By Index Scan | (c:C)", plan)
+        self.env.assertNotIn("Index Scan | (a:A)", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[3, 3]])
+
+        # intermediate node as the entry point
+        q = """MATCH (a:A)-[:R]->(c:C)-[:S]->(d:D) USING INDEX c:C(v)
+               WHERE c.v = 4 RETURN a.v, d.v"""
+        plan = self.plan(q)
+        self.env.assertIn("Node By Index Scan | (c:C)", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[4, 4]])
+
+    def test03_unmet_index_hint(self):
+        # no index on hinted attribute, hint is reported in the plan
+        q = "MATCH (d:D) USING INDEX d:D(v) WHERE d.v = 2 RETURN d.v"
+        plan = self.plan(q)
+        self.env.assertIn("Node By Label Scan | (d:D)", plan)
+        self.env.assertIn("index hint ignored", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[2]])
+
+        # no predicate on hinted attribute
+        q = "MATCH (c:C) USING INDEX c:C(v) RETURN count(c)"
+        plan = self.plan(q)
+        self.env.assertIn("index hint ignored", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[10]])
+
+    def test04_using_join(self):
+        q = """MATCH (a:A)-[:R]->(c:C)-[:S]->(d:D) USING JOIN ON c
+               RETURN a.v, c.v, d.v ORDER BY a.v"""
+        plan = self.plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+        expected = [[x, x, x] for x in range(10)]
+        self.env.assertEquals(graph.query(q).result_set, expected)
+
+        # join combined with scan hints on both sides
+        q = """MATCH (a:A)-[:R]->(c:C)-[:S]->(d:D)
+               USING JOIN ON c USING SCAN a:A USING SCAN d:D
+               WHERE a.v = 5 RETURN a.v, d.v"""
+        plan = self.plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+        self.env.assertIn("Node By Label Scan | (a:A)", plan)
+        self.env.assertIn("Node By Label Scan | (d:D)", plan)
+        self.env.assertEquals(graph.query(q).result_set, [[5, 5]])
+
+    def test05_invalid_hints(self):
+        queries = [
+            # hinted label is not part of the pattern
+            ("MATCH (a:A) USING SCAN a:D RETURN a", "not labeled"),
+            # hinted variable is bound by a previous clause
+            ("MATCH (a:A) WITH a MATCH (a)-[:R]->(c) USING SCAN a:A RETURN c",
+             "already bound"),
+            # join node doesn't split the pattern
+            ("MATCH (a:A)-[:R]->(c:C) USING JOIN ON a RETURN a",
+             "join hint"),
+            # two entry points within a single connected pattern
+            ("MATCH (a:A)-[:R]->(c:C) USING SCAN a:A USING SCAN c:C RETURN a",
+             "USING JOIN"),
+        ]
+        for q, err in queries:
+            try:
+                graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains(err, str(e))
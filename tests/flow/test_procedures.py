@@ -366,6 +366,7 @@ class testProcedures(FlowTestsBase):
                            ["WRITE", "db.idx.fulltext.createNodeIndex"],
                            ["WRITE", "db.idx.fulltext.drop"],
                            ["READ",  "db.idx.fulltext.queryNodes"],
+                           ["READ",  "db.idx.hybrid.queryNodes"],
                            ["READ",  "db.idx.vector.query"],
                            ["READ",  "db.indexes"],
                            ["READ",  "db.labels"],
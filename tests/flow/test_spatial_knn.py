@@ -0,0 +1,103 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "spatial_knn"
+
+# number of nodes holding a location
+POINT_COUNT = 1000
+
+# number of nodes lacking a location
+MISSING_COUNT = 5
+
+class testSpatialKNN():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # grid of locations
+        q = """UNWIND range(0, $n - 1) AS i
+               CREATE (:Store {i: i, loc: point({latitude: (i % 40) * 0.5 - 10,
+                                                 longitude: (i / 40) * 0.5 + 30})})"""
+        self.graph.query(q, params={'n': POINT_COUNT})
+
+        q = "UNWIND range(1, $n) AS i CREATE (:Store {i: -i})"
+        self.graph.query(q, params={'n': MISSING_COUNT})
+
+        create_node_range_index(self.graph, 'Store', 'loc', sync=True)
+
+    def knn(self, origin, k, skip=0):
+        # returns distances of the k nearest nodes
+        # compared against the same query sorted by an additional key
+        # which doesn't utilize the distance scan
+        lat, lon = origin
+        q = f"""MATCH (n:Store)
+                RETURN n.i, distance(n.loc, point({{latitude: {lat}, longitude: {lon}}})) AS d
+                ORDER BY d SKIP {skip} LIMIT {k}"""
+        plan = str(self.graph.explain(q))
+        self.env.assertIn("Node By Distance Scan", plan)
+
+        expected_q = q.replace("ORDER BY d", "ORDER BY d, n.i")
+        plan = str(self.graph.explain(expected_q))
+        self.env.assertNotIn("Node By Distance Scan", plan)
+
+        actual   = self.graph.query(q).result_set
+        expected = self.graph.query(expected_q).result_set
+        self.env.assertEquals([row[1] for row in actual],
+                              [row[1] for row in expected])
+        return actual
+
+    def test01_nearest(self):
+        for k in [1, 10, 100]:
+            res = self.knn((0, 35), k)
+            self.env.assertEquals(len(res), k)
+
+        # origin far away from all nodes, radius is expanded
+        res = self.knn((-60, -120), 10)
+        self.env.assertEquals(len(res), 10)
+
+    def test02_skip(self):
+        res = self.knn((0, 35), 10, skip=5)
+        self.env.assertEquals(len(res), 10)
+
+    def test03_missing_locations(self):
+        # nodes lacking a location are ordered last
+        res = self.knn((0, 35), POINT_COUNT + MISSING_COUNT + 10)
+        self.env.assertEquals(len(res), POINT_COUNT + MISSING_COUNT)
+        self.env.assertEquals([row[1] for row in res[POINT_COUNT:]],
+                              [None] * MISSING_COUNT)
+
+    def test04_records_produced(self):
+        # only the nearest nodes are scanned
+        q = """MATCH (n:Store)
+               RETURN n.i ORDER BY distance(n.loc, point({latitude: 0, longitude: 35}))
+               LIMIT 3"""
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Node By Distance Scan | (n:Store) | Records produced: 3",
+                          profile)
+
+    def test05_not_applicable(self):
+        queries = [
+            # descending order
+            """MATCH (n:Store) RETURN n.i
+               ORDER BY distance(n.loc, point({latitude: 0, longitude: 35})) DESC
+               LIMIT 3""",
+            # no limit
+            """MATCH (n:Store) RETURN n.i
+               ORDER BY distance(n.loc, point({latitude: 0, longitude: 35}))""",
+            # filtered nodes
+            """MATCH (n:Store) WHERE n.i % 2 = 0 RETURN n.i
+               ORDER BY distance(n.loc, point({latitude: 0, longitude: 35}))
+               LIMIT 3""",
+            # distance from a non constant point
+            """MATCH (n:Store) RETURN n.i
+               ORDER BY distance(n.loc, point({latitude: n.i, longitude: 35}))
+               LIMIT 3""",
+        ]
+
+        for q in queries:
+            plan = str(self.graph.explain(q))
+            self.env.assertNotIn("Node By Distance Scan", plan)
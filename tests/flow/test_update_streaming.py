@@ -0,0 +1,129 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "update_streaming"
+
+# number of records committed at once by a streaming update
+UPDATE_BATCH_SIZE = 16384
+
+# more nodes than a single update batch
+NODE_COUNT = UPDATE_BATCH_SIZE * 2 + 100
+
+class testUpdateStreaming():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+    def populate_graph(self):
+        self.conn.delete(GRAPH_ID)
+        q = f"UNWIND range(0, {NODE_COUNT - 1}) AS i CREATE (:N {{i: i, v: 0}})"
+        self.graph.query(q)
+
+    def test01_bulk_set(self):
+        self.populate_graph()
+
+        # updated attributes aren't read by the plan, updates are streamed
+        q = "MATCH (n:N) SET n.w = n.i * 2 RETURN count(n)"
+        res = self.graph.query(q)
+        self.env.assertEquals(res.result_set[0][0], NODE_COUNT)
+        self.env.assertEquals(res.properties_set, NODE_COUNT)
+
+        q = "MATCH (n:N) WHERE n.w = n.i * 2 RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT)
+
+        # returned entities reflect their updates
+        q = "MATCH (n:N) WHERE n.i < 3 SET n.x = 'y' RETURN n.i, n.x ORDER BY n.i"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[0, 'y'], [1, 'y'], [2, 'y']])
+
+    def test02_self_referencing_update(self):
+        self.populate_graph()
+
+        # update reads the attribute it sets, each node is incremented once
+        q = "MATCH (n:N) SET n.v = n.v + 1"
+        self.graph.query(q)
+
+        q = "MATCH (n:N) WHERE n.v = 1 RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT)
+
+    def test03_filter_on_updated_attribute(self):
+        self.populate_graph()
+
+        # filter reads the updated attribute, later records must not observe
+        # updates committed for earlier records
+        q = "MATCH (n:N), (m:N) WHERE n.v = 0 AND m.i = 0 SET m.v = m.v + 1"
+        self.graph.query(q)
+
+        q = "MATCH (n:N {i: 0}) RETURN n.v"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT)
+
+    def test04_duplicate_entities(self):
+        self.populate_graph()
+
+        # the same node is updated by many records
+        q = f"UNWIND range(0, {NODE_COUNT - 1}) AS i MATCH (n:N {{i: 0}}) SET n.w = i"
+        self.graph.query(q)
+
+        q = "MATCH (n:N {i: 0}) RETURN n.w"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT - 1)
+
+    def test05_limit(self):
+        self.populate_graph()
+
+        # all matched nodes are updated even though only a few are returned
+        q = "MATCH (n:N) SET n.w = 1 RETURN n.i LIMIT 5"
+        res = self.graph.query(q)
+        self.env.assertEquals(len(res.result_set), 5)
+
+        q = "MATCH (n:N) WHERE n.w = 1 RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT)
+
+    def test06_indexed_attribute(self):
+        self.populate_graph()
+        create_node_range_index(self.graph, 'N', 'i', sync=True)
+
+        # records are produced by an index scan
+        q = "MATCH (n:N) WHERE n.i >= 0 SET n.w = 2"
+        plan = self.graph.execution_plan(q)
+        self.env.assertIn("Node By Index Scan", plan)
+        self.graph.query(q)
+
+        q = "MATCH (n:N) WHERE n.w = 2 RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], NODE_COUNT)
+
+    def test07_batches(self):
+        self.populate_graph()
+
+        # streamed updates are committed in batches
+        q = "MATCH (n:N) SET n.w = n.i RETURN count(n)"
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        batches = (NODE_COUNT + UPDATE_BATCH_SIZE - 1) // UPDATE_BATCH_SIZE
+        self.env.assertIn(f"Update | Batches: {batches} | Records produced: {NODE_COUNT}", profile)
+
+        # eager updates are committed at once
+        q = "MATCH (n:N) SET n.v = n.v + 1"
+        profile = self.conn.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Update | Records produced: 0", profile)
+
+    def test08_failed_batch(self):
+        self.populate_graph()
+
+        # the last batch fails, earlier batches were committed on their own
+        # and are kept, only the failing batch is rolled back
+        q = f"""MATCH (n:N)
+               SET n.w = CASE WHEN n.i = {NODE_COUNT - 1} THEN {{a: 1}} ELSE 1 END"""
+        try:
+            self.graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Property values can only be of primitive types", str(e))
+
+        committed = (NODE_COUNT // UPDATE_BATCH_SIZE) * UPDATE_BATCH_SIZE
+        q = "MATCH (n:N) WHERE n.w IS NOT NULL RETURN count(n)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], committed)
+
+        q = "MATCH (n:N) WHERE n.w IS NOT NULL RETURN max(n.i)"
+        self.env.assertEquals(self.graph.query(q).result_set[0][0], committed - 1)
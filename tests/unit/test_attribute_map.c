@@ -0,0 +1,184 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/graph/attribute_map.h"
+
+#include <stdio.h>
+#include <limits.h>
+#include <pthread.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define READER_COUNT      8
+#define ATTRIBUTE_COUNT   4096
+
+static void _AttributeName
+(
+	char *buf,
+	uint i
+) {
+	sprintf(buf, "attr_%u", i);
+}
+
+void test_AttributeMap_AddGet(void) {
+	char name[32];
+	AttributeMap *map = AttributeMap_New();
+
+	TEST_ASSERT(AttributeMap_Count(map) == 0);
+	TEST_ASSERT(AttributeMap_GetID(map, "a") == ATTRIBUTE_ID_NONE);
+
+	// add enough attributes for the map to grow a few times
+	for(uint i = 0; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, i);
+		TEST_ASSERT(AttributeMap_Add(map, name) == i);
+		TEST_ASSERT(AttributeMap_Count(map) == i + 1);
+	}
+
+	for(uint i = 0; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, i);
+		TEST_ASSERT(AttributeMap_GetID(map, name) == i);
+		TEST_ASSERT(strcmp(AttributeMap_GetName(map, i), name) == 0);
+	}
+
+	// remove last attribute
+	_AttributeName(name, ATTRIBUTE_COUNT - 1);
+	AttributeMap_RemoveLast(map);
+	TEST_ASSERT(AttributeMap_Count(map) == ATTRIBUTE_COUNT - 1);
+	TEST_ASSERT(AttributeMap_GetID(map, name) == ATTRIBUTE_ID_NONE);
+
+	// removed ID is reassigned
+	TEST_ASSERT(AttributeMap_Add(map, "b") == ATTRIBUTE_COUNT - 1);
+	TEST_ASSERT(AttributeMap_GetID(map, "b") == ATTRIBUTE_COUNT - 1);
+	TEST_ASSERT(strcmp(AttributeMap_GetName(map, ATTRIBUTE_COUNT - 1), "b") == 0);
+
+	AttributeMap_Free(map);
+}
+
+//------------------------------------------------------------------------------
+// concurrent readers
+//------------------------------------------------------------------------------
+
+typedef struct {
+	AttributeMap *map;  // map under test
+	bool *done;         // writer is done
+	bool valid;         // all lookups were consistent
+} ReaderCtx;
+
+static void *_Reader
+(
+	void *arg
+) {
+	char name[32];
+	ReaderCtx *ctx = arg;
+	uint i = 0;
+
+	while(!__atomic_load_n(ctx->done, __ATOMIC_ACQUIRE)) {
+		uint count = AttributeMap_Count(ctx->map);
+		if(count == 0) continue;
+
+		// every published attribute must be resolvable both ways
+		Attribute_ID id = i++ % count;
+		_AttributeName(name, id);
+		const char *attr = AttributeMap_GetName(ctx->map, id);
+		if(strcmp(attr, name) != 0 ||
+		   AttributeMap_GetID(ctx->map, name) != id) {
+			ctx->valid = false;
+		}
+	}
+
+	return NULL;
+}
+
+void test_AttributeMap_ConcurrentReaders(void) {
+	char name[32];
+	bool done = false;
+	AttributeMap *map = AttributeMap_New();
+
+	pthread_t readers[READER_COUNT];
+	ReaderCtx ctxs[READER_COUNT];
+	for(uint i = 0; i < READER_COUNT; i++) {
+		ctxs[i] = (ReaderCtx){.map = map, .done = &done, .valid = true};
+		pthread_create(readers + i, NULL, _Reader, ctxs + i);
+	}
+
+	// add attributes while readers resolve them
+	for(uint i = 0; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, i);
+		AttributeMap_Add(map, name);
+	}
+
+	__atomic_store_n(&done, true, __ATOMIC_RELEASE);
+	for(uint i = 0; i < READER_COUNT; i++) {
+		pthread_join(readers[i], NULL);
+		TEST_ASSERT(ctxs[i].valid);
+	}
+
+	AttributeMap_Free(map);
+}
+
+//------------------------------------------------------------------------------
+// rollbacks
+//------------------------------------------------------------------------------
+
+void test_AttributeMap_RemoveLast(void) {
+	char name[32];
+	AttributeMap *map = AttributeMap_New();
+
+	for(uint i = 0; i < 16; i++) {
+		_AttributeName(name, i);
+		AttributeMap_Add(map, name);
+	}
+
+	// repeatedly add and remove attributes, as failing queries do
+	// removed slots are tombstoned and must not break probes of others
+	for(uint i = 0; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, 16 + i % 3);
+		TEST_ASSERT(AttributeMap_Add(map, name) == 16);
+		TEST_ASSERT(AttributeMap_Add(map, "extra") == 17);
+		TEST_ASSERT(AttributeMap_GetID(map, name) == 16);
+		TEST_ASSERT(strcmp(AttributeMap_GetName(map, 16), name) == 0);
+
+		AttributeMap_RemoveLast(map);
+		AttributeMap_RemoveLast(map);
+		TEST_ASSERT(AttributeMap_Count(map) == 16);
+		TEST_ASSERT(AttributeMap_GetID(map, name) == ATTRIBUTE_ID_NONE);
+		TEST_ASSERT(AttributeMap_GetID(map, "extra") == ATTRIBUTE_ID_NONE);
+	}
+
+	for(uint i = 0; i < 16; i++) {
+		_AttributeName(name, i);
+		TEST_ASSERT(AttributeMap_GetID(map, name) == i);
+	}
+
+	// grow the map past removed attributes
+	for(uint i = 16; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, i);
+		TEST_ASSERT(AttributeMap_Add(map, name) == i);
+	}
+
+	for(uint i = 0; i < ATTRIBUTE_COUNT; i++) {
+		_AttributeName(name, i);
+		TEST_ASSERT(AttributeMap_GetID(map, name) == i);
+		TEST_ASSERT(strcmp(AttributeMap_GetName(map, i), name) == 0);
+	}
+	TEST_ASSERT(AttributeMap_GetID(map, "extra") == ATTRIBUTE_ID_NONE);
+
+	AttributeMap_Free(map);
+}
+
+TEST_LIST = {
+	{"AttributeMap_AddGet", test_AttributeMap_AddGet},
+	{"AttributeMap_ConcurrentReaders", test_AttributeMap_ConcurrentReaders},
+	{"AttributeMap_RemoveLast", test_AttributeMap_RemoveLast},
+	{NULL, NULL}
+};
+
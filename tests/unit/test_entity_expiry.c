@@ -0,0 +1,69 @@
+/*
+ * Copyright FalkorDB Ltd. 2023 - present
+ * Licensed under the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/graph/entity_expiry.h"
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+void test_expiryOrder() {
+	EntityExpiry *ex = EntityExpiry_New();
+
+	EntityID id;
+	GraphEntityType t;
+
+	// nothing is due
+	TEST_ASSERT(!EntityExpiry_Due(ex, INT64_MAX));
+	TEST_ASSERT(!EntityExpiry_Pop(ex, INT64_MAX, &t, &id));
+
+	// entries are added out of order, including negative times
+	EntityExpiry_Add(ex, GETYPE_NODE, 300, 1000);
+	EntityExpiry_Add(ex, GETYPE_EDGE, 7,   -5);
+	EntityExpiry_Add(ex, GETYPE_NODE, 2,   1000);
+	EntityExpiry_Add(ex, GETYPE_EDGE, 1,   20);
+	EntityExpiry_Add(ex, GETYPE_NODE, 9,   5000);
+
+	// duplicate entry
+	EntityExpiry_Add(ex, GETYPE_EDGE, 1,   20);
+
+	TEST_ASSERT(!EntityExpiry_Due(ex, -6));
+	TEST_ASSERT(EntityExpiry_Due(ex, -5));
+
+	// entries are popped by expiration time
+	TEST_ASSERT(EntityExpiry_Pop(ex, 1000, &t, &id));
+	TEST_ASSERT(t == GETYPE_EDGE && id == 7);
+
+	TEST_ASSERT(EntityExpiry_Pop(ex, 1000, &t, &id));
+	TEST_ASSERT(t == GETYPE_EDGE && id == 1);
+
+	// same expiration time, ordered by entity ID
+	TEST_ASSERT(EntityExpiry_Pop(ex, 1000, &t, &id));
+	TEST_ASSERT(t == GETYPE_NODE && id == 2);
+
+	TEST_ASSERT(EntityExpiry_Pop(ex, 1000, &t, &id));
+	TEST_ASSERT(t == GETYPE_NODE && id == 300);
+
+	// remaining entry isn't due
+	TEST_ASSERT(!EntityExpiry_Pop(ex, 1000, &t, &id));
+	TEST_ASSERT(!EntityExpiry_Due(ex, 4999));
+
+	TEST_ASSERT(EntityExpiry_Pop(ex, 5000, &t, &id));
+	TEST_ASSERT(t == GETYPE_NODE && id == 9);
+
+	TEST_ASSERT(!EntityExpiry_Due(ex, INT64_MAX));
+
+	EntityExpiry_Free(ex);
+}
+
+TEST_LIST = {
+	{"expiryOrder", test_expiryOrder},
+	{NULL, NULL}
+};
+
@@ -44,13 +44,12 @@ static void _fake_graph_context() {
 	gc->ref_count        = 1;
 	gc->index_count      = 0;
 	gc->graph_name       = strdup("G");
-	gc->attributes       = raxNew();
-	gc->string_mapping   = (char**)array_new(char*, 64);
+	gc->attributes       = AttributeMap_New();
 	gc->node_schemas     = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
 	gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
 	gc->queries_log      = QueriesLog_New();
 
-	pthread_rwlock_init(&gc->_attribute_rwlock,  NULL);
+	pthread_mutex_init(&gc->_attribute_mutex, NULL);
 	QueryCtx_SetGraphCtx(gc);
 }
 
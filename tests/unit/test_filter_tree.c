@@ -29,8 +29,8 @@ void _fake_graph_context() {
 	// accessible via thread local storage, as such we're creating a
 	// fake graph context and placing it within thread local storage
 	GraphContext *gc = (GraphContext *)calloc(1, sizeof(GraphContext));
-	gc->attributes = raxNew();
-	pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
+	gc->attributes = AttributeMap_New();
+	pthread_mutex_init(&gc->_attribute_mutex, NULL);
 	QueryCtx_SetGraphCtx(gc);
 }
 
@@ -44,7 +44,7 @@ void setup() {
 
 void tearDown() {
 	GraphContext *gc = QueryCtx_GetGraphCtx();
-	raxFree(gc->attributes);
+	AttributeMap_Free(gc->attributes);
 	free(gc);
 	QueryCtx_Free();
 }
@@ -387,11 +387,21 @@ void test_getEdge() {
 	Graph_CreateEdge(g, 3, 4, relations[3], &e);
 
 	// Validations
-	// Try to get edges by ID
+	// Try to get edges by ID, including their endpoints and relation
+	NodeID expected_src[5]  = {0, 0, 1, 2, 3};
+	NodeID expected_dest[5] = {1, 1, 2, 3, 4};
+	int expected_rel[5]     = {relations[0], relations[1], relations[1],
+		relations[2], relations[3]};
+
 	for(EdgeID i = 0; i < edgeCount; i++) {
+		e = (Edge){0};
 		Graph_GetEdge(g, i, &e);
 		TEST_ASSERT(e.attributes != NULL);
 		TEST_ASSERT(e.id == i);
+		TEST_ASSERT(Edge_GetSrcNodeID(&e) == expected_src[i]);
+		TEST_ASSERT(Edge_GetDestNodeID(&e) == expected_dest[i]);
+		TEST_ASSERT(Edge_GetRelationID(&e) == expected_rel[i]);
+		TEST_ASSERT(Graph_GetEdgeRelation(g, &e) == expected_rel[i]);
 	}
 
 	// Try to get edges connecting source to destination node.
@@ -463,11 +473,51 @@ void test_getEdge() {
 	Graph_Free(g);
 }
 
+// tests labels and relations are stamped by the write modifying them
+void test_modifiedSince() {
+	Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+
+	// first write creates a labeled node
+	Graph_AcquireWriteLock(g);
+	uint64_t v = Graph_WriteVersion(g);
+	LabelID l = Graph_AddLabel(g);
+	RelationID r = Graph_AddRelationType(g);
+	Node n = GE_NEW_NODE();
+	Graph_CreateNode(g, &n, &l, 1);
+	Graph_TouchNode(g, ENTITY_GET_ID(&n));
+	Graph_ReleaseLock(g);
+
+	TEST_ASSERT(Graph_LabelModifiedSince(g, l, v - 1));
+	TEST_ASSERT(!Graph_LabelModifiedSince(g, l, v));
+	TEST_ASSERT(!Graph_RelationModifiedSince(g, r, v - 1));
+
+	// second write modifies the relation only
+	Graph_AcquireWriteLock(g);
+	Graph_TouchRelation(g, r);
+	Graph_ReleaseLock(g);
+
+	TEST_ASSERT(!Graph_LabelModifiedSince(g, l, v));
+	TEST_ASSERT(Graph_RelationModifiedSince(g, r, v));
+
+	// third write modifies every entity
+	Graph_AcquireWriteLock(g);
+	uint64_t all = Graph_WriteVersion(g);
+	Graph_TouchAll(g);
+	Graph_ReleaseLock(g);
+
+	TEST_ASSERT(Graph_LabelModifiedSince(g, l, v + 1));
+	TEST_ASSERT(Graph_RelationModifiedSince(g, r, v + 1));
+	TEST_ASSERT(!Graph_LabelModifiedSince(g, l, all));
+
+	Graph_Free(g);
+}
+
 TEST_LIST = {
 	{"newGraph", test_newGraph},
 	{"graphConstruction", test_graphConstruction},
 	{"removeNodes", test_removeNodes},
 	{"getNode", test_getNode},
 	{"getEdge", test_getEdge},
+	{"modifiedSince", test_modifiedSince},
 	{NULL, NULL}
 };